@@ -16,6 +16,7 @@ macro(os_set_flags)
         set(CMAKE_C_FLAGS   "${CMAKE_C_FLAGS}   -mssse3")
         set(CMAKE_CXX_FLAGS "${CMAKE_CXX_FLAGS} -mssse3")
         set(LRS_TRY_USE_AVX true)
+        set(LRS_AVX2_FLAGS -mavx2)
     endif(${MACHINE} MATCHES "arm-linux-gnueabihf")
 
     if(BUILD_WITH_OPENMP)
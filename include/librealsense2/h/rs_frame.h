@@ -81,6 +81,16 @@ rs2_metadata_type rs2_get_frame_metadata(const rs2_frame* frame, rs2_frame_metad
 */
 int rs2_supports_frame_metadata(const rs2_frame* frame, rs2_frame_metadata_value frame_metadata, rs2_error** error);
 
+/**
+* retrieve all the metadata attributes of the frame in a single call
+* \param[in] frame         handle returned from a callback
+* \param[out] values       receives the value of every supported attribute, indexed by rs2_frame_metadata_value, zero for the others
+* \param[in] count         number of elements in values, usually RS2_FRAME_METADATA_COUNT. Elements past it are left untouched
+* \param[out] error        if non-null, receives any error that occurs during this call, otherwise, errors are ignored
+* \return                  bitmask of the supported attributes, bit i is set when values[i] holds the metadata value
+*/
+unsigned long long rs2_get_frame_metadata_all(const rs2_frame* frame, rs2_metadata_type* values, int count, rs2_error** error);
+
 /**
 * retrieve timestamp domain from frame handle. timestamps can only be comparable if they are in common domain
 * (for example, depth timestamp might come from system time while color timestamp might come from the device)
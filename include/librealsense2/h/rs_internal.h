@@ -111,6 +111,16 @@ typedef struct rs2_software_pose_frame
     const rs2_stream_profile* profile;
 } rs2_software_pose_frame;
 
+/** \brief Debug counters of the frame buffer pool of a sensor, accumulated over all of its frame types*/
+typedef struct rs2_frame_pool_statistics
+{
+    unsigned long long hits;           /**< Frame buffers served from the pool */
+    unsigned long long misses;         /**< Frame buffers that had to be allocated */
+    unsigned long long expired;        /**< Pooled buffers discarded after exceeding the retention period */
+    unsigned long long pooled_buffers; /**< Buffers currently held by the pool */
+    unsigned long long pooled_bytes;   /**< Memory currently held by the pool */
+} rs2_frame_pool_statistics;
+
 /**
  * Create librealsense context that will try to record all operations over librealsense into a file
  * \param[in] api_version realsense API version as provided by RS2_API_VERSION macro
@@ -243,6 +253,14 @@ void rs2_software_sensor_add_read_only_option(rs2_sensor* sensor, rs2_option opt
  * \param[out] error  if non-null, receives any error that occurs during this call, otherwise, errors are ignored
  */
 void rs2_software_sensor_update_read_only_option(rs2_sensor* sensor, rs2_option option, float val, rs2_error** error);
+
+/**
+ * Query the frame buffer pool counters of a sensor. Retention of the pool is controlled by RS2_OPTION_FRAME_POOL_RETENTION
+ * \param[in] sensor the sensor
+ * \param[out] stats the pool counters
+ * \param[out] error  if non-null, receives any error that occurs during this call, otherwise, errors are ignored
+ */
+void rs2_get_frame_pool_statistics(const rs2_sensor* sensor, rs2_frame_pool_statistics* stats, rs2_error** error);
 #ifdef __cplusplus
 }
 #endif
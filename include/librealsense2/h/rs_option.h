@@ -81,6 +81,13 @@ extern "C" {
         RS2_OPTION_ENABLE_POSE_JUMPING, /**< Enable position jumping */
         RS2_OPTION_ENABLE_DYNAMIC_CALIBRATION, /**< Enable dynamic calibration */
         RS2_OPTION_DEPTH_OFFSET, /**< Offset from sensor to depth origin in millimetrers*/
+        RS2_OPTION_FRAME_POOL_RETENTION, /**< Time in milliseconds released frame buffers are kept for reuse by the sensor. Zero disables buffer recycling */
+        RS2_OPTION_PROCESSING_THREADS, /**< Number of threads a processing block splits its work across. 1 runs on the calling thread only */
+        RS2_OPTION_PROCESSING_QUEUE_SIZE, /**< Number of frames that may wait to be processed asynchronously on the library's shared worker threads. 0 processes frames synchronously on the invoking thread */
+        RS2_OPTION_PROCESSING_DROP_POLICY, /**< Handling of a frame invoked while the processing queue is full: 0 - drop the oldest queued frame, 1 - drop the new frame, 2 - block the invoking thread */
+        RS2_OPTION_SYNC_TOLERANCE, /**< Largest difference in milliseconds between the timestamps of matched frames. 0 uses half the shortest frame interval of the matched streams */
+        RS2_OPTION_SYNC_MAX_LATENCY, /**< Milliseconds of timestamps a frameset waits for frames of missing streams before it is passed on without them */
+        RS2_OPTION_SYNC_DROP_INCOMPLETE, /**< Handling of a frameset missing some of its streams: 0 - pass it on, 1 - release its frames */
         RS2_OPTION_COUNT /**< Number of enumeration values. Not a valid input: intended to be used in for-loops. */
     } rs2_option;
 
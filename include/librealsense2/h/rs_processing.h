@@ -35,6 +35,16 @@ rs2_processing_block* rs2_create_colorizer(rs2_error** error);
 */
 rs2_processing_block* rs2_create_sync_processing_block(rs2_error** error);
 
+/**
+* Creates multi-device Sync processing block. This block accepts frames of any number of devices and outputs composite frames of the frames whose timestamps match
+* Frames are matched by their global time (or system time) timestamps, frames of other timestamp domains are passed on alone
+* The first framesets wait until every device had the time to deliver a frame, and a frameset waits for its missing streams for a bounded time,
+* set along with the matching tolerance and the handling of incomplete framesets
+* through RS2_OPTION_SYNC_TOLERANCE, RS2_OPTION_SYNC_MAX_LATENCY and RS2_OPTION_SYNC_DROP_INCOMPLETE
+* \param[out] error  if non-null, receives any error that occurs during this call, otherwise, errors are ignored
+*/
+rs2_processing_block* rs2_create_multi_device_sync_processing_block(rs2_error** error);
+
 /**
 * Creates Point-Cloud processing block. This block accepts depth frames and outputs Points frames
 * In addition, given non-depth frame, the block will align texture coordinate to the non-depth stream
@@ -149,6 +159,16 @@ void rs2_delete_processing_block(rs2_processing_block* block);
 */
 rs2_frame_queue* rs2_create_frame_queue(int capacity, rs2_error** error);
 
+/**
+* create frame queue, selecting its implementation. The lock-free queue keeps the same drop-oldest and blocking
+* semantics, but producers and consumer do not contend on a mutex, which pays off when many streams share a host
+* \param[in] capacity max number of frames to allow to be stored in the queue before older frames will start to get dropped
+* \param[in] lock_free non-zero to back the queue with a bounded lock-free ring buffer instead of a mutex-protected queue
+* \param[out] error  if non-null, receives any error that occurs during this call, otherwise, errors are ignored
+* \return handle to the frame queue, must be released using rs2_delete_frame_queue
+*/
+rs2_frame_queue* rs2_create_frame_queue_ex(int capacity, int lock_free, rs2_error** error);
+
 /**
 * deletes frame queue and releases all frames inside it
 * \param[in] queue queue to delete
@@ -243,6 +263,21 @@ rs2_processing_block* rs2_create_rates_printer_block(rs2_error** error);
 */
 rs2_processing_block* rs2_create_zero_order_invalidation_block(rs2_error** error);
 
+/**
+* Creates a depth post-processing block that runs decimation, spatial, temporal and hole filling filters as one block.
+* The stages keep their order and options, and the output matches that of the chained blocks, but the frame is processed in place
+* rather than copied by each stage. A stage's block should not be used to process frames on its own as well
+* \param[in] decimation     Decimation filter block, or NULL to skip this stage
+* \param[in] spatial        Spatial filter block, or NULL to skip this stage
+* \param[in] temporal       Temporal filter block, or NULL to skip this stage
+* \param[in] hole_filling   Hole filling filter block, or NULL to skip this stage
+* \param[in] use_disparity  Non-zero runs the spatial and temporal filters in the disparity domain of stereo-based depth
+* \param[out] error         If non-null, receives any error that occurs during this call, otherwise, errors are ignored
+* \return                   depth post-processing block
+*/
+rs2_processing_block* rs2_create_depth_postprocess_block(rs2_processing_block* decimation, rs2_processing_block* spatial,
+    rs2_processing_block* temporal, rs2_processing_block* hole_filling, int use_disparity, rs2_error** error);
+
 /**
 * Retrieve processing block specific information, like name.
 * \param[in]  block     The processing block
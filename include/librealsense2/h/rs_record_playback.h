@@ -27,6 +27,37 @@ typedef enum rs2_playback_status
 
 const char* rs2_playback_status_to_string(rs2_playback_status status);
 
+/** \brief Defines what the recorder does with new frames once the frames waiting to be written reach its memory cap */
+typedef enum rs2_recorder_overflow_policy
+{
+    RS2_RECORDER_OVERFLOW_POLICY_DROP_FRAMES, /**< New frames are not recorded until the writer catches up, and are counted as dropped */
+    RS2_RECORDER_OVERFLOW_POLICY_BLOCK,       /**< The sensor delivering a new frame waits until the writer catches up */
+    RS2_RECORDER_OVERFLOW_POLICY_COUNT
+} rs2_recorder_overflow_policy;
+
+const char* rs2_recorder_overflow_policy_to_string(rs2_recorder_overflow_policy policy);
+
+/** \brief Recording settings, see rs2_create_record_device_with_config */
+typedef struct rs2_recorder_config
+{
+    int                          compression_level;   /**< 0 records uncompressed, 1 (fastest) to 9 (smallest) selects the LZ4 compression level */
+    int                          compression_threads; /**< Threads compressing the recorded chunks, 0 compresses on the writing thread */
+    unsigned long long           max_pending_bytes;   /**< Memory cap of the frames waiting to be written, 0 selects the default cap */
+    rs2_recorder_overflow_policy overflow_policy;     /**< What to do with new frames once max_pending_bytes is reached */
+} rs2_recorder_config;
+
+/** \brief Progress of a recording device */
+typedef struct rs2_recorder_statistics
+{
+    unsigned long long pending_frames;     /**< Frames waiting to be written */
+    unsigned long long pending_bytes;      /**< Size of the frames waiting to be written */
+    unsigned long long dropped_frames;     /**< Frames not recorded because max_pending_bytes was reached */
+    unsigned long long compressing_chunks; /**< Chunks being compressed, not yet written to the file */
+    unsigned long long compressing_bytes;  /**< Uncompressed size of the chunks being compressed */
+    unsigned long long written_chunks;     /**< Chunks written to the file */
+    unsigned long long written_bytes;      /**< Size of the chunks written to the file */
+} rs2_recorder_statistics;
+
 typedef void (*rs2_playback_status_changed_callback_ptr)(rs2_playback_status);
 
 /**
@@ -48,6 +79,26 @@ rs2_device* rs2_create_record_device(const rs2_device* device, const char* file,
 */
 rs2_device* rs2_create_record_device_ex(const rs2_device* device, const char* file, int compression_enabled, rs2_error** error);
 
+/**
+* Creates a recording device to record the given device and save it to the given file, with the given recording settings
+* Unlike the recorders of rs2_create_record_device, which compress on their writing thread and never drop a frame,
+* it may compress on background threads and caps the memory of the frames waiting to be written
+* \param[in]  device    The device to record
+* \param[in]  file      The desired path to which the recorder should save the data
+* \param[in]  config    Compression and memory settings of the recorder
+* \param[out] error     If non-null, receives any error that occurs during this call, otherwise, errors are ignored
+* \return A pointer to a device that records its data to file, or null in case of failure
+*/
+rs2_device* rs2_create_record_device_with_config(const rs2_device* device, const char* file, const rs2_recorder_config* config, rs2_error** error);
+
+/**
+* Gets the progress of the recording device: frames and chunks waiting to be written, and dropped frames
+* \param[in]  device    A recording device
+* \param[out] stats     The recorder counters
+* \param[out] error     If non-null, receives any error that occurs during this call, otherwise, errors are ignored
+*/
+void rs2_record_device_get_statistics(const rs2_device* device, rs2_recorder_statistics* stats, rs2_error** error);
+
 /**
 * Pause the recording device without stopping the actual device from streaming.
 * Pausing will cause the device to stop writing new data to the file, in particular, frames and changes to extensions
@@ -111,6 +162,25 @@ void rs2_playback_seek(const rs2_device* device, long long int time, rs2_error**
  */
 unsigned long long int rs2_playback_get_position(const rs2_device* device, rs2_error** error);
 
+/**
+ * Gets the number of frames of a stream recorded in the file
+ * \param[in] device     A playback device
+ * \param[in] profile    One of the stream profiles of the playback device
+ * \param[out] error     If non-null, receives any error that occurs during this call, otherwise, errors are ignored
+ * \return Number of frames of the stream in the file
+ */
+unsigned long long int rs2_playback_get_frames_count(const rs2_device* device, const rs2_stream_profile* profile, rs2_error** error);
+
+/**
+ * Reads a single frame of a stream from the file by its index, without affecting the playback position
+ * \param[in] device     A playback device
+ * \param[in] profile    One of the stream profiles of the playback device
+ * \param[in] index      Zero based index of the frame within the stream, smaller than rs2_playback_get_frames_count
+ * \param[out] error     If non-null, receives any error that occurs during this call, otherwise, errors are ignored
+ * \return The requested frame, should be released by rs2_release_frame
+ */
+rs2_frame* rs2_playback_get_frame(const rs2_device* device, const rs2_stream_profile* profile, unsigned long long int index, rs2_error** error);
+
 /**
  * Pauses the playback
  * Calling pause() in "Paused" status does nothing
@@ -142,6 +212,17 @@ void rs2_playback_device_pause(const rs2_device* device, rs2_error** error);
  */
 void rs2_playback_device_set_real_time(const rs2_device* device, int real_time, rs2_error** error);
 
+/**
+ * Set how far a playback device reads ahead of the frames it delivers in non real time mode.
+ * Compressed chunks of the file are decompressed on background threads, and each stream keeps a few decoded frames
+ * ready for its callback. By default one thread per additional CPU core, up to 4, and 64MB are used.
+ * \param[in] device    A playback device
+ * \param[in] threads   Number of decompression threads, 0 reads each frame only when it is played
+ * \param[in] max_bytes Uncompressed size of the file data held ahead of the frame being played
+ * \param[out] error    If non-null, receives any error that occurs during this call, otherwise, errors are ignored
+ */
+void rs2_playback_device_set_read_ahead(const rs2_device* device, unsigned int threads, unsigned long long max_bytes, rs2_error** error);
+
 /**
  * Indicates if playback is in real time mode or non real time
  * \param[in] device A playback device
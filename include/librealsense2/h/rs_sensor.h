@@ -79,6 +79,7 @@ typedef enum rs2_format
     RS2_FORMAT_Y10BPACK        , /**< 16-bit per-pixel grayscale image unpacked from 10 bits per pixel packed ([8:8:8:8:2222]) grey-scale image. The data is unpacked to LSB and padded with 6 zero bits */
     RS2_FORMAT_DISTANCE        , /**< 32-bit float-point depth distance value.  */
     RS2_FORMAT_MJPEG           , /**< Bitstream encoding for video in which an image of each frame is encoded as JPEG-DIB   */
+    RS2_FORMAT_MOTION_XYZ32F_BATCH, /**< Motion data of several consecutive samples, packed as an array of rs2_motion_sample. Listed after all the regular profiles of a sensor, and only streamed when requested explicitly */
     RS2_FORMAT_COUNT             /**< Number of enumeration values. Not a valid input: intended to be used in for-loops. */
 } rs2_format;
 const char* rs2_format_to_string(rs2_format format);
@@ -260,6 +261,27 @@ void rs2_stop(const rs2_sensor* sensor, rs2_error** error);
 */
 void rs2_set_notifications_callback(const rs2_sensor* sensor, rs2_notification_callback_ptr on_notification, void* user, rs2_error** error);
 
+/**
+* set a custom allocator for the buffers of frames produced by the sensor, e.g. to place them in pinned or shared memory.
+* Buffers are recycled by the sensor, so the allocator is called mostly during the first frames of a stream.
+* Buffers already allocated keep a reference to their allocator, free_cb may therefore be called after the sensor has stopped.
+* Software sensors publish the pixels they are given and do not allocate frame buffers
+* \param[in] sensor     RealSense sensor
+* \param[in] alloc_cb   function returning a buffer of at least the given number of bytes, or null to fall back to the default allocator. Pass null to restore the default allocator
+* \param[in] free_cb    function releasing a buffer returned by alloc_cb, receives the size it was allocated with
+* \param[in] user       auxiliary data passed to both callbacks
+* \param[out] error     if non-null, receives any error that occurs during this call, otherwise, errors are ignored
+*/
+void rs2_set_frame_allocator(const rs2_sensor* sensor, rs2_frame_alloc_callback_ptr alloc_cb, rs2_frame_free_callback_ptr free_cb, void* user, rs2_error** error);
+
+/**
+* set a custom allocator for the buffers of frames produced by the sensor
+* \param[in] sensor     RealSense sensor
+* \param[in] allocator  allocator object, ownership is passed to the sensor and it is released once no frame buffer refers to it
+* \param[out] error     if non-null, receives any error that occurs during this call, otherwise, errors are ignored
+*/
+void rs2_set_frame_allocator_cpp(const rs2_sensor* sensor, rs2_frame_allocator* allocator, rs2_error** error);
+
 /**
 * set callback to get notifications from specified device
 * \param[in] sensor  RealSense sensor
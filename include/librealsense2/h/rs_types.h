@@ -98,6 +98,13 @@ typedef struct rs2_vector
     float x, y, z;
 }rs2_vector;
 
+/** \brief Single sample of a motion frame in RS2_FORMAT_MOTION_XYZ32F_BATCH format */
+typedef struct rs2_motion_sample
+{
+    rs2_vector data;      /**< X, Y, Z values of the sample, in the units of RS2_FORMAT_MOTION_XYZ32F */
+    double     timestamp; /**< Timestamp of the sample in milliseconds, in the timestamp domain of the frame */
+} rs2_motion_sample;
+
 /** \brief Quaternion used to represent rotation  */
 typedef struct rs2_quaternion
 {
@@ -170,6 +177,7 @@ typedef enum rs2_extension
     RS2_EXTENSION_GLOBAL_TIMER,
     RS2_EXTENSION_UPDATABLE,
     RS2_EXTENSION_UPDATE_DEVICE,
+    RS2_EXTENSION_DEPTH_POSTPROCESS_FILTER,
     RS2_EXTENSION_COUNT
 } rs2_extension;
 const char* rs2_extension_type_to_string(rs2_extension type);
@@ -233,11 +241,14 @@ typedef struct rs2_options_list rs2_options_list;
 typedef struct rs2_devices_changed_callback rs2_devices_changed_callback;
 typedef struct rs2_notification rs2_notification;
 typedef struct rs2_notifications_callback rs2_notifications_callback;
+typedef struct rs2_frame_allocator rs2_frame_allocator;
 typedef void (*rs2_notification_callback_ptr)(rs2_notification*, void*);
 typedef void (*rs2_devices_changed_callback_ptr)(rs2_device_list*, rs2_device_list*, void*);
 typedef void (*rs2_frame_callback_ptr)(rs2_frame*, void*);
 typedef void (*rs2_frame_processor_callback_ptr)(rs2_frame*, rs2_source*, void*);
 typedef void(*rs2_update_progress_callback_ptr)(const float, void*);
+typedef void* (*rs2_frame_alloc_callback_ptr)(int, void*);
+typedef void (*rs2_frame_free_callback_ptr)(void*, int, void*);
 
 typedef double      rs2_time_t;     /**< Timestamp format. units are milliseconds */
 typedef long long   rs2_metadata_type; /**< Metadata attribute type is defined as 64 bit signed integer*/
@@ -467,6 +467,19 @@ namespace rs2
             return r != 0;
         }
 
+        /** retrieve all the frame_metadata values in a single call
+        * \param[out] values  receives the value of every supported frame_metadata, indexed by rs2_frame_metadata_value
+        * \param[in] count    number of elements in values
+        * \return             bitmask of the supported frame_metadata, bit i is set when values[i] is valid
+        */
+        unsigned long long get_frame_metadata_all(rs2_metadata_type* values, int count = RS2_FRAME_METADATA_COUNT) const
+        {
+            rs2_error* e = nullptr;
+            auto r = rs2_get_frame_metadata_all(frame_ref, values, count, &e);
+            error::handle(e);
+            return r;
+        }
+
         /**
         * retrieve frame number (from frame handle)
         * \return               the frame number of the frame, in milliseconds since the device was started
@@ -832,6 +845,29 @@ namespace rs2
             auto data = reinterpret_cast<const float*>(get_data());
             return rs2_vector{ data[0], data[1], data[2] };
         }
+
+        /**
+        * Retrieve the number of IMU samples held by the frame
+        * \return More than one only for frames of RS2_FORMAT_MOTION_XYZ32F_BATCH format
+        */
+        size_t get_samples_count() const
+        {
+            if (get_profile().format() != RS2_FORMAT_MOTION_XYZ32F_BATCH)
+                return 1;
+            return get_data_size() / sizeof(rs2_motion_sample);
+        }
+
+        /**
+        * Retrieve a single IMU sample of the frame
+        * \param[in] index  Zero based index of the sample, less than get_samples_count()
+        * \return rs2_motion_sample - the sample data and its timestamp
+        */
+        rs2_motion_sample get_sample(size_t index) const
+        {
+            if (get_profile().format() != RS2_FORMAT_MOTION_XYZ32F_BATCH)
+                return rs2_motion_sample{ get_motion_data(), get_timestamp() };
+            return reinterpret_cast<const rs2_motion_sample*>(get_data())[index];
+        }
     };
 
     class pose_frame : public frame
@@ -129,6 +129,20 @@ namespace rs2
             error::handle(e);
         }
 
+        /**
+        * create frame queue, selecting its implementation
+        * param[in] capacity size of the frame queue
+        * param[in] lock_free back the queue with a bounded lock-free ring buffer, reducing contention between producers and consumer
+        */
+        frame_queue(unsigned int capacity, bool lock_free) : _capacity(capacity)
+        {
+            rs2_error* e = nullptr;
+            _queue = std::shared_ptr<rs2_frame_queue>(
+                rs2_create_frame_queue_ex(capacity, lock_free ? 1 : 0, &e),
+                rs2_delete_frame_queue);
+            error::handle(e);
+        }
+
         frame_queue() : frame_queue(1) {}
 
         /**
@@ -566,6 +580,36 @@ namespace rs2
         }
     };
 
+    class multi_device_syncer : public processing_block
+    {
+    public:
+        /**
+        * Creates a syncer that matches the frames of several devices by their global time timestamps
+        * \param[in] tolerance_ms       Largest difference between the timestamps of matched frames, 0 for half the shortest frame interval
+        * \param[in] max_latency_ms     Timestamp milliseconds a frameset waits for frames of missing streams, and the first framesets for the devices to start
+        * \param[in] drop_incomplete    Release framesets missing some of their streams instead of passing them on
+        */
+        multi_device_syncer(float tolerance_ms = 0.f, float max_latency_ms = 100.f, bool drop_incomplete = false)
+            : processing_block(init())
+        {
+            set_option(RS2_OPTION_SYNC_TOLERANCE, tolerance_ms);
+            set_option(RS2_OPTION_SYNC_MAX_LATENCY, max_latency_ms);
+            set_option(RS2_OPTION_SYNC_DROP_INCOMPLETE, drop_incomplete ? 1.f : 0.f);
+        }
+
+    private:
+        std::shared_ptr<rs2_processing_block> init()
+        {
+            rs2_error* e = nullptr;
+            auto block = std::shared_ptr<rs2_processing_block>(
+                rs2_create_multi_device_sync_processing_block(&e),
+                rs2_delete_processing_block);
+
+            error::handle(e);
+            return block;
+        }
+    };
+
     class syncer
     {
     public:
@@ -1036,5 +1080,57 @@ namespace rs2
             return block;
         }
     };
+
+    /**
+    * Runs the decimation, spatial, temporal and hole filling filters as a single block, in this order.
+    * The output matches that of the chained filters, but the frame is processed in place instead of being copied by each of them.
+    * The stages are configured through their own options, and should not process frames on their own as well
+    */
+    class depth_postprocess : public filter
+    {
+    public:
+        /**
+        * Create depth post-processing block
+        * \param[in] decimation, spatial, temporal, hole_filling - the stage filters, a nullptr skips that stage
+        * \param[in] use_disparity - run the spatial and temporal filters in the disparity domain
+        */
+        depth_postprocess(const decimation_filter* decimation, const spatial_filter* spatial,
+            const temporal_filter* temporal, const hole_filling_filter* hole_filling, bool use_disparity = true)
+            : filter(init(decimation, spatial, temporal, hole_filling, use_disparity), 1) {}
+
+        depth_postprocess(const decimation_filter& decimation, const spatial_filter& spatial,
+            const temporal_filter& temporal, const hole_filling_filter& hole_filling, bool use_disparity = true)
+            : depth_postprocess(&decimation, &spatial, &temporal, &hole_filling, use_disparity) {}
+
+        depth_postprocess(filter f) : filter(f)
+        {
+            rs2_error* e = nullptr;
+            if (!rs2_is_processing_block_extendable_to(f.get(), RS2_EXTENSION_DEPTH_POSTPROCESS_FILTER, &e) && !e)
+            {
+                _block.reset();
+            }
+            error::handle(e);
+        }
+
+    private:
+        friend class context;
+
+        static std::shared_ptr<rs2_processing_block> init(const decimation_filter* decimation, const spatial_filter* spatial,
+            const temporal_filter* temporal, const hole_filling_filter* hole_filling, bool use_disparity)
+        {
+            rs2_error* e = nullptr;
+            auto block = std::shared_ptr<rs2_processing_block>(
+                rs2_create_depth_postprocess_block(
+                    decimation ? decimation->get() : nullptr,
+                    spatial ? spatial->get() : nullptr,
+                    temporal ? temporal->get() : nullptr,
+                    hole_filling ? hole_filling->get() : nullptr,
+                    use_disparity, &e),
+                rs2_delete_processing_block);
+            error::handle(e);
+
+            return block;
+        }
+    };
 }
 #endif // LIBREALSENSE_RS2_PROCESSING_HPP
@@ -73,6 +73,33 @@ namespace rs2
             return pos;
         }
 
+        /**
+        * Retrieves the number of frames of a stream recorded in the file
+        * \param[in] profile  One of the stream profiles of the playback device
+        * \return Number of frames of the stream in the file
+        */
+        uint64_t get_frames_count(const stream_profile& profile) const
+        {
+            rs2_error* e = nullptr;
+            uint64_t count = rs2_playback_get_frames_count(_dev.get(), profile.get(), &e);
+            error::handle(e);
+            return count;
+        }
+
+        /**
+        * Reads a single frame of a stream from the file by its index, without affecting the playback position
+        * \param[in] profile  One of the stream profiles of the playback device
+        * \param[in] index    Zero based index of the frame within the stream
+        * \return The requested frame
+        */
+        frame get_frame(const stream_profile& profile, uint64_t index) const
+        {
+            rs2_error* e = nullptr;
+            auto f = rs2_playback_get_frame(_dev.get(), profile.get(), index, &e);
+            error::handle(e);
+            return frame(f);
+        }
+
         /**
         * Retrieves the total duration of the file
         * \return Total duration of the file
@@ -126,6 +153,18 @@ namespace rs2
             error::handle(e);
         }
 
+        /**
+        * Set how far playback reads ahead of the frames it delivers in non real time mode
+        * \param[in] threads    Number of decompression threads, 0 reads each frame only when it is played
+        * \param[in] max_bytes  Uncompressed size of the file data held ahead of the frame being played
+        */
+        void set_read_ahead(uint32_t threads, uint64_t max_bytes) const
+        {
+            rs2_error* e = nullptr;
+            rs2_playback_device_set_read_ahead(_dev.get(), threads, max_bytes, &e);
+            error::handle(e);
+        }
+
         /**
         * Set the playing speed
         * \param[in] speed  Indicates a multiplication of the speed to play (e.g: 1 = normal, 0.5 twice as slow)
@@ -234,6 +273,20 @@ namespace rs2
             rs2::error::handle(e);
         }
 
+        /**
+        * Creates a recording device to record the given device and save it to the given file as rosbag format
+        * \param[in]  file      The desired path to which the recorder should save the data
+        * \param[in]  device    The device to record
+        * \param[in]  config    Compression level and threads, memory cap of the pending frames and what to do when it is reached
+        */
+        recorder(const std::string& file, rs2::device dev, const rs2_recorder_config& config)
+        {
+            rs2_error* e = nullptr;
+            _dev = std::shared_ptr<rs2_device>(
+                rs2_create_record_device_with_config(dev.get().get(), file.c_str(), &config, &e),
+                rs2_delete_device);
+            rs2::error::handle(e);
+        }
 
         /**
         * Pause the recording device without stopping the actual device from streaming.
@@ -266,6 +319,19 @@ namespace rs2
             error::handle(e);
             return filename;
         }
+
+        /**
+        * Gets the progress of the recorder: pending frames and chunks, dropped frames and written data
+        * \return The recorder counters
+        */
+        rs2_recorder_statistics get_statistics() const
+        {
+            rs2_error* e = nullptr;
+            rs2_recorder_statistics stats;
+            rs2_record_device_get_statistics(_dev.get(), &stats, &e);
+            error::handle(e);
+            return stats;
+        }
     protected:
         explicit recorder(std::shared_ptr<rs2_device> dev) : device(dev)
         {
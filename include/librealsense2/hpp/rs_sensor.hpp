@@ -100,6 +100,20 @@ namespace rs2
 
 
 
+    template<class A, class F>
+    class frame_allocator : public rs2_frame_allocator
+    {
+        A allocate_function;
+        F deallocate_function;
+    public:
+        frame_allocator(A allocate, F deallocate) : allocate_function(allocate), deallocate_function(deallocate) {}
+
+        void* allocate(int size) override { return allocate_function(size); }
+        void deallocate(void* buffer, int size) override { deallocate_function(buffer, size); }
+
+        void release() override { delete this; }
+    };
+
     class sensor : public options
     {
     public:
@@ -213,6 +227,20 @@ namespace rs2
             error::handle(e);
         }
 
+        /**
+        * Provide the memory of the frames produced by the sensor from a user-defined allocator
+        * \param[in] allocate     callable of signature void*(int size), returning nullptr falls back to the default allocator
+        * \param[in] deallocate   callable of signature void(void* buffer, int size), may be called after the sensor was stopped
+        */
+        template<class A, class F>
+        void set_frame_allocator(A allocate, F deallocate) const
+        {
+            rs2_error* e = nullptr;
+            rs2_set_frame_allocator_cpp(_sensor.get(),
+                new frame_allocator<A, F>(std::move(allocate), std::move(deallocate)), &e);
+            error::handle(e);
+        }
+
 
         /**
         * Retrieves the list of stream profiles supported by the sensor.
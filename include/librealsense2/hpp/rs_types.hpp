@@ -36,6 +36,14 @@ struct rs2_frame_processor_callback
     virtual                                 ~rs2_frame_processor_callback() {}
 };
 
+struct rs2_frame_allocator
+{
+    virtual void*                           allocate(int size) = 0;
+    virtual void                            deallocate(void* buffer, int size) = 0;
+    virtual void                            release() = 0;
+    virtual                                 ~rs2_frame_allocator() {}
+};
+
 struct rs2_notifications_callback
 {
     virtual void                            on_notification(rs2_notification* n) = 0;
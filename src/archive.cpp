@@ -155,31 +155,32 @@ namespace librealsense
 
     std::shared_ptr<archive_interface> make_archive(rs2_extension type,
         std::atomic<uint32_t>* in_max_frame_queue_size,
+        std::atomic<uint32_t>* in_pool_retention_ms,
         std::shared_ptr<platform::time_service> ts,
         std::shared_ptr<metadata_parser_map> parsers)
     {
         switch (type)
         {
         case RS2_EXTENSION_VIDEO_FRAME:
-            return std::make_shared<frame_archive<video_frame>>(in_max_frame_queue_size, ts, parsers);
+            return std::make_shared<frame_archive<video_frame>>(in_max_frame_queue_size, in_pool_retention_ms, ts, parsers);
 
         case RS2_EXTENSION_COMPOSITE_FRAME:
-            return std::make_shared<frame_archive<composite_frame>>(in_max_frame_queue_size, ts, parsers);
+            return std::make_shared<frame_archive<composite_frame>>(in_max_frame_queue_size, in_pool_retention_ms, ts, parsers);
 
         case RS2_EXTENSION_MOTION_FRAME:
-            return std::make_shared<frame_archive<motion_frame>>(in_max_frame_queue_size, ts, parsers);
+            return std::make_shared<frame_archive<motion_frame>>(in_max_frame_queue_size, in_pool_retention_ms, ts, parsers);
 
         case RS2_EXTENSION_POINTS:
-            return std::make_shared<frame_archive<points>>(in_max_frame_queue_size, ts, parsers);
+            return std::make_shared<frame_archive<points>>(in_max_frame_queue_size, in_pool_retention_ms, ts, parsers);
 
         case RS2_EXTENSION_DEPTH_FRAME:
-            return std::make_shared<frame_archive<depth_frame>>(in_max_frame_queue_size, ts, parsers);
+            return std::make_shared<frame_archive<depth_frame>>(in_max_frame_queue_size, in_pool_retention_ms, ts, parsers);
 
         case RS2_EXTENSION_POSE_FRAME:
-            return std::make_shared<frame_archive<pose_frame>>(in_max_frame_queue_size, ts, parsers);
+            return std::make_shared<frame_archive<pose_frame>>(in_max_frame_queue_size, in_pool_retention_ms, ts, parsers);
 
         case RS2_EXTENSION_DISPARITY_FRAME:
-            return std::make_shared<frame_archive<disparity_frame>>(in_max_frame_queue_size, ts, parsers);
+            return std::make_shared<frame_archive<disparity_frame>>(in_max_frame_queue_size, in_pool_retention_ms, ts, parsers);
 
         default:
             throw std::runtime_error("Requested frame type is not supported!");
@@ -211,8 +212,53 @@ namespace librealsense
         return owner->publish_frame(this);
     }
 
+    bool frame::decode_metadata(const rs2_frame_metadata_value& frame_metadata) const
+    {
+        static_assert(::RS2_FRAME_METADATA_COUNT <= 64, "The metadata masks hold one bit per attribute");
+
+        auto bit = uint64_t(1) << frame_metadata;
+        if (_metadata_known.load(std::memory_order_acquire) & bit)
+            return true;
+
+        // While another thread decodes the attribute, when its parser queries it again or after the parser failed,
+        // the attribute is served by the parser directly
+        if (_metadata_claimed.fetch_or(bit) & bit)
+            return false;
+
+        if (metadata_parsers)
+        {
+            auto it = metadata_parsers->find(frame_metadata);
+            if (it != metadata_parsers->end())
+            {
+                try
+                {
+                    if (it->second->supports(*this))
+                    {
+                        _metadata_values[frame_metadata] = it->second->get(*this);
+                        _metadata_supported.fetch_or(bit, std::memory_order_relaxed);
+                    }
+                }
+                catch (...)
+                {
+                    // Left to the parser, to report the error when the attribute is queried
+                    return false;
+                }
+            }
+        }
+
+        _metadata_known.fetch_or(bit, std::memory_order_release);
+        return true;
+    }
+
     rs2_metadata_type frame::get_frame_metadata(const rs2_frame_metadata_value& frame_metadata) const
     {
+        if (frame_metadata < ::RS2_FRAME_METADATA_COUNT && decode_metadata(frame_metadata))
+        {
+            auto bit = uint64_t(1) << frame_metadata;
+            if (_metadata_supported & bit)
+                return _metadata_values[frame_metadata];
+        }
+
         if (!metadata_parsers)
             throw invalid_value_exception(to_string() << "metadata not available for "
                 << get_string(get_stream()->get_stream_type()) << " stream");
@@ -229,6 +275,12 @@ namespace librealsense
 
     bool frame::supports_frame_metadata(const rs2_frame_metadata_value& frame_metadata) const
     {
+        if (frame_metadata < ::RS2_FRAME_METADATA_COUNT && decode_metadata(frame_metadata))
+        {
+            auto bit = uint64_t(1) << frame_metadata;
+            return (_metadata_supported & bit) != 0;
+        }
+
         // verify preconditions
         if (!metadata_parsers)
             return false;                         // No parsers are available or no metadata was attached
@@ -240,8 +292,28 @@ namespace librealsense
         return it->second->supports(*this);
     }
 
+    unsigned long long frame::get_frame_metadata_all(rs2_metadata_type* values, int count) const
+    {
+        unsigned long long supported = 0;
+        for (int i = 0; i < std::min(count, static_cast<int>(::RS2_FRAME_METADATA_COUNT)); i++)
+        {
+            auto frame_metadata = static_cast<rs2_frame_metadata_value>(i);
+            values[i] = 0;
+            if (supports_frame_metadata(frame_metadata))
+            {
+                values[i] = get_frame_metadata(frame_metadata);
+                supported |= 1ULL << i;
+            }
+        }
+        return supported;
+    }
+
     int frame::get_frame_data_size() const
     {
+        // A frame that references the backend buffer directly has no storage of its own
+        if (on_release.get_data())
+            return static_cast<int>(on_release.get_size());
+
         return data.size();
     }
 
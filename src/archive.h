@@ -5,6 +5,7 @@
 
 #include "types.h"
 #include "core/streaming.h"
+#include "frame-buffer.h"
 #include <atomic>
 #include <array>
 #include <math.h>
@@ -75,6 +76,9 @@ namespace librealsense
 
         virtual std::shared_ptr<metadata_parser_map> get_md_parsers() const = 0;
 
+        virtual frame_pool_statistics get_pool_statistics() const = 0;
+        virtual void set_frame_allocator(frame_allocator_ptr allocator) = 0;
+
         virtual void flush() = 0;
 
         virtual frame_interface* publish_frame(frame_interface* frame) = 0;
@@ -85,6 +89,7 @@ namespace librealsense
 
     std::shared_ptr<archive_interface> make_archive(rs2_extension type,
         std::atomic<uint32_t>* in_max_frame_queue_size,
+        std::atomic<uint32_t>* in_pool_retention_ms,
         std::shared_ptr<platform::time_service> ts,
         std::shared_ptr<metadata_parser_map> parsers);
 
@@ -92,14 +97,14 @@ namespace librealsense
     class LRS_EXTENSION_API frame : public frame_interface
     {
     public:
-        std::vector<byte> data;
+        frame_buffer data;
         frame_additional_data additional_data;
         std::shared_ptr<metadata_parser_map> metadata_parsers = nullptr;
-        explicit frame() : ref_count(0), _kept(false), owner(nullptr), on_release() {}
+        explicit frame() : ref_count(0), _kept(false), owner(nullptr), on_release(), _metadata_claimed(0), _metadata_known(0), _metadata_supported(0) {}
         frame(const frame& r) = delete;
         frame(frame&& r)
             : ref_count(r.ref_count.exchange(0)), _kept(r._kept.exchange(false)),
-            owner(r.owner), on_release()
+            owner(r.owner), on_release(), _metadata_claimed(0), _metadata_known(0), _metadata_supported(0)
         {
             *this = std::move(r);
             if (owner) metadata_parsers = owner->get_md_parsers();
@@ -109,12 +114,13 @@ namespace librealsense
         frame& operator=(const frame& r) = delete;
         frame& operator=(frame&& r)
         {
-            data = move(r.data);
+            data = std::move(r.data);
             owner = r.owner;
             ref_count = r.ref_count.exchange(0);
             _kept = r._kept.exchange(false);
             on_release = std::move(r.on_release);
             additional_data = std::move(r.additional_data);
+            reset_metadata();
             r.owner.reset();
             if (owner) metadata_parsers = owner->get_md_parsers();
             if (r.metadata_parsers) metadata_parsers = std::move(r.metadata_parsers);
@@ -124,21 +130,23 @@ namespace librealsense
         virtual ~frame() { on_release.reset(); }
         rs2_metadata_type get_frame_metadata(const rs2_frame_metadata_value& frame_metadata) const override;
         bool supports_frame_metadata(const rs2_frame_metadata_value& frame_metadata) const override;
+        unsigned long long get_frame_metadata_all(rs2_metadata_type* values, int count) const override;
         int get_frame_data_size() const override;
         const byte* get_frame_data() const override;
         rs2_time_t get_frame_timestamp() const override;
         rs2_timestamp_domain get_frame_timestamp_domain() const override;
-        void set_timestamp(double new_ts) override { additional_data.timestamp = new_ts; }
+        void set_timestamp(double new_ts) override { additional_data.timestamp = new_ts; reset_metadata(); }
         unsigned long long get_frame_number() const override;
         void set_timestamp_domain(rs2_timestamp_domain timestamp_domain) override
         {
             additional_data.timestamp_domain = timestamp_domain;
+            reset_metadata();
         }
 
         rs2_time_t get_frame_system_time() const override;
 
         std::shared_ptr<stream_profile_interface> get_stream() const override { return stream; }
-        void set_stream(std::shared_ptr<stream_profile_interface> sp) override { stream = std::move(sp); }
+        void set_stream(std::shared_ptr<stream_profile_interface> sp) override { stream = std::move(sp); reset_metadata(); }
 
         rs2_time_t get_frame_callback_start_time_point() const override;
         void update_frame_callback_start_ts(rs2_time_t ts) override;
@@ -168,6 +176,9 @@ namespace librealsense
         bool is_blocking() const override { return additional_data.is_blocking; }
 
     private:
+        bool decode_metadata(const rs2_frame_metadata_value& frame_metadata) const;
+        void reset_metadata() { _metadata_claimed = 0; _metadata_known = 0; _metadata_supported = 0; }
+
         // TODO: check boost::intrusive_ptr or an alternative
         std::atomic<int> ref_count; // the reference count is on how many times this placeholder has been observed (not lifetime, not content)
         std::shared_ptr<archive_interface> owner; // pointer to the owner to be returned to by last observe
@@ -176,6 +187,14 @@ namespace librealsense
         bool _fixed = false;
         std::atomic_bool _kept;
         std::shared_ptr<stream_profile_interface> stream;
+
+        // Each public metadata attribute is decoded once, on its first access, into a dense array indexed by
+        // rs2_frame_metadata_value. Only the parser of the queried attribute runs. Bits of _metadata_known mark
+        // the attributes whose parsers completed, the others, and the internal attributes, keep going through the parsers
+        mutable std::atomic<uint64_t> _metadata_claimed;
+        mutable std::atomic<uint64_t> _metadata_known;
+        mutable std::atomic<uint64_t> _metadata_supported;
+        mutable std::array<rs2_metadata_type, ::RS2_FRAME_METADATA_COUNT> _metadata_values;
     };
 
     class points : public frame
@@ -230,6 +249,10 @@ namespace librealsense
         {
             return first()->supports_frame_metadata(frame_metadata);
         }
+        unsigned long long get_frame_metadata_all(rs2_metadata_type* values, int count) const override
+        {
+            return first()->get_frame_metadata_all(values, count);
+        }
         int get_frame_data_size() const override
         {
             return first()->get_frame_data_size();
@@ -364,9 +387,10 @@ namespace librealsense
                     {
                         //For playback sensors
                         auto extendable = As<librealsense::extendable_interface>(sensor);
-                        if (extendable && extendable->extend_to(TypeToExtension<librealsense::depth_sensor>::value, (void**)(&depth_sensor)))
+                        librealsense::depth_sensor* extension = nullptr;
+                        if (extendable && extendable->extend_to(TypeToExtension<librealsense::depth_sensor>::value, (void**)(&extension)) && extension)
                         {
-                            return depth_sensor->get_depth_scale();
+                            return extension->get_depth_scale();
                         }
                     }
                 }
@@ -453,6 +477,28 @@ namespace librealsense
     public:
         motion_frame() : frame()
         {}
+
+        // Invokes action on the X, Y, Z values of every sample held by the frame
+        template<class T>
+        void foreach_sample(T action)
+        {
+            get_frame_data(); // call GetData to ensure data is in main memory
+            switch (get_stream()->get_format())
+            {
+            case RS2_FORMAT_MOTION_XYZ32F:
+                action(*reinterpret_cast<float3*>(data.data()));
+                break;
+            case RS2_FORMAT_MOTION_XYZ32F_BATCH:
+            {
+                auto samples = reinterpret_cast<rs2_motion_sample*>(data.data());
+                for (size_t i = 0; i < data.size() / sizeof(rs2_motion_sample); i++)
+                    action(*reinterpret_cast<float3*>(&samples[i].data));
+                break;
+            }
+            default:
+                break;
+            }
+        }
     };
 
     MAP_EXTENSION(RS2_EXTENSION_MOTION_FRAME, librealsense::motion_frame);
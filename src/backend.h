@@ -324,7 +324,15 @@ namespace librealsense
         };
 #pragma pack(pop)
 
+        struct sensor_data_batch
+        {
+            hid_sensor sensor;
+            const frame_object* samples;
+            size_t samples_count;
+        };
+
         typedef std::function<void(const sensor_data&)> hid_callback;
+        typedef std::function<void(const sensor_data_batch&)> hid_batch_callback;
 
         class hid_device
         {
@@ -335,6 +343,15 @@ namespace librealsense
             virtual void close() = 0;
             virtual void stop_capture() = 0;
             virtual void start_capture(hid_callback callback) = 0;
+            // Delivers all the samples a sensor reported together in a single call.
+            // Backends that receive the samples one by one hand over batches of a single sample
+            virtual void start_batch_capture(hid_batch_callback callback)
+            {
+                start_capture([callback](const sensor_data& data)
+                {
+                    callback({ data.sensor, &data.fo, 1 });
+                });
+            }
             virtual std::vector<hid_sensor> get_sensors() = 0;
             virtual std::vector<uint8_t> get_custom_report_data(const std::string& custom_sensor_name,
                                                                 const std::string& report_name,
@@ -372,6 +389,9 @@ namespace librealsense
             virtual std::string get_device_location() const = 0;
             virtual usb_spec  get_usb_specification() const = 0;
 
+            // Whether frames may keep referencing the backend buffers until they are released, instead of copying them out
+            virtual bool supports_zero_copy() const { return false; }
+
             virtual ~uvc_device() = default;
 
         protected:
@@ -497,6 +517,11 @@ namespace librealsense
                 return _dev->get_usb_specification();
             }
 
+            bool supports_zero_copy() const override
+            {
+                return _dev->supports_zero_copy();
+            }
+
             void lock() const override { _dev->lock(); }
             void unlock() const override { _dev->unlock(); }
 
@@ -624,6 +649,11 @@ namespace librealsense
                 _dev.front()->start_capture(callback);
             }
 
+            void start_batch_capture(hid_batch_callback callback) override
+            {
+                _dev.front()->start_batch_capture(callback);
+            }
+
             std::vector<hid_sensor> get_sensors() override
             {
                 return _dev.front()->get_sensors();
@@ -761,6 +791,11 @@ namespace librealsense
                 return _dev.front()->get_usb_specification();
             }
 
+            bool supports_zero_copy() const override
+            {
+                return std::all_of(_dev.begin(), _dev.end(), [](const std::shared_ptr<uvc_device>& dev) { return dev->supports_zero_copy(); });
+            }
+
             void lock() const override
             {
                 std::vector<uvc_device*> locked_dev;
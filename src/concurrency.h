@@ -8,6 +8,13 @@
 #include <thread>
 #include <atomic>
 #include <functional>
+#include <memory>
+#include <stdexcept>
+#include <cstdint>
+#include <vector>
+#include <exception>
+#include <cstring>
+#include <type_traits>
 
 const int QUEUE_MAX_SIZE = 10;
 // Simplest implementation of a blocking concurrent queue for thread messaging
@@ -138,13 +145,303 @@ public:
     }
 };
 
+// Bounded lock-free alternative to single_consumer_queue, based on a ring of sequenced cells
+// (D. Vyukov's bounded MPMC queue). Producers and the consumer only touch atomics on the fast path;
+// the mutex is taken solely to park / wake a thread that has to wait, and only when someone waits.
+// Keeps the semantics of single_consumer_queue: enqueue drops the oldest item once the capacity is exceeded,
+// blocking_enqueue waits for room, and clear / start implement the same flush mechanism.
+// Note that peek is not offered - with drop-oldest producers the front item may be released at any time.
 template<class T>
-class single_consumer_frame_queue
+class lock_free_single_consumer_queue
+{
+    struct cell
+    {
+        std::atomic<size_t> sequence;
+        T data;
+    };
+
+    static size_t ring_size(unsigned int cap)
+    {
+        // blocking_enqueue may hold cap+1 items, same as single_consumer_queue
+        size_t size = 2;
+        while (size < size_t(cap) + 1) size <<= 1;
+        return size;
+    }
+
+public:
+    // Rings are preallocated, so the capacity must be bounded
+    static const unsigned int max_capacity = 1 << 20;
+
+    explicit lock_free_single_consumer_queue<T>(unsigned int cap = QUEUE_MAX_SIZE)
+        : _cap(cap), _accepting(true), _need_to_flush(false),
+          _enqueue_pos(0), _dequeue_pos(0), _deq_waiters(0), _enq_waiters(0)
+    {
+        if (cap == 0 || cap > max_capacity)
+            throw std::invalid_argument("lock-free queue capacity must be in range [1, 2^20]");
+
+        auto size = ring_size(cap);
+        _buffer.reset(new cell[size]);
+        _mask = size - 1;
+        for (size_t i = 0; i < size; i++)
+            _buffer[i].sequence.store(i, std::memory_order_relaxed);
+    }
+
+    void enqueue(T&& item)
+    {
+        if (_accepting)
+        {
+            T dropped;
+            while (!try_push(item))
+                try_pop(&dropped);
+
+            // The ring is rounded up to a power of two, enforce the requested capacity
+            while (size() > _cap && try_pop(&dropped)) {}
+        }
+        notify(_deq_waiters, _deq_cv);
+    }
+
+    void blocking_enqueue(T&& item)
+    {
+        if (_accepting)
+        {
+            const auto pred = [this]() { return size() <= _cap || !_accepting; };
+            while (_accepting)
+            {
+                if (size() <= _cap && try_push(item))
+                    break;
+                wait(_enq_waiters, _enq_cv, pred, std::chrono::milliseconds(100));
+            }
+        }
+        notify(_deq_waiters, _deq_cv);
+    }
+
+    bool dequeue(T* item, unsigned int timeout_ms)
+    {
+        _accepting = true;
+        const auto ready = [this]() { return size() > 0 || _need_to_flush; };
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeout_ms);
+        while (!try_pop(item))
+        {
+            if (_need_to_flush)
+                return false;
+
+            auto now = std::chrono::steady_clock::now();
+            if (now >= deadline ||
+                !wait(_deq_waiters, _deq_cv, ready, std::chrono::duration_cast<std::chrono::milliseconds>(deadline - now)))
+            {
+                // Last chance, an item may have landed right at the deadline
+                if (!try_pop(item))
+                    return false;
+                break;
+            }
+        }
+        notify(_enq_waiters, _enq_cv);
+        return true;
+    }
+
+    bool try_dequeue(T* item)
+    {
+        _accepting = true;
+        if (try_pop(item))
+        {
+            notify(_enq_waiters, _enq_cv);
+            return true;
+        }
+        return false;
+    }
+
+    void clear()
+    {
+        _accepting = false;
+        _need_to_flush = true;
+
+        T item;
+        while (try_pop(&item)) {}
+
+        std::lock_guard<std::mutex> lock(_mutex);
+        _deq_cv.notify_all();
+        _enq_cv.notify_all();
+    }
+
+    void start()
+    {
+        _need_to_flush = false;
+        _accepting = true;
+    }
+
+    size_t size() const
+    {
+        auto deq = _dequeue_pos.load(std::memory_order_acquire);
+        auto enq = _enqueue_pos.load(std::memory_order_acquire);
+        return enq > deq ? enq - deq : 0;
+    }
+
+private:
+    bool try_push(T& item)
+    {
+        auto pos = _enqueue_pos.load(std::memory_order_relaxed);
+        cell* c;
+        for (;;)
+        {
+            c = &_buffer[pos & _mask];
+            auto seq = c->sequence.load(std::memory_order_acquire);
+            auto diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+            if (diff == 0)
+            {
+                if (_enqueue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                    break;
+            }
+            else if (diff < 0)
+                return false; // full
+            else
+                pos = _enqueue_pos.load(std::memory_order_relaxed);
+        }
+        c->data = std::move(item);
+        c->sequence.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool try_pop(T* item)
+    {
+        auto pos = _dequeue_pos.load(std::memory_order_relaxed);
+        cell* c;
+        for (;;)
+        {
+            c = &_buffer[pos & _mask];
+            auto seq = c->sequence.load(std::memory_order_acquire);
+            auto diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos + 1);
+            if (diff == 0)
+            {
+                if (_dequeue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                    break;
+            }
+            else if (diff < 0)
+                return false; // empty
+            else
+                pos = _dequeue_pos.load(std::memory_order_relaxed);
+        }
+        *item = std::move(c->data);
+        c->data = T(); // release whatever the moved-from cell still references
+        c->sequence.store(pos + _mask + 1, std::memory_order_release);
+        return true;
+    }
+
+    // The waiters counter and the seq_cst fences pair up so that either the waker observes a waiter,
+    // or the waiter observes the state change before it goes to sleep
+    void notify(std::atomic<int>& waiters, std::condition_variable& cv)
+    {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (waiters.load(std::memory_order_relaxed) > 0)
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            cv.notify_all();
+        }
+    }
+
+    template<class Pred>
+    bool wait(std::atomic<int>& waiters, std::condition_variable& cv, Pred pred, std::chrono::milliseconds timeout)
+    {
+        waiters.fetch_add(1);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        bool res;
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            res = cv.wait_for(lock, timeout, pred);
+        }
+        waiters.fetch_sub(1);
+        return res;
+    }
+
+    std::unique_ptr<cell[]> _buffer;
+    size_t _mask;
+    unsigned int _cap;
+
+    std::atomic<bool> _accepting;
+    std::atomic<bool> _need_to_flush;
+
+    // Producer and consumer indices live on separate cache lines. Padding rather than alignas,
+    // since C++11 operator new does not honour over-aligned types
+    char _pad0[64];
+    std::atomic<size_t> _enqueue_pos;
+    char _pad1[64];
+    std::atomic<size_t> _dequeue_pos;
+    char _pad2[64];
+
+    std::atomic<int> _deq_waiters;
+    std::atomic<int> _enq_waiters;
+    std::mutex _mutex;
+    std::condition_variable _deq_cv;
+    std::condition_variable _enq_cv;
+};
+
+// Single consumer queue whose implementation (mutex based or lock-free) is chosen on construction
+template<class T>
+class selectable_single_consumer_queue
 {
     single_consumer_queue<T> _queue;
+    std::unique_ptr<lock_free_single_consumer_queue<T>> _lock_free_queue;
 
 public:
-    single_consumer_frame_queue<T>(unsigned int cap = QUEUE_MAX_SIZE) : _queue(cap) {}
+    explicit selectable_single_consumer_queue<T>(unsigned int cap = QUEUE_MAX_SIZE, bool lock_free = false)
+        : _queue(cap), _lock_free_queue(lock_free ? new lock_free_single_consumer_queue<T>(cap) : nullptr)
+    {}
+
+    bool is_lock_free() const { return _lock_free_queue != nullptr; }
+
+    void enqueue(T&& item)
+    {
+        if (_lock_free_queue) _lock_free_queue->enqueue(std::move(item));
+        else _queue.enqueue(std::move(item));
+    }
+
+    void blocking_enqueue(T&& item)
+    {
+        if (_lock_free_queue) _lock_free_queue->blocking_enqueue(std::move(item));
+        else _queue.blocking_enqueue(std::move(item));
+    }
+
+    bool dequeue(T* item, unsigned int timeout_ms)
+    {
+        return _lock_free_queue ? _lock_free_queue->dequeue(item, timeout_ms) : _queue.dequeue(item, timeout_ms);
+    }
+
+    bool try_dequeue(T* item)
+    {
+        return _lock_free_queue ? _lock_free_queue->try_dequeue(item) : _queue.try_dequeue(item);
+    }
+
+    bool peek(T** item)
+    {
+        if (_lock_free_queue)
+            throw std::logic_error("peek is not supported by lock-free queues");
+        return _queue.peek(item);
+    }
+
+    void clear()
+    {
+        if (_lock_free_queue) _lock_free_queue->clear();
+        else _queue.clear();
+    }
+
+    void start()
+    {
+        if (_lock_free_queue) _lock_free_queue->start();
+        else _queue.start();
+    }
+
+    size_t size()
+    {
+        return _lock_free_queue ? _lock_free_queue->size() : _queue.size();
+    }
+};
+
+template<class T>
+class single_consumer_frame_queue
+{
+    selectable_single_consumer_queue<T> _queue;
+
+public:
+    single_consumer_frame_queue<T>(unsigned int cap = QUEUE_MAX_SIZE, bool lock_free = false) : _queue(cap, lock_free) {}
 
     void enqueue(T&& item)
     {
@@ -213,8 +510,8 @@ public:
         dispatcher* _owner;
     };
 
-    dispatcher(unsigned int cap)
-        : _queue(cap),
+    dispatcher(unsigned int cap, bool lock_free = false)
+        : _queue(cap, lock_free),
           _was_stopped(true),
           _was_flushed(false),
           _is_alive(true)
@@ -298,7 +595,8 @@ public:
         _thread.join();
     }
 
-    bool flush()
+    // is_blocking waits for room in a full queue, instead of dropping its oldest item
+    bool flush(bool is_blocking = false)
     {
         std::mutex m;
         std::condition_variable cv;
@@ -315,7 +613,7 @@ public:
                 invoked = true;
             }
             cv.notify_one();
-        });
+        }, is_blocking);
         std::unique_lock<std::mutex> locker(m);
         *wait_sucess = cv.wait_for(locker, std::chrono::seconds(10), [&]() { return invoked || _was_stopped; });
         return *wait_sucess;
@@ -328,7 +626,7 @@ public:
 
 private:
     friend cancellable_timer;
-    single_consumer_queue<std::function<void(cancellable_timer)>> _queue;
+    selectable_single_consumer_queue<std::function<void(cancellable_timer)>> _queue;
     std::thread _thread;
 
     std::atomic<bool> _was_stopped;
@@ -386,3 +684,287 @@ private:
     dispatcher _dispatcher;
     std::atomic<bool> _stopped;
 };
+
+// Fixed set of threads running data-parallel work, e.g. independent rows of an image.
+// run() splits [0, count) into contiguous chunks, one per thread, and blocks until all of them are done.
+// The calling thread processes the first chunk, so a single-thread pool runs everything inline.
+// The partition only depends on the count and the number of threads, never on timing
+class worker_pool
+{
+public:
+    explicit worker_pool(unsigned int threads = 1)
+        : _generation(0), _pending(0), _is_alive(true)
+    {
+        resize(threads);
+    }
+
+    ~worker_pool()
+    {
+        stop_workers();
+    }
+
+    worker_pool(const worker_pool&) = delete;
+    worker_pool& operator=(const worker_pool&) = delete;
+
+    // Must not be called concurrently with run()
+    void resize(unsigned int threads)
+    {
+        if (!threads)
+            throw std::invalid_argument("worker_pool requires at least one thread");
+
+        if (threads == size())
+            return;
+
+        stop_workers();
+        _is_alive = true;
+        // New workers only pick up runs that start after they are created
+        auto generation = _generation;
+        for (unsigned int i = 1; i < threads; i++)
+            _workers.emplace_back([this, i, generation]() { work(i, generation); });
+    }
+
+    unsigned int size() const { return static_cast<unsigned int>(_workers.size() + 1); }
+
+    void run(size_t count, const std::function<void(size_t, size_t)>& task)
+    {
+        auto threads = size();
+        if (threads == 1 || count < 2)
+        {
+            if (count) task(0, count);
+            return;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _task = &task;
+            _count = count;
+            _chunks = threads;
+            _pending = threads - 1;
+            _error = nullptr;
+            _generation++;
+        }
+        _work_cv.notify_all();
+
+        std::exception_ptr error;
+        try
+        {
+            run_chunk(0);
+        }
+        catch (...)
+        {
+            error = std::current_exception();
+        }
+
+        std::unique_lock<std::mutex> lock(_mutex);
+        _done_cv.wait(lock, [&]() { return _pending == 0; });
+        _task = nullptr;
+        if (!error) error = _error;
+        lock.unlock();
+
+        if (error)
+            std::rethrow_exception(error);
+    }
+
+private:
+    void run_chunk(unsigned int index)
+    {
+        auto begin = _count * index / _chunks;
+        auto end = _count * (index + 1) / _chunks;
+        if (begin < end)
+            (*_task)(begin, end);
+    }
+
+    void work(unsigned int index, unsigned long long seen)
+    {
+        while (true)
+        {
+            {
+                std::unique_lock<std::mutex> lock(_mutex);
+                _work_cv.wait(lock, [&]() { return !_is_alive || _generation != seen; });
+                if (!_is_alive)
+                    return;
+                seen = _generation;
+            }
+
+            std::exception_ptr error;
+            try
+            {
+                run_chunk(index);
+            }
+            catch (...)
+            {
+                error = std::current_exception();
+            }
+
+            std::lock_guard<std::mutex> lock(_mutex);
+            if (error && !_error)
+                _error = error;
+            if (--_pending == 0)
+                _done_cv.notify_one();
+        }
+    }
+
+    void stop_workers()
+    {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _is_alive = false;
+        }
+        _work_cv.notify_all();
+        for (auto&& t : _workers)
+            t.join();
+        _workers.clear();
+    }
+
+    std::vector<std::thread> _workers;
+    std::mutex _mutex;
+    std::condition_variable _work_cv;
+    std::condition_variable _done_cv;
+    const std::function<void(size_t, size_t)>* _task = nullptr;
+    size_t _count = 0;
+    unsigned int _chunks = 1;
+    unsigned long long _generation;
+    unsigned int _pending;
+    std::exception_ptr _error;
+    bool _is_alive;
+};
+
+// Fixed set of threads running the tasks submitted to it, in submission order.
+// Tasks are independent of each other: ordering between related tasks is up to whoever submits them.
+// Tasks still queued when the executor is destroyed are dropped
+class task_executor
+{
+public:
+    explicit task_executor(unsigned int threads)
+        : _is_alive(true)
+    {
+        if (!threads)
+            throw std::invalid_argument("task_executor requires at least one thread");
+
+        for (unsigned int i = 0; i < threads; i++)
+            _threads.emplace_back([this]() { work(); });
+        for (auto&& t : _threads)
+            _thread_ids.push_back(t.get_id());
+    }
+
+    ~task_executor()
+    {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _is_alive = false;
+        }
+        _cv.notify_all();
+        for (auto&& t : _threads)
+            t.join();
+    }
+
+    task_executor(const task_executor&) = delete;
+    task_executor& operator=(const task_executor&) = delete;
+
+    void submit(std::function<void()> task)
+    {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _tasks.push(std::move(task));
+        }
+        _cv.notify_one();
+    }
+
+    unsigned int size() const { return static_cast<unsigned int>(_threads.size()); }
+
+    // Whether the calling thread is one of the executor's own, which must not wait for other tasks to run
+    bool is_executor_thread() const
+    {
+        auto id = std::this_thread::get_id();
+        for (auto&& t : _thread_ids)
+            if (t == id) return true;
+        return false;
+    }
+
+private:
+    void work()
+    {
+        while (true)
+        {
+            std::function<void()> task;
+            {
+                std::unique_lock<std::mutex> lock(_mutex);
+                _cv.wait(lock, [&]() { return !_is_alive || !_tasks.empty(); });
+                if (!_is_alive)
+                    return;
+                task = std::move(_tasks.front());
+                _tasks.pop();
+            }
+
+            // A failing task must not take a shared thread down with it
+            try
+            {
+                task();
+            }
+            catch (...) {}
+        }
+    }
+
+    std::vector<std::thread> _threads;
+    std::vector<std::thread::id> _thread_ids;
+    std::mutex _mutex;
+    std::condition_variable _cv;
+    std::queue<std::function<void()>> _tasks;
+    bool _is_alive;
+};
+
+// Publishes a value written by one thread at a time to any number of readers that never block.
+// A reader only retries when it overlaps a write, and writers must be serialized by the caller
+template<class T>
+class seqlock
+{
+    static_assert(std::is_trivially_copyable<T>::value, "seqlock values are copied word by word");
+
+public:
+    explicit seqlock(const T& value = T())
+        : _sequence(0)
+    {
+        store_words(value);
+    }
+
+    void store(const T& value)
+    {
+        auto sequence = _sequence.load(std::memory_order_relaxed);
+        _sequence.store(sequence + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        store_words(value);
+        _sequence.store(sequence + 2, std::memory_order_release);
+    }
+
+    T load() const
+    {
+        uint64_t words[words_count];
+        unsigned int before, after;
+        do
+        {
+            before = _sequence.load(std::memory_order_acquire);
+            for (size_t i = 0; i < words_count; i++)
+                words[i] = _words[i].load(std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_acquire);
+            after = _sequence.load(std::memory_order_relaxed);
+        } while ((before & 1) || before != after);
+
+        T value;
+        memcpy(&value, words, sizeof(T));
+        return value;
+    }
+
+private:
+    static const size_t words_count = (sizeof(T) + sizeof(uint64_t) - 1) / sizeof(uint64_t);
+
+    void store_words(const T& value)
+    {
+        uint64_t words[words_count] = {};
+        memcpy(words, &value, sizeof(T));
+        for (size_t i = 0; i < words_count; i++)
+            _words[i].store(words[i], std::memory_order_relaxed);
+    }
+
+    std::atomic<unsigned int> _sequence;   // Odd while a write is in progress
+    std::atomic<uint64_t> _words[words_count];
+};
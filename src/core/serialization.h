@@ -330,6 +330,7 @@ namespace librealsense
             virtual void write_snapshot(const sensor_identifier& sensor_id, const nanoseconds& timestamp, rs2_extension type, const std::shared_ptr<extension_snapshot>& snapshot) = 0;
             virtual void write_notification(const sensor_identifier& stream_id, const nanoseconds& timestamp, const notification& n) = 0;
             virtual const std::string& get_file_name() const = 0;
+            virtual void get_statistics(rs2_recorder_statistics& statistics) const = 0; // fills the compressing and written counters
             virtual ~writer() = default;
         };
 
@@ -346,6 +347,9 @@ namespace librealsense
             virtual void disable_stream(const std::vector<device_serializer::stream_identifier>& stream_ids) = 0;
             virtual const std::string& get_file_name() const = 0;
             virtual std::vector<std::shared_ptr<serialized_data>> fetch_last_frames(const nanoseconds& seek_time) = 0;
+            virtual uint64_t query_frames_count(const stream_identifier& stream_id) const = 0;
+            virtual std::shared_ptr<serialized_data> read_frame(const stream_identifier& stream_id, uint64_t frame_index) = 0;
+            virtual void set_read_ahead(uint32_t threads, uint64_t max_bytes) = 0; // 0 threads reads only what is requested
         };
     }
 }
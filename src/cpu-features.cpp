@@ -0,0 +1,100 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2019 Intel Corporation. All Rights Reserved.
+
+#include "cpu-features.h"
+#include "types.h"
+
+#include <atomic>
+
+#if defined (ANDROID) || (defined (__linux__) && !defined (__x86_64__))
+
+bool has_avx() { return false; }
+bool has_avx2() { return false; }
+
+#else
+
+#ifdef _WIN32
+#include <intrin.h>
+#define cpuid(info, x)    __cpuidex(info, x, 0)
+#else
+#include <cpuid.h>
+void cpuid(int info[4], int info_type){
+    __cpuid_count(info_type, 0, info[0], info[1], info[2], info[3]);
+}
+#endif
+
+bool has_avx()
+{
+    int info[4];
+    cpuid(info, 0);
+    cpuid(info, 0x80000000);
+    return (info[2] & ((int)1 << 28)) != 0;
+}
+
+static unsigned long long xgetbv0()
+{
+#ifdef _WIN32
+    return _xgetbv(0);
+#else
+    unsigned int eax, edx;
+    __asm__ volatile("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+    return ((unsigned long long)edx << 32) | eax;
+#endif
+}
+
+bool has_avx2()
+{
+    int info[4];
+    cpuid(info, 0);
+    if (info[0] < 7)
+        return false;
+
+    // AVX2 registers are usable only when the OS saves the YMM state (OSXSAVE + XCR0 bits 1,2)
+    cpuid(info, 1);
+    if ((info[2] & (1 << 27)) == 0 || (info[2] & (1 << 28)) == 0 || (xgetbv0() & 6) != 6)
+        return false;
+
+    cpuid(info, 7);
+    return (info[1] & (1 << 5)) != 0;
+}
+
+#endif
+
+namespace librealsense
+{
+    static simd_level detect_simd_level()
+    {
+#if defined(RS2_USE_AVX2) && defined(__SSSE3__) && !defined(ANDROID)
+        if (has_avx2()) return simd_level::avx2;
+#endif
+#ifdef __SSSE3__
+        return simd_level::ssse3;
+#else
+        return simd_level::scalar;
+#endif
+    }
+
+    simd_level get_max_simd_level()
+    {
+        static const simd_level level = detect_simd_level();
+        return level;
+    }
+
+    static std::atomic<simd_level>& active_simd_level()
+    {
+        static std::atomic<simd_level> level(get_max_simd_level());
+        return level;
+    }
+
+    simd_level get_simd_level()
+    {
+        return active_simd_level().load(std::memory_order_relaxed);
+    }
+
+    void set_simd_level(simd_level level)
+    {
+        if (level > get_max_simd_level())
+            throw invalid_value_exception("requested SIMD level is not supported on this platform");
+        active_simd_level() = level;
+    }
+}
@@ -0,0 +1,23 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2019 Intel Corporation. All Rights Reserved.
+
+#pragma once
+#ifndef LIBREALSENSE_CPU_FEATURES_H
+#define LIBREALSENSE_CPU_FEATURES_H
+
+bool has_avx();
+bool has_avx2();
+
+namespace librealsense
+{
+    // Instruction sets the unpackers and the processing blocks (pointcloud, align, colorizer, temporal filter,
+    // zero order) are vectorized for. x86 builds target SSSE3, AVX2 kernels are selected at runtime.
+    // Every kernel follows the same setting, so that lowering it runs the whole library on its scalar reference code
+    enum class simd_level { scalar, ssse3, avx2 };
+
+    simd_level       get_max_simd_level             ();                 // Best one supported by both the build and the CPU
+    simd_level       get_simd_level                 ();
+    void             set_simd_level                 (simd_level level); // Lower it to compare the kernels against the scalar reference
+}
+
+#endif
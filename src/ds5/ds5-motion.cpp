@@ -304,12 +304,10 @@ namespace librealsense
                 float3x3 imu_to_depth = _mm_calib->imu_to_depth_alignment();
                 align_imu_axes = [imu_to_depth](rs2_stream stream, frame_interface* fr, callback_invocation_holder callback)
                 {
-                    if (fr->get_stream()->get_format() == RS2_FORMAT_MOTION_XYZ32F)
+                    if (auto motion = dynamic_cast<motion_frame*>(fr))
                     {
-                        auto xyz = (float3*)(fr->get_frame_data());
-
                         // The IMU sensor orientation shall be aligned with depth sensor's coordinate system
-                        *xyz = imu_to_depth * (*xyz);
+                        motion->foreach_sample([&](float3& xyz) { xyz = imu_to_depth * xyz; });
                     }
                 };
             }
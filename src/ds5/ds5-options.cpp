@@ -185,15 +185,17 @@ namespace librealsense
         mm_ep->register_on_before_frame_callback(
             [this, frame_callback](rs2_stream stream, frame_interface* fr, callback_invocation_holder callback)
             {
-                if (_is_enabled.load() && fr->get_stream()->get_format() == RS2_FORMAT_MOTION_XYZ32F)
+                auto motion = dynamic_cast<motion_frame*>(fr);
+                if (_is_enabled.load() && motion)
                 {
-                    auto xyz = (float3*)(fr->get_frame_data());
-
-                    if (stream == RS2_STREAM_ACCEL)
-                        *xyz = (_accel.sensitivity * (*xyz)) - _accel.bias;
-
-                    if (stream == RS2_STREAM_GYRO)
-                        *xyz = _gyro.sensitivity * (*xyz) - _gyro.bias;
+                    motion->foreach_sample([&](float3& xyz)
+                    {
+                        if (stream == RS2_STREAM_ACCEL)
+                            xyz = (_accel.sensitivity * xyz) - _accel.bias;
+
+                        if (stream == RS2_STREAM_GYRO)
+                            xyz = _gyro.sensitivity * xyz - _gyro.bias;
+                    });
                 }
 
                 // Align IMU axes to the established Coordinates System
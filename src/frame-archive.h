@@ -16,7 +16,7 @@ namespace librealsense
         std::shared_ptr<metadata_parser_map> _metadata_parsers = nullptr;
         callbacks_heap callback_inflight;
 
-        std::vector<T> freelist; // return frames here
+        frame_buffer_pool buffer_pool; // return frame buffers here
         std::atomic<bool> recycle_frames;
         int pending_frames = 0;
         std::recursive_mutex mutex;
@@ -29,35 +29,9 @@ namespace librealsense
         T alloc_frame(const size_t size, const frame_additional_data& additional_data, bool requires_memory)
         {
             T backbuffer;
-            //const size_t size = modes[stream].get_image_size(stream);
-            {
-                std::lock_guard<std::recursive_mutex> guard(mutex);
-
-                if (requires_memory)
-                {
-                    // Attempt to obtain a buffer of the appropriate size from the freelist
-                    for (auto it = begin(freelist); it != end(freelist); ++it)
-                    {
-                        if (it->data.size() == size)
-                        {
-                            backbuffer = std::move(*it);
-                            freelist.erase(it);
-                            break;
-                        }
-                    }
-                }
-
-                // Discard buffers that have been in the freelist for longer than 1s
-                for (auto it = begin(freelist); it != end(freelist);)
-                {
-                    if (additional_data.timestamp > it->additional_data.timestamp + 1000) it = freelist.erase(it);
-                    else ++it;
-                }
-            }
-
             if (requires_memory)
             {
-                backbuffer.data.resize(size, 0); // TODO: Allow users to provide a custom allocator for frame buffers
+                backbuffer.data = buffer_pool.acquire(size, additional_data.timestamp);
             }
             backbuffer.additional_data = additional_data;
             return backbuffer;
@@ -84,15 +58,13 @@ namespace librealsense
             {
                 auto f = (T*)frame;
                 log_frame_callback_end(f);
-                std::unique_lock<std::recursive_mutex> lock(mutex);
 
                 frame->keep();
 
                 if (recycle_frames)
                 {
-                    freelist.push_back(std::move(*f));
+                    buffer_pool.release(std::move(f->data), f->additional_data.timestamp);
                 }
-                lock.unlock();
 
                 if (f->is_fixed())
                     published_frames.deallocate(f);
@@ -158,13 +130,18 @@ namespace librealsense
 
         std::shared_ptr<metadata_parser_map> get_md_parsers() const override { return _metadata_parsers; };
 
+        frame_pool_statistics get_pool_statistics() const override { return buffer_pool.get_statistics(); }
+        void set_frame_allocator(frame_allocator_ptr allocator) override { buffer_pool.set_allocator(allocator); }
+
         friend class frame;
 
     public:
         explicit frame_archive(std::atomic<uint32_t>* in_max_frame_queue_size,
+            std::atomic<uint32_t>* in_pool_retention_ms,
             std::shared_ptr<platform::time_service> ts,
             std::shared_ptr<metadata_parser_map> parsers)
             : max_frame_queue_size(in_max_frame_queue_size),
+            buffer_pool(in_pool_retention_ms),
             mutex(), recycle_frames(true), _time_service(ts),
             _metadata_parsers(parsers)
         {
@@ -201,10 +178,7 @@ namespace librealsense
             // wait until user is done with all the stuff he chose to borrow
             callback_inflight.wait_until_empty();
 
-            {
-                std::lock_guard<std::recursive_mutex> guard(mutex);
-                freelist.clear();
-            }
+            buffer_pool.clear();
 
             pending_frames = published_frames.get_size();
             if (pending_frames > 0)
@@ -0,0 +1,177 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2019 Intel Corporation. All Rights Reserved.
+
+#include "frame-buffer.h"
+
+namespace librealsense
+{
+    frame_buffer& frame_buffer::operator=(frame_buffer&& other)
+    {
+        if (this != &other)
+        {
+            release_storage();
+            _vector = std::move(other._vector);
+            _block = std::move(other._block);
+            _allocator = std::move(other._allocator);
+            _external = other._external;
+            _data = other._data;
+            _size = other._size;
+            _capacity = other._capacity;
+
+            other._vector.clear();
+            other._external = other._data = nullptr;
+            other._size = other._capacity = 0;
+        }
+        return *this;
+    }
+
+    frame_buffer& frame_buffer::operator=(std::vector<byte>&& other)
+    {
+        release_storage();
+        _vector = std::move(other);
+        _data = _vector.data();
+        _size = _capacity = _vector.size();
+        return *this;
+    }
+
+    frame_buffer& frame_buffer::operator=(const std::vector<byte>& other)
+    {
+        _size = 0;
+        resize(other.size());
+        if (_size) std::memcpy(_data, other.data(), _size);
+        return *this;
+    }
+
+    void frame_buffer::resize(size_t size)
+    {
+        if (size > _capacity)
+        {
+            byte* external = nullptr;
+            std::unique_ptr<byte[]> block;
+            if (_allocator)
+            {
+                external = static_cast<byte*>(_allocator->allocate(static_cast<int>(size)));
+                if (!external)
+                    LOG_WARNING("Custom frame allocator failed to provide " << size << " bytes, using the default allocator");
+            }
+            // new byte[] default-initializes, i.e. does not touch the memory
+            if (!external)
+                block.reset(new byte[size]);
+
+            auto data = external ? external : block.get();
+            if (_size) std::memcpy(data, _data, _size);
+
+            auto allocator = _allocator;
+            release_storage();
+            _allocator = allocator;
+            _block = std::move(block);
+            _external = external;
+            _data = data;
+            _capacity = size;
+        }
+        _size = size;
+    }
+
+    void frame_buffer::release_storage()
+    {
+        if (_external)
+            _allocator->deallocate(_external, static_cast<int>(_capacity));
+
+        _external = nullptr;
+        _block.reset();
+        _vector = std::vector<byte>();
+        _data = nullptr;
+        _size = _capacity = 0;
+    }
+
+    frame_buffer_pool::frame_buffer_pool(const std::atomic<uint32_t>* retention_ms)
+        : _retention_ms(retention_ms)
+    {}
+
+    frame_buffer frame_buffer_pool::acquire(size_t size, rs2_time_t timestamp)
+    {
+        frame_buffer buffer;
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            expire(timestamp);
+
+            auto it = _buckets.find(size);
+            if (it != _buckets.end() && !it->second.empty())
+            {
+                buffer = std::move(it->second.back().buffer);
+                it->second.pop_back();
+                _statistics.hits++;
+                _statistics.pooled_buffers--;
+                _statistics.pooled_bytes -= size;
+            }
+            else
+            {
+                _statistics.misses++;
+                buffer = frame_buffer(_allocator);
+            }
+        }
+
+        buffer.resize(size);
+        return buffer;
+    }
+
+    void frame_buffer_pool::release(frame_buffer&& buffer, rs2_time_t timestamp)
+    {
+        // Buffers that are not kept are freed on return, outside of the lock
+        frame_buffer released(std::move(buffer));
+        if (!*_retention_ms || released.empty())
+            return;
+
+        auto size = released.size();
+        std::lock_guard<std::mutex> lock(_mutex);
+        // A buffer of a replaced allocator goes back to it rather than to the pool
+        if (released.get_allocator() != _allocator)
+            return;
+
+        _buckets[size].push_back({ std::move(released), timestamp });
+        _statistics.pooled_buffers++;
+        _statistics.pooled_bytes += size;
+    }
+
+    void frame_buffer_pool::clear()
+    {
+        decltype(_buckets) buckets;
+        std::lock_guard<std::mutex> lock(_mutex);
+        std::swap(buckets, _buckets);
+        _statistics.pooled_buffers = 0;
+        _statistics.pooled_bytes = 0;
+    }
+
+    void frame_buffer_pool::set_allocator(frame_allocator_ptr allocator)
+    {
+        decltype(_buckets) buckets;
+        std::lock_guard<std::mutex> lock(_mutex);
+        _allocator = allocator;
+        std::swap(buckets, _buckets);
+        _statistics.pooled_buffers = 0;
+        _statistics.pooled_bytes = 0;
+    }
+
+    frame_pool_statistics frame_buffer_pool::get_statistics() const
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _statistics;
+    }
+
+    void frame_buffer_pool::expire(rs2_time_t timestamp)
+    {
+        // Buffers are released in time order, so within a bucket the oldest ones are always at the front
+        double retention = *_retention_ms;
+        for (auto&& bucket : _buckets)
+        {
+            auto& buffers = bucket.second;
+            while (!buffers.empty() && timestamp > buffers.front().released_at + retention)
+            {
+                buffers.pop_front();
+                _statistics.expired++;
+                _statistics.pooled_buffers--;
+                _statistics.pooled_bytes -= bucket.first;
+            }
+        }
+    }
+}
@@ -0,0 +1,119 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2019 Intel Corporation. All Rights Reserved.
+
+#pragma once
+
+#include "types.h"
+
+#include <deque>
+#include <unordered_map>
+
+namespace librealsense
+{
+    // Storage of the frame payload.
+    // Exposes the subset of std::vector<byte> used across the library, with one difference:
+    // growing the buffer does not value-initialize the new bytes, since the unpacker is about to overwrite them.
+    // Memory is taken from the user-provided allocator when there is one
+    class frame_buffer
+    {
+    public:
+        frame_buffer() : _external(nullptr), _data(nullptr), _size(0), _capacity(0) {}
+        explicit frame_buffer(frame_allocator_ptr allocator) : frame_buffer() { _allocator = std::move(allocator); }
+        ~frame_buffer() { release_storage(); }
+
+        frame_buffer(const frame_buffer&) = delete;
+        frame_buffer& operator=(const frame_buffer&) = delete;
+
+        frame_buffer(frame_buffer&& other) : frame_buffer() { *this = std::move(other); }
+        frame_buffer& operator=(frame_buffer&& other);
+
+        // Adopt the storage of a vector (e.g. a message deserialized from a recording) without copying it
+        frame_buffer& operator=(std::vector<byte>&& other);
+        frame_buffer& operator=(const std::vector<byte>& other);
+
+        byte* data() { return _data; }
+        const byte* data() const { return _data; }
+        size_t size() const { return _size; }
+        size_t capacity() const { return _capacity; }
+        bool empty() const { return _size == 0; }
+
+        byte* begin() { return _data; }
+        byte* end() { return _data + _size; }
+        const byte* begin() const { return _data; }
+        const byte* end() const { return _data + _size; }
+
+        byte& operator[](size_t i) { return _data[i]; }
+        const byte& operator[](size_t i) const { return _data[i]; }
+
+        // Existing content is preserved up to the new size, additional bytes are left uninitialized
+        void resize(size_t size);
+        void clear() { _size = 0; }
+
+        const frame_allocator_ptr& get_allocator() const { return _allocator; }
+
+    private:
+        void release_storage();
+
+        std::vector<byte> _vector;       // adopted storage
+        std::unique_ptr<byte[]> _block;  // storage allocated by the buffer itself
+        frame_allocator_ptr _allocator;  // user allocator, kept alive for as long as it owns _external
+        byte* _external;                 // storage allocated by the user allocator
+        byte* _data;
+        size_t _size;
+        size_t _capacity;
+    };
+
+    struct frame_pool_statistics
+    {
+        unsigned long long hits = 0;
+        unsigned long long misses = 0;
+        unsigned long long expired = 0;
+        unsigned long long pooled_buffers = 0;
+        unsigned long long pooled_bytes = 0;
+
+        frame_pool_statistics& operator+=(const frame_pool_statistics& other)
+        {
+            hits += other.hits;
+            misses += other.misses;
+            expired += other.expired;
+            pooled_buffers += other.pooled_buffers;
+            pooled_bytes += other.pooled_bytes;
+            return *this;
+        }
+    };
+
+    // Recycles frame buffers, bucketed by their exact size.
+    // Both acquire and release are O(1): the most recently released buffer of the requested size is handed out first,
+    // while buffers idle for longer than the retention period are trimmed from the cold end of each bucket
+    class frame_buffer_pool
+    {
+    public:
+        // Retention is given in milliseconds of frame time, zero disables recycling altogether
+        explicit frame_buffer_pool(const std::atomic<uint32_t>* retention_ms);
+
+        frame_buffer acquire(size_t size, rs2_time_t timestamp);
+        void release(frame_buffer&& buffer, rs2_time_t timestamp);
+
+        void clear();
+
+        // Pooled buffers of the previous allocator are dropped, buffers still in use return to it when released
+        void set_allocator(frame_allocator_ptr allocator);
+
+        frame_pool_statistics get_statistics() const;
+
+    private:
+        struct pooled_buffer
+        {
+            frame_buffer buffer;
+            rs2_time_t released_at;
+        };
+
+        void expire(rs2_time_t timestamp);
+
+        const std::atomic<uint32_t>* _retention_ms;
+        mutable std::mutex _mutex;
+        std::unordered_map<size_t, std::deque<pooled_buffer>> _buckets;
+        frame_pool_statistics _statistics;
+        frame_allocator_ptr _allocator;
+    };
+}
@@ -1,20 +1,36 @@
 // License: Apache 2.0. See LICENSE file in root directory.
 // Copyright(c) 2015 Intel Corporation. All Rights Reserved.
 #include "global_timestamp_reader.h"
+#include <algorithm>
 #include <chrono>
+#include <cmath>
 
 namespace librealsense
 {
     CLinearCoefficients::CLinearCoefficients(unsigned int buffer_size) :
         _base_sample(0, 0),
-        _buffer_size(buffer_size)
+        _buffer_size(buffer_size),
+        _sums(),
+        _dropped_since_rebase(0),
+        _is_full(false),
+        _model(linear_model{ 1, 0, 0, 0, 0, 0, 0, 0 })
     {
         //LOG_DEBUG("CLinearCoefficients started");
     }
 
     void CLinearCoefficients::reset()
     {
+        std::lock_guard<std::recursive_mutex> lock(_add_mtx);
         _last_values.clear();
+        _sums = regression_sums();
+        _dropped_since_rebase = 0;
+        _is_full = false;
+
+        // The last model keeps converting timestamps until the next sample
+        auto model = _model.load();
+        model.residual = 0;
+        model.samples = 0;
+        _model.store(model);
         //LOG_DEBUG("CLinearCoefficients::reset");
     }
 
@@ -32,61 +48,107 @@ namespace librealsense
         return *this;
     }
 
+    void CLinearCoefficients::regression_sums::add(const CSample& sample, double weight)
+    {
+        n += weight;
+        x += weight * sample._x;
+        y += weight * sample._y;
+        xy += weight * sample._x * sample._y;
+        x2 += weight * sample._x * sample._x;
+        y2 += weight * sample._y * sample._y;
+    }
+
     bool CLinearCoefficients::is_full() const 
     {
-        return _last_values.size() >= _buffer_size;
+        return _is_full;
     }
 
     void CLinearCoefficients::add_value(CSample val)
     {
         std::lock_guard<std::recursive_mutex> lock(_add_mtx);   // Redandent as only being read from update_diff_time() and there is a lock there.
+        if (_last_values.empty())
+            _base_sample = val;
+
         while (_last_values.size() > _buffer_size)
         {
+            CSample dropped(_last_values.back());
+            dropped -= _base_sample;
+            _sums.add(dropped, -1);
             _last_values.pop_back();
+            _dropped_since_rebase++;
         }
         _last_values.push_front(val);
+
+        // Once the window was renewed, the sums are restarted from its oldest sample,
+        // so that neither their magnitude nor the rounding errors of the removals grow over time
+        if (_dropped_since_rebase > _buffer_size)
+        {
+            rebase();
+        }
+        else
+        {
+            CSample added(val);
+            added -= _base_sample;
+            _sums.add(added, 1);
+        }
+
+        _is_full = _last_values.size() >= _buffer_size;
         calc_linear_coefs();
     }
 
+    void CLinearCoefficients::rebase()
+    {
+        _base_sample = _last_values.back();
+        _sums = regression_sums();
+        for (auto&& sample : _last_values)
+        {
+            CSample crnt_sample(sample);
+            crnt_sample -= _base_sample;
+            _sums.add(crnt_sample, 1);
+        }
+        _dropped_since_rebase = 0;
+    }
+
     void CLinearCoefficients::calc_linear_coefs()
     {
         // Calculate linear coefficients, based on calculus described in: https://www.statisticshowto.datasciencecentral.com/probability-and-statistics/regression-analysis/find-a-linear-regression-equation/
-        // Calculate Std 
-        double sum_x(0);
-        double sum_y(0);
-        double sum_xy(0);
-        double sum_x2(0);
-        double n(static_cast<double>(_last_values.size()));
-        CSample base_sample = _last_values.back();
-        double a(1);
-        double b(0);
-        if (n > 1)
+        const auto& s = _sums;
+        linear_model model{ 1, 0, _last_values.front()._x, _last_values.front()._y, _last_values.front()._x, _last_values.front()._y, 0,
+                            static_cast<unsigned int>(_last_values.size()) };
+        double det(s.n * s.x2 - s.x * s.x);
+        if (_last_values.size() > 1 && det > 0)
         {
-            for (auto sample = _last_values.begin(); sample != _last_values.end(); sample++)
-            {
-                CSample crnt_sample(*sample);
-                crnt_sample -= base_sample;
-                sum_x += crnt_sample._x;
-                sum_y += crnt_sample._y;
-                sum_xy += (crnt_sample._x * crnt_sample._y);
-                sum_x2 += (crnt_sample._x * crnt_sample._x);
-            }
-            b = (sum_y*sum_x2 - sum_x * sum_xy) / (n*sum_x2 - sum_x * sum_x);
-            a = (n*sum_xy - sum_x * sum_y) / (n*sum_x2 - sum_x * sum_x);
+            model.b = (s.y * s.x2 - s.x * s.xy) / det;
+            model.a = (s.n * s.xy - s.x * s.y) / det;
+            model.base_x = _base_sample._x;
+            model.base_y = _base_sample._y;
+
+            // The residual sum of squares is the variance of y that the slope does not explain
+            double cov_xy(s.xy - s.x * s.y / s.n);
+            double var_y(s.y2 - s.y * s.y / s.n);
+            model.residual = std::sqrt(std::max(var_y - model.a * cov_xy, 0.) / s.n);
         }
-        std::lock_guard<std::recursive_mutex> lock(_stat_mtx);
-        _base_sample = base_sample;
-        _a = a;
-        _b = b;
+        _model.store(model);
     }
 
     double CLinearCoefficients::calc_value(double x) const
     {
-        std::lock_guard<std::recursive_mutex> lock(_stat_mtx);
-        double y(_a * (x - _base_sample._x) + _b + _base_sample._y);
+        auto model = _model.load();
+        double y(model.a * (x - model.base_x) + model.b + model.base_y);
         return y;
     }
 
+    clock_model_stats CLinearCoefficients::get_stats(double y) const
+    {
+        auto model = _model.load();
+        clock_model_stats stats;
+        stats.samples = model.samples;
+        stats.drift_ppm = (model.a - 1) * 1e6;
+        stats.residual = model.residual;
+        stats.sample_age = model.samples ? y - model.last_y : 0;
+        return stats;
+    }
+
     time_diff_keeper::time_diff_keeper(global_time_interface* dev, const unsigned int sampling_interval_ms) :
         _device(dev),
         _poll_intervals_ms(sampling_interval_ms),
@@ -187,6 +249,8 @@ namespace librealsense
     double time_diff_keeper::get_system_hw_time(double crnt_hw_time, bool& is_ready)
     {
         static const double possible_loop_time(3000);
+        // Only a suspected time loop takes the lock, converting a timestamp otherwise never waits
+        if ((_last_sample_hw_time - crnt_hw_time) > possible_loop_time)
         {
             std::lock_guard<std::recursive_mutex> lock(_read_mtx);
             if ((_last_sample_hw_time - crnt_hw_time) > possible_loop_time)
@@ -201,6 +265,12 @@ namespace librealsense
             return crnt_hw_time;
     }
 
+    clock_model_stats time_diff_keeper::get_stats() const
+    {
+        using namespace std::chrono;
+        return _coefs.get_stats(duration<double, std::milli>(system_clock::now().time_since_epoch()).count());
+    }
+
     global_timestamp_reader::global_timestamp_reader(std::unique_ptr<frame_timestamp_reader> device_timestamp_reader, 
                                                      std::shared_ptr<time_diff_keeper> timediff,
                                                      std::shared_ptr<global_time_option> enable_option) :
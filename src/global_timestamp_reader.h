@@ -30,6 +30,18 @@ namespace librealsense
         double _y;
     };
 
+    // Quality of a linear clock model, as of its last sample
+    struct clock_model_stats
+    {
+        unsigned int samples;   // Samples the model is fitted to, 0 until the first sample after a reset
+        double drift_ppm;       // Deviation of the model slope from 1, in parts per million
+        double residual;        // Root mean square distance of the samples from the model, in y units
+        double sample_age;      // Distance of the last sample from the time the stats were taken, in y units
+    };
+
+    // Linear regression of y over x on a sliding window of samples.
+    // The window is summed incrementally and the model is published through a seqlock, so calc_value never blocks.
+    // add_value and reset may be called from one thread at a time
     class CLinearCoefficients
     {
     public:
@@ -38,17 +50,36 @@ namespace librealsense
         void add_value(CSample val);
         double calc_value(double x) const;
         bool is_full() const;
+        clock_model_stats get_stats(double y) const;
 
     private:
+        struct regression_sums
+        {
+            double n, x, y, xy, x2, y2;
+            void add(const CSample& sample, double weight);
+        };
+
+        struct linear_model
+        {
+            double a, b;              // y = a * (x - base_x) + b + base_y
+            double base_x, base_y;
+            double last_x, last_y;
+            double residual;
+            unsigned int samples;
+        };
+
+        void rebase();
         void calc_linear_coefs();
 
     private:
         unsigned int _buffer_size;
         std::deque<CSample> _last_values;
-        double _b, _a;    //Linear regression coeffitions.
-        CSample _base_sample;
+        CSample _base_sample;            // Samples are summed relative to it, to keep the sums small
+        regression_sums _sums;
+        unsigned int _dropped_since_rebase;
+        std::atomic<bool> _is_full;
+        seqlock<linear_model> _model;
         mutable std::recursive_mutex _add_mtx;
-        mutable std::recursive_mutex _stat_mtx;
     };
 
     class global_time_interface;
@@ -61,6 +92,7 @@ namespace librealsense
         void stop();
         ~time_diff_keeper();
         double get_system_hw_time(double crnt_hw_time, bool& is_ready);
+        clock_model_stats get_stats() const;    // Host clock in milliseconds over hardware clock in milliseconds
 
     private:
         bool update_diff_time();
@@ -68,7 +100,7 @@ namespace librealsense
 
     private:
         global_time_interface* _device;
-        double _last_sample_hw_time;
+        std::atomic<double> _last_sample_hw_time;
         unsigned int _poll_intervals_ms;
         int             _users_count;
         active_object<> _active_object;
@@ -76,7 +108,7 @@ namespace librealsense
         mutable std::recursive_mutex _read_mtx; // Watch only 1 reader at a time.
         mutable std::recursive_mutex _enable_mtx; // Watch only 1 start/stop operation at a time.
         CLinearCoefficients _coefs;
-        bool _is_ready;
+        std::atomic<bool> _is_ready;
     };
 
     class global_timestamp_reader : public frame_timestamp_reader
@@ -108,6 +140,7 @@ namespace librealsense
         global_time_interface();
         ~global_time_interface() { _tf_keeper.reset(); }
         void enable_time_diff_keeper(bool is_enable);
+        clock_model_stats get_time_diff_stats() const { return _tf_keeper->get_stats(); }
         virtual double get_device_time_ms() = 0; // Returns time in miliseconds.
         virtual void create_snapshot(std::shared_ptr<global_time_interface>& snapshot) const override {}
         virtual void enable_recording(std::function<void(const global_time_interface&)> record_action) override {}
@@ -8,14 +8,15 @@
 //#include "../include/librealsense2/rsutil.h" // For projection/deprojection logic
 
 #ifndef ANDROID
-    #if defined(__SSSE3__) && defined(__AVX2__)
+    #if defined(__SSSE3__) && (defined(__AVX2__) || defined(RS2_USE_AVX2))
     #include <tmmintrin.h> // For SSE3 intrinsic used in unpack_yuy2_sse
     #include <immintrin.h>
 
     #pragma pack(push, 1) // All structs in this file are assumed to be byte-packed
     namespace librealsense
     {
-        template<rs2_format FORMAT> void unpack_yuy2(byte * const d[], const byte * s, int n)
+        // SOURCE is the 4:2:2 byte order of the input, YUYV (Y0 U Y1 V) or UYVY (U Y0 V Y1)
+        template<rs2_format FORMAT, rs2_format SOURCE = RS2_FORMAT_YUYV> void unpack_yuy2(byte * const d[], const byte * s, int n)
         {
             assert(n % 16 == 0); // All currently supported color resolutions are multiples of 16 pixels. Could easily extend support to other resolutions by copying final n<16 pixels into a zero-padded buffer and recursively calling self for final iteration.
 
@@ -51,7 +52,10 @@
                 }
 
                 // Shuffle all Y components to the low order bytes of the register, and all U/V components to the high order bytes
-                const __m256i evens_odd1s_odd3s = _mm256_setr_epi8(0, 2, 4, 6, 8, 10, 12, 14, 1, 5, 9, 13, 3, 7, 11, 15,
+                const __m256i evens_odd1s_odd3s = (SOURCE == RS2_FORMAT_UYVY) ?
+                    _mm256_setr_epi8(1, 3, 5, 7, 9, 11, 13, 15, 0, 4, 8, 12, 2, 6, 10, 14,
+                    1, 3, 5, 7, 9, 11, 13, 15, 0, 4, 8, 12, 2, 6, 10, 14) :
+                    _mm256_setr_epi8(0, 2, 4, 6, 8, 10, 12, 14, 1, 5, 9, 13, 3, 7, 11, 15,
                     0, 2, 4, 6, 8, 10, 12, 14, 1, 5, 9, 13, 3, 7, 11, 15); // to get yyyyyyyyuuuuvvvvyyyyyyyyuuuuvvvv
                 __m256i yyyyyyyyuuuuvvvv0 = _mm256_shuffle_epi8(s0, evens_odd1s_odd3s);
                 __m256i yyyyyyyyuuuuvvvv8 = _mm256_shuffle_epi8(s1, evens_odd1s_odd3s);
@@ -218,11 +222,11 @@
                         // Shuffle rgb triples to the start and end of each register
                         __m128i bgr0 = _mm_shuffle_epi8(rgba0, _mm_setr_epi8(3, 7, 11, 15, 0, 1, 2, 4, 5, 6, 8, 9, 10, 12, 13, 14));
                         __m128i bgr1 = _mm_shuffle_epi8(rgba1, _mm_setr_epi8(0, 1, 2, 4, 3, 7, 11, 15, 5, 6, 8, 9, 10, 12, 13, 14));
-                        __m128i bgr2 = _mm_shuffle_epi8(rgba2, _mm_setr_epi8(0, 1, 2, 4, 5, 6, 8, 9, 3, 7, 11, 15, 10, 12, 13, 1));
+                        __m128i bgr2 = _mm_shuffle_epi8(rgba2, _mm_setr_epi8(0, 1, 2, 4, 5, 6, 8, 9, 3, 7, 11, 15, 10, 12, 13, 14));
                         __m128i bgr3 = _mm_shuffle_epi8(rgba3, _mm_setr_epi8(0, 1, 2, 4, 5, 6, 8, 9, 10, 12, 13, 14, 3, 7, 11, 15));
                         __m128i bgr4 = _mm_shuffle_epi8(rgba4, _mm_setr_epi8(3, 7, 11, 15, 0, 1, 2, 4, 5, 6, 8, 9, 10, 12, 13, 14));
                         __m128i bgr5 = _mm_shuffle_epi8(rgba5, _mm_setr_epi8(0, 1, 2, 4, 3, 7, 11, 15, 5, 6, 8, 9, 10, 12, 13, 14));
-                        __m128i bgr6 = _mm_shuffle_epi8(rgba6, _mm_setr_epi8(0, 1, 2, 4, 5, 6, 8, 9, 3, 7, 11, 15, 10, 12, 13, 1));
+                        __m128i bgr6 = _mm_shuffle_epi8(rgba6, _mm_setr_epi8(0, 1, 2, 4, 5, 6, 8, 9, 3, 7, 11, 15, 10, 12, 13, 14));
                         __m128i bgr7 = _mm_shuffle_epi8(rgba7, _mm_setr_epi8(0, 1, 2, 4, 5, 6, 8, 9, 10, 12, 13, 14, 3, 7, 11, 15));
 
                         __m128i a1 = _mm_alignr_epi8(bgr1, bgr0, 4);
@@ -274,6 +278,116 @@
         {
             unpack_yuy2<RS2_FORMAT_BGRA8>(d, s, n);
         }
+
+    #ifdef RS2_USE_AVX2
+        int unpack_uyvy_avx_rgb8(byte * const d[], const byte * s, int n)
+        {
+            unpack_yuy2<RS2_FORMAT_RGB8, RS2_FORMAT_UYVY>(d, s, n);
+            return n / 32 * 32;
+        }
+        int unpack_uyvy_avx_rgba8(byte * const d[], const byte * s, int n)
+        {
+            unpack_yuy2<RS2_FORMAT_RGBA8, RS2_FORMAT_UYVY>(d, s, n);
+            return n / 32 * 32;
+        }
+        int unpack_uyvy_avx_bgr8(byte * const d[], const byte * s, int n)
+        {
+            unpack_yuy2<RS2_FORMAT_BGR8, RS2_FORMAT_UYVY>(d, s, n);
+            return n / 32 * 32;
+        }
+        int unpack_uyvy_avx_bgra8(byte * const d[], const byte * s, int n)
+        {
+            unpack_yuy2<RS2_FORMAT_BGRA8, RS2_FORMAT_UYVY>(d, s, n);
+            return n / 32 * 32;
+        }
+
+        // Loads two 16 byte blocks into the low and high lanes of a register
+        static inline __m256i load_lanes(const byte * lo, const byte * hi)
+        {
+            return _mm256_inserti128_si256(_mm256_castsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(lo))),
+                                           _mm_loadu_si128(reinterpret_cast<const __m128i*>(hi)), 1);
+        }
+
+        int unpack_y8_y8_from_y8i_avx(byte * const d[], const byte * s, int count)
+        {
+            // Per lane, gather the left bytes of 8 pixels into the low half and the right bytes into the high half
+            const __m256i split = _mm256_setr_epi8(0, 2, 4, 6, 8, 10, 12, 14, 1, 3, 5, 7, 9, 11, 13, 15,
+                                                   0, 2, 4, 6, 8, 10, 12, 14, 1, 3, 5, 7, 9, 11, 13, 15);
+            auto src = reinterpret_cast<const __m256i*>(s);
+            auto left = reinterpret_cast<__m256i*>(d[0]);
+            auto right = reinterpret_cast<__m256i*>(d[1]);
+
+            auto n = count / 32;
+            for (int i = 0; i < n; i++)
+            {
+                auto a = _mm256_shuffle_epi8(_mm256_loadu_si256(&src[i * 2]), split);     // L0-7 R0-7 | L8-15 R8-15
+                auto b = _mm256_shuffle_epi8(_mm256_loadu_si256(&src[i * 2 + 1]), split); // L16-23 R16-23 | L24-31 R24-31
+
+                // Unpacking leaves the 8 pixel groups in 0, 16, 8, 24 order, restored by the cross-lane permute
+                _mm256_storeu_si256(&left[i], _mm256_permute4x64_epi64(_mm256_unpacklo_epi64(a, b), _MM_SHUFFLE(3, 1, 2, 0)));
+                _mm256_storeu_si256(&right[i], _mm256_permute4x64_epi64(_mm256_unpackhi_epi64(a, b), _MM_SHUFFLE(3, 1, 2, 0)));
+            }
+            return n * 32;
+        }
+
+        int unpack_y16_y16_from_y12i_10_avx(byte * const d[], const byte * s, int count)
+        {
+            // Every lane holds 4 pixels (12 bytes). The right value is the little-endian word at bytes 0-1 masked to 12 bits,
+            // the left one is the word at bytes 1-2 shifted down by 4
+            const __m256i r_lo = _mm256_setr_epi8(0, 1, 3, 4, 6, 7, 9, 10, -1, -1, -1, -1, -1, -1, -1, -1,
+                                                  0, 1, 3, 4, 6, 7, 9, 10, -1, -1, -1, -1, -1, -1, -1, -1);
+            const __m256i r_hi = _mm256_setr_epi8(-1, -1, -1, -1, -1, -1, -1, -1, 0, 1, 3, 4, 6, 7, 9, 10,
+                                                  -1, -1, -1, -1, -1, -1, -1, -1, 0, 1, 3, 4, 6, 7, 9, 10);
+            const __m256i l_lo = _mm256_setr_epi8(1, 2, 4, 5, 7, 8, 10, 11, -1, -1, -1, -1, -1, -1, -1, -1,
+                                                  1, 2, 4, 5, 7, 8, 10, 11, -1, -1, -1, -1, -1, -1, -1, -1);
+            const __m256i l_hi = _mm256_setr_epi8(-1, -1, -1, -1, -1, -1, -1, -1, 1, 2, 4, 5, 7, 8, 10, 11,
+                                                  -1, -1, -1, -1, -1, -1, -1, -1, 1, 2, 4, 5, 7, 8, 10, 11);
+            const __m256i mask12 = _mm256_set1_epi16(0x0fff);
+            auto left = reinterpret_cast<__m256i*>(d[0]);
+            auto right = reinterpret_cast<__m256i*>(d[1]);
+
+            // The last load reads 4 bytes past the 16 pixels of the block, hence the extra margin
+            int i = 0;
+            for (; i <= count - 18; i += 16)
+            {
+                auto p = s + i * 3;
+                auto a = load_lanes(p, p + 12);      // pixels 0-3 | 4-7
+                auto b = load_lanes(p + 24, p + 36); // pixels 8-11 | 12-15
+
+                auto l = _mm256_srli_epi16(_mm256_or_si256(_mm256_shuffle_epi8(a, l_lo), _mm256_shuffle_epi8(b, l_hi)), 4);
+                auto r = _mm256_and_si256(_mm256_or_si256(_mm256_shuffle_epi8(a, r_lo), _mm256_shuffle_epi8(b, r_hi)), mask12);
+                l = _mm256_or_si256(_mm256_slli_epi16(l, 6), _mm256_srli_epi16(l, 4));
+                r = _mm256_or_si256(_mm256_slli_epi16(r, 6), _mm256_srli_epi16(r, 4));
+
+                // Pixel groups are in 0, 8, 4, 12 order
+                _mm256_storeu_si256(&left[i / 16], _mm256_permute4x64_epi64(l, _MM_SHUFFLE(3, 1, 2, 0)));
+                _mm256_storeu_si256(&right[i / 16], _mm256_permute4x64_epi64(r, _MM_SHUFFLE(3, 1, 2, 0)));
+            }
+            return i;
+        }
+
+        int unpack_y8_from_y16_10_avx(uint8_t * d, const uint16_t * s, int count)
+        {
+            // Keep the low byte of each shifted value so that out-of-range input truncates like the scalar code
+            const __m256i low_byte = _mm256_set1_epi16(0xff);
+            auto n = count / 32;
+            for (int i = 0; i < n; i++)
+            {
+                auto a = _mm256_and_si256(_mm256_srli_epi16(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(s + i * 32)), 2), low_byte);
+                auto b = _mm256_and_si256(_mm256_srli_epi16(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(s + i * 32 + 16)), 2), low_byte);
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(d + i * 32), _mm256_permute4x64_epi64(_mm256_packus_epi16(a, b), _MM_SHUFFLE(3, 1, 2, 0)));
+            }
+            return n * 32;
+        }
+
+        int unpack_y16_from_y16_10_avx(uint16_t * d, const uint16_t * s, int count)
+        {
+            auto n = count / 16;
+            for (int i = 0; i < n; i++)
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(d + i * 16), _mm256_slli_epi16(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(s + i * 16)), 6));
+            return n * 16;
+        }
+    #endif
     }
 
     #pragma pack(pop)
@@ -18,6 +18,19 @@ namespace librealsense
     void unpack_yuy2_avx_bgr8(byte * const d[], const byte * s, int n);
     void unpack_yuy2_avx_bgra8(byte * const d[], const byte * s, int n);
     #endif
+
+    // Runtime-dispatched kernels, only to be called once has_avx2() confirmed CPU support.
+    // Each one handles the leading pixels that fill whole registers and returns how many, the caller completes the rest
+    #if defined(__SSSE3__) && defined(RS2_USE_AVX2)
+    int unpack_y8_y8_from_y8i_avx(byte * const d[], const byte * s, int count);
+    int unpack_y16_y16_from_y12i_10_avx(byte * const d[], const byte * s, int count);
+    int unpack_y8_from_y16_10_avx(uint8_t * d, const uint16_t * s, int count);
+    int unpack_y16_from_y16_10_avx(uint16_t * d, const uint16_t * s, int count);
+    int unpack_uyvy_avx_rgb8(byte * const d[], const byte * s, int n);
+    int unpack_uyvy_avx_rgba8(byte * const d[], const byte * s, int n);
+    int unpack_uyvy_avx_bgr8(byte * const d[], const byte * s, int n);
+    int unpack_uyvy_avx_bgra8(byte * const d[], const byte * s, int n);
+    #endif
 #endif
 }
 
@@ -3,6 +3,7 @@
 
 #include "image.h"
 #include "image-avx.h"
+#include "cpu-features.h"
 #include "types.h"
 
 #define STB_IMAGE_STATIC
@@ -16,32 +17,6 @@
 #include <tmmintrin.h> // For SSSE3 intrinsics
 #endif
 
-#if defined (ANDROID) || (defined (__linux__) && !defined (__x86_64__))
-
-bool has_avx() { return false; }
-
-#else
-
-#ifdef _WIN32
-#include <intrin.h>
-#define cpuid(info, x)    __cpuidex(info, x, 0)
-#else
-#include <cpuid.h>
-void cpuid(int info[4], int info_type){
-    __cpuid_count(info_type, 0, info[0], info[1], info[2], info[3]);
-}
-#endif
-
-bool has_avx()
-{
-    int info[4];
-    cpuid(info, 0);
-    cpuid(info, 0x80000000);
-    return (info[2] & ((int)1 << 28)) != 0;
-}
-
-#endif
-
 #pragma pack(push, 1) // All structs in this file are assumed to be byte-packed
 namespace librealsense
 {
@@ -80,6 +55,7 @@ namespace librealsense
         case RS2_FORMAT_GPIO_RAW: return 1;
         case RS2_FORMAT_MOTION_RAW: return 1;
         case RS2_FORMAT_MOTION_XYZ32F: return 1;
+        case RS2_FORMAT_MOTION_XYZ32F_BATCH: return 1;
         case RS2_FORMAT_6DOF: return 1;
         case RS2_FORMAT_MJPEG: return 8;
         default: assert(false); return 0;
@@ -140,6 +116,59 @@ namespace librealsense
         librealsense::copy(dest[0], source + input_reports_offset, input_reports_size);
     }
 
+#ifdef __SSSE3__
+    // Rotates one 8x8 block: transposes it in registers, then reverses each transposed row
+    inline void rotate_l500_block(byte * out, int out_stride, const byte * in, int in_stride, std::integral_constant<size_t, 2>)
+    {
+        __m128i r[8], t[8], u[8];
+        for (int k = 0; k < 8; k++)
+            r[k] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + k * in_stride));
+
+        for (int k = 0; k < 4; k++)
+        {
+            t[k * 2] = _mm_unpacklo_epi16(r[k * 2], r[k * 2 + 1]);
+            t[k * 2 + 1] = _mm_unpackhi_epi16(r[k * 2], r[k * 2 + 1]);
+        }
+        u[0] = _mm_unpacklo_epi32(t[0], t[2]); u[1] = _mm_unpackhi_epi32(t[0], t[2]);
+        u[2] = _mm_unpacklo_epi32(t[1], t[3]); u[3] = _mm_unpackhi_epi32(t[1], t[3]);
+        u[4] = _mm_unpacklo_epi32(t[4], t[6]); u[5] = _mm_unpackhi_epi32(t[4], t[6]);
+        u[6] = _mm_unpacklo_epi32(t[5], t[7]); u[7] = _mm_unpackhi_epi32(t[5], t[7]);
+
+        const __m128i reverse = _mm_setr_epi8(14, 15, 12, 13, 10, 11, 8, 9, 6, 7, 4, 5, 2, 3, 0, 1);
+        for (int k = 0; k < 4; k++)
+        {
+            // Column 2k and 2k+1 of the input block, which become output rows 7-2k and 6-2k
+            auto col0 = _mm_unpacklo_epi64(u[k], u[k + 4]);
+            auto col1 = _mm_unpackhi_epi64(u[k], u[k + 4]);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out + (7 - k * 2) * out_stride), _mm_shuffle_epi8(col0, reverse));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out + (6 - k * 2) * out_stride), _mm_shuffle_epi8(col1, reverse));
+        }
+    }
+
+    inline void rotate_l500_block(byte * out, int out_stride, const byte * in, int in_stride, std::integral_constant<size_t, 1>)
+    {
+        __m128i r[8], t[4], u[4];
+        for (int k = 0; k < 8; k++)
+            r[k] = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(in + k * in_stride));
+
+        for (int k = 0; k < 4; k++)
+            t[k] = _mm_unpacklo_epi8(r[k * 2], r[k * 2 + 1]);
+        auto lo0 = _mm_unpacklo_epi16(t[0], t[1]), hi0 = _mm_unpackhi_epi16(t[0], t[1]);
+        auto lo1 = _mm_unpacklo_epi16(t[2], t[3]), hi1 = _mm_unpackhi_epi16(t[2], t[3]);
+        u[0] = _mm_unpacklo_epi32(lo0, lo1); u[1] = _mm_unpackhi_epi32(lo0, lo1);
+        u[2] = _mm_unpacklo_epi32(hi0, hi1); u[3] = _mm_unpackhi_epi32(hi0, hi1);
+
+        const __m128i reverse = _mm_setr_epi8(7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8);
+        for (int k = 0; k < 4; k++)
+        {
+            // Columns 2k and 2k+1 of the input block, in the low and high halves
+            auto cols = _mm_shuffle_epi8(u[k], reverse);
+            _mm_storel_epi64(reinterpret_cast<__m128i*>(out + (7 - k * 2) * out_stride), cols);
+            _mm_storel_epi64(reinterpret_cast<__m128i*>(out + (6 - k * 2) * out_stride), _mm_srli_si128(cols, 8));
+        }
+    }
+#endif
+
     template<size_t SIZE>
     void align_l500_image_optimized(byte * const dest[], const byte * source, int width, int height, int actual_size)
     {
@@ -147,6 +176,17 @@ namespace librealsense
         auto height_out = width;
 
         auto out = dest[0];
+#ifdef __SSSE3__
+        if (get_simd_level() >= simd_level::ssse3)
+        {
+            // Block (i, j) lands rotated at output row width-8-j, column height-8-i
+            for (int i = 0; i <= height - 8; i = i + 8)
+                for (int j = 0; j <= width - 8; j = j + 8)
+                    rotate_l500_block(&out[((height_out - 8 - j) * width_out + width_out - 8 - i) * SIZE], width_out * SIZE,
+                                      &source[(i * width + j) * SIZE], width * SIZE, std::integral_constant<size_t, SIZE>());
+            return;
+        }
+#endif
         byte buffer[8][8 * SIZE]; // = { 0 };
         for (int i = 0; i <= height-8; i = i + 8)
         {
@@ -219,6 +259,11 @@ namespace librealsense
         librealsense::copy(dest[0], source, SIZE * count);
     }
 
+    bool is_zero_copy_capable(const pixel_format_unpacker& unpacker)
+    {
+        return unpacker.unpack == &copy_pixels<1> || unpacker.unpack == &copy_pixels<2>;
+    }
+
     void copy_raw10(byte * const dest[], const byte * source, int width, int height, int actual_size)
     {
         auto count = width * height; // num of pixels
@@ -248,7 +293,23 @@ namespace librealsense
     }
 
     void unpack_y16_from_y8(byte * const d[], const byte * s, int width, int height, int actual_size) { unpack_pixels(d, width * height, reinterpret_cast<const uint8_t *>(s), [](uint8_t  pixel) -> uint16_t { return pixel | pixel << 8; }, actual_size); }
-    void unpack_y16_from_y16_10(byte * const d[], const byte * s, int width, int height, int actual_size) { unpack_pixels(d, width * height, reinterpret_cast<const uint16_t*>(s), [](uint16_t pixel) -> uint16_t { return pixel << 6; }, actual_size); }
+    void unpack_y16_from_y16_10(byte * const d[], const byte * s, int width, int height, int actual_size)
+    {
+        auto count = width * height;
+        auto in = reinterpret_cast<const uint16_t*>(s);
+        auto out = reinterpret_cast<uint16_t*>(d[0]);
+        int i = 0;
+#if defined(RS2_USE_AVX2) && defined(__SSSE3__) && !defined(ANDROID)
+        if (get_simd_level() == simd_level::avx2)
+            i = unpack_y16_from_y16_10_avx(out, in, count);
+#endif
+#ifdef __SSSE3__
+        if (get_simd_level() >= simd_level::ssse3)
+            for (; i <= count - 8; i += 8)
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), _mm_slli_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i)), 6));
+#endif
+        for (; i < count; ++i) out[i] = in[i] << 6;
+    }
     void unpack_y8_from_y16_10(byte * const d[], const byte * s, int width, int height, int actual_size) { unpack_pixels(d, width * height, reinterpret_cast<const uint16_t*>(s), [](uint16_t pixel) -> uint8_t  { return pixel >> 2; }, actual_size); }
     void unpack_rw10_from_rw8(byte *  const d[], const byte * s, int width, int height, int actual_size)
     {
@@ -684,6 +745,21 @@ namespace librealsense
 #ifdef __SSSE3__
         auto src = reinterpret_cast<const __m128i *>(s);
         auto dst = reinterpret_cast<__m128i *>(d[0]);
+#if defined(RS2_USE_AVX2) && !defined(ANDROID)
+        if (get_simd_level() == simd_level::avx2)
+        {
+            int done = 0;
+            if (FORMAT == RS2_FORMAT_RGB8) done = unpack_uyvy_avx_rgb8(d, s, n);
+            if (FORMAT == RS2_FORMAT_RGBA8) done = unpack_uyvy_avx_rgba8(d, s, n);
+            if (FORMAT == RS2_FORMAT_BGR8) done = unpack_uyvy_avx_bgr8(d, s, n);
+            if (FORMAT == RS2_FORMAT_BGRA8) done = unpack_uyvy_avx_bgra8(d, s, n);
+
+            // The remaining (at most 16) pixels go through the SSSE3 loop below
+            src += done * 2 / sizeof(__m128i);
+            dst += done * get_image_bpp(FORMAT) / 8 / sizeof(__m128i);
+            n -= done;
+        }
+#endif
         for (; n; n -= 16)
         {
             const __m128i zero = _mm_set1_epi8(0);
@@ -958,7 +1034,27 @@ namespace librealsense
 #ifdef RS2_USE_CUDA
         rscuda::split_frame_y8_y8_from_y8i_cuda(dest, count, reinterpret_cast<const y8i_pixel *>(source));
 #else
-        split_frame(dest, count, reinterpret_cast<const y8i_pixel*>(source),
+        int i = 0;
+#if defined(RS2_USE_AVX2) && defined(__SSSE3__) && !defined(ANDROID)
+        if (get_simd_level() == simd_level::avx2)
+            i = unpack_y8_y8_from_y8i_avx(dest, source, count);
+#endif
+#ifdef __SSSE3__
+        if (get_simd_level() >= simd_level::ssse3)
+        {
+            // Gather the left bytes of 8 pixels into the low half of a register and the right bytes into the high half
+            const __m128i split = _mm_setr_epi8(0, 2, 4, 6, 8, 10, 12, 14, 1, 3, 5, 7, 9, 11, 13, 15);
+            for (; i <= count - 16; i += 16)
+            {
+                auto a = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(source + i * 2)), split);
+                auto b = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(source + i * 2 + 16)), split);
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(dest[0] + i), _mm_unpacklo_epi64(a, b));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(dest[1] + i), _mm_unpackhi_epi64(a, b));
+            }
+        }
+#endif
+        byte * const tail[] = { dest[0] + i, dest[1] + i };
+        split_frame(tail, count - i, reinterpret_cast<const y8i_pixel*>(source) + i,
             [](const y8i_pixel & p) -> uint8_t { return p.l; },
             [](const y8i_pixel & p) -> uint8_t { return p.r; });
 #endif
@@ -971,7 +1067,36 @@ namespace librealsense
 #ifdef RS2_USE_CUDA
     rscuda::split_frame_y16_y16_from_y12i_cuda(dest, count, reinterpret_cast<const y12i_pixel *>(source));
 #else
-        split_frame(dest, count, reinterpret_cast<const y12i_pixel*>(source),
+        int i = 0;
+#if defined(RS2_USE_AVX2) && defined(__SSSE3__) && !defined(ANDROID)
+        if (get_simd_level() == simd_level::avx2)
+            i = unpack_y16_y16_from_y12i_10_avx(dest, source, count);
+#endif
+#ifdef __SSSE3__
+        if (get_simd_level() >= simd_level::ssse3)
+        {
+            // Each load covers 4 pixels (12 bytes). The right value is the little-endian word at bytes 0-1 masked to 12 bits,
+            // the left one is the word at bytes 1-2 shifted down by 4
+            const __m128i r_lo = _mm_setr_epi8(0, 1, 3, 4, 6, 7, 9, 10, -1, -1, -1, -1, -1, -1, -1, -1);
+            const __m128i r_hi = _mm_setr_epi8(-1, -1, -1, -1, -1, -1, -1, -1, 0, 1, 3, 4, 6, 7, 9, 10);
+            const __m128i l_lo = _mm_setr_epi8(1, 2, 4, 5, 7, 8, 10, 11, -1, -1, -1, -1, -1, -1, -1, -1);
+            const __m128i l_hi = _mm_setr_epi8(-1, -1, -1, -1, -1, -1, -1, -1, 1, 2, 4, 5, 7, 8, 10, 11);
+            const __m128i mask12 = _mm_set1_epi16(0x0fff);
+
+            // The second load of the last block reads 4 bytes past its 8 pixels, hence the extra margin
+            for (; i <= count - 10; i += 8)
+            {
+                auto a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + i * 3));
+                auto b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + i * 3 + 12));
+                auto l = _mm_srli_epi16(_mm_or_si128(_mm_shuffle_epi8(a, l_lo), _mm_shuffle_epi8(b, l_hi)), 4);
+                auto r = _mm_and_si128(_mm_or_si128(_mm_shuffle_epi8(a, r_lo), _mm_shuffle_epi8(b, r_hi)), mask12);
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(dest[0] + i * 2), _mm_or_si128(_mm_slli_epi16(l, 6), _mm_srli_epi16(l, 4)));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(dest[1] + i * 2), _mm_or_si128(_mm_slli_epi16(r, 6), _mm_srli_epi16(r, 4)));
+            }
+        }
+#endif
+        byte * const tail[] = { dest[0] + i * 2, dest[1] + i * 2 };
+        split_frame(tail, count - i, reinterpret_cast<const y12i_pixel*>(source) + i,
         [](const y12i_pixel & p) -> uint16_t { return p.l() << 6 | p.l() >> 4; },  // We want to convert 10-bit data to 16-bit data
         [](const y12i_pixel & p) -> uint16_t { return p.r() << 6 | p.r() >> 4; }); // Multiply by 64 1/16 to efficiently approximate 65535/1023
 #endif
@@ -1002,7 +1127,26 @@ namespace librealsense
 #ifdef RS2_USE_CUDA
         rscuda::unpack_z16_y8_from_sr300_inzi_cuda(out_ir, in, count);
 #else
-        for (int i = 0; i < count; ++i) *out_ir++ = *in++ >> 2;
+        int i = 0;
+#if defined(RS2_USE_AVX2) && defined(__SSSE3__) && !defined(ANDROID)
+        if (get_simd_level() == simd_level::avx2)
+            i = unpack_y8_from_y16_10_avx(out_ir, in, count);
+#endif
+#ifdef __SSSE3__
+        if (get_simd_level() >= simd_level::ssse3)
+        {
+            // Keep the low byte of each shifted value so that out-of-range input truncates like the scalar code
+            const __m128i low_byte = _mm_set1_epi16(0xff);
+            for (; i <= count - 16; i += 16)
+            {
+                auto a = _mm_and_si128(_mm_srli_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i)), 2), low_byte);
+                auto b = _mm_and_si128(_mm_srli_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i + 8)), 2), low_byte);
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(out_ir + i), _mm_packus_epi16(a, b));
+            }
+        }
+#endif
+        for (; i < count; ++i) out_ir[i] = in[i] >> 2;
+        in += count;
 #endif
         librealsense::copy(dest[0], in, count * 2);
     }
@@ -1026,8 +1170,20 @@ namespace librealsense
         auto in = reinterpret_cast<const uint8_t *>(source);
         auto out = reinterpret_cast<uint8_t *>(dest[0]);
 
-        librealsense::copy(out, in, count * 3);
-        for (auto i = 0; i < count; i++)
+        auto i = 0;
+#ifdef __SSSE3__
+        if (get_simd_level() >= simd_level::ssse3)
+        {
+            // Swap 5 pixels per 16 byte load. The 16th byte is stored unchanged and rewritten by the next iteration,
+            // so the loop stops while a whole register is still in bounds
+            const __m128i swap = _mm_setr_epi8(2, 1, 0, 5, 4, 3, 8, 7, 6, 11, 10, 9, 14, 13, 12, 15);
+            for (; i <= count - 6; i += 5)
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i * 3),
+                                 _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i * 3)), swap));
+        }
+#endif
+        librealsense::copy(out + i * 3, in + i * 3, (count - i) * 3);
+        for (; i < count; i++)
         {
             std::swap(out[i * 3], out[i * 3 + 2]);
         }
@@ -1118,9 +1274,11 @@ namespace librealsense
                                                                                                    { true,                &unpack_yuy2<RS2_FORMAT_BGR8 >,                { { RS2_STREAM_COLOR,          RS2_FORMAT_BGR8 } } },
                                                                                                    { true,                &unpack_yuy2<RS2_FORMAT_BGRA8>,                { { RS2_STREAM_COLOR,          RS2_FORMAT_BGRA8 } } } } };
 
-    const native_pixel_format pf_accel_axes               = { rs_fourcc('A','C','C','L'), 1, 1, {  { true,                &unpack_accel_axes<RS2_FORMAT_MOTION_XYZ32F>,  { { RS2_STREAM_ACCEL,          RS2_FORMAT_MOTION_XYZ32F } } } } };
+    const native_pixel_format pf_accel_axes               = { rs_fourcc('A','C','C','L'), 1, 1, {  { true,                &unpack_accel_axes<RS2_FORMAT_MOTION_XYZ32F>,  { { RS2_STREAM_ACCEL,          RS2_FORMAT_MOTION_XYZ32F } } },
+                                                                                                   { true,                &unpack_accel_axes<RS2_FORMAT_MOTION_XYZ32F>,  { { RS2_STREAM_ACCEL,          RS2_FORMAT_MOTION_XYZ32F_BATCH } } } } };
                                                                                                  //{ false,               &unpack_hid_raw_data,                          { { RS2_STREAM_ACCEL,          RS2_FORMAT_MOTION_RAW  } } } } };
-    const native_pixel_format pf_gyro_axes                = { rs_fourcc('G','Y','R','O'), 1, 1, {  { true,                &unpack_gyro_axes<RS2_FORMAT_MOTION_XYZ32F>,   { { RS2_STREAM_GYRO,           RS2_FORMAT_MOTION_XYZ32F } } } } };
+    const native_pixel_format pf_gyro_axes                = { rs_fourcc('G','Y','R','O'), 1, 1, {  { true,                &unpack_gyro_axes<RS2_FORMAT_MOTION_XYZ32F>,   { { RS2_STREAM_GYRO,           RS2_FORMAT_MOTION_XYZ32F } } },
+                                                                                                   { true,                &unpack_gyro_axes<RS2_FORMAT_MOTION_XYZ32F>,   { { RS2_STREAM_GYRO,           RS2_FORMAT_MOTION_XYZ32F_BATCH } } } } };
                                                                                                  //{ false,               &unpack_hid_raw_data,                          { { RS2_STREAM_GYRO,           RS2_FORMAT_MOTION_RAW  } } } } };
     const native_pixel_format pf_gpio_timestamp           = { rs_fourcc('G','P','I','O'), 1, 1, {  { false,               &unpack_input_reports_data,                  { { { RS2_STREAM_GPIO, 1 },      RS2_FORMAT_GPIO_RAW },
                                                                                                                                                      { { RS2_STREAM_GPIO, 2 },      RS2_FORMAT_GPIO_RAW },
@@ -0,0 +1,56 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2019 Intel Corporation. All Rights Reserved.
+
+#include "latency-histogram.h"
+
+namespace librealsense
+{
+    void latency_histogram::record(std::chrono::microseconds latency)
+    {
+        size_t bucket = 0;
+        for (auto us = latency.count(); us > 0 && bucket < buckets - 1; us >>= 1)
+            bucket++;
+        _counts[bucket].fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void latency_histogram::reset()
+    {
+        for (auto&& count : _counts)
+            count.store(0, std::memory_order_relaxed);
+    }
+
+    std::array<uint64_t, latency_histogram::buckets> latency_histogram::get_counts() const
+    {
+        std::array<uint64_t, buckets> counts;
+        for (size_t i = 0; i < buckets; i++)
+            counts[i] = _counts[i].load(std::memory_order_relaxed);
+        return counts;
+    }
+
+    uint64_t latency_histogram::get_count() const
+    {
+        uint64_t total = 0;
+        for (auto count : get_counts())
+            total += count;
+        return total;
+    }
+
+    std::chrono::microseconds latency_histogram::get_percentile(double fraction) const
+    {
+        auto counts = get_counts();
+        uint64_t total = 0;
+        for (auto count : counts)
+            total += count;
+        if (!total)
+            return std::chrono::microseconds(0);
+
+        uint64_t accumulated = 0;
+        for (size_t i = 0; i < buckets; i++)
+        {
+            accumulated += counts[i];
+            if (accumulated >= fraction * total)
+                return std::chrono::microseconds(1LL << i);
+        }
+        return std::chrono::microseconds(1LL << (buckets - 1));
+    }
+}
@@ -0,0 +1,35 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2019 Intel Corporation. All Rights Reserved.
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+namespace librealsense
+{
+    // Distribution of durations, e.g. the delay between the driver timestamping a frame and the frame being handled.
+    // Bucket 0 counts durations under 1us, bucket N counts [2^(N-1), 2^N) microseconds.
+    // Recording and reading may happen concurrently
+    class latency_histogram
+    {
+    public:
+        static const size_t buckets = 24;
+
+        latency_histogram() { reset(); }
+
+        void record(std::chrono::microseconds latency);
+        void reset();
+
+        std::array<uint64_t, buckets> get_counts() const;
+        uint64_t get_count() const;
+
+        // Upper bound of the bucket holding the given fraction (0..1] of the samples
+        std::chrono::microseconds get_percentile(double fraction) const;
+
+    private:
+        std::array<std::atomic<uint64_t>, buckets> _counts;
+    };
+}
@@ -21,8 +21,10 @@ const uint8_t HID_METADATA_SIZE = 8;     // bytes
 const size_t HID_DATA_ACTUAL_SIZE = 6;  // bytes
 
 const std::string IIO_DEVICE_PREFIX("iio:device");
-const std::string IIO_ROOT_PATH("/sys/bus/iio/devices");
-const std::string HID_CUSTOM_PATH("/sys/bus/platform/drivers/hid_sensor_custom");
+// Relative to the sysfs root
+const std::string IIO_ROOT_PATH("/bus/iio/devices");
+const std::string HID_CUSTOM_PATH("/bus/platform/drivers/hid_sensor_custom");
+const std::string HID_CUSTOM_SENSOR_PREFIX("HID-SENSOR-2000e1");
 
 namespace librealsense
 {
@@ -433,6 +435,7 @@ namespace librealsense
               _sensor_name(""),
               _sampling_frequency_name(""),
               _callback(nullptr),
+              _batch_callback(nullptr),
               _is_capturing(false),
               _pm_dispatcher(16)    // queue for async power management commands
         {
@@ -458,7 +461,7 @@ namespace librealsense
         }
 
         // start capturing and polling.
-        void iio_hid_sensor::start_capture(hid_callback sensor_callback)
+        void iio_hid_sensor::start_capture(hid_callback sensor_callback, hid_batch_callback batch_callback)
         {
             if (_is_capturing)
                 return;
@@ -506,12 +509,16 @@ namespace librealsense
             }
 
             _callback = sensor_callback;
+            _batch_callback = batch_callback;
             _is_capturing = true;
             _hid_thread = std::unique_ptr<std::thread>(new std::thread([this](){
                 const uint32_t channel_size = get_channel_size();
                 size_t raw_data_size = channel_size*hid_buf_len;
 
                 std::vector<uint8_t> raw_data(raw_data_size);
+                std::vector<frame_object> samples(hid_buf_len);
+                std::vector<metadata_hid_raw> samples_metadata(hid_buf_len);
+                const hid_sensor sensor{ get_sensor_name() };
                 auto metadata = has_metadata();
 
                 do {
@@ -552,17 +559,18 @@ namespace librealsense
                             continue;
                         }
 
-                        // TODO: code refactoring to reduce latency
-                        for (auto i = 0; i < read_size / channel_size; ++i)
+                        // All the samples of a single read share the backend time, and are handed over
+                        // in one call when a batch callback was provided
+                        auto now_ts = std::chrono::duration<double, std::milli>(std::chrono::system_clock::now().time_since_epoch()).count();
+                        auto samples_count = static_cast<size_t>(read_size / channel_size);
+                        for (size_t i = 0; i < samples_count; ++i)
                         {
-                            auto now_ts = std::chrono::duration<double, std::milli>(std::chrono::system_clock::now().time_since_epoch()).count();
                             auto p_raw_data = raw_data.data() + channel_size * i;
-                            sensor_data sens_data{};
-                            sens_data.sensor = hid_sensor{get_sensor_name()};
 
                             auto hid_data_size = channel_size - HID_METADATA_SIZE;
                             // Populate HID IMU data - Header
-                            metadata_hid_raw meta_data{};
+                            metadata_hid_raw& meta_data = samples_metadata[i];
+                            meta_data = {};
                             meta_data.header.report_type = md_hid_report_type::hid_report_imu;
                             meta_data.header.length = hid_header_size + metadata_imu_report_size;
                             meta_data.header.timestamp = *(reinterpret_cast<uint64_t *>(&p_raw_data[16]));
@@ -576,22 +584,20 @@ namespace librealsense
 //                            meta_data.report_type.imu_report.imu_counter = p_raw_data[30];
 //                            meta_data.report_type.imu_report.usb_counter = p_raw_data[31];
 
-                            sens_data.fo = {hid_data_size, metadata? meta_data.header.length: uint8_t(0),
-                                            p_raw_data,  metadata? &meta_data : nullptr, now_ts};
+                            samples[i] = {hid_data_size, metadata? meta_data.header.length: uint8_t(0),
+                                          p_raw_data,  metadata? &meta_data : nullptr, now_ts};
                             //Linux HID provides timestamps in nanosec. Convert to usec (FW default)
                             if (metadata)
                             {
-                                //auto* ts_nsec = reinterpret_cast<uint64_t*>(const_cast<void*>(sens_data.fo.metadata));
-                                //*ts_nsec /=1000;
                                 meta_data.header.timestamp /=1000;
                             }
 
-//                            for (auto i=0ul; i<channel_size; i++)
-//                                std::cout << std::hex << int(p_raw_data[i]) << " ";
-//                            std::cout << std::dec << std::endl;
-
-                            this->_callback(sens_data);
+                            if (!this->_batch_callback)
+                                this->_callback(sensor_data{ sensor, samples[i] });
                         }
+
+                        if (this->_batch_callback && samples_count)
+                            this->_batch_callback(sensor_data_batch{ sensor, samples.data(), samples_count });
                     }
                     else
                     {
@@ -611,6 +617,7 @@ namespace librealsense
             signal_stop();
             _hid_thread->join();
             _callback = nullptr;
+            _batch_callback = nullptr;
             _channels.clear();
 
             if(::close(_fd) < 0)
@@ -1003,6 +1010,20 @@ namespace librealsense
         }
 
         void v4l_hid_device::start_capture(hid_callback callback)
+        {
+            start_capture(callback, nullptr);
+        }
+
+        void v4l_hid_device::start_batch_capture(hid_batch_callback callback)
+        {
+            // Custom sensors report their samples one by one
+            start_capture([callback](const sensor_data& data)
+            {
+                callback({ data.sensor, &data.fo, 1 });
+            }, callback);
+        }
+
+        void v4l_hid_device::start_capture(hid_callback callback, hid_batch_callback batch_callback)
         {
             for (auto& profile : _hid_profiles)
             {
@@ -1032,7 +1053,7 @@ namespace librealsense
                 try{
                 for (auto& elem : _streaming_iio_sensors)
                 {
-                    elem->start_capture(callback);
+                    elem->start_capture(callback, batch_callback);
                     captured_sensors.push_back(elem);
                 }
                 }
@@ -1101,19 +1122,20 @@ namespace librealsense
             throw linux_backend_exception(to_string() << " custom sensor " << custom_sensor_name << " not found!");
         }
 
-        void v4l_hid_device::foreach_hid_device(std::function<void(const hid_device_info&)> action)
+        void v4l_hid_device::foreach_hid_device(std::function<void(const hid_device_info&)> action, const std::string& sysfs_root)
         {
             // Common HID Sensors
             DIR* dir = nullptr;
             struct dirent* ent = nullptr;
             std::vector<std::string> common_sensors;
-            if ((dir = opendir(IIO_ROOT_PATH.c_str())) != NULL)
+            const std::string iio_root_path = sysfs_root + IIO_ROOT_PATH;
+            if ((dir = opendir(iio_root_path.c_str())) != NULL)
             {
               while ((ent = readdir(dir)) != NULL)
               {
                   auto str = std::string(ent->d_name);
                   if (str.find(IIO_DEVICE_PREFIX) != std::string::npos)
-                      common_sensors.push_back(IIO_ROOT_PATH + "/" + str);
+                      common_sensors.push_back(iio_root_path + "/" + str);
               }
               closedir(dir);
             }
@@ -1145,17 +1167,17 @@ namespace librealsense
 
 
             // Custom HID Sensors
-            static const char* prefix_custom_sensor_name = "HID-SENSOR-2000e1";
             std::vector<std::string> custom_sensors;
             dir = nullptr;
             ent = nullptr;
-            if ((dir = opendir(HID_CUSTOM_PATH.c_str())) != NULL)
+            const std::string hid_custom_path = sysfs_root + HID_CUSTOM_PATH;
+            if ((dir = opendir(hid_custom_path.c_str())) != NULL)
             {
               while ((ent = readdir(dir)) != NULL)
               {
                   auto str = std::string(ent->d_name);
-                  if (str.find(prefix_custom_sensor_name) != std::string::npos)
-                      custom_sensors.push_back(HID_CUSTOM_PATH + "/" + str);
+                  if (str.find(HID_CUSTOM_SENSOR_PREFIX) != std::string::npos)
+                      custom_sensors.push_back(hid_custom_path + "/" + str);
               }
               closedir(dir);
             }
@@ -1175,6 +1197,21 @@ namespace librealsense
             }
         }
 
+        bool v4l_hid_device::query_hid_device(const std::string& sysfs_path, hid_device_info& device_info)
+        {
+            auto name = sysfs_path.substr(sysfs_path.find_last_of('/') + 1);
+            auto is_custom = name.find(HID_CUSTOM_SENSOR_PREFIX) != std::string::npos;
+            if (!is_custom && name.find(IIO_DEVICE_PREFIX) == std::string::npos)
+                return false;
+
+            if (!get_hid_device_info(sysfs_path.c_str(), device_info))
+                return false;
+
+            if (is_custom)
+                device_info.id = custom_id;
+            return true;
+        }
+
         bool v4l_hid_device::get_hid_device_info(const char* dev_path, hid_device_info& device_info)
         {
             char device_path[PATH_MAX] = {};
@@ -136,8 +136,9 @@ namespace librealsense
 
             ~iio_hid_sensor();
 
-            // start capturing and polling.
-            void start_capture(hid_callback sensor_callback);
+            // start capturing and polling. When batch_callback is set, it receives all the samples of
+            // each read at once instead of calling sensor_callback per sample.
+            void start_capture(hid_callback sensor_callback, hid_batch_callback batch_callback = nullptr);
 
             void stop_capture();
 
@@ -180,6 +181,7 @@ namespace librealsense
             std::list<hid_input*> _inputs;
             std::list<hid_input*> _channels;
             hid_callback _callback;
+            hid_batch_callback _batch_callback;
             std::atomic<bool> _is_capturing;
             std::unique_ptr<std::thread> _hid_thread;
             std::unique_ptr<std::thread> _pm_thread;    // Delayed initialization due to power-up sequence
@@ -203,17 +205,24 @@ namespace librealsense
 
             void start_capture(hid_callback callback);
 
+            void start_batch_capture(hid_batch_callback callback) override;
+
             void stop_capture();
 
             std::vector<uint8_t> get_custom_report_data(const std::string& custom_sensor_name,
                                                         const std::string& report_name,
                                                         custom_sensor_report_field report_field);
 
-            static void foreach_hid_device(std::function<void(const hid_device_info&)> action);
+            static void foreach_hid_device(std::function<void(const hid_device_info&)> action, const std::string& sysfs_root = "/sys");
+
+            // Reads a single common (iio) or custom HID sensor from its sysfs directory
+            static bool query_hid_device(const std::string& sysfs_path, hid_device_info& device_info);
 
         private:
             static bool get_hid_device_info(const char* dev_path, hid_device_info& device_info);
 
+            void start_capture(hid_callback callback, hid_batch_callback batch_callback);
+
             std::vector<hid_profile> _hid_profiles;
             std::vector<hid_device_info> _hid_device_infos;
             std::vector<std::unique_ptr<iio_hid_sensor>> _iio_hid_sensors;
@@ -3,6 +3,7 @@
 
 #include "backend-v4l2.h"
 #include "backend-hid.h"
+#include "netlink-device-watcher.h"
 #include "backend.h"
 #include "types.h"
 #include "usb/usb-enumerator.h"
@@ -34,6 +35,7 @@
 #include <sys/stat.h>
 #include <sys/mman.h>
 #include <sys/ioctl.h>
+#include <poll.h>
 #include <sys/sysmacros.h> // minor(...), major(...)
 #include <linux/usb/video.h>
 #include <linux/uvcvideo.h>
@@ -216,6 +218,16 @@ namespace librealsense
             }
         }
 
+        buffer::buffer(v4l2_buf_type type, uint32_t length, uint32_t index)
+            : _type(type), _original_length(length), _use_memory_map(false), _index(index), _buf{}
+        {
+            uint8_t md_extra = (V4L2_BUF_TYPE_VIDEO_CAPTURE==type) ? MAX_META_DATA_SIZE : 0;
+            _length = _original_length + md_extra;
+            _start = static_cast<uint8_t*>(malloc(_length));
+            if (!_start) throw linux_backend_exception("User_p allocation failed!");
+            memset(_start, 0, _length);
+        }
+
         void buffer::prepare_for_streaming(int fd)
         {
             v4l2_buffer buf = {};
@@ -236,7 +248,7 @@ namespace librealsense
         {
             if (_use_memory_map)
             {
-               if(munmap(_start, _length) < 0)
+               if(munmap(_start, _original_length) < 0)
                    linux_backend_exception("munmap");
             }
             else
@@ -258,6 +270,12 @@ namespace librealsense
             _must_enqueue = false;
         }
 
+        bool buffer::is_held() const
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            return _must_enqueue;
+        }
+
         void buffer::request_next_frame(int fd)
         {
             std::lock_guard<std::mutex> lock(_mutex);
@@ -312,6 +330,38 @@ namespace librealsense
             };
         }
 
+        void publish_buffer(const std::vector<std::shared_ptr<buffer>>& pool, buffer& buf, const v4l2_buffer& v4l_buf,
+                            const stream_profile& profile, frame_object fo, const frame_callback& callback,
+                            std::function<void()> requeue)
+        {
+            auto held = std::count_if(pool.begin(), pool.end(),
+                [](const std::shared_ptr<buffer>& b) { return b->is_held(); });
+            auto starved = (held + 1 >= static_cast<long>(pool.size()));
+
+            buf.attach_buffer(v4l_buf);
+
+            if (starved)
+            {
+                auto payload = std::make_shared<std::vector<uint8_t>>(buf.get_frame_start(),
+                    buf.get_frame_start() + buf.get_length_frame_only());
+                fo.pixels = payload->data();
+
+                // Metadata is consumed within the callback, the copy lives as long as the frame
+                callback(profile, fo, [payload]() {});
+                requeue();
+            }
+            else
+            {
+                callback(profile, fo, requeue);
+            }
+        }
+
+        bool zero_copy_requested()
+        {
+            auto zero_copy_var = getenv("LRS_V4L_ZERO_COPY");
+            return zero_copy_var && atoi(zero_copy_var) > 0;
+        }
+
         static std::tuple<std::string,uint16_t>  get_usb_descriptors(libusb_device* usb_device)
         {
             auto usb_bus = std::to_string(libusb_get_bus_number(usb_device));
@@ -407,13 +457,16 @@ namespace librealsense
 
         void v4l_uvc_device::foreach_uvc_device(
                 std::function<void(const uvc_device_info&,
-                                   const std::string&)> action)
+                                   const std::string&)> action,
+                const std::string& sysfs_root,
+                const std::string& device_path)
         {
             // Enumerate all subdevices present on the system
-            DIR * dir = opendir("/sys/class/video4linux");
+            const std::string class_path = sysfs_root + "/class/video4linux/";
+            DIR * dir = opendir(class_path.c_str());
             if(!dir)
             {
-                LOG_INFO("Cannot access /sys/class/video4linux");
+                LOG_INFO("Cannot access " << class_path);
                 return;
             }
 
@@ -427,7 +480,7 @@ namespace librealsense
                 if(name == "." || name == "..") continue;
 
                 // Resolve a pathname to ignore virtual video devices
-                std::string path = "/sys/class/video4linux/" + name;
+                std::string path = class_path + name;
                 std::string real_path{};
                 char buff[PATH_MAX] = {0};
                 if (realpath(path.c_str(), buff) != nullptr)
@@ -437,6 +490,10 @@ namespace librealsense
                         continue;
                 }
 
+                // Skip the nodes of other devices before opening anything
+                if (!device_path.empty() && !is_sysfs_subpath(real_path, device_path))
+                    continue;
+
                 try
                 {
                     uint16_t vid, pid, mi;
@@ -453,7 +510,7 @@ namespace librealsense
                         throw linux_backend_exception(dev_name + " is no device");
 
                     // Search directory and up to three parent directories to find busnum/devnum
-                    std::ostringstream ss; ss << "/sys/dev/char/" << major(st.st_rdev) << ":" << minor(st.st_rdev) << "/device/";
+                    std::ostringstream ss; ss << sysfs_root << "/dev/char/" << major(st.st_rdev) << ":" << minor(st.st_rdev) << "/device/";
                     auto path = ss.str();
                     auto valid_path = false;
                     for(auto i=0U; i < MAX_DEV_PARENT_DIR; ++i)
@@ -482,7 +539,7 @@ namespace librealsense
                     }
 
                     std::string modalias;
-                    if(!(std::ifstream("/sys/class/video4linux/" + name + "/device/modalias") >> modalias))
+                    if(!(std::ifstream(class_path + name + "/device/modalias") >> modalias))
                         throw linux_backend_exception("Failed to read modalias");
                     if(modalias.size() < 14 || modalias.substr(0,5) != "usb:v" || modalias[9] != 'p')
                         throw linux_backend_exception("Not a usb format modalias");
@@ -490,7 +547,7 @@ namespace librealsense
                         throw linux_backend_exception("Failed to read vendor ID");
                     if(!(std::istringstream(modalias.substr(10,4)) >> std::hex >> pid))
                         throw linux_backend_exception("Failed to read product ID");
-                    if(!(std::ifstream("/sys/class/video4linux/" + name + "/device/bInterfaceNumber") >> std::hex >> mi))
+                    if(!(std::ifstream(class_path + name + "/device/bInterfaceNumber") >> std::hex >> mi))
                         throw linux_backend_exception("Failed to read interface number");
 
                     // Find the USB specification (USB2/3) type from the underlying device
@@ -588,6 +645,7 @@ namespace librealsense
               _thread(nullptr),
               _named_mtx(nullptr),
               _use_memory_map(use_memory_map),
+              _reactor(epoll_reactor::get_shared()),
               _fd(-1),
               _stop_pipe_fd{}
         {
@@ -610,6 +668,7 @@ namespace librealsense
         v4l_uvc_device::~v4l_uvc_device()
         {
             _is_capturing = false;
+            if (_reactor && _reactor_source >= 0) _reactor->remove(_reactor_source);
             if (_thread && _thread->joinable()) _thread->join();
             for (auto&& fd : _fds)
             {
@@ -708,7 +767,20 @@ namespace librealsense
                 streamon();
 
                 _is_capturing = true;
-                _thread = std::unique_ptr<std::thread>(new std::thread([this](){ capture_loop(); }));
+                _latency.reset();
+                if (_reactor)
+                {
+                    // The reactor stops watching the device on its own, the stop pipe is not needed
+                    _capture_fds.clear();
+                    for (auto fd : _fds)
+                        if (fd != _stop_pipe_fd[0] && fd != _stop_pipe_fd[1])
+                            _capture_fds.push_back(fd);
+
+                    _reactor_source = _reactor->add(_capture_fds, [this]() { return service_ready_descriptors(); },
+                                                    std::chrono::milliseconds(5000), [this]() { notify_frames_timeout(); });
+                }
+                else
+                    _thread = std::unique_ptr<std::thread>(new std::thread([this](){ capture_loop(); }));
             }
         }
 
@@ -722,11 +794,23 @@ namespace librealsense
             _is_capturing = false;
             _is_started = false;
 
-            // Stop nn-demand frames polling
-            signal_stop();
+            if (_reactor)
+            {
+                _reactor->remove(_reactor_source);
+                _reactor_source = -1;
+            }
+            else
+            {
+                // Stop nn-demand frames polling
+                signal_stop();
+
+                _thread->join();
+                _thread.reset();
+            }
 
-            _thread->join();
-            _thread.reset();
+            if (_latency.get_count())
+                LOG_DEBUG(_name << " frame latency p50 " << _latency.get_percentile(0.5).count()
+                          << "us p99 " << _latency.get_percentile(0.99).count() << "us over " << _latency.get_count() << " frames");
 
             // Notify kernel
             streamoff();
@@ -779,36 +863,31 @@ namespace librealsense
             }
         }
 
-        void v4l_uvc_device::poll()
+        int v4l_uvc_device::wait_for_descriptors(const std::vector<int>& fds, int timeout_ms, ready_fds& ready) const
         {
-             fd_set fds{};
-             FD_ZERO(&fds);
-             for (auto fd : _fds)
-             {
-                 FD_SET(fd, &fds);
-             }
-
-            struct timespec mono_time;
-            int ret = clock_gettime(CLOCK_MONOTONIC, &mono_time);
-            if (ret) throw linux_backend_exception("could not query time!");
+            // poll(2) is not bound by FD_SETSIZE, unlike select(2)
+            std::vector<pollfd> poll_fds;
+            for (auto fd : fds)
+                poll_fds.push_back({ fd, POLLIN, 0 });
 
-            struct timeval expiration_time = { mono_time.tv_sec + 5, mono_time.tv_nsec / 1000 };
+            auto expiration_time = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeout_ms);
             int val = 0;
             do {
-                struct timeval remaining;
-                ret = clock_gettime(CLOCK_MONOTONIC, &mono_time);
-                if (ret) throw linux_backend_exception("could not query time!");
-
-                struct timeval current_time = { mono_time.tv_sec, mono_time.tv_nsec / 1000 };
-                timersub(&expiration_time, &current_time, &remaining);
-                if (timercmp(&current_time, &expiration_time, <)) {
-                    val = select(_max_fd + 1, &fds, nullptr, nullptr, &remaining);
-                }
-                else {
-                    val = 0;
-                }
+                auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(expiration_time - std::chrono::steady_clock::now());
+                val = ::poll(poll_fds.data(), poll_fds.size(), std::max(0, static_cast<int>(remaining.count())));
             } while (val < 0 && errno == EINTR);
 
+            for (auto&& p : poll_fds)
+                if (p.revents & (POLLIN | POLLERR | POLLHUP))
+                    ready.set(p.fd);
+            return val;
+        }
+
+        void v4l_uvc_device::poll()
+        {
+            ready_fds fds;
+            auto val = wait_for_descriptors(_fds, 5000, fds);
+
             if(val < 0)
             {
                 stop_data_capture();
@@ -817,7 +896,7 @@ namespace librealsense
             {
                 if(val > 0)
                 {
-                    if(FD_ISSET(_stop_pipe_fd[0], &fds) || FD_ISSET(_stop_pipe_fd[1], &fds))
+                    if(fds.is_set(_stop_pipe_fd[0]) || fds.is_set(_stop_pipe_fd[1]))
                     {
                         if(!_is_capturing)
                         {
@@ -832,93 +911,134 @@ namespace librealsense
                     }
                     else // Check and acquire data buffers from kernel
                     {
-                        buffers_mgr buf_mgr(_use_memory_map);
-                        // Read metadata from a node
-                        acquire_metadata(buf_mgr,fds);
-
-                        if(FD_ISSET(_fd, &fds))
-                        {
-                            FD_CLR(_fd,&fds);
-                            v4l2_buffer buf = {};
-                            buf.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
-                            buf.memory = _use_memory_map ? V4L2_MEMORY_MMAP : V4L2_MEMORY_USERPTR;
-                            if(xioctl(_fd, VIDIOC_DQBUF, &buf) < 0)
-                            {
-                                LOG_DEBUG("Dequeued empty buf for fd " << _fd);
-                                if(errno == EAGAIN)
-                                    return;
+                        handle_ready_descriptors(fds, val);
+                    }
+                }
+                else // (val==0)
+                {
+                    notify_frames_timeout();
+                }
+            }
+        }
 
-                                throw linux_backend_exception(to_string() << "xioctl(VIDIOC_DQBUF) failed for fd: " << _fd);
-                            }
-                            //LOG_DEBUG("Dequeued buf " << buf.index << " for fd " << _fd);
+        void v4l_uvc_device::notify_frames_timeout()
+        {
+            LOG_WARNING("Frames didn't arrived within 5 seconds");
+            librealsense::notification n = {RS2_NOTIFICATION_CATEGORY_FRAMES_TIMEOUT, 0, RS2_LOG_SEVERITY_WARN,  "Frames didn't arrived within 5 seconds"};
 
-                            auto buffer = _buffers[buf.index];
-                            buf_mgr.handle_buffer(e_video_buf,_fd, buf,buffer);
+            _error_handler(n);
+        }
 
-                            if (_is_started)
-                            {
-                                if(buf.bytesused == 0)
-                                {
-                                    LOG_INFO("Empty video frame arrived");
-                                    return;
-                                }
+        bool v4l_uvc_device::service_ready_descriptors()
+        {
+            try
+            {
+                // The reactor reports a single descriptor, the video and metadata nodes are serviced together
+                ready_fds fds;
+                auto val = wait_for_descriptors(_capture_fds, 0, fds);
+                if (val < 0)
+                    throw linux_backend_exception("poll() failed for capture descriptors");
+                if (val > 0)
+                    handle_ready_descriptors(fds, val);
+                return true;
+            }
+            catch (const std::exception& ex)
+            {
+                LOG_ERROR(ex.what());
 
-                                if(_profile.format != 1296715847 && // allow JPEG frames size to be smaller than the uncompressed frame
-                                        (buf.bytesused < buffer->get_full_length() - MAX_META_DATA_SIZE))
-                                {
-                                    auto percentage = (100 * buf.bytesused) / buffer->get_full_length();
-                                    std::stringstream s;
-                                    s << "Incomplete video frame detected!\nSize " << buf.bytesused
-                                      << " out of " << buffer->get_full_length() << " bytes (" << percentage << "%)";
-                                    librealsense::notification n = { RS2_NOTIFICATION_CATEGORY_FRAME_CORRUPTED, 0, RS2_LOG_SEVERITY_WARN, s.str()};
+                librealsense::notification n = {RS2_NOTIFICATION_CATEGORY_UNKNOWN_ERROR, 0, RS2_LOG_SEVERITY_ERROR, ex.what()};
 
-                                    _error_handler(n);
-                                }
-                                else
-                                {
-                                    auto timestamp = (double)buf.timestamp.tv_sec*1000.f + (double)buf.timestamp.tv_usec/1000.f;
-                                    timestamp = monotonic_to_realtime(timestamp);
+                _error_handler(n);
+                return false;
+            }
+        }
 
-                                    // read metadata from the frame appendix
-                                    acquire_metadata(buf_mgr,fds);
+        void v4l_uvc_device::handle_ready_descriptors(ready_fds& fds, int ready_count)
+        {
+            buffers_mgr buf_mgr(_use_memory_map);
+            // Read metadata from a node
+            acquire_metadata(buf_mgr,fds);
 
-                                    if (val > 1)
-                                        LOG_INFO("Frame buf ready, md size: " << std::dec << (int)buf_mgr.metadata_size() << " seq. id: " << buf.sequence);
-                                    frame_object fo{ buf.bytesused - MAX_META_DATA_SIZE, buf_mgr.metadata_size(),
-                                        buffer->get_frame_start(), buf_mgr.metadata_start(), timestamp };
+            if(fds.is_set(_fd))
+            {
+                fds.clear(_fd);
+                v4l2_buffer buf = {};
+                buf.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+                buf.memory = _use_memory_map ? V4L2_MEMORY_MMAP : V4L2_MEMORY_USERPTR;
+                if(xioctl(_fd, VIDIOC_DQBUF, &buf) < 0)
+                {
+                    LOG_DEBUG("Dequeued empty buf for fd " << _fd);
+                    if(errno == EAGAIN)
+                        return;
 
-                                     buffer->attach_buffer(buf);
-                                     buf_mgr.handle_buffer(e_video_buf,-1); // transfer new buffer request to the frame callback
+                    throw linux_backend_exception(to_string() << "xioctl(VIDIOC_DQBUF) failed for fd: " << _fd);
+                }
+                //LOG_DEBUG("Dequeued buf " << buf.index << " for fd " << _fd);
 
-                                     //Invoke user callback and enqueue next frame
-                                     _callback(_profile, fo,
-                                               [buf_mgr]() mutable {
-                                         buf_mgr.request_next_frame();
-                                     });
-                                }
-                            }
-                            else
-                            {
-                                LOG_INFO("Video frame arrived in idle mode."); // TODO - verification
-                            }
-                        }
-                        else
-                        {
-                            LOG_INFO("FD_ISSET returned false - video node is not signalled (md only)");
-                        }
-                    }
+                if (buf.flags & V4L2_BUF_FLAG_TIMESTAMP_MONOTONIC)
+                {
+                    struct timespec mono_time;
+                    if (!clock_gettime(CLOCK_MONOTONIC, &mono_time))
+                        _latency.record(std::chrono::microseconds((mono_time.tv_sec - buf.timestamp.tv_sec) * 1000000LL +
+                                                                  mono_time.tv_nsec / 1000 - buf.timestamp.tv_usec));
                 }
-                else // (val==0)
+
+                auto buffer = _buffers[buf.index];
+                buf_mgr.handle_buffer(e_video_buf,_fd, buf,buffer);
+
+                if (_is_started)
                 {
-                    LOG_WARNING("Frames didn't arrived within 5 seconds");
-                        librealsense::notification n = {RS2_NOTIFICATION_CATEGORY_FRAMES_TIMEOUT, 0, RS2_LOG_SEVERITY_WARN,  "Frames didn't arrived within 5 seconds"};
+                    if(buf.bytesused == 0)
+                    {
+                        LOG_INFO("Empty video frame arrived");
+                        return;
+                    }
+
+                    if(_profile.format != 1296715847 && // allow JPEG frames size to be smaller than the uncompressed frame
+                            (buf.bytesused < buffer->get_full_length() - MAX_META_DATA_SIZE))
+                    {
+                        auto percentage = (100 * buf.bytesused) / buffer->get_full_length();
+                        std::stringstream s;
+                        s << "Incomplete video frame detected!\nSize " << buf.bytesused
+                          << " out of " << buffer->get_full_length() << " bytes (" << percentage << "%)";
+                        librealsense::notification n = { RS2_NOTIFICATION_CATEGORY_FRAME_CORRUPTED, 0, RS2_LOG_SEVERITY_WARN, s.str()};
 
                         _error_handler(n);
+                    }
+                    else
+                    {
+                        auto timestamp = (double)buf.timestamp.tv_sec*1000.f + (double)buf.timestamp.tv_usec/1000.f;
+                        timestamp = monotonic_to_realtime(timestamp);
+
+                        // read metadata from the frame appendix
+                        acquire_metadata(buf_mgr,fds);
+
+                        if (ready_count > 1)
+                            LOG_INFO("Frame buf ready, md size: " << std::dec << (int)buf_mgr.metadata_size() << " seq. id: " << buf.sequence);
+                        frame_object fo{ buf.bytesused - MAX_META_DATA_SIZE, buf_mgr.metadata_size(),
+                            buffer->get_frame_start(), buf_mgr.metadata_start(), timestamp };
+
+                         buf_mgr.handle_buffer(e_video_buf,-1); // transfer new buffer request to the frame callback
+
+                         //Invoke user callback and enqueue next frame
+                         publish_buffer(_buffers, *buffer, buf, _profile, fo, _callback,
+                                        [buf_mgr]() mutable {
+                             buf_mgr.request_next_frame();
+                         });
+                    }
+                }
+                else
+                {
+                    LOG_INFO("Video frame arrived in idle mode."); // TODO - verification
                 }
             }
+            else
+            {
+                LOG_INFO("Video node is not signalled (md only)");
+            }
         }
 
-        void v4l_uvc_device::acquire_metadata(buffers_mgr & buf_mgr,fd_set &)
+        void v4l_uvc_device::acquire_metadata(buffers_mgr & buf_mgr,ready_fds &)
         {
             if (has_metadata())
                 buf_mgr.set_md_from_video_node();
@@ -1507,15 +1627,15 @@ namespace librealsense
         }
 
         // retrieve metadata from a dedicated UVC node
-        void v4l_uvc_meta_device::acquire_metadata(buffers_mgr & buf_mgr,fd_set &fds)
+        void v4l_uvc_meta_device::acquire_metadata(buffers_mgr & buf_mgr,ready_fds &fds)
         {
             // Metadata is calculated once per frame
             if (buf_mgr.metadata_size())
                 return;
 
-            if(FD_ISSET(_md_fd, &fds))
+            if(fds.is_set(_md_fd))
             {
-                FD_CLR(_md_fd,&fds);
+                fds.clear(_md_fd);
                 v4l2_buffer buf{};
                 buf.type = LOCAL_V4L2_BUF_TYPE_META_CAPTURE;
                 buf.memory = _use_memory_map ? V4L2_MEMORY_MMAP : V4L2_MEMORY_USERPTR;
@@ -1566,8 +1686,9 @@ namespace librealsense
 
         std::shared_ptr<uvc_device> v4l_backend::create_uvc_device(uvc_device_info info) const
         {
-            auto v4l_uvc_dev = (!info.has_metadata_node) ? std::make_shared<v4l_uvc_device>(info) :
-                                                           std::make_shared<v4l_uvc_meta_device>(info);
+            auto use_memory_map = zero_copy_requested();
+            auto v4l_uvc_dev = (!info.has_metadata_node) ? std::make_shared<v4l_uvc_device>(info, use_memory_map) :
+                                                           std::make_shared<v4l_uvc_meta_device>(info, use_memory_map);
 
             return std::make_shared<platform::retry_controls_work_around>(v4l_uvc_dev);
         }
@@ -1618,7 +1739,7 @@ namespace librealsense
 
         std::shared_ptr<device_watcher> v4l_backend::create_device_watcher() const
         {
-            return std::make_shared<polling_device_watcher>(this);
+            return std::make_shared<netlink_device_watcher>();
         }
 
         std::shared_ptr<backend> create_backend()
@@ -5,6 +5,7 @@
 
 #include "backend.h"
 #include "types.h"
+#include "epoll-reactor.h"
 
 #include <cassert>
 #include <cstdlib>
@@ -112,11 +113,21 @@ namespace librealsense
 
         static int xioctl(int fh, unsigned long request, void *arg);
 
+        // True when path is parent itself or a node below it in the sysfs tree
+        inline bool is_sysfs_subpath(const std::string& path, const std::string& parent)
+        {
+            return path.compare(0, parent.size(), parent) == 0 &&
+                   (path.size() == parent.size() || path[parent.size()] == '/');
+        }
+
         class buffer
         {
         public:
             buffer(int fd, v4l2_buf_type type, bool use_memory_map, uint32_t index);
 
+            // User pointer buffer of the given length, allocated without querying a device
+            buffer(v4l2_buf_type type, uint32_t length, uint32_t index);
+
             void prepare_for_streaming(int fd);
 
             ~buffer();
@@ -134,6 +145,9 @@ namespace librealsense
 
             bool use_memory_map() const { return _use_memory_map; }
 
+            // The buffer was handed to a frame and is not queued to the kernel until the frame releases it
+            bool is_held() const;
+
         private:
             v4l2_buf_type _type;
             uint8_t* _start;
@@ -142,10 +156,22 @@ namespace librealsense
             bool _use_memory_map;
             uint32_t _index;
             v4l2_buffer _buf;
-            std::mutex _mutex;
+            mutable std::mutex _mutex;
             bool _must_enqueue = false;
         };
 
+        // Descriptors found readable in a single capture iteration
+        class ready_fds
+        {
+        public:
+            void set(int fd) { _fds.push_back(fd); }
+            void clear(int fd) { _fds.erase(std::remove(_fds.begin(), _fds.end(), fd), _fds.end()); }
+            bool is_set(int fd) const { return std::find(_fds.begin(), _fds.end(), fd) != _fds.end(); }
+
+        private:
+            std::vector<int> _fds;
+        };
+
         enum supported_kernel_buf_types : uint8_t
         {
             e_video_buf,
@@ -220,6 +246,17 @@ namespace librealsense
             std::array<kernel_buf_guard, e_max_kernel_buf_type> buffers;
         };
 
+        // Invokes callback with the payload of buf, a dequeued buffer of the pool. The frame holds on to buf and calls requeue
+        // once released, unless no other buffer of the pool would remain queued to the driver: the payload is then copied out
+        // and requeue runs as soon as the callback returns, so held frames can never stall the stream
+        void publish_buffer(const std::vector<std::shared_ptr<buffer>>& pool, buffer& buf, const v4l2_buffer& v4l_buf,
+                            const stream_profile& profile, frame_object fo, const frame_callback& callback,
+                            std::function<void()> requeue);
+
+        // Capture into mmap'd kernel buffers, published to the frames without a copy, is opted in at runtime by setting
+        // LRS_V4L_ZERO_COPY to a positive value. Metadata appended to the video payload (kernels before 4.16) is then unavailable
+        bool zero_copy_requested();
+
         class v4l_uvc_interface
         {
             virtual void capture_loop() = 0;
@@ -236,15 +273,19 @@ namespace librealsense
             virtual void set_format(stream_profile profile) = 0;
             virtual void prepare_capture_buffers() = 0;
             virtual void stop_data_capture() = 0;
-            virtual void acquire_metadata(buffers_mgr & buf_mgr,fd_set &fds) = 0;
+            virtual void acquire_metadata(buffers_mgr & buf_mgr,ready_fds &fds) = 0;
         };
 
         class v4l_uvc_device : public uvc_device, public v4l_uvc_interface
         {
         public:
+            // Enumerates the UVC nodes listed under sysfs_root. When device_path is given, only the nodes
+            // of that sysfs device (e.g. a single USB device or interface) are opened and reported
             static void foreach_uvc_device(
                     std::function<void(const uvc_device_info&,
-                                       const std::string&)> action);
+                                       const std::string&)> action,
+                    const std::string& sysfs_root = "/sys",
+                    const std::string& device_path = "");
 
             v4l_uvc_device(const uvc_device_info& info, bool use_memory_map = false);
 
@@ -288,6 +329,12 @@ namespace librealsense
             std::string get_device_location() const override { return _device_path; }
             usb_spec get_usb_specification() const override { return _device_usb_spec; }
 
+            // Frames reference the mmap'd kernel buffers, which are queued back once released
+            bool supports_zero_copy() const override { return _use_memory_map; }
+
+            // Delay between the driver timestamping a frame and the frame being dequeued
+            const latency_histogram& get_latency_histogram() const { return _latency; }
+
         protected:
             static uint32_t get_cid(rs2_option option);
 
@@ -305,7 +352,15 @@ namespace librealsense
             virtual void set_format(stream_profile profile) override;
             virtual void prepare_capture_buffers() override;
             virtual void stop_data_capture() override;
-            virtual void acquire_metadata(buffers_mgr & buf_mgr,fd_set &fds) override;
+            virtual void acquire_metadata(buffers_mgr & buf_mgr,ready_fds &fds) override;
+
+            // Waits up to timeout_ms for any of the descriptors, returns the count of ready ones as poll(2) does
+            int wait_for_descriptors(const std::vector<int>& fds, int timeout_ms, ready_fds& ready) const;
+            // Dequeues and dispatches the buffers of the ready descriptors
+            void handle_ready_descriptors(ready_fds& fds, int ready_count);
+            // Services the device from the shared reactor thread, returns false once capture failed
+            bool service_ready_descriptors();
+            void notify_frames_timeout();
 
             power_state _state = D3;
             std::string _name = "";
@@ -324,6 +379,10 @@ namespace librealsense
             bool _use_memory_map;
             int _max_fd = 0;                    // specifies the maximal pipe number the polling process will monitor
             std::vector<int>  _fds;             // list the file descriptors to be monitored during frames polling
+            std::shared_ptr<epoll_reactor> _reactor;    // Shared capture threads, null when the device runs its own thread
+            int _reactor_source = -1;
+            std::vector<int> _capture_fds;      // _fds without the stop pipe, watched by the reactor
+            latency_histogram _latency;
 
         private:
             int _fd = 0;          // prevent unintentional abuse in derived class
@@ -349,7 +408,7 @@ namespace librealsense
             void unmap_device_descriptor();
             void set_format(stream_profile profile);
             void prepare_capture_buffers();
-            virtual void acquire_metadata(buffers_mgr & buf_mgr,fd_set &fds);
+            virtual void acquire_metadata(buffers_mgr & buf_mgr,ready_fds &fds);
 
             int _md_fd = -1;
             std::string _md_name = "";
@@ -0,0 +1,237 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2019 Intel Corporation. All Rights Reserved.
+
+#include "epoll-reactor.h"
+#include "types.h"
+
+#include <cstdlib>
+#include <sstream>
+
+#include <errno.h>
+#include <pthread.h>
+#include <sched.h>
+#include <unistd.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+
+const int EPOLL_MAX_EVENTS = 16;
+// Upper bound of the time between two checks of the sources timeouts
+const int TIMEOUTS_CHECK_INTERVAL_MS = 100;
+
+namespace librealsense
+{
+    namespace platform
+    {
+        epoll_reactor::epoll_reactor(size_t threads, const std::vector<int>& cpus)
+            : _running(true)
+        {
+            _epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+            if (_epoll_fd < 0)
+                throw linux_backend_exception("epoll_reactor: epoll_create1 failed");
+
+            // Stays readable once signalled, so that every thread wakes up on stop
+            _stop_fd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+            epoll_event event = {};
+            event.events = EPOLLIN;
+            event.data.u64 = 0;
+            if (_stop_fd < 0 || epoll_ctl(_epoll_fd, EPOLL_CTL_ADD, _stop_fd, &event) < 0)
+            {
+                ::close(_epoll_fd);
+                if (_stop_fd >= 0)
+                    ::close(_stop_fd);
+                throw linux_backend_exception("epoll_reactor: Cannot create the stop event");
+            }
+
+            _last_timeouts_check = std::chrono::steady_clock::now();
+            for (size_t i = 0; i < std::max<size_t>(threads, 1); i++)
+            {
+                _threads.emplace_back([this]() { run(); });
+
+                if (!cpus.empty())
+                {
+                    cpu_set_t cpu_set;
+                    CPU_ZERO(&cpu_set);
+                    CPU_SET(cpus[i % cpus.size()], &cpu_set);
+                    if (pthread_setaffinity_np(_threads.back().native_handle(), sizeof(cpu_set), &cpu_set))
+                        LOG_WARNING("epoll_reactor: Cannot pin thread " << i << " to cpu " << cpus[i % cpus.size()]);
+                }
+            }
+        }
+
+        epoll_reactor::~epoll_reactor()
+        {
+            _running = false;
+            uint64_t value = 1;
+            if (write(_stop_fd, &value, sizeof(value)) < 0)
+                LOG_ERROR("epoll_reactor: Could not signal the reactor threads to stop");
+            for (auto&& thread : _threads)
+                thread.join();
+
+            ::close(_stop_fd);
+            ::close(_epoll_fd);
+        }
+
+        std::shared_ptr<epoll_reactor> epoll_reactor::get_shared()
+        {
+            static std::mutex mutex;
+            static std::weak_ptr<epoll_reactor> shared;
+
+            std::lock_guard<std::mutex> lock(mutex);
+            if (auto reactor = shared.lock())
+                return reactor;
+
+            auto threads_var = getenv("LRS_V4L_REACTOR_THREADS");
+            auto threads = threads_var ? atoi(threads_var) : 0;
+            if (threads <= 0)
+                return nullptr;
+
+            std::vector<int> cpus;
+            if (auto cpus_var = getenv("LRS_V4L_REACTOR_CPUS"))
+            {
+                std::stringstream ss(cpus_var);
+                std::string cpu;
+                while (std::getline(ss, cpu, ','))
+                    if (!cpu.empty())
+                        cpus.push_back(atoi(cpu.c_str()));
+            }
+
+            auto reactor = std::make_shared<epoll_reactor>(threads, cpus);
+            shared = reactor;
+            LOG_INFO("V4L2 capture is multiplexed over " << threads << " epoll threads");
+            return reactor;
+        }
+
+        int epoll_reactor::add(const std::vector<int>& fds, ready_handler on_ready,
+                               std::chrono::milliseconds timeout, timeout_handler on_timeout)
+        {
+            auto src = std::make_shared<source>();
+            src->fds = fds;
+            src->on_ready = std::move(on_ready);
+            src->timeout = timeout;
+            src->on_timeout = std::move(on_timeout);
+            src->last_activity = std::chrono::steady_clock::now();
+
+            int id;
+            {
+                std::lock_guard<std::mutex> lock(_sources_mutex);
+                id = _next_id++;
+                _sources[id] = src;
+            }
+
+            for (auto fd : fds)
+            {
+                // One shot events keep a descriptor from being handed to two threads at once
+                epoll_event event = {};
+                event.events = EPOLLIN | EPOLLONESHOT;
+                event.data.u64 = (static_cast<uint64_t>(id) << 32) | static_cast<uint32_t>(fd);
+                if (epoll_ctl(_epoll_fd, EPOLL_CTL_ADD, fd, &event) < 0)
+                {
+                    remove(id);
+                    throw linux_backend_exception(to_string() << "epoll_reactor: Cannot watch fd " << fd);
+                }
+            }
+            return id;
+        }
+
+        void epoll_reactor::remove(int id)
+        {
+            std::shared_ptr<source> src;
+            {
+                std::lock_guard<std::mutex> lock(_sources_mutex);
+                auto it = _sources.find(id);
+                if (it == _sources.end())
+                    return;
+                src = it->second;
+                _sources.erase(it);
+            }
+
+            for (auto fd : src->fds)
+                epoll_ctl(_epoll_fd, EPOLL_CTL_DEL, fd, nullptr);
+
+            // Wait for a handler already running on another thread
+            std::lock_guard<std::mutex> lock(src->mutex);
+            src->active = false;
+        }
+
+        void epoll_reactor::run()
+        {
+            epoll_event events[EPOLL_MAX_EVENTS];
+            while (_running)
+            {
+                auto count = epoll_wait(_epoll_fd, events, EPOLL_MAX_EVENTS, TIMEOUTS_CHECK_INTERVAL_MS);
+                if (count < 0 && errno != EINTR)
+                {
+                    LOG_ERROR("epoll_reactor: epoll_wait failed, errno: " << errno);
+                    break;
+                }
+
+                for (auto i = 0; i < count && _running; i++)
+                {
+                    if (events[i].data.u64)
+                        handle(events[i].data.u64);
+                }
+
+                check_timeouts();
+            }
+        }
+
+        void epoll_reactor::handle(uint64_t key)
+        {
+            auto id = static_cast<int>(key >> 32);
+            auto fd = static_cast<int>(key & 0xffffffff);
+
+            std::shared_ptr<source> src;
+            {
+                std::lock_guard<std::mutex> lock(_sources_mutex);
+                auto it = _sources.find(id);
+                if (it == _sources.end())
+                    return;
+                src = it->second;
+            }
+
+            std::lock_guard<std::mutex> lock(src->mutex);
+            if (!src->active)
+                return;
+
+            src->last_activity = std::chrono::steady_clock::now();
+            if (!src->on_ready())
+            {
+                src->active = false;
+                return;
+            }
+
+            epoll_event event = {};
+            event.events = EPOLLIN | EPOLLONESHOT;
+            event.data.u64 = key;
+            epoll_ctl(_epoll_fd, EPOLL_CTL_MOD, fd, &event);
+        }
+
+        void epoll_reactor::check_timeouts()
+        {
+            std::vector<std::shared_ptr<source>> sources;
+            {
+                std::unique_lock<std::mutex> lock(_timeouts_mutex, std::try_to_lock);
+                auto now = std::chrono::steady_clock::now();
+                if (!lock || now - _last_timeouts_check < std::chrono::milliseconds(TIMEOUTS_CHECK_INTERVAL_MS))
+                    return;
+                _last_timeouts_check = now;
+
+                std::lock_guard<std::mutex> sources_lock(_sources_mutex);
+                for (auto&& src : _sources)
+                    if (src.second->on_timeout)
+                        sources.push_back(src.second);
+            }
+
+            for (auto&& src : sources)
+            {
+                std::lock_guard<std::mutex> lock(src->mutex);
+                auto now = std::chrono::steady_clock::now();
+                if (src->active && now - src->last_activity >= src->timeout)
+                {
+                    src->last_activity = now;
+                    src->on_timeout();
+                }
+            }
+        }
+    }
+}
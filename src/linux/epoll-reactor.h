@@ -0,0 +1,80 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2019 Intel Corporation. All Rights Reserved.
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "../latency-histogram.h"
+
+namespace librealsense
+{
+    namespace platform
+    {
+        using librealsense::latency_histogram;
+
+        // Multiplexes the file descriptors of many capture devices over a small pool of epoll threads.
+        // Each source is serviced by one thread at a time; different sources are serviced in parallel
+        class epoll_reactor
+        {
+        public:
+            // Services whatever is ready on the source, returns false to stop watching it
+            typedef std::function<bool()> ready_handler;
+            typedef std::function<void()> timeout_handler;
+
+            // Threads are pinned round robin to the given cpus, an empty list leaves them unpinned
+            explicit epoll_reactor(size_t threads, const std::vector<int>& cpus = {});
+            ~epoll_reactor();
+
+            // The reactor shared by all V4L2 devices when LRS_V4L_REACTOR_THREADS is set to a positive count,
+            // optionally pinned with LRS_V4L_REACTOR_CPUS (e.g. "2,3"). Null when every device runs its own thread
+            static std::shared_ptr<epoll_reactor> get_shared();
+
+            // Starts watching fds for input. on_timeout is invoked whenever no input arrived for timeout
+            int add(const std::vector<int>& fds, ready_handler on_ready,
+                    std::chrono::milliseconds timeout = std::chrono::milliseconds(0), timeout_handler on_timeout = nullptr);
+
+            // Stops watching the source, waiting for a running handler to return. Must not be called from a handler
+            void remove(int id);
+
+            size_t get_threads_count() const { return _threads.size(); }
+
+        private:
+            struct source
+            {
+                std::vector<int> fds;
+                ready_handler on_ready;
+                std::chrono::milliseconds timeout;
+                timeout_handler on_timeout;
+
+                std::mutex mutex;   // Serializes the handlers of the source
+                bool active = true;
+                std::chrono::steady_clock::time_point last_activity;
+            };
+
+            void run();
+            void handle(uint64_t key);
+            void check_timeouts();
+
+            int _epoll_fd = -1;
+            int _stop_fd = -1;
+            std::atomic<bool> _running;
+            std::vector<std::thread> _threads;
+
+            std::mutex _sources_mutex;
+            std::map<int, std::shared_ptr<source>> _sources;
+            int _next_id = 1;
+
+            std::mutex _timeouts_mutex;
+            std::chrono::steady_clock::time_point _last_timeouts_check;
+        };
+    }
+}
@@ -0,0 +1,391 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2019 Intel Corporation. All Rights Reserved.
+
+#include "netlink-device-watcher.h"
+#include "backend-v4l2.h"
+#include "backend-hid.h"
+#include "usb/usb-enumerator.h"
+
+#include <algorithm>
+#include <numeric>
+#include <cstring>
+
+#include <dirent.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <sys/select.h>
+#include <sys/socket.h>
+#include <linux/netlink.h>
+
+const size_t UEVENT_BUFFER_SIZE = 8192;
+const int UEVENT_KERNEL_GROUP = 1;
+// Used only when the uevent socket cannot be opened
+const int FALLBACK_POLLING_INTERVAL_MS = 5000;
+// Queries of a UVC interface, one per quiet period, before giving up on its inaccessible nodes
+const int MAX_UVC_QUERY_ATTEMPTS = 5;
+
+namespace librealsense
+{
+    namespace platform
+    {
+        template<class T>
+        static size_t erase_devices_under(std::vector<T>& devices, const std::string& path)
+        {
+            auto it = std::remove_if(devices.begin(), devices.end(),
+                [&path](const T& info) { return is_sysfs_subpath(info.device_path, path); });
+            auto count = std::distance(it, devices.end());
+            devices.erase(it, devices.end());
+            return count;
+        }
+
+        // Number of video4linux nodes the kernel registered for a USB interface
+        static size_t count_uvc_nodes(const std::string& interface_path)
+        {
+            size_t count = 0;
+            if (DIR* dir = opendir((interface_path + "/video4linux").c_str()))
+            {
+                while (dirent* entry = readdir(dir))
+                {
+                    std::string name = entry->d_name;
+                    if (name != "." && name != "..")
+                        count++;
+                }
+                closedir(dir);
+            }
+            return count;
+        }
+
+        netlink_device_watcher::netlink_device_watcher(const std::string& sysfs_root, std::chrono::milliseconds quiet_period)
+            : _sysfs_root(sysfs_root), _quiet_period(quiet_period), _running(false)
+        {
+            // Device paths are reported after symlink resolution, resolve the root the same way
+            char buff[PATH_MAX] = {};
+            if (realpath(sysfs_root.c_str(), buff) != nullptr)
+                _sysfs_root = buff;
+        }
+
+        netlink_device_watcher::~netlink_device_watcher()
+        {
+            stop();
+        }
+
+        backend_device_group netlink_device_watcher::query_devices() const
+        {
+            backend_device_group group;
+            v4l_uvc_device::foreach_uvc_device([&group](const uvc_device_info& i, const std::string&)
+            {
+                group.uvc_devices.push_back(i);
+            }, _sysfs_root);
+            group.usb_devices = usb_enumerator::query_devices_info();
+            v4l_hid_device::foreach_hid_device([&group](const hid_device_info& i)
+            {
+                group.hid_devices.push_back(i);
+            }, _sysfs_root);
+            return group;
+        }
+
+        void netlink_device_watcher::start(device_changed_callback callback)
+        {
+            stop();
+            _callback = std::move(callback);
+
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                _devices_data = query_devices();
+                _reported_data = _devices_data;
+                _pending = false;
+            }
+
+            _socket_fd = socket(AF_NETLINK, SOCK_DGRAM | SOCK_CLOEXEC, NETLINK_KOBJECT_UEVENT);
+            if (_socket_fd >= 0)
+            {
+                sockaddr_nl addr = {};
+                addr.nl_family = AF_NETLINK;
+                addr.nl_groups = UEVENT_KERNEL_GROUP;
+                if (bind(_socket_fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0)
+                {
+                    ::close(_socket_fd);
+                    _socket_fd = -1;
+                }
+            }
+            if (_socket_fd < 0)
+                LOG_WARNING("Cannot listen to kernel uevents, errno: " << errno << ", falling back to device polling");
+
+            if (pipe(_wake_pipe_fd) < 0)
+            {
+                if (_socket_fd >= 0)
+                    ::close(_socket_fd);
+                _socket_fd = -1;
+                throw linux_backend_exception("netlink_device_watcher: Cannot create pipe!");
+            }
+
+            _running = true;
+            _thread = std::thread([this]() { run(); });
+        }
+
+        void netlink_device_watcher::stop()
+        {
+            if (!_thread.joinable())
+                return;
+
+            _running = false;
+            char buff[1] = {};
+            if (write(_wake_pipe_fd[1], buff, 1) < 0)
+                LOG_ERROR("netlink_device_watcher: Could not signal the watcher thread to stop");
+            _thread.join();
+
+            if (_socket_fd >= 0)
+                ::close(_socket_fd);
+            ::close(_wake_pipe_fd[0]);
+            ::close(_wake_pipe_fd[1]);
+            _socket_fd = _wake_pipe_fd[0] = _wake_pipe_fd[1] = -1;
+        }
+
+        void netlink_device_watcher::run()
+        {
+            auto last_poll = std::chrono::steady_clock::now();
+            while (_running)
+            {
+                fd_set fds{};
+                FD_ZERO(&fds);
+                FD_SET(_wake_pipe_fd[0], &fds);
+                auto max_fd = _wake_pipe_fd[0];
+                if (_socket_fd >= 0)
+                {
+                    FD_SET(_socket_fd, &fds);
+                    max_fd = std::max(max_fd, _socket_fd);
+                }
+
+                // Sleep until the next event, the end of the quiet period or the next fallback poll
+                auto now = std::chrono::steady_clock::now();
+                auto wait = std::chrono::milliseconds::max();
+                {
+                    std::lock_guard<std::mutex> lock(_mutex);
+                    if (_pending)
+                        wait = std::chrono::duration_cast<std::chrono::milliseconds>(_last_change + _quiet_period - now);
+                }
+                if (_socket_fd < 0)
+                    wait = std::min(wait, std::chrono::duration_cast<std::chrono::milliseconds>(
+                        last_poll + std::chrono::milliseconds(FALLBACK_POLLING_INTERVAL_MS) - now));
+                wait = std::max(wait, std::chrono::milliseconds(0));
+
+                timeval tv = { static_cast<time_t>(wait.count() / 1000), static_cast<suseconds_t>((wait.count() % 1000) * 1000) };
+                auto val = select(max_fd + 1, &fds, nullptr, nullptr, wait == std::chrono::milliseconds::max() ? nullptr : &tv);
+                if (val < 0)
+                {
+                    if (errno == EINTR)
+                        continue;
+                    LOG_ERROR("netlink_device_watcher: select failed, errno: " << errno);
+                    break;
+                }
+
+                if (val > 0 && FD_ISSET(_wake_pipe_fd[0], &fds))
+                {
+                    char buff[16];
+                    if (read(_wake_pipe_fd[0], buff, sizeof(buff)) < 0)
+                        LOG_WARNING("netlink_device_watcher: Could not read from the wake pipe");
+                }
+
+                if (val > 0 && _socket_fd >= 0 && FD_ISSET(_socket_fd, &fds))
+                {
+                    char buff[UEVENT_BUFFER_SIZE];
+                    sockaddr_nl sender = {};
+                    socklen_t sender_size = sizeof(sender);
+                    auto size = recvfrom(_socket_fd, buff, sizeof(buff), MSG_DONTWAIT,
+                                         reinterpret_cast<sockaddr*>(&sender), &sender_size);
+                    // Only the kernel is trusted to report device changes
+                    if (size > 0 && sender.nl_pid == 0)
+                        handle_uevent(buff, size);
+                }
+
+                if (_socket_fd < 0 && std::chrono::steady_clock::now() - last_poll >= std::chrono::milliseconds(FALLBACK_POLLING_INTERVAL_MS))
+                {
+                    last_poll = std::chrono::steady_clock::now();
+                    auto curr = query_devices();
+                    std::lock_guard<std::mutex> lock(_mutex);
+                    _devices_data = curr;
+                    _pending = true;
+                    _last_change = last_poll - _quiet_period;
+                }
+
+                dispatch();
+            }
+        }
+
+        std::vector<uvc_device_info> netlink_device_watcher::query_uvc_interface(const std::string& interface_path) const
+        {
+            std::vector<uvc_device_info> found;
+            v4l_uvc_device::foreach_uvc_device([&found](const uvc_device_info& i, const std::string&)
+            {
+                found.push_back(i);
+            }, _sysfs_root, interface_path);
+            return found;
+        }
+
+        void netlink_device_watcher::dispatch()
+        {
+            std::map<std::string, int> stale;
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                if (!_pending || std::chrono::steady_clock::now() - _last_change < _quiet_period)
+                    return;
+                stale.swap(_stale_uvc_interfaces);
+            }
+
+            // Video and metadata nodes are merged per USB interface, so the whole interface is re-queried
+            std::map<std::string, std::vector<uvc_device_info>> found;
+            for (auto&& interface : stale)
+                found[interface.first] = query_uvc_interface(interface.first);
+
+            backend_device_group prev, curr;
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                auto& uvc_devices = _devices_data.uvc_devices;
+                for (auto&& interface : found)
+                {
+                    erase_devices_under(uvc_devices, interface.first);
+                    uvc_devices.insert(uvc_devices.end(), interface.second.begin(), interface.second.end());
+
+                    // A node udev has not given access to yet is queried again after another quiet period
+                    auto nodes = std::accumulate(interface.second.begin(), interface.second.end(), size_t(0),
+                        [](size_t count, const uvc_device_info& i) { return count + (i.has_metadata_node ? 2 : 1); });
+                    auto attempts = stale[interface.first] + 1;
+                    if (nodes < count_uvc_nodes(interface.first) && attempts < MAX_UVC_QUERY_ATTEMPTS)
+                    {
+                        _stale_uvc_interfaces.insert({ interface.first, attempts });
+                        _last_change = std::chrono::steady_clock::now();
+                    }
+                }
+
+                // The change is reported once every interface was queried
+                if (!_stale_uvc_interfaces.empty())
+                    return;
+
+                _pending = false;
+                prev = _reported_data;
+                curr = _devices_data;
+                _reported_data = _devices_data;
+            }
+
+            if (list_changed(prev.uvc_devices, curr.uvc_devices) ||
+                list_changed(prev.usb_devices, curr.usb_devices) ||
+                list_changed(prev.hid_devices, curr.hid_devices))
+            {
+                _callback(prev, curr);
+            }
+        }
+
+        bool netlink_device_watcher::handle_uevent(const char* buffer, size_t size)
+        {
+            // Messages forwarded by udevd carry a binary header, only raw kernel messages are parsed
+            if (size == 0 || !memchr(buffer, '@', strnlen(buffer, size)))
+                return false;
+
+            std::string action, devpath, subsystem, devtype;
+            for (size_t pos = strnlen(buffer, size) + 1; pos < size;)
+            {
+                std::string entry(buffer + pos, strnlen(buffer + pos, size - pos));
+                pos += entry.size() + 1;
+
+                auto separator = entry.find('=');
+                if (separator == std::string::npos)
+                    continue;
+                auto key = entry.substr(0, separator);
+                auto value = entry.substr(separator + 1);
+                if (key == "ACTION") action = value;
+                else if (key == "DEVPATH") devpath = value;
+                else if (key == "SUBSYSTEM") subsystem = value;
+                else if (key == "DEVTYPE") devtype = value;
+            }
+            if (action.empty() || devpath.empty())
+                return false;
+
+            auto path = _sysfs_root + devpath;
+            bool changed = false;
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                if (subsystem == "video4linux")
+                    changed = update_uvc_devices(action, path);
+                else if (subsystem == "iio" || subsystem == "platform")
+                    changed = update_hid_devices(action, path);
+                else if (subsystem == "usb" && devtype == "usb_device")
+                    changed = update_usb_devices(action, path);
+
+                if (changed)
+                {
+                    _pending = true;
+                    _last_change = std::chrono::steady_clock::now();
+                }
+            }
+
+            // Let the watcher thread restart its quiet period
+            if (changed && _wake_pipe_fd[1] >= 0)
+            {
+                char buff[1] = {};
+                if (write(_wake_pipe_fd[1], buff, 1) < 0)
+                    LOG_WARNING("netlink_device_watcher: Could not wake the watcher thread");
+            }
+            return changed;
+        }
+
+        bool netlink_device_watcher::update_uvc_devices(const std::string& action, const std::string& path)
+        {
+            if (action != "add" && action != "remove")
+                return false;
+
+            // The interface is queried by dispatch, once udev is done with the burst of events:
+            // /sys/devices/pci0000:00/0000:00:xx.0/ABC/M-N/3-6:1.0/video4linux/video0
+            auto interface_end = path.rfind("/video4linux/");
+            if (interface_end == std::string::npos)
+                return false;
+
+            _stale_uvc_interfaces[path.substr(0, interface_end)] = 0;
+            return true;
+        }
+
+        bool netlink_device_watcher::update_hid_devices(const std::string& action, const std::string& path)
+        {
+            auto& hid_devices = _devices_data.hid_devices;
+            if (action == "remove" || action == "unbind")
+                return erase_devices_under(hid_devices, path) > 0;
+
+            if (action != "add" && action != "bind")
+                return false;
+
+            hid_device_info info{};
+            if (!v4l_hid_device::query_hid_device(path, info))
+                return false;
+
+            auto it = std::find_if(hid_devices.begin(), hid_devices.end(),
+                [&info](const hid_device_info& i) { return i.device_path == info.device_path; });
+            if (it != hid_devices.end())
+                return false;
+
+            hid_devices.push_back(info);
+            return true;
+        }
+
+        bool netlink_device_watcher::update_usb_devices(const std::string& action, const std::string& path)
+        {
+            if (action != "add" && action != "remove")
+                return false;
+
+            bool changed = false;
+            if (action == "remove")
+            {
+                // The interfaces normally report their own removal first, this catches any left behind
+                changed |= erase_devices_under(_devices_data.uvc_devices, path) > 0;
+                changed |= erase_devices_under(_devices_data.hid_devices, path) > 0;
+            }
+
+            // libusb offers no lookup of a single device, the usb list is refreshed as a whole
+            auto usb_devices = usb_enumerator::query_devices_info();
+            changed |= list_changed(_devices_data.usb_devices, usb_devices);
+            _devices_data.usb_devices = usb_devices;
+            return changed;
+        }
+    }
+}
@@ -0,0 +1,70 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2019 Intel Corporation. All Rights Reserved.
+
+#pragma once
+
+#include "backend.h"
+#include "types.h"
+
+#include <atomic>
+#include <chrono>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+
+namespace librealsense
+{
+    namespace platform
+    {
+        // Device watcher driven by kernel uevents (NETLINK_KOBJECT_UEVENT) instead of periodic
+        // re-enumeration. Each event re-queries only the device it refers to, and a burst of
+        // events (all the interfaces of a camera appear one by one) is reported as a single
+        // change once no further event arrived for the quiet period.
+        // Video nodes are only queried at the end of the quiet period, as they cannot be opened
+        // before udev applied their permissions; nodes still not accessible are queried again later.
+        class netlink_device_watcher : public device_watcher
+        {
+        public:
+            explicit netlink_device_watcher(const std::string& sysfs_root = "/sys",
+                std::chrono::milliseconds quiet_period = std::chrono::milliseconds(200));
+            ~netlink_device_watcher();
+
+            void start(device_changed_callback callback) override;
+            void stop() override;
+
+            // Applies a single uevent in the kernel wire format ("action@devpath\0KEY=VALUE\0...")
+            // Returns true when the device list changed, or when a UVC interface is to be re-queried;
+            // the change is reported from the watcher thread
+            bool handle_uevent(const char* buffer, size_t size);
+
+        protected:
+            // Lists the UVC devices of a USB interface, leaving out the nodes that cannot be opened
+            virtual std::vector<uvc_device_info> query_uvc_interface(const std::string& interface_path) const;
+
+        private:
+            void run();
+            void dispatch();
+            backend_device_group query_devices() const;
+            bool update_uvc_devices(const std::string& action, const std::string& path);
+            bool update_hid_devices(const std::string& action, const std::string& path);
+            bool update_usb_devices(const std::string& action, const std::string& path);
+
+            std::string _sysfs_root;
+            std::chrono::milliseconds _quiet_period;
+
+            std::mutex _mutex;
+            backend_device_group _devices_data;     // Current state, updated by every uevent
+            backend_device_group _reported_data;    // State passed to the last callback
+            bool _pending = false;
+            std::map<std::string, int> _stale_uvc_interfaces;   // Interfaces to query, with the number of failed attempts
+            std::chrono::steady_clock::time_point _last_change;
+
+            device_changed_callback _callback;
+            std::thread _thread;
+            std::atomic<bool> _running;
+            int _socket_fd = -1;                // -1 when uevents are not available, the thread then re-enumerates periodically
+            int _wake_pipe_fd[2] = { -1, -1 };  // write to _wake_pipe_fd[1] and read from _wake_pipe_fd[0]
+        };
+    }
+}
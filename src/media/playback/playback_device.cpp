@@ -18,6 +18,8 @@ playback_device::playback_device(std::shared_ptr<context> ctx, std::shared_ptr<d
     m_is_paused(false),
     m_sample_rate(1),
     m_real_time(true),
+    m_read_ahead_threads(std::min(4u, std::max(1u, std::thread::hardware_concurrency()) - 1)),
+    m_read_ahead_bytes(64 * 1024 * 1024),
     m_prev_timestamp(0),
     m_last_published_timestamp(0)
 {
@@ -341,6 +343,39 @@ void playback_device::set_real_time(bool real_time)
 {
     LOG_INFO("Set real time to " << ((real_time) ? "True" : "False"));
     m_real_time = real_time;
+    (*m_read_thread)->invoke([this](dispatcher::cancellable_timer t)
+    {
+        update_read_ahead();
+    });
+}
+
+void playback_device::set_read_ahead(uint32_t threads, uint64_t max_bytes)
+{
+    LOG_INFO("Set read ahead to " << threads << " threads and " << max_bytes << " bytes");
+    (*m_read_thread)->invoke([this, threads, max_bytes](dispatcher::cancellable_timer t)
+    {
+        m_read_ahead_threads = threads;
+        m_read_ahead_bytes = max_bytes;
+        update_read_ahead();
+    });
+    if ((*m_read_thread)->flush() == false)
+    {
+        LOG_ERROR("Error - timeout waiting for set_read_ahead, possible deadlock detected");
+        assert(0); //Detect this immediately in debug
+    }
+}
+
+void playback_device::update_read_ahead()
+{
+    //update_read_ahead() is called from within the reading thread
+    //In real time the reading is paced by the recording times, reading ahead only helps when frames are consumed as fast as they are read
+    bool read_ahead = !m_real_time && m_read_ahead_threads > 0;
+    m_reader->set_read_ahead(read_ahead ? m_read_ahead_threads : 0, m_read_ahead_bytes);
+    //A few frames per stream wait for the user callback, the reader's frame pool is shared by all the streams
+    for (auto&& sensor : m_sensors)
+    {
+        sensor.second->set_frames_queue_size(read_ahead ? 4 : 1);
+    }
 }
 
 bool playback_device::is_real_time() const
@@ -623,6 +658,71 @@ uint64_t playback_device::get_position() const
 {
     return m_prev_timestamp.count();
 }
+
+device_serializer::stream_identifier playback_device::get_stream_identifier(const stream_profile_interface& profile) const
+{
+    for (auto&& sensor : m_sensors)
+    {
+        for (auto&& sensor_profile : sensor.second->get_stream_profiles())
+        {
+            if (sensor_profile->get_unique_id() == profile.get_unique_id())
+            {
+                return { get_device_index(), sensor.first, profile.get_stream_type(), static_cast<uint32_t>(profile.get_stream_index()) };
+            }
+        }
+    }
+    throw invalid_value_exception(to_string() << "Stream profile " << profile.get_stream_type() << " is not part of the playback device");
+}
+
+uint64_t playback_device::get_frames_count(const stream_profile_interface& profile)
+{
+    auto stream_id = get_stream_identifier(profile);
+    uint64_t frames_count = 0;
+    //The reader is only accessed from the reading thread
+    (*m_read_thread)->invoke([this, stream_id, &frames_count](dispatcher::cancellable_timer t)
+    {
+        frames_count = m_reader->query_frames_count(stream_id);
+    });
+    if ((*m_read_thread)->flush() == false)
+    {
+        LOG_ERROR("Error - timeout waiting for get_frames_count, possible deadlock detected");
+        assert(0); //Detect this immediately in debug
+    }
+    return frames_count;
+}
+
+frame_holder playback_device::get_frame(const stream_profile_interface& profile, uint64_t index)
+{
+    auto stream_id = get_stream_identifier(profile);
+    std::shared_ptr<device_serializer::serialized_data> data;
+    std::exception_ptr error;
+    (*m_read_thread)->invoke([this, stream_id, index, &data, &error](dispatcher::cancellable_timer t)
+    {
+        try
+        {
+            data = m_reader->read_frame(stream_id, index);
+        }
+        catch (...)
+        {
+            error = std::current_exception();
+        }
+    });
+    if ((*m_read_thread)->flush() == false)
+    {
+        LOG_ERROR("Error - timeout waiting for get_frame, possible deadlock detected");
+        assert(0); //Detect this immediately in debug
+    }
+    if (error)
+        std::rethrow_exception(error);
+
+    auto frame = data ? data->as<device_serializer::serialized_frame>() : nullptr;
+    if (!frame || !frame->frame)
+    {
+        throw io_exception(to_string() << "Failed to read frame " << index << " of stream " << stream_id);
+    }
+    m_sensors.at(stream_id.sensor_index)->attach_frame(frame->frame);
+    return std::move(frame->frame);
+}
 void playback_device::catch_up()
 {
     m_base_timestamp = std::chrono::microseconds(0);
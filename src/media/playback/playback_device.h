@@ -42,6 +42,9 @@ namespace librealsense
         bool is_real_time() const;
         const std::string& get_file_name() const;
         uint64_t get_position() const;
+        uint64_t get_frames_count(const stream_profile_interface& profile);
+        frame_holder get_frame(const stream_profile_interface& profile, uint64_t index);
+        void set_read_ahead(uint32_t threads, uint64_t max_bytes);
         signal<playback_device, rs2_playback_status> playback_status_changed;
         platform::backend_device_group get_device_data() const override;
         std::pair<uint32_t, rs2_extrinsics> get_extrinsics(const stream_interface& stream) const override;
@@ -73,6 +76,8 @@ namespace librealsense
         void register_extrinsics(const device_serializer::device_snapshot& device_description);
         void update_extensions(const device_serializer::device_snapshot& device_description);
         bool prefetch_done();
+        device_serializer::stream_identifier get_stream_identifier(const stream_profile_interface& profile) const;
+        void update_read_ahead();
 
     private:
         lazy<std::shared_ptr<dispatcher>> m_read_thread;
@@ -87,6 +92,8 @@ namespace librealsense
         std::map<uint32_t, std::shared_ptr<playback_sensor>> m_active_sensors;
         std::atomic<double> m_sample_rate;
         std::atomic_bool m_real_time;
+        uint32_t m_read_ahead_threads;
+        uint64_t m_read_ahead_bytes;
         device_serializer::nanoseconds m_prev_timestamp;
         std::vector<std::shared_ptr<lazy<rs2_extrinsics>>> m_extrinsics_fetchers;
         std::map<int, std::pair<uint32_t, rs2_extrinsics>> m_extrinsics_map;
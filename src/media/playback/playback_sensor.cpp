@@ -30,7 +30,8 @@ playback_sensor::playback_sensor(device_interface& parent_device, const device_s
     m_sensor_description(sensor_description),
     m_sensor_id(sensor_description.get_sensor_index()),
     m_parent_device(parent_device),
-    _default_queue_size(1)
+    _default_queue_size(1),
+    m_frames_queue_size(_default_queue_size)
 {
     register_sensor_streams(m_sensor_description.get_stream_profiles());
     register_sensor_infos(m_sensor_description);
@@ -85,7 +86,7 @@ void playback_sensor::open(const stream_profiles& requests)
     //For each stream, create a dedicated dispatching thread
     for (auto&& profile : requests)
     {
-        m_dispatchers.emplace(std::make_pair(profile->get_unique_id(), std::make_shared<dispatcher>(_default_queue_size)));
+        m_dispatchers.emplace(std::make_pair(profile->get_unique_id(), std::make_shared<dispatcher>(m_frames_queue_size)));
         m_dispatchers[profile->get_unique_id()]->start();
         device_serializer::stream_identifier f{ get_device_index(), m_sensor_id, profile->get_stream_type(), static_cast<uint32_t>(profile->get_stream_index()) };
         opened_streams.push_back(f);
@@ -181,10 +182,25 @@ void playback_sensor::flush_pending_frames()
 {
     for (auto&& dispatcher : m_dispatchers)
     {
-        dispatcher.second->flush();
+        //The frames already read are delivered, a non blocking flush would drop one of them when the queue is full
+        dispatcher.second->flush(true);
     }
 }
 
+void playback_sensor::set_frames_queue_size(unsigned int size)
+{
+    m_frames_queue_size = size;
+}
+
+void playback_sensor::attach_frame(frame_holder& frame)
+{
+    frame->get_owner()->set_sensor(shared_from_this());
+    auto type = frame->get_stream()->get_stream_type();
+    auto index = static_cast<uint32_t>(frame->get_stream()->get_stream_index());
+    frame->set_stream(m_streams[std::make_pair(type, index)]);
+    frame->set_sensor(shared_from_this());
+}
+
 void playback_sensor::register_sensor_streams(const stream_profiles& profiles)
 {
     for (auto profile : profiles)
@@ -50,6 +50,7 @@ namespace librealsense
         void unregister_before_start_callback(int token) override;
         void raise_notification(const notification& n);
         bool streams_contains_one_frame_or_more();
+        void set_frames_queue_size(unsigned int size); //Number of frames each stream holds for the user callback, applied on open
         virtual processing_blocks get_recommended_processing_blocks() const override
         {
             auto processing_blocks_snapshot = m_sensor_description.get_sensor_extensions_snapshots().find(RS2_EXTENSION_RECOMMENDED_FILTERS);
@@ -82,8 +83,12 @@ namespace librealsense
         stream_profiles m_available_profiles;
         stream_profiles m_active_streams;
         const unsigned int _default_queue_size;
+        std::atomic<unsigned int> m_frames_queue_size;
 
     public:
+        //Associates a frame read from the file with this sensor and its stream profile
+        void attach_frame(frame_holder& frame);
+
         //handle frame use 3 lambda functions that determines if and when a frame should be published.
         //calc_sleep - calculates the duration that the sensor should wait before publishing the frame,
         // the start point for this calculation is the last playback resume.
@@ -99,11 +104,7 @@ namespace librealsense
             }
             if (m_is_started)
             {
-                frame->get_owner()->set_sensor(shared_from_this());
-                auto type = frame->get_stream()->get_stream_type();
-                auto index = static_cast<uint32_t>(frame->get_stream()->get_stream_index());
-                frame->set_stream(m_streams[std::make_pair(type, index)]);
-                frame->set_sensor(shared_from_this());
+                attach_frame(frame);
                 auto stream_id = frame.frame->get_stream()->get_unique_id();
                 //TODO: Ziv, remove usage of shared_ptr when frame_holder is cpoyable
                 auto pf = std::make_shared<frame_holder>(std::move(frame));
@@ -8,11 +8,27 @@
 
 using namespace librealsense;
 
+rs2_recorder_config librealsense::record_device::default_config(bool compress_while_record)
+{
+    rs2_recorder_config config;
+    config.compression_level = compress_while_record ? 9 : 0;
+    config.compression_threads = 0;
+    config.max_pending_bytes = std::numeric_limits<unsigned long long>::max();
+    config.overflow_policy = RS2_RECORDER_OVERFLOW_POLICY_DROP_FRAMES;
+    return config;
+}
+
 librealsense::record_device::record_device(std::shared_ptr<librealsense::device_interface> device,
-                                      std::shared_ptr<librealsense::device_serializer::writer> serializer):
+                                      std::shared_ptr<librealsense::device_serializer::writer> serializer,
+                                      const rs2_recorder_config& config):
     m_write_thread([](){return std::make_shared<dispatcher>(std::numeric_limits<unsigned int>::max());}),
     m_is_recording(true),
-    m_record_pause_time(0)
+    m_record_pause_time(0),
+    m_cached_data_size(0),
+    m_cached_frames(0),
+    m_dropped_frames(0),
+    m_max_cached_data_size(config.max_pending_bytes ? config.max_pending_bytes : MAX_CACHED_DATA_SIZE),
+    m_overflow_policy(config.overflow_policy)
 {
     if (device == nullptr)
     {
@@ -24,6 +40,11 @@ librealsense::record_device::record_device(std::shared_ptr<librealsense::device_
         throw invalid_value_exception("serializer is null");
     }
 
+    if (!librealsense::is_valid(config.overflow_policy))
+    {
+        throw invalid_value_exception(to_string() << "Invalid recorder overflow policy " << static_cast<int>(config.overflow_policy));
+    }
+
     m_device = device;
     m_ros_writer = serializer;
     (*m_write_thread)->start(); //Start thread before creating the sensors (since they might write right away)
@@ -121,23 +142,21 @@ void librealsense::record_device::write_data(size_t sensor_index, librealsense::
         initialize_recording();
     });
 
-    //TODO: restore: uint64_t data_size = frame.frame->get_frame_data_size();
-    uint64_t cached_data_size = m_cached_data_size; //TODO: restore: (+ data_size)
-    if (cached_data_size > MAX_CACHED_DATA_SIZE)
+    uint64_t data_size = frame ? frame.frame->get_frame_data_size() : 0;
+    if (!reserve_cached_data(data_size))
     {
         LOG_WARNING("Recorder reached maximum cache size, frame dropped");
-        on_error("Recorder reached maximum cache size, frame dropped");
         return;
     }
 
-    m_cached_data_size = cached_data_size;
     auto capture_time = get_capture_time();
     //TODO: remove usage of shared pointer when frame_holder is copyable
     auto frame_holder_ptr = std::make_shared<frame_holder>();
     *frame_holder_ptr = std::move(frame);
-    (*m_write_thread)->invoke([this, frame_holder_ptr, sensor_index, capture_time/*, data_size*/, on_error](dispatcher::cancellable_timer t) {
+    (*m_write_thread)->invoke([this, frame_holder_ptr, sensor_index, capture_time, data_size, on_error](dispatcher::cancellable_timer t) {
         if (m_is_recording == false)
         {
+            release_cached_data(data_size);
             return; //Recording is paused
         }
         std::call_once(m_first_frame_flag, [&]()
@@ -159,15 +178,57 @@ void librealsense::record_device::write_data(size_t sensor_index, librealsense::
             auto stream_type = frame_holder_ptr->frame->get_stream()->get_stream_type();
             auto stream_index = static_cast<uint32_t>(frame_holder_ptr->frame->get_stream()->get_stream_index());
             m_ros_writer->write_frame({ device_index, static_cast<uint32_t>(sensor_index), stream_type, stream_index }, capture_time, std::move(*frame_holder_ptr));
-            //TODO: restore: std::lock_guard<std::mutex> locker(m_mutex);  m_cached_data_size -= data_size;
         }
         catch(std::exception& e)
         {
             on_error(to_string() << "Failed to write frame. " << e.what());
         }
+        release_cached_data(data_size);
     });
 }
 
+//Accounts a frame handed to the write thread, false if the frame should be dropped
+bool librealsense::record_device::reserve_cached_data(uint64_t data_size)
+{
+    std::unique_lock<std::mutex> locker(m_mutex);
+    //A frame larger than the cap is still recorded once nothing else is pending
+    auto has_room = [&]() { return m_cached_frames == 0 || m_cached_data_size + data_size <= m_max_cached_data_size; };
+    if (!has_room())
+    {
+        if (m_overflow_policy != RS2_RECORDER_OVERFLOW_POLICY_BLOCK)
+        {
+            m_dropped_frames++;
+            return false;
+        }
+        m_cached_data_released.wait(locker, has_room);
+    }
+    m_cached_data_size += data_size;
+    m_cached_frames++;
+    return true;
+}
+
+void librealsense::record_device::release_cached_data(uint64_t data_size)
+{
+    {
+        std::lock_guard<std::mutex> locker(m_mutex);
+        m_cached_data_size -= data_size;
+        m_cached_frames--;
+    }
+    m_cached_data_released.notify_all();
+}
+
+void librealsense::record_device::get_statistics(rs2_recorder_statistics& statistics) const
+{
+    statistics = {};
+    {
+        std::lock_guard<std::mutex> locker(m_mutex);
+        statistics.pending_frames = m_cached_frames;
+        statistics.pending_bytes = m_cached_data_size;
+        statistics.dropped_frames = m_dropped_frames;
+    }
+    m_ros_writer->get_statistics(statistics);
+}
+
 const std::string& librealsense::record_device::get_info(rs2_camera_info info) const
 {
     return m_device->get_info(info);
@@ -417,7 +478,6 @@ void record_device::initialize_recording()
 {
     //Expected to be called once when recording to file actually starts
     m_capture_time_base = std::chrono::high_resolution_clock::now();
-    m_cached_data_size = 0;
 }
 void record_device::stop_gracefully(to_string error_msg)
 {
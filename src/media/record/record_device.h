@@ -20,7 +20,12 @@ namespace librealsense
     public:
         static const uint64_t MAX_CACHED_DATA_SIZE = 1920 * 1080 * 4 * 30; // ~1 sec of HD video @ 30 FPS
 
-        record_device(std::shared_ptr<device_interface> device, std::shared_ptr<device_serializer::writer> serializer);
+        // Recording settings used when none are given: LZ4 compression on the writing thread if compress_while_record is set,
+        // and no cap on the frames waiting to be written, so that no frame is ever dropped
+        static rs2_recorder_config default_config(bool compress_while_record);
+
+        record_device(std::shared_ptr<device_interface> device, std::shared_ptr<device_serializer::writer> serializer,
+                      const rs2_recorder_config& config = default_config(true));
         virtual ~record_device();
 
         std::shared_ptr<context> get_context() const override;
@@ -39,6 +44,7 @@ namespace librealsense
         void pause_recording();
         void resume_recording();
         const std::string& get_filename() const;
+        void get_statistics(rs2_recorder_statistics& statistics) const;
         platform::backend_device_group get_device_data() const override;
         std::pair<uint32_t, rs2_extrinsics> get_extrinsics(const stream_interface& stream) const override;
         bool is_valid() const override;
@@ -55,6 +61,8 @@ namespace librealsense
         void write_header();
         std::chrono::nanoseconds get_capture_time() const;
         void write_data(size_t sensor_index, frame_holder f, std::function<void(std::string const&)> on_error);
+        bool reserve_cached_data(uint64_t data_size);
+        void release_cached_data(uint64_t data_size);
         void write_sensor_extension_snapshot(size_t sensor_index, rs2_extension ext, std::shared_ptr<extension_snapshot> snapshot, std::function<void(std::string const&)> on_error);
         void write_notification(size_t sensor_index, const notification& n);
         std::vector<std::shared_ptr<record_sensor>> create_record_sensors(std::shared_ptr<device_interface> m_device);
@@ -70,13 +78,18 @@ namespace librealsense
         std::chrono::high_resolution_clock::duration m_record_pause_time;
         std::chrono::high_resolution_clock::time_point m_time_of_pause;
 
-        std::mutex m_mutex;
+        mutable std::mutex m_mutex;
+        std::condition_variable m_cached_data_released;
         bool m_is_recording;
         std::once_flag m_first_frame_flag;
         int m_on_notification_token;
         int m_on_frame_token;
         int m_on_extension_change_token;
         uint64_t m_cached_data_size;
+        uint64_t m_cached_frames;
+        uint64_t m_dropped_frames;
+        uint64_t m_max_cached_data_size;
+        rs2_recorder_overflow_policy m_overflow_policy;
         std::once_flag m_first_call_flag;
         void initialize_recording();
         void stop_gracefully(to_string error_msg);
@@ -97,53 +97,66 @@ namespace librealsense
         auto seek_time_as_secs = std::chrono::duration_cast<std::chrono::duration<double>>(seek_time);
         auto seek_time_as_rostime = rs2rosinternal::Time(seek_time_as_secs.count());
 
-        m_samples_view.reset(new rosbag::View(m_file, FalseQuery()));
-
         //Using cached topics here and not querying them (before reseting) since a previous call to seek
         // could have changed the view and some streams that should be streaming were dropped.
         //E.g:  Recording Depth+Color, stopping Depth, starting IR, stopping IR and Color. Play IR+Depth: will play only depth, then only IR, then we seek to a point only IR was streaming, and then to 0.
-        for (auto topic : m_enabled_streams_topics)
-        {
-            m_samples_view->addQuery(m_file, rosbag::TopicQuery(topic), seek_time_as_rostime);
-        }
+        //A single query over all of them lets the view locate the seek time once per connection
+        std::set<std::string> enabled_topics(m_enabled_streams_topics.begin(), m_enabled_streams_topics.end());
+        m_samples_view.reset(new rosbag::View(m_file, [enabled_topics](rosbag::ConnectionInfo const* info) { return enabled_topics.count(info->topic) > 0; }, seek_time_as_rostime));
         m_samples_itrator = m_samples_view->begin();
     }
 
     std::vector<std::shared_ptr<serialized_data>> ros_reader::fetch_last_frames(const nanoseconds& seek_time)
     {
         std::vector<std::shared_ptr<serialized_data>> result;
-        rosbag::View view(m_file, FalseQuery());
         auto as_rostime = to_rostime(seek_time);
         auto start_time = to_rostime(get_static_file_info_timestamp());
 
-        for (auto topic : m_enabled_streams_topics)
-        {
-            view.addQuery(m_file, rosbag::TopicQuery(topic), start_time, as_rostime);
-        }
-        std::map<device_serializer::stream_identifier, rs2rosinternal::Time> last_frames;
-        for (auto&& m : view)
+        for (auto&& stream_frames : m_frames_index)
         {
-            if (m.isType<sensor_msgs::Image>() || m.isType<sensor_msgs::Imu>())
-            {
-                auto id = ros_topic::get_stream_identifier(m.getTopic());
-                last_frames[id] = m.getTime();
-            }
+            auto&& frames = stream_frames.second;
+            if (!frames.front().isType<sensor_msgs::Image>() && !frames.front().isType<sensor_msgs::Imu>())
+                continue;
+            if (std::find(m_enabled_streams_topics.begin(), m_enabled_streams_topics.end(), frames.front().getTopic()) == m_enabled_streams_topics.end())
+                continue;
+
+            //Last frame of the stream at or before the seek time
+            auto it = std::upper_bound(frames.begin(), frames.end(), as_rostime,
+                [](const rs2rosinternal::Time& time, const rosbag::MessageInstance& msg) { return time < msg.getTime(); });
+            if (it == frames.begin() || (--it)->getTime() < start_time)
+                continue;
+
+            result.push_back(create_frame(*it));
         }
-        for (auto&& kvp : last_frames)
+        return result;
+    }
+
+    uint64_t ros_reader::query_frames_count(const stream_identifier& stream_id) const
+    {
+        auto it = m_frames_index.find(stream_id);
+        return it == m_frames_index.end() ? 0 : it->second.size();
+    }
+
+    std::shared_ptr<serialized_data> ros_reader::read_frame(const stream_identifier& stream_id, uint64_t frame_index)
+    {
+        auto frames_count = query_frames_count(stream_id);
+        if (frame_index >= frames_count)
         {
-            auto topic = ros_topic::frame_data_topic(kvp.first);
-            rosbag::View view(m_file, rosbag::TopicQuery(topic), kvp.second, kvp.second);
-            auto msg = view.begin();
-            auto new_frame = create_frame(*msg);
-            result.push_back(new_frame);
+            throw invalid_value_exception(to_string() << "Requested frame is out of range. (Requested = " << frame_index << ", Stream " << stream_id << " has " << frames_count << " frames)");
         }
-        return result;
+        return create_frame(m_frames_index.at(stream_id)[frame_index]);
     }
     nanoseconds ros_reader::query_duration() const
     {
         return m_total_duration;
     }
 
+    void ros_reader::set_read_ahead(uint32_t threads, uint64_t max_bytes)
+    {
+        //The bag keeps these across reset(), which reopens the file
+        m_file.setReadAhead(threads, max_bytes);
+    }
+
     void ros_reader::reset()
     {
         m_file.close();
@@ -153,6 +166,25 @@ namespace librealsense
         m_frame_source = std::make_shared<frame_source>(m_version == 1 ? 128 : 32);
         m_frame_source->init(m_metadata_parser_map);
         m_initial_device_description = read_device_description(get_static_file_info_timestamp(), true);
+        build_frames_index();
+    }
+
+    void ros_reader::build_frames_index()
+    {
+        //The bag keeps the position of every message, walking a view over the frame topics only reads those index entries
+        m_frames_index.clear();
+        std::function<bool(rosbag::ConnectionInfo const* info)> query;
+        if (m_version == legacy_file_format::file_version())
+            query = legacy_file_format::FrameQuery();
+        else
+            query = FrameQuery();
+        rosbag::View all_frames_view(m_file, query);
+        for (auto&& msg : all_frames_view)
+        {
+            auto stream_id = m_version == legacy_file_format::file_version() ?
+                legacy_file_format::get_stream_identifier(msg.getTopic()) : ros_topic::get_stream_identifier(msg.getTopic());
+            m_frames_index[stream_id].push_back(msg);
+        }
     }
 
     void ros_reader::enable_stream(const std::vector<device_serializer::stream_identifier>& stream_ids)
@@ -23,6 +23,9 @@ namespace librealsense
         virtual void enable_stream(const std::vector<device_serializer::stream_identifier>& stream_ids) override;
         virtual void disable_stream(const std::vector<device_serializer::stream_identifier>& stream_ids) override;
         const std::string& get_file_name() const override;
+        uint64_t query_frames_count(const stream_identifier& stream_id) const override;
+        std::shared_ptr<serialized_data> read_frame(const stream_identifier& stream_id, uint64_t frame_index) override;
+        void set_read_ahead(uint32_t threads, uint64_t max_bytes) override;
 
     private:
 
@@ -43,6 +46,7 @@ namespace librealsense
 
         std::shared_ptr<serialized_frame> create_frame(const rosbag::MessageInstance& msg);
         static nanoseconds get_file_duration(const rosbag::Bag& file, uint32_t version);
+        void build_frames_index();
         static void get_legacy_frame_metadata(const rosbag::Bag& bag,
             const device_serializer::stream_identifier& stream_id,
             const rosbag::MessageInstance &msg,
@@ -118,6 +122,8 @@ namespace librealsense
         std::unique_ptr<rosbag::View>           m_samples_view;
         rosbag::View::iterator                  m_samples_itrator;
         std::vector<std::string>                m_enabled_streams_topics;
+        //Frame messages of each stream in timestamp order, pointing at their chunk and offset in the file
+        std::map<stream_identifier, std::vector<rosbag::MessageInstance>> m_frames_index;
         std::shared_ptr<context>                m_context;
         uint32_t                                m_version;
     };
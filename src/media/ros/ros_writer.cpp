@@ -14,13 +14,21 @@ namespace librealsense
 {
     using namespace device_serializer;
 
-    ros_writer::ros_writer(const std::string& file, bool compress_while_record) : m_file_path(file)
+    ros_writer::ros_writer(const std::string& file, const rs2_recorder_config& config) : m_file_path(file)
     {
-        LOG_INFO("Compression while record is set to " << (compress_while_record ? "ON" : "OFF"));
+        if (config.compression_level < 0 || config.compression_level > 9)
+            throw invalid_value_exception(to_string() << "Invalid compression level " << config.compression_level << ", expected 0 to 9");
+        if (config.compression_threads < 0)
+            throw invalid_value_exception(to_string() << "Invalid compression threads count " << config.compression_threads);
+
+        LOG_INFO("Compression while record is set to " << (config.compression_level ? "ON" : "OFF")
+            << " (level " << config.compression_level << ", " << config.compression_threads << " threads)");
         m_bag.open(file, rosbag::BagMode::Write);
-        if (compress_while_record)
+        if (config.compression_level)
         {
             m_bag.setCompression(rosbag::CompressionType::LZ4);
+            m_bag.setCompressionLevel(config.compression_level);
+            m_bag.setCompressionThreads(config.compression_threads);
         }
         write_file_version();
     }
@@ -77,6 +85,15 @@ namespace librealsense
         return m_file_path;
     }
 
+    void ros_writer::get_statistics(rs2_recorder_statistics& statistics) const
+    {
+        auto compression = m_bag.getCompressionStatistics();
+        statistics.compressing_chunks = compression.pending_chunks;
+        statistics.compressing_bytes = compression.pending_bytes;
+        statistics.written_chunks = compression.written_chunks;
+        statistics.written_bytes = compression.compressed_bytes;
+    }
+
     void ros_writer::write_file_version()
     {
         std_msgs::UInt32 msg;
@@ -192,18 +209,38 @@ namespace librealsense
 
     void ros_writer::write_motion_frame(const stream_identifier& stream_id, const nanoseconds& timestamp, frame_holder&& frame)
     {
-        sensor_msgs::Imu imu_msg;
         if (!frame)
         {
             throw io_exception("Null frame passed to write_motion_frame");
         }
 
-        imu_msg.header.seq = static_cast<uint32_t>(frame.frame->get_frame_number());
-        std::chrono::duration<double, std::milli> timestamp_ms(frame.frame->get_frame_timestamp());
+        if (frame.frame->get_stream()->get_format() != RS2_FORMAT_MOTION_XYZ32F_BATCH)
+        {
+            write_motion_sample(stream_id, timestamp, frame, frame.frame->get_frame_number(), frame.frame->get_frame_timestamp(),
+                reinterpret_cast<const float*>(frame.frame->get_frame_data()));
+            return;
+        }
+
+        // Batched samples are recorded one by one, so the file plays back as a regular motion stream
+        auto samples = reinterpret_cast<const rs2_motion_sample*>(frame.frame->get_frame_data());
+        auto samples_count = static_cast<size_t>(frame.frame->get_frame_data_size()) / sizeof(rs2_motion_sample);
+        for (size_t i = 0; i < samples_count; i++)
+        {
+            std::chrono::duration<double, std::milli> offset_ms(samples[i].timestamp - samples[0].timestamp);
+            write_motion_sample(stream_id, timestamp + std::chrono::duration_cast<nanoseconds>(offset_ms), frame,
+                frame.frame->get_frame_number() + i, samples[i].timestamp, &samples[i].data.x);
+        }
+    }
+
+    void ros_writer::write_motion_sample(const stream_identifier& stream_id, const nanoseconds& timestamp, const frame_holder& frame,
+        unsigned long long frame_number, rs2_time_t frame_timestamp, const float* data_ptr)
+    {
+        sensor_msgs::Imu imu_msg;
+        imu_msg.header.seq = static_cast<uint32_t>(frame_number);
+        std::chrono::duration<double, std::milli> timestamp_ms(frame_timestamp);
         imu_msg.header.stamp = rs2rosinternal::Time(std::chrono::duration<double>(timestamp_ms).count());
         std::string TODO_CORRECT_ME = "0";
         imu_msg.header.frame_id = TODO_CORRECT_ME;
-        auto data_ptr = reinterpret_cast<const float*>(frame.frame->get_frame_data());
         if (stream_id.stream_type == RS2_STREAM_ACCEL)
         {
             imu_msg.linear_acceleration.x = data_ptr[0];
@@ -308,7 +345,9 @@ namespace librealsense
     {
         realsense_msgs::StreamInfo stream_info_msg;
         stream_info_msg.is_recommended = profile->get_tag() & profile_tag::PROFILE_TAG_DEFAULT;
-        convert(profile->get_format(), stream_info_msg.encoding);
+        // Batched motion samples are recorded one by one, see write_motion_frame
+        auto format = profile->get_format() == RS2_FORMAT_MOTION_XYZ32F_BATCH ? RS2_FORMAT_MOTION_XYZ32F : profile->get_format();
+        convert(format, stream_info_msg.encoding);
         stream_info_msg.fps = profile->get_framerate();
         write_message(ros_topic::stream_info_topic({ sensor_id.device_index, sensor_id.sensor_index, profile->get_stream_type(), static_cast<uint32_t>(profile->get_stream_index()) }), timestamp, stream_info_msg);
     }
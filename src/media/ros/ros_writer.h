@@ -12,12 +12,13 @@ namespace librealsense
     class ros_writer: public writer
     {
     public:
-        explicit ros_writer(const std::string& file, bool compress_while_record);
+        ros_writer(const std::string& file, const rs2_recorder_config& config);
         void write_device_description(const librealsense::device_snapshot& device_description) override;
         void write_frame(const stream_identifier& stream_id, const nanoseconds& timestamp, frame_holder&& frame) override;
         void write_snapshot(uint32_t device_index, const nanoseconds& timestamp, rs2_extension type, const std::shared_ptr<extension_snapshot>& snapshot) override;
         void write_snapshot(const sensor_identifier& sensor_id, const nanoseconds& timestamp, rs2_extension type, const std::shared_ptr<extension_snapshot>& snapshot) override;
         const std::string& get_file_name() const override;
+        void get_statistics(rs2_recorder_statistics& statistics) const override;
 
     private:
         void write_file_version();
@@ -28,6 +29,8 @@ namespace librealsense
         void write_additional_frame_messages(const stream_identifier& stream_id, const nanoseconds& timestamp, frame_interface* frame);
         void write_video_frame(const stream_identifier& stream_id, const nanoseconds& timestamp, frame_holder&& frame);
         void write_motion_frame(const stream_identifier& stream_id, const nanoseconds& timestamp, frame_holder&& frame);
+        void write_motion_sample(const stream_identifier& stream_id, const nanoseconds& timestamp, const frame_holder& frame,
+            unsigned long long frame_number, rs2_time_t frame_timestamp, const float* data_ptr);
         inline geometry_msgs::Vector3 to_vector3(const float3& f);
         inline geometry_msgs::Quaternion to_quaternion(const float4& f);
         void write_pose_frame(const stream_identifier& stream_id, const nanoseconds& timestamp, frame_holder&& frame);
@@ -68,7 +68,8 @@ namespace librealsense
         {
             auto pair_size = (sizeof(rs2_frame_metadata_value) + sizeof(rs2_metadata_type));
             const uint8_t* pos = frm.additional_data.metadata_blob.data();
-            while (pos <= frm.additional_data.metadata_blob.data() + frm.additional_data.metadata_blob.size())
+            const uint8_t* end = pos + std::min<size_t>(frm.additional_data.metadata_size, frm.additional_data.metadata_blob.size());
+            while (pos + pair_size <= end)
             {
                 const rs2_frame_metadata_value* type = reinterpret_cast<const rs2_frame_metadata_value*>(pos);
                 pos += sizeof(rs2_frame_metadata_value);
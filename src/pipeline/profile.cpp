@@ -19,7 +19,8 @@ namespace librealsense
                 if (!dev)
                     throw librealsense::invalid_value_exception("Failed to create a profile, device is null");
 
-                _dev = std::make_shared<record_device>(dev, std::make_shared<ros_writer>(to_file, dev->compress_while_record()));
+                auto config = record_device::default_config(dev->compress_while_record());
+                _dev = std::make_shared<record_device>(dev, std::make_shared<ros_writer>(to_file, config), config);
             }
             _multistream = config.resolve(_dev.get());
         }
@@ -185,6 +185,7 @@ namespace librealsense
 
                 for (auto profile : profiles)
                 {
+                    if (is_opt_in_format(profile->get_format())) continue;
                     profiles_map[std::make_tuple(profile->get_unique_id(), profile->get_stream_index())].push_back(profile);
                 }
 
@@ -344,6 +345,12 @@ namespace librealsense
                 return sort_highest_framerate(lhs, rhs);
             }
 
+            // Formats that are only streamed when requested explicitly
+            static bool is_opt_in_format(rs2_format format)
+            {
+                return format == RS2_FORMAT_MOTION_XYZ32F_BATCH;
+            }
+
             static void auto_complete(std::vector<stream_profile> &requests, stream_profiles candidates, const device_interface* dev)
             {
                 for (auto & request : requests)
@@ -351,6 +358,7 @@ namespace librealsense
                     if (!has_wildcards(request)) continue;
                     for (auto candidate : candidates)
                     {
+                        if (request.format == RS2_FORMAT_ANY && is_opt_in_format(candidate->get_format())) continue;
                         if (match(candidate.get(), request) && !dev->contradicts(candidate.get(), requests))
                         {
                             request = to_request(candidate.get());
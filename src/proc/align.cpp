@@ -15,6 +15,26 @@ namespace librealsense
 {
     template<int N> struct bytes { byte b[N]; };
 
+    void map_depth_pixel(const rs2_intrinsics& depth_intrin, const rs2_extrinsics& depth_to_other, const rs2_intrinsics& other_intrin,
+        int depth_x, int depth_y, float depth, int2& top_left, int2& bottom_right)
+    {
+        // Map the top-left corner of the depth pixel onto the other image
+        float depth_pixel[2] = { depth_x - 0.5f, depth_y - 0.5f }, depth_point[3], other_point[3], other_pixel[2];
+        rs2_deproject_pixel_to_point(depth_point, &depth_intrin, depth_pixel, depth);
+        rs2_transform_point_to_point(other_point, &depth_to_other, depth_point);
+        rs2_project_point_to_pixel(other_pixel, &other_intrin, other_point);
+        top_left.x = static_cast<int>(other_pixel[0] + 0.5f);
+        top_left.y = static_cast<int>(other_pixel[1] + 0.5f);
+
+        // Map the bottom-right corner of the depth pixel onto the other image
+        depth_pixel[0] = depth_x + 0.5f; depth_pixel[1] = depth_y + 0.5f;
+        rs2_deproject_pixel_to_point(depth_point, &depth_intrin, depth_pixel, depth);
+        rs2_transform_point_to_point(other_point, &depth_to_other, depth_point);
+        rs2_project_point_to_pixel(other_pixel, &other_intrin, other_point);
+        bottom_right.x = static_cast<int>(other_pixel[0] + 0.5f);
+        bottom_right.y = static_cast<int>(other_pixel[1] + 0.5f);
+    }
+
     template<class GET_DEPTH, class TRANSFER_PIXEL>
     void align_images(const rs2_intrinsics& depth_intrin, const rs2_extrinsics& depth_to_other,
         const rs2_intrinsics& other_intrin, GET_DEPTH get_depth, TRANSFER_PIXEL transfer_pixel)
@@ -29,29 +49,16 @@ namespace librealsense
                 // Skip over depth pixels with the value of zero, we have no depth data so we will not write anything into our aligned images
                 if (float depth = get_depth(depth_pixel_index))
                 {
-                    // Map the top-left corner of the depth pixel onto the other image
-                    float depth_pixel[2] = { depth_x - 0.5f, depth_y - 0.5f }, depth_point[3], other_point[3], other_pixel[2];
-                    rs2_deproject_pixel_to_point(depth_point, &depth_intrin, depth_pixel, depth);
-                    rs2_transform_point_to_point(other_point, &depth_to_other, depth_point);
-                    rs2_project_point_to_pixel(other_pixel, &other_intrin, other_point);
-                    const int other_x0 = static_cast<int>(other_pixel[0] + 0.5f);
-                    const int other_y0 = static_cast<int>(other_pixel[1] + 0.5f);
-
-                    // Map the bottom-right corner of the depth pixel onto the other image
-                    depth_pixel[0] = depth_x + 0.5f; depth_pixel[1] = depth_y + 0.5f;
-                    rs2_deproject_pixel_to_point(depth_point, &depth_intrin, depth_pixel, depth);
-                    rs2_transform_point_to_point(other_point, &depth_to_other, depth_point);
-                    rs2_project_point_to_pixel(other_pixel, &other_intrin, other_point);
-                    const int other_x1 = static_cast<int>(other_pixel[0] + 0.5f);
-                    const int other_y1 = static_cast<int>(other_pixel[1] + 0.5f);
-
-                    if (other_x0 < 0 || other_y0 < 0 || other_x1 >= other_intrin.width || other_y1 >= other_intrin.height)
+                    int2 other0, other1;
+                    map_depth_pixel(depth_intrin, depth_to_other, other_intrin, depth_x, depth_y, depth, other0, other1);
+
+                    if (other0.x < 0 || other0.y < 0 || other1.x >= other_intrin.width || other1.y >= other_intrin.height)
                         continue;
 
                     // Transfer between the depth pixels and the pixels inside the rectangle on the other image
-                    for (int y = other_y0; y <= other_y1; ++y)
+                    for (int y = other0.y; y <= other1.y; ++y)
                     {
-                        for (int x = other_x0; x <= other_x1; ++x)
+                        for (int x = other0.x; x <= other1.x; ++x)
                         {
                             transfer_pixel(depth_pixel_index, y * other_intrin.width + x);
                         }
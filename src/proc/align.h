@@ -12,6 +12,11 @@
 
 namespace librealsense
 {
+    // Maps a depth pixel onto the rectangle of pixels it covers in the other image, from the projections of its
+    // top-left and bottom-right corners. The reference the vectorized align implementations reproduce exactly
+    void map_depth_pixel(const rs2_intrinsics& depth_intrin, const rs2_extrinsics& depth_to_other, const rs2_intrinsics& other_intrin,
+        int depth_x, int depth_y, float depth, int2& top_left, int2& bottom_right);
+
     class LRS_EXTENSION_API align : public generic_processing_block
     {
     public:
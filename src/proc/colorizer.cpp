@@ -10,9 +10,97 @@
 #include "option.h"
 #include "colorizer.h"
 #include "disparity-transform.h"
+#include "cpu-features.h"
+#include "proc/sse/colorizer-avx.h"
+
+#ifdef __SSSE3__
+#include <tmmintrin.h> // For SSSE3 intrinsics
+#endif
 
 namespace librealsense
 {
+    // Worker threads sharing each frame, a single thread keeps the colorizer on the calling thread
+    const uint8_t colorizer_threads_min = 1;
+    const uint8_t colorizer_threads_max = 16;
+    const uint8_t colorizer_threads_step = 1;
+    const uint8_t colorizer_threads_default = 1;
+
+    namespace
+    {
+        // Lookup table entries hold the RGB bytes of a color in their 3 lowest bytes
+        inline uint32_t pack_color(const float3& c)
+        {
+            return uint32_t(uint8_t(c.x)) | uint32_t(uint8_t(c.y)) << 8 | uint32_t(uint8_t(c.z)) << 16;
+        }
+
+        inline void store_color(uint8_t* rgb, uint32_t color)
+        {
+            rgb[0] = uint8_t(color);
+            rgb[1] = uint8_t(color >> 8);
+            rgb[2] = uint8_t(color >> 16);
+        }
+
+        // Disparities are binned by their integer part, as update_histogram does
+        inline int histogram_bin(uint16_t value) { return value; }
+        inline int histogram_bin(float value) { return clamp_val(int(value), 0, colorizer::MAX_DEPTH - 1); }
+
+        // Counts values into the 4 interleaved sub-histograms of bins, and widens [min, max] to the non-zero values counted
+        template<typename T>
+        void count_values(const T* depth, size_t begin, size_t end, int* bins, int& min, int& max)
+        {
+            // Zero wraps around to the largest value, so that it never lowers the minimum
+            auto lo = unsigned(min - 1);
+            auto hi = max;
+            auto i = begin;
+            for (; i + 4 <= end; i += 4)
+            {
+                auto d0 = histogram_bin(depth[i]), d1 = histogram_bin(depth[i + 1]);
+                auto d2 = histogram_bin(depth[i + 2]), d3 = histogram_bin(depth[i + 3]);
+                bins[d0 * 4]++;
+                bins[d1 * 4 + 1]++;
+                bins[d2 * 4 + 2]++;
+                bins[d3 * 4 + 3]++;
+                lo = std::min(std::min(lo, unsigned(d0 - 1)), std::min(std::min(unsigned(d1 - 1), unsigned(d2 - 1)), unsigned(d3 - 1)));
+                hi = std::max(std::max(hi, d0), std::max(std::max(d1, d2), d3));
+            }
+            for (; i < end; i++)
+            {
+                auto d = histogram_bin(depth[i]);
+                bins[d * 4]++;
+                lo = std::min(lo, unsigned(d - 1));
+                hi = std::max(hi, d);
+            }
+            min = int(lo + 1);
+            max = hi;
+        }
+
+#ifdef __SSSE3__
+        // Colors of 4 depth pixels, their RGB bytes in the 12 lowest bytes
+        inline __m128i lookup_rgb(const uint32_t* lut, const uint16_t* depth)
+        {
+            const auto pack = _mm_setr_epi8(0, 1, 2, 4, 5, 6, 8, 9, 10, 12, 13, 14, -1, -1, -1, -1);
+            return _mm_shuffle_epi8(_mm_setr_epi32(int(lut[depth[0]]), int(lut[depth[1]]), int(lut[depth[2]]), int(lut[depth[3]])), pack);
+        }
+
+        size_t colorize_lut_sse(const uint16_t* depth, const uint32_t* lut, uint8_t* rgb, size_t count)
+        {
+            size_t i = 0;
+            for (; i + 16 <= count; i += 16)
+            {
+                auto a = lookup_rgb(lut, depth + i), b = lookup_rgb(lut, depth + i + 4);
+                auto c = lookup_rgb(lut, depth + i + 8), d = lookup_rgb(lut, depth + i + 12);
+
+                // Four groups of 12 bytes make the 48 bytes of the 16 pixels
+                auto out = reinterpret_cast<__m128i*>(rgb + i * 3);
+                _mm_storeu_si128(out, _mm_or_si128(a, _mm_slli_si128(b, 12)));
+                _mm_storeu_si128(out + 1, _mm_or_si128(_mm_srli_si128(b, 4), _mm_slli_si128(c, 8)));
+                _mm_storeu_si128(out + 2, _mm_or_si128(_mm_srli_si128(c, 8), _mm_slli_si128(d, 4)));
+            }
+            return i;
+        }
+#endif
+    }
+
     static color_map hue{ {
         { 255, 0, 0 },
         { 255, 255, 0 },
@@ -141,7 +229,9 @@ namespace librealsense
     colorizer::colorizer(const char* name)
         : stream_filter_processing_block(name),
          _min(0.f), _max(6.f), _equalize(true), 
-         _target_stream_profile(), _histogram()
+         _target_stream_profile(), _histogram(),
+         _processing_threads(colorizer_threads_default),
+         _workers(colorizer_threads_default)
     {
         _histogram = std::vector<int>(MAX_DEPTH, 0);
         _hist_data = _histogram.data();
@@ -212,6 +302,121 @@ namespace librealsense
 
         auto hist_opt = std::make_shared<ptr_option<bool>>(false, true, true, true, &_equalize, "Perform histogram equalization");
         register_option(RS2_OPTION_HISTOGRAM_EQUALIZATION_ENABLED, hist_opt);
+
+        auto processing_threads = std::make_shared<ptr_option<uint8_t>>(
+            colorizer_threads_min,
+            colorizer_threads_max,
+            colorizer_threads_step,
+            colorizer_threads_default,
+            &_processing_threads, "Number of threads sharing the colorization of a frame");
+        register_option(RS2_OPTION_PROCESSING_THREADS, processing_threads);
+    }
+
+    template<typename T>
+    void colorizer::equalize_histogram(const T* depth_data, size_t count, color_map* cm)
+    {
+        auto threads = _workers.size();
+        _counts.resize(threads);
+        for (auto&& counts : _counts)
+            if (counts.bins.empty())
+                counts.bins.assign(MAX_DEPTH * 4, 0);
+
+        _workers.run(threads, [&](size_t begin, size_t end)
+        {
+            for (auto t = begin; t < end; t++)
+            {
+                auto& counts = _counts[t];
+                counts.min = MAX_DEPTH;
+                counts.max = 0;
+                count_values(depth_data, count * t / threads, count * (t + 1) / threads, counts.bins.data(), counts.min, counts.max);
+            }
+        });
+
+        int min = MAX_DEPTH, max = 0;
+        for (auto&& counts : _counts)
+        {
+            min = std::min(min, counts.min);
+            max = std::max(max, counts.max);
+        }
+
+        auto merge = [this](int value)
+        {
+            int sum = 0;
+            for (auto&& counts : _counts)
+            {
+                auto bin = counts.bins.data() + value * 4;
+                sum += bin[0] + bin[1] + bin[2] + bin[3];
+                bin[0] = bin[1] = bin[2] = bin[3] = 0;
+            }
+            return sum;
+        };
+
+        // The cumulative histogram update_histogram builds, only over the values found in the frame
+        auto zeros = merge(0);
+        int total = 0;
+        for (auto value = min; value <= max; value++)
+        {
+            total += merge(value);
+            _hist_data[value] = total;
+        }
+        _hist_data[0] = zeros;
+
+        _lut.resize(MAX_DEPTH);
+        _lut[0] = 0;
+        _lut_cropped = false;
+
+        auto pixels = (float)total;
+        if (min <= max)
+            _workers.run(max - min + 1, [&](size_t begin, size_t end)
+            {
+                for (auto value = min + int(begin); value < min + int(end); value++)
+                    _lut[value] = pack_color(cm->get(_hist_data[value] / pixels));
+            });
+        _lut_zero_bin = pack_color(cm->get(zeros / pixels));
+    }
+
+    void colorizer::update_value_cropped_lut(color_map* cm, float min, float max)
+    {
+        if (_lut_cropped && _lut_map == cm && _lut_min == min && _lut_max == max && _lut_depth_units == _depth_units)
+            return;
+
+        _lut.resize(MAX_DEPTH);
+        _lut[0] = 0;
+        auto depth_units = _depth_units;
+        _workers.run(MAX_DEPTH - 1, [&](size_t begin, size_t end)
+        {
+            for (auto value = begin + 1; value < end + 1; value++)
+                _lut[value] = pack_color(cm->get((float(value) * depth_units - min) / (max - min)));
+        });
+
+        _lut_cropped = true;
+        _lut_map = cm;
+        _lut_min = min;
+        _lut_max = max;
+        _lut_depth_units = depth_units;
+    }
+
+    void colorizer::colorize_z16(const uint16_t* depth_data, uint8_t* rgb_data, size_t count)
+    {
+        auto lut = _lut.data();
+        _workers.run(count, [&](size_t begin, size_t end)
+        {
+            auto depth = depth_data + begin;
+            auto rgb = rgb_data + begin * 3;
+            auto n = end - begin;
+
+            size_t i = 0;
+#if defined(RS2_USE_AVX2) && defined(__SSSE3__) && !defined(ANDROID)
+            if (get_simd_level() == simd_level::avx2)
+                i = colorize_lut_avx(depth, lut, rgb, n);
+#endif
+#ifdef __SSSE3__
+            if (get_simd_level() >= simd_level::ssse3)
+                i += colorize_lut_sse(depth + i, lut, rgb + i * 3, n - i);
+#endif
+            for (; i < n; i++)
+                store_color(rgb + i * 3, lut[depth[i]]);
+        });
     }
 
     bool colorizer::should_process(const rs2::frame& frame)
@@ -237,32 +442,41 @@ namespace librealsense
             _d2d_convert_factor = info.d2d_convert_factor;
         }
 
-        auto make_equalized_histogram = [this](const rs2::video_frame& depth, rs2::video_frame rgb)
+        // Options may be set from other threads, the frame is colorized with the values they had when it arrived
+        auto cm = _maps[_map_index];
+        auto min = _min, max = _max;
+        // The pool is only resized here, between frames, since the option may be set from any thread
+        _workers.resize(_processing_threads);
+
+        auto make_equalized_histogram = [this, cm](const rs2::video_frame& depth, rs2::video_frame rgb)
         {
             auto depth_format = depth.get_profile().format();
             const auto w = depth.get_width(), h = depth.get_height();
             auto rgb_data = reinterpret_cast<uint8_t*>(const_cast<void *>(rgb.get_data()));
-            auto coloring_function = [&, this](float data) {
-                auto hist_data = _hist_data[(int)data];
-                auto pixels = (float)_hist_data[MAX_DEPTH - 1];
-                return (hist_data / pixels);
-            };
 
             if (depth_format == RS2_FORMAT_DISPARITY32)
             {
                 auto depth_data = reinterpret_cast<const float*>(depth.get_data());
-                update_histogram(_hist_data, depth_data, w, h);
-                make_rgb_data<float>(depth_data, rgb_data, w, h, coloring_function);
+                equalize_histogram(depth_data, w * h, cm);
+                _workers.run(w * h, [&](size_t begin, size_t end)
+                {
+                    for (auto i = begin; i < end; i++)
+                    {
+                        auto d = depth_data[i];
+                        auto bin = histogram_bin(d);
+                        store_color(rgb_data + i * 3, !d ? 0 : bin ? _lut[bin] : _lut_zero_bin);
+                    }
+                });
             }
             else if (depth_format == RS2_FORMAT_Z16)
             {
                 auto depth_data = reinterpret_cast<const uint16_t*>(depth.get_data());
-                update_histogram(_hist_data, depth_data, w, h);
-                make_rgb_data<uint16_t>(depth_data, rgb_data, w, h, coloring_function);
+                equalize_histogram(depth_data, w * h, cm);
+                colorize_z16(depth_data, rgb_data, w * h);
             }
         };
 
-        auto make_value_cropped_frame = [this](const rs2::video_frame& depth, rs2::video_frame rgb)
+        auto make_value_cropped_frame = [this, cm, min, max](const rs2::video_frame& depth, rs2::video_frame rgb)
         {
             auto depth_format = depth.get_profile().format();
             const auto w = depth.get_width(), h = depth.get_height();
@@ -273,22 +487,18 @@ namespace librealsense
                 auto depth_data = reinterpret_cast<const float*>(depth.get_data());
                 // convert from depth min max to disparity min max
                 // note: max min value is inverted in disparity domain
-                auto max = (_d2d_convert_factor / (_min + 0.1)) * _depth_units + .5f;
-                auto min = (_d2d_convert_factor / (_max)) * _depth_units + .5f;
+                auto disparity_max = (_d2d_convert_factor / (min + 0.1)) * _depth_units + .5f;
+                auto disparity_min = (_d2d_convert_factor / (max)) * _depth_units + .5f;
                 auto coloring_function = [&, this](float data) {
-                    return (data - min) / (max - min);
+                    return (data - disparity_min) / (disparity_max - disparity_min);
                 };
                 make_rgb_data<float>(depth_data, rgb_data, w, h, coloring_function);
             }
             else if (depth_format == RS2_FORMAT_Z16)
             {
                 auto depth_data = reinterpret_cast<const uint16_t*>(depth.get_data());
-                auto min = _min;
-                auto max = _max;
-                auto coloring_function = [&, this](float data) {
-                    return (data * _depth_units - min) / (max - min);
-                };
-                make_rgb_data<uint16_t>(depth_data, rgb_data, w, h, coloring_function);
+                update_value_cropped_lut(cm, min, max);
+                colorize_z16(depth_data, rgb_data, w * h);
             }
         };
 
@@ -6,6 +6,8 @@
 #include <map>
 #include <vector>
 
+#include "concurrency.h"
+
 namespace rs2
 {
     class stream_profile;
@@ -153,6 +155,12 @@ namespace librealsense {
             }
         }
 
+        // Counts the values of the frame and fills the lookup table over their range with the colors of their equalized histogram
+        template<typename T>
+        void equalize_histogram(const T* depth_data, size_t count, color_map* cm);
+        void update_value_cropped_lut(color_map* cm, float min, float max);
+        void colorize_z16(const uint16_t* depth_data, uint8_t* rgb_data, size_t count);
+
         float _min, _max;
         bool _equalize;
 
@@ -168,5 +176,26 @@ namespace librealsense {
 
         float   _depth_units = 0.f;
         float   _d2d_convert_factor = 0.f;
+
+        // Values of a depth frame counted by one thread. Each value is counted in one of 4 interleaved
+        // sub-histograms, so that runs of equal depth do not serialize on the increments of a single counter.
+        // Bins are cleared back to zero once merged, the range bounds the non-zero depth values counted
+        struct histogram_counts
+        {
+            std::vector<int> bins;
+            int min = MAX_DEPTH, max = 0;
+        };
+        std::vector<histogram_counts> _counts;
+
+        // Packed RGB color of each 16 bit depth value. Value cropped tables are kept while the color map and range are unchanged,
+        // equalized tables are only valid over the range of the frame they were built for
+        std::vector<uint32_t> _lut;
+        bool _lut_cropped = false;
+        color_map* _lut_map = nullptr;
+        float _lut_min = 0.f, _lut_max = 0.f, _lut_depth_units = 0.f;
+        uint32_t _lut_zero_bin = 0;   // Color of the non-zero disparities below 1
+
+        uint8_t _processing_threads;
+        worker_pool _workers;
     };
 }
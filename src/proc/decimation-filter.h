@@ -16,6 +16,8 @@ namespace librealsense
         decimation_filter();
 
     protected:
+        friend class depth_postprocess;
+
         rs2::frame prepare_target_frame(const rs2::frame& f, const rs2::frame_source& source, rs2_extension tgt_type);
 
         void decimate_depth(const uint16_t * frame_data_in, uint16_t * frame_data_out,
@@ -0,0 +1,144 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2019 Intel Corporation. All Rights Reserved.
+
+#include "../include/librealsense2/hpp/rs_sensor.hpp"
+#include "../include/librealsense2/hpp/rs_processing.hpp"
+#include "option.h"
+#include "environment.h"
+#include "context.h"
+#include "software-device.h"
+#include "proc/synthetic-stream.h"
+#include "proc/decimation-filter.h"
+#include "proc/disparity-transform.h"
+#include "proc/spatial-filter.h"
+#include "proc/temporal-filter.h"
+#include "proc/hole-filling-filter.h"
+#include "proc/depth-postprocess.h"
+
+namespace librealsense
+{
+    depth_postprocess::depth_postprocess(std::shared_ptr<decimation_filter> decimation,
+                                         std::shared_ptr<spatial_filter> spatial,
+                                         std::shared_ptr<temporal_filter> temporal,
+                                         std::shared_ptr<hole_filling_filter> hole_filling,
+                                         bool use_disparity)
+        : depth_processing_block("Depth Post-Processing"),
+        _decimation(decimation),
+        _spatial(spatial),
+        _temporal(temporal),
+        _hole_filling(hole_filling),
+        _use_disparity(use_disparity),
+        _in_disparity(false),
+        _d2d_convert_factor(0.f),
+        _width(0), _height(0)
+    {
+        _stream_filter.stream = RS2_STREAM_DEPTH;
+        _stream_filter.format = RS2_FORMAT_Z16;
+    }
+
+    rs2::frame depth_postprocess::process_frame(const rs2::frame_source& source, const rs2::frame& f)
+    {
+        auto src = f.as<rs2::video_frame>();
+        rs2::frame tgt;
+        {
+            // The decimation settings determine the output resolution, so they are held until the frame is decimated
+            std::unique_lock<std::mutex> lock;
+            if (_decimation)
+            {
+                lock = std::unique_lock<std::mutex>(_decimation->_mutex);
+                _decimation->update_output_profile(f);
+            }
+
+            update_configuration(f);
+
+            tgt = source.allocate_video_frame(_target_stream_profile, f, sizeof(uint16_t), int(_width), int(_height),
+                int(_width * sizeof(uint16_t)), RS2_EXTENSION_DEPTH_FRAME);
+            if (!tgt)
+                return f;
+
+            auto depth = static_cast<uint16_t*>(const_cast<void*>(tgt.get_data()));
+            if (_decimation)
+                _decimation->decimate_depth(static_cast<const uint16_t*>(src.get_data()), depth,
+                    src.get_width(), src.get_height(), _decimation->_patch_size);
+            else
+                memcpy(depth, src.get_data(), _width * _height * sizeof(uint16_t));
+        }
+
+        auto depth = const_cast<void*>(tgt.get_data());
+        auto data = _in_disparity ? static_cast<void*>(_disparity.data()) : depth;
+
+        if (_in_disparity)
+            disparity_transform::convert<uint16_t, float>(depth, data, _width * _height, _d2d_convert_factor);
+
+        if (_spatial)
+        {
+            std::lock_guard<std::mutex> lock(_spatial->_mutex);
+            _spatial->filter_in_place(data);
+        }
+
+        if (_temporal)
+        {
+            std::lock_guard<std::mutex> lock(_temporal->_mutex);
+            _temporal->filter_in_place(data);
+        }
+
+        if (_in_disparity)
+            disparity_transform::convert<float, uint16_t>(data, depth, _width * _height, _d2d_convert_factor);
+
+        if (_hole_filling)
+        {
+            std::lock_guard<std::mutex> lock(_hole_filling->_mutex);
+            _hole_filling->filter_in_place(depth);
+        }
+
+        return tgt;
+    }
+
+    void depth_postprocess::update_configuration(const rs2::frame& f)
+    {
+        rs2::stream_profile target;
+        if (_decimation)
+        {
+            target = _decimation->_target_stream_profile;
+            _width = _decimation->_padded_width;
+            _height = _decimation->_padded_height;
+        }
+        else if (f.get_profile().get() != _source_stream_profile.get())
+        {
+            target = f.get_profile().clone(RS2_STREAM_DEPTH, 0, RS2_FORMAT_Z16);
+            auto vf = f.as<rs2::video_frame>();
+            _width = vf.get_width();
+            _height = vf.get_height();
+        }
+        _source_stream_profile = f.get_profile();
+
+        if (!target || target.get() == _target_stream_profile.get())
+            return;
+
+        // The output resolution changed, all stages start over as the chained blocks would on a new profile.
+        // The disparity conversion uses the focal length of the decimated stream
+        _target_stream_profile = target;
+        auto fx = _target_stream_profile.as<rs2::video_stream_profile>().get_intrinsics().fx;
+        auto info = disparity_info::update_info_from_frame(f, fx);
+        _in_disparity = _use_disparity && info.stereoscopic_depth && (_spatial || _temporal);
+        _d2d_convert_factor = info.d2d_convert_factor;
+        _disparity.resize(_in_disparity ? _width * _height : 0);
+
+        auto type = _in_disparity ? RS2_EXTENSION_DISPARITY_FRAME : RS2_EXTENSION_DEPTH_FRAME;
+        if (_spatial)
+        {
+            std::lock_guard<std::mutex> lock(_spatial->_mutex);
+            _spatial->configure(_width, _height, type);
+        }
+        if (_temporal)
+        {
+            std::lock_guard<std::mutex> lock(_temporal->_mutex);
+            _temporal->configure(_width, _height, type);
+        }
+        if (_hole_filling)
+        {
+            std::lock_guard<std::mutex> lock(_hole_filling->_mutex);
+            _hole_filling->configure(_width, _height, RS2_EXTENSION_DEPTH_FRAME);
+        }
+    }
+}
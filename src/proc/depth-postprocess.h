@@ -0,0 +1,49 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2019 Intel Corporation. All Rights Reserved.
+
+#pragma once
+
+#include "synthetic-stream.h"
+
+namespace librealsense
+{
+    class decimation_filter;
+    class spatial_filter;
+    class temporal_filter;
+    class hole_filling_filter;
+
+    // Runs the recommended depth post-processing chain as a single block:
+    // decimation -> depth to disparity -> spatial -> temporal -> disparity to depth -> hole filling.
+    // All stages work in place on the one output frame, plus a disparity buffer that is reused across frames,
+    // instead of each stage allocating and copying a frame of its own. The output matches that of the chained blocks.
+    // The stages are regular filter blocks configured through their own options, a stage passed as null is skipped.
+    // Blocks handed to depth_postprocess are driven by it and should not process frames on their own at the same time
+    class depth_postprocess : public depth_processing_block
+    {
+    public:
+        depth_postprocess(std::shared_ptr<decimation_filter> decimation,
+                          std::shared_ptr<spatial_filter> spatial,
+                          std::shared_ptr<temporal_filter> temporal,
+                          std::shared_ptr<hole_filling_filter> hole_filling,
+                          bool use_disparity);
+
+    protected:
+        rs2::frame process_frame(const rs2::frame_source& source, const rs2::frame& f) override;
+
+    private:
+        void    update_configuration(const rs2::frame& f);
+
+        std::shared_ptr<decimation_filter>      _decimation;
+        std::shared_ptr<spatial_filter>         _spatial;
+        std::shared_ptr<temporal_filter>        _temporal;
+        std::shared_ptr<hole_filling_filter>    _hole_filling;
+        bool                    _use_disparity;
+        bool                    _in_disparity;      // Spatial and temporal filters run in the disparity domain
+        float                   _d2d_convert_factor;
+        size_t                  _width, _height;
+        rs2::stream_profile     _source_stream_profile;
+        rs2::stream_profile     _target_stream_profile;
+        std::vector<float>      _disparity;         // Working buffer of the disparity domain stages
+    };
+    MAP_EXTENSION(RS2_EXTENSION_DEPTH_POSTPROCESS_FILTER, librealsense::depth_postprocess);
+}
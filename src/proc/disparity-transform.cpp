@@ -73,9 +73,9 @@ namespace librealsense
             auto src = f.as<rs2::video_frame>();
 
             if (_transform_to_disparity)
-                convert<uint16_t, float>(src.get_data(), const_cast<void*>(tgt.get_data()));
+                convert<uint16_t, float>(src.get_data(), const_cast<void*>(tgt.get_data()), _width * _height, _d2d_convert_factor);
             else
-                convert<float, uint16_t>(src.get_data(), const_cast<void*>(tgt.get_data()));
+                convert<float, uint16_t>(src.get_data(), const_cast<void*>(tgt.get_data()), _width * _height, _d2d_convert_factor);
         }
 
         return tgt;
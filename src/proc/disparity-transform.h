@@ -18,11 +18,9 @@ namespace librealsense
         bool should_process(const rs2::frame& frame) override;
         rs2::frame process_frame(const rs2::frame_source& source, const rs2::frame& f) override;
 
-    protected:
-        rs2::frame prepare_target_frame(const rs2::frame& f, const rs2::frame_source& source);
-
+        // Converts between depth and disparity, the factor is taken from disparity_info
         template<typename Tin, typename Tout>
-        void convert(const void* in_data, void* out_data)
+        static void convert(const void* in_data, void* out_data, size_t pixels, float d2d_convert_factor)
         {
             static_assert((std::is_arithmetic<Tin>::value), "disparity transform requires numeric type for input data");
             static_assert((std::is_arithmetic<Tout>::value), "disparity transform requires numeric type for output data");
@@ -35,18 +33,20 @@ namespace librealsense
 
             float input{};
             //TODO SSE optimize
-            for (auto i = 0; i < _height; i++)
-                for (auto j = 0; j < _width; j++)
-                {
-                    input = *in;
-                    if (std::isnormal(input))
-                        *out++ = static_cast<Tout>((_d2d_convert_factor / input)+round);
-                    else
-                        *out++ = 0;
-                    in++;
-                }
+            for (size_t i = 0; i < pixels; i++)
+            {
+                input = *in;
+                if (std::isnormal(input))
+                    *out++ = static_cast<Tout>((d2d_convert_factor / input)+round);
+                else
+                    *out++ = 0;
+                in++;
+            }
         }
 
+    protected:
+        rs2::frame prepare_target_frame(const rs2::frame& f, const rs2::frame_source& source);
+
     private:
         void    update_transformation_profile(const rs2::frame& f);
 
@@ -74,7 +74,9 @@ namespace librealsense
             float d2d_convert_factor = 0;
         };
 
-        static info update_info_from_frame(const rs2::frame& f)
+        // The conversion factor depends on the focal length of the stream being converted.
+        // Zero takes it from the frame's own profile, others are used to convert e.g. a decimated copy of the frame
+        static info update_info_from_frame(const rs2::frame& f, float focal_lenght_mm = 0.f)
         {
             // Check if the new frame originated from stereo-based depth sensor
             // and retrieve the stereo baseline parameter that will be used in transformations
@@ -107,8 +109,8 @@ namespace librealsense
 
             if (info.stereoscopic_depth)
             {
-                auto vp = f.get_profile().as<rs2::video_stream_profile>();
-                auto focal_lenght_mm = vp.get_intrinsics().fx;
+                if (!focal_lenght_mm)
+                    focal_lenght_mm = f.get_profile().as<rs2::video_stream_profile>().get_intrinsics().fx;
                 const uint8_t fractional_bits = 5;
                 const uint8_t fractions = 1 << fractional_bits;
                 info.d2d_convert_factor = (stereo_baseline_meter * focal_lenght_mm * fractions) / info.depth_units;
@@ -59,13 +59,18 @@ namespace librealsense
         update_configuration(f);
         auto tgt = prepare_target_frame(f, source);
 
+        filter_in_place(const_cast<void*>(tgt.get_data()));
+
+        return tgt;
+    }
+
+    void hole_filling_filter::filter_in_place(void* frame_data)
+    {
         // Hole filling pass
         if (_extension_type == RS2_EXTENSION_DISPARITY_FRAME)
-            apply_hole_filling<float>(const_cast<void*>(tgt.get_data()));
+            apply_hole_filling<float>(frame_data);
         else
-            apply_hole_filling<uint16_t>(const_cast<void*>(tgt.get_data()));
-
-        return tgt;
+            apply_hole_filling<uint16_t>(frame_data);
     }
 
     void  hole_filling_filter::update_configuration(const rs2::frame& f)
@@ -75,17 +80,21 @@ namespace librealsense
             _source_stream_profile = f.get_profile();
             _target_stream_profile = _source_stream_profile.clone(RS2_STREAM_DEPTH, 0, _source_stream_profile.format());
 
-            _extension_type = f.is<rs2::disparity_frame>() ? RS2_EXTENSION_DISPARITY_FRAME : RS2_EXTENSION_DEPTH_FRAME;
-            _bpp = (_extension_type == RS2_EXTENSION_DISPARITY_FRAME) ? sizeof(float) : sizeof(uint16_t);
             auto vp = _target_stream_profile.as<rs2::video_stream_profile>();
-            _width = vp.width();
-            _height = vp.height();
-            _stride = _width * _bpp;
-            _current_frm_size_pixels = _width * _height;
-
+            configure(vp.width(), vp.height(), f.is<rs2::disparity_frame>() ? RS2_EXTENSION_DISPARITY_FRAME : RS2_EXTENSION_DEPTH_FRAME);
         }
     }
 
+    void hole_filling_filter::configure(size_t width, size_t height, rs2_extension type)
+    {
+        _extension_type = type;
+        _bpp = (_extension_type == RS2_EXTENSION_DISPARITY_FRAME) ? sizeof(float) : sizeof(uint16_t);
+        _width = width;
+        _height = height;
+        _stride = _width * _bpp;
+        _current_frm_size_pixels = _width * _height;
+    }
+
     rs2::frame hole_filling_filter::prepare_target_frame(const rs2::frame& f, const rs2::frame_source& source)
     {
         // Allocate and copy the content of the input data to the target
@@ -19,7 +19,13 @@ namespace librealsense
         hole_filling_filter();
 
     protected:
+        friend class depth_postprocess;
+
         void update_configuration(const rs2::frame& f);
+
+        // Sets the layout of the frames to fill, also used by the fused depth_postprocess block
+        void configure(size_t width, size_t height, rs2_extension type);
+        void filter_in_place(void* frame_data);
         rs2::frame process_frame(const rs2::frame_source& source, const rs2::frame& f) override;
 
         rs2::frame prepare_target_frame(const rs2::frame& f, const rs2::frame_source& source);
@@ -24,25 +24,34 @@
 
 namespace librealsense
 {
-    template<class MAP_DEPTH> void deproject_depth(float * points, const rs2_intrinsics & intrin, const uint16_t * depth, MAP_DEPTH map_depth)
-    {
-        for (int y = 0; y < intrin.height; ++y)
-        {
-            for (int x = 0; x < intrin.width; ++x)
-            {
-                const float pixel[] = { (float)x, (float)y };
-                rs2_deproject_pixel_to_point(points, &intrin, pixel, map_depth(*depth++));
-                points += 3;
-            }
-        }
-    }
+    const uint8_t pc_threads_min = 1;
+    const uint8_t pc_threads_max = 16;
+    const uint8_t pc_threads_step = 1;
+    const uint8_t pc_threads_default = 1;
 
     const float3 * pointcloud::depth_to_points(rs2::points output, 
         const rs2_intrinsics &depth_intrinsics, const rs2::depth_frame& depth_frame, float depth_scale)
     {
-        auto image = output.get_vertices();
-        deproject_depth((float*)image, depth_intrinsics, (const uint16_t*)depth_frame.get_data(), [depth_scale](uint16_t z) { return depth_scale * z; });
-        return (float3*)image;
+        auto points = (float*)output.get_vertices();
+        auto depth = (const uint16_t*)depth_frame.get_data();
+        auto map_x = _pre_compute_map_x.data();
+        auto map_y = _pre_compute_map_y.data();
+        size_t width = depth_intrinsics.width;
+
+        _workers.resize(_processing_threads);
+        _workers.run(depth_intrinsics.height, [&](size_t begin, size_t end)
+        {
+            auto first = begin * width, last = end * width;
+            first += deproject_kernel(points + first * 3, depth + first, map_x + first, map_y + first, depth_scale, last - first);
+            for (auto i = first; i < last; ++i)
+            {
+                auto z = depth_scale * depth[i];
+                points[i * 3] = z * map_x[i];
+                points[i * 3 + 1] = z * map_y[i];
+                points[i * 3 + 2] = z;
+            }
+        });
+        return (float3*)points;
     }
 
     float3 transform(const rs2_extrinsics *extrin, const float3 &point) { float3 p = {}; rs2_transform_point_to_point(&p.x, extrin, &point.x); return p; }
@@ -50,6 +59,54 @@ namespace librealsense
     float2 pixel_to_texcoord(const rs2_intrinsics *intrin, const float2 & pixel) { return{ pixel.x / (intrin->width), pixel.y / (intrin->height) }; }
     float2 project_to_texcoord(const rs2_intrinsics *intrin, const float3 & point) { return pixel_to_texcoord(intrin, project(intrin, point)); }
 
+    void pointcloud::pre_compute_rays(const rs2_intrinsics& intrinsics)
+    {
+        if (_pre_compute_intrinsics && *_pre_compute_intrinsics == intrinsics)
+            return;
+
+        _pre_compute_map_x.resize(intrinsics.width * intrinsics.height);
+        _pre_compute_map_y.resize(intrinsics.width * intrinsics.height);
+
+        for (int y = 0; y < intrinsics.height; ++y)
+        {
+            for (int x = 0; x < intrinsics.width; ++x)
+            {
+                const float pixel[] = { (float)x, (float)y };
+                float ray[3];
+                rs2_deproject_pixel_to_point(ray, &intrinsics, pixel, 1.f);
+
+                _pre_compute_map_x[y * intrinsics.width + x] = ray[0];
+                _pre_compute_map_y[y * intrinsics.width + x] = ray[1];
+            }
+        }
+
+        _pre_compute_intrinsics = intrinsics;
+        _pre_compute_extrinsics = optional_value<rs2_extrinsics>();
+    }
+
+    void pointcloud::pre_compute_texture_rays(const rs2_extrinsics& extr)
+    {
+        if (_pre_compute_extrinsics && !memcmp(&*_pre_compute_extrinsics, &extr, sizeof(extr)))
+            return;
+
+        auto size = _pre_compute_map_x.size();
+        _pre_compute_tex_x.resize(size);
+        _pre_compute_tex_y.resize(size);
+        _pre_compute_tex_z.resize(size);
+
+        auto r = extr.rotation;
+        for (size_t i = 0; i < size; ++i)
+        {
+            auto x = _pre_compute_map_x[i];
+            auto y = _pre_compute_map_y[i];
+            _pre_compute_tex_x[i] = r[0] * x + r[3] * y + r[6];
+            _pre_compute_tex_y[i] = r[1] * x + r[4] * y + r[7];
+            _pre_compute_tex_z[i] = r[2] * x + r[5] * y + r[8];
+        }
+
+        _pre_compute_extrinsics = extr;
+    }
+
     void pointcloud::set_extrinsics()
     {
         if (_output_stream && _other_stream && !_extrinsics)
@@ -89,6 +146,7 @@ namespace librealsense
                 _pixels_map.resize(_depth_intrinsics->height*_depth_intrinsics->width);
                 _occlusion_filter->set_depth_intrinsics(_depth_intrinsics.value());
 
+                pre_compute_rays(_depth_intrinsics.value());
                 preprocess();
 
                 found_depth_intrinsics = true;
@@ -142,30 +200,34 @@ namespace librealsense
     {
         auto tex_ptr = (float2*)output.get_texture_coordinates();
 
-        for (unsigned int y = 0; y < height; ++y)
+        pre_compute_texture_rays(extr);
+        auto tex_x = _pre_compute_tex_x.data();
+        auto tex_y = _pre_compute_tex_y.data();
+        auto tex_z = _pre_compute_tex_z.data();
+
+        _workers.resize(_processing_threads);
+        _workers.run(height, [&](size_t begin, size_t end)
         {
-            for (unsigned int x = 0; x < width; ++x)
+            auto first = begin * width, last = end * width;
+            first += texture_map_kernel(tex_ptr + first, pixels_ptr + first, points + first,
+                tex_x + first, tex_y + first, tex_z + first, other_intrinsics, extr, last - first);
+            for (auto i = first; i < last; ++i)
             {
-                if (points->z)
+                if (auto z = points[i].z)
                 {
-                    auto trans = transform(&extr, *points);
-                    //auto tex_xy = project_to_texcoord(&mapped_intr, trans);
+                    // Same as transforming the point, with the rotation of its ray looked up
+                    float3 trans = { z * tex_x[i] + extr.translation[0], z * tex_y[i] + extr.translation[1], z * tex_z[i] + extr.translation[2] };
                     // Store intermediate results for poincloud filters
-                    *pixels_ptr = project(&other_intrinsics, trans);
-                    auto tex_xy = pixel_to_texcoord(&other_intrinsics, *pixels_ptr);
-
-                    *tex_ptr = tex_xy;
+                    pixels_ptr[i] = project(&other_intrinsics, trans);
+                    tex_ptr[i] = pixel_to_texcoord(&other_intrinsics, pixels_ptr[i]);
                 }
                 else
                 {
-                    *tex_ptr = { 0.f, 0.f };
-                    *pixels_ptr = { 0.f, 0.f };
+                    tex_ptr[i] = { 0.f, 0.f };
+                    pixels_ptr[i] = { 0.f, 0.f };
                 }
-                ++points;
-                ++tex_ptr;
-                ++pixels_ptr;
             }
-        }
+        });
     }
 
     rs2::points pointcloud::allocate_points(const rs2::frame_source& source, const rs2::frame& depth)
@@ -216,7 +278,9 @@ namespace librealsense
     {}
 
     pointcloud::pointcloud(const char* name)
-        : stream_filter_processing_block(name)
+        : stream_filter_processing_block(name),
+        _processing_threads(pc_threads_default),
+        _workers(pc_threads_default)
     {
         _occlusion_filter = std::make_shared<occlusion_filter>();
 
@@ -240,6 +304,14 @@ namespace librealsense
         occlusion_invalidation->set_description(1.f, "Heuristic");
         occlusion_invalidation->set_description(2.f, "Exhaustive");
         register_option(RS2_OPTION_FILTER_MAGNITUDE, occlusion_invalidation);
+
+        auto processing_threads = std::make_shared<ptr_option<uint8_t>>(
+            pc_threads_min,
+            pc_threads_max,
+            pc_threads_step,
+            pc_threads_default,
+            &_processing_threads, "Number of threads sharing the deprojection of a frame");
+        register_option(RS2_OPTION_PROCESSING_THREADS, processing_threads);
     }
 
     bool pointcloud::should_process(const rs2::frame& frame)
@@ -4,6 +4,7 @@
 #pragma once
 #include "../include/librealsense2/hpp/rs_frame.hpp"
 #include "synthetic-stream.h"
+#include "concurrency.h"
 
 namespace librealsense
 {
@@ -38,6 +39,13 @@ namespace librealsense
         bool should_process(const rs2::frame& frame) override;
         rs2::frame process_frame(const rs2::frame_source& source, const rs2::frame& f) override;
 
+        // Vectorized kernels of the derived blocks, run on the rows of one thread.
+        // Each one handles the leading pixels of the range and returns how many, the caller completes the rest
+        virtual size_t deproject_kernel(float* points, const uint16_t* depth, const float* ray_x, const float* ray_y,
+            float depth_scale, size_t count) const { return 0; }
+        virtual size_t texture_map_kernel(float2* tex, float2* pixels, const float3* points, const float* ray_x, const float* ray_y,
+            const float* ray_z, const rs2_intrinsics& other_intrinsics, const rs2_extrinsics& extr, size_t count) const { return 0; }
+
         optional_value<rs2_intrinsics>         _depth_intrinsics;
         optional_value<rs2_intrinsics>         _other_intrinsics;
         optional_value<float>                  _depth_units;
@@ -47,6 +55,19 @@ namespace librealsense
         // Intermediate translation table of (depth_x*depth_y) with actual texel coordinates per depth pixel
         std::vector<float2>                    _pixels_map;
 
+        // Deprojection ray of every depth pixel at unit depth, the point of a pixel is its ray scaled by the depth
+        std::vector<float>                     _pre_compute_map_x;
+        std::vector<float>                     _pre_compute_map_y;
+        optional_value<rs2_intrinsics>         _pre_compute_intrinsics;
+        // The same rays rotated to the texture stream, a point maps to (depth * ray + translation) there
+        std::vector<float>                     _pre_compute_tex_x;
+        std::vector<float>                     _pre_compute_tex_y;
+        std::vector<float>                     _pre_compute_tex_z;
+        optional_value<rs2_extrinsics>         _pre_compute_extrinsics;
+
+        uint8_t                                _processing_threads;
+        worker_pool                            _workers;
+
         rs2::stream_profile _output_stream;
         rs2::frame _other_stream;
         rs2::frame _depth_stream;
@@ -55,6 +76,8 @@ namespace librealsense
         void inspect_other_frame(const rs2::frame& other);
         rs2::frame process_depth_frame(const rs2::frame_source& source, const rs2::depth_frame& depth);
         void set_extrinsics();
+        void pre_compute_rays(const rs2_intrinsics& intrinsics);
+        void pre_compute_texture_rays(const rs2_extrinsics& extr);
 
         stream_filter _prev_stream_filter;
     };
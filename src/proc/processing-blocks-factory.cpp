@@ -4,6 +4,7 @@
 #include "processing-blocks-factory.h"
 #include "sse/sse-align.h"
 #include "cuda/cuda-align.h"
+#include "cpu-features.h"
 
 namespace librealsense
 {
@@ -16,6 +17,10 @@ namespace librealsense
 #ifdef __SSSE3__
     std::shared_ptr<librealsense::align> create_align(rs2_stream align_to)
     {
+#ifdef RS2_USE_AVX2
+        if (get_simd_level() == simd_level::avx2)
+            return std::make_shared<librealsense::align_avx>(align_to);
+#endif
         return std::make_shared<librealsense::align_sse>(align_to);
     }
 #else // No optimizations
@@ -48,6 +48,12 @@ namespace librealsense
     const uint8_t holes_fill_step = 1;
     const uint8_t holes_fill_def = sp_hf_disabled;
 
+    // Worker threads for the recursive passes, a single thread keeps the filter on the calling thread
+    const uint8_t threads_min = 1;
+    const uint8_t threads_max = 16;
+    const uint8_t threads_step = 1;
+    const uint8_t threads_def = 1;
+
     spatial_filter::spatial_filter() :
         depth_processing_block("Spatial Filter"),
         _spatial_alpha_param(alpha_default_val),
@@ -60,7 +66,9 @@ namespace librealsense
         _focal_lenght_mm(0.f),
         _stereo_baseline_mm(0.f),
         _holes_filling_mode(holes_fill_def),
-        _holes_filling_radius(0)
+        _holes_filling_radius(0),
+        _processing_threads(threads_def),
+        _workers(threads_def)
     {
         _stream_filter.stream = RS2_STREAM_DEPTH;
         _stream_filter.format = RS2_FORMAT_Z16;
@@ -144,7 +152,15 @@ namespace librealsense
         register_option(RS2_OPTION_FILTER_SMOOTH_ALPHA, spatial_filter_alpha);
         register_option(RS2_OPTION_FILTER_SMOOTH_DELTA, spatial_filter_delta);
         register_option(RS2_OPTION_FILTER_MAGNITUDE, spatial_filter_iterations);
+        auto processing_threads = std::make_shared<ptr_option<uint8_t>>(
+            threads_min,
+            threads_max,
+            threads_step,
+            threads_def,
+            &_processing_threads, "Number of threads running the filter passes");
+
         register_option(RS2_OPTION_HOLES_FILL, holes_filling_mode);
+        register_option(RS2_OPTION_PROCESSING_THREADS, processing_threads);
     }
 
     rs2::frame spatial_filter::process_frame(const rs2::frame_source& source, const rs2::frame& f)
@@ -154,13 +170,32 @@ namespace librealsense
         update_configuration(f);
         tgt = prepare_target_frame(f, source);
 
+        filter_in_place(const_cast<void*>(tgt.get_data()));
+
+        return tgt;
+    }
+
+    void spatial_filter::filter_in_place(void* frame_data)
+    {
+        // The pool is only resized here, between frames, since the option may be set from any thread
+        _workers.resize(_processing_threads);
+
         // Spatial domain transform edge-preserving filter
         if (_extension_type == RS2_EXTENSION_DISPARITY_FRAME)
-            dxf_smooth<float>(const_cast<void*>(tgt.get_data()), _spatial_alpha_param, _spatial_edge_threshold, _spatial_iterations);
+            dxf_smooth<float>(frame_data, _spatial_alpha_param, _spatial_edge_threshold, _spatial_iterations);
         else
-            dxf_smooth<uint16_t>(const_cast<void*>(tgt.get_data()), _spatial_alpha_param, _spatial_edge_threshold, _spatial_iterations);
+            dxf_smooth<uint16_t>(frame_data, _spatial_alpha_param, _spatial_edge_threshold, _spatial_iterations);
+    }
 
-        return tgt;
+    void spatial_filter::configure(size_t width, size_t height, rs2_extension type)
+    {
+        _extension_type = type;
+        _bpp = (_extension_type == RS2_EXTENSION_DISPARITY_FRAME) ? sizeof(float) : sizeof(uint16_t);
+        _width = width;
+        _height = height;
+        _stride = _width * _bpp;
+        _current_frm_size_pixels = _width * _height;
+        _spatial_edge_threshold = _spatial_delta_param;
     }
 
     void  spatial_filter::update_configuration(const rs2::frame& f)
@@ -170,14 +205,9 @@ namespace librealsense
             _source_stream_profile = f.get_profile();
             _target_stream_profile = _source_stream_profile.clone(RS2_STREAM_DEPTH, 0, _source_stream_profile.format());
 
-            _extension_type = f.is<rs2::disparity_frame>() ? RS2_EXTENSION_DISPARITY_FRAME : RS2_EXTENSION_DEPTH_FRAME;
-            _bpp = (_extension_type == RS2_EXTENSION_DISPARITY_FRAME) ? sizeof(float) : sizeof(uint16_t);
             auto vp = _target_stream_profile.as<rs2::video_stream_profile>();
             _focal_lenght_mm = vp.get_intrinsics().fx;
-            _width = vp.width();
-            _height = vp.height();
-            _stride = _width * _bpp;
-            _current_frm_size_pixels = _width * _height;
+            configure(vp.width(), vp.height(), f.is<rs2::disparity_frame>() ? RS2_EXTENSION_DISPARITY_FRAME : RS2_EXTENSION_DEPTH_FRAME);
 
             // Check if the new frame originated from stereo-based depth sensor
             // retrieve the stereo baseline parameter
@@ -212,8 +242,8 @@ namespace librealsense
                     _stereo_baseline_mm = dss->get_stereo_baseline_mm();
             }
 
-            _spatial_edge_threshold = _spatial_delta_param;// (_extension_type == RS2_EXTENSION_DISPARITY_FRAME) ?
-                                                           // (_focal_lenght_mm * _stereo_baseline_mm) / float(_spatial_delta_param) : _spatial_delta_param;
+            // Edge threshold is set by configure(), in depth units for both domains
+            // (_extension_type == RS2_EXTENSION_DISPARITY_FRAME) ? (_focal_lenght_mm * _stereo_baseline_mm) / float(_spatial_delta_param) : _spatial_delta_param;
         }
     }
 
@@ -226,13 +256,13 @@ namespace librealsense
         return tgt;
     }
 
-    void spatial_filter::recursive_filter_horizontal_fp(void * image_data, float alpha, float deltaZ)
+    void spatial_filter::recursive_filter_horizontal_fp(void * image_data, float alpha, float deltaZ, size_t first_row, size_t last_row)
     {
         float *image = reinterpret_cast<float*>(image_data);
 
         int v, u;
 
-        for (v = 0; v < _height;) {
+        for (v = int(first_row); v < last_row;) {
             // left to right
             float *im = image + v * _width;
             float state = *im;
@@ -354,7 +384,7 @@ namespace librealsense
         }
     }
 
-    void spatial_filter::recursive_filter_vertical_fp(void * image_data, float alpha, float deltaZ)
+    void spatial_filter::recursive_filter_vertical_fp(void * image_data, float alpha, float deltaZ, size_t first_column, size_t last_column)
     {
         float *image = reinterpret_cast<float*>(image_data);
 
@@ -362,7 +392,7 @@ namespace librealsense
 
         // we'll do one column at a time, top to bottom, bottom to top, left to right,
 
-        for (u = 0; u < _width;) {
+        for (u = int(first_column); u < last_column;) {
 
             float *im = image + u;
             float state = im[0];
@@ -12,6 +12,7 @@
 
 #include "../include/librealsense2/hpp/rs_frame.hpp"
 #include "../include/librealsense2/hpp/rs_processing.hpp"
+#include "../concurrency.h"
 
 namespace librealsense
 {
@@ -21,8 +22,14 @@ namespace librealsense
         spatial_filter();
 
     protected:
+        friend class depth_postprocess;
+
         void    update_configuration(const rs2::frame& f);
 
+        // Sets the layout of the frames to filter, either from the input profile or by the fused depth_postprocess block
+        void    configure(size_t width, size_t height, rs2_extension type);
+        void    filter_in_place(void* frame_data);
+
         rs2::frame prepare_target_frame(const rs2::frame& f, const rs2::frame_source& source);
         rs2::frame process_frame(const rs2::frame_source& source, const rs2::frame& f) override;
 
@@ -32,31 +39,40 @@ namespace librealsense
             static_assert((std::is_arithmetic<T>::value), "Spatial filter assumes numeric types");
             bool fp = (std::is_floating_point<T>::value);
 
-            for (int i = 0; i < iterations; i++)
+            // Rows are independent in the horizontal pass and columns in the vertical one,
+            // so each worker owns a fixed band of them and the result does not depend on the thread count
+            auto rows = [&](size_t first, size_t last)
             {
                 if (fp)
-                {
-                    recursive_filter_horizontal_fp(frame_data, alpha, delta);
-                    recursive_filter_vertical_fp(frame_data, alpha, delta);
-                }
+                    recursive_filter_horizontal_fp(frame_data, alpha, delta, first, last);
                 else
-                {
-                    recursive_filter_horizontal<T>(frame_data, alpha, delta);
-                    recursive_filter_vertical<T>(frame_data, alpha, delta);
-                }
+                    recursive_filter_horizontal<T>(frame_data, alpha, delta, first, last);
+            };
+            auto columns = [&](size_t first, size_t last)
+            {
+                if (fp)
+                    recursive_filter_vertical_fp(frame_data, alpha, delta, first, last);
+                else
+                    recursive_filter_vertical<T>(frame_data, alpha, delta, first, last);
+            };
+
+            for (int i = 0; i < iterations; i++)
+            {
+                _workers.run(_height, rows);
+                _workers.run(_width, columns);
             }
 
             // Disparity domain hole filling requires a second pass over the frame data
             // For depth domain a more efficient in-place hole filling is performed
             if (_holes_filling_mode && fp)
-                intertial_holes_fill<T>(static_cast<T*>(frame_data));
+                _workers.run(_height, [&](size_t first, size_t last) { intertial_holes_fill<T>(static_cast<T*>(frame_data), first, last); });
         }
 
-        void recursive_filter_horizontal_fp(void * image_data, float alpha, float deltaZ);
-        void recursive_filter_vertical_fp(void * image_data, float alpha, float deltaZ);
+        void recursive_filter_horizontal_fp(void * image_data, float alpha, float deltaZ, size_t first_row, size_t last_row);
+        void recursive_filter_vertical_fp(void * image_data, float alpha, float deltaZ, size_t first_column, size_t last_column);
 
         template <typename T>
-        void  recursive_filter_horizontal(void * image_data, float alpha, float deltaZ)
+        void  recursive_filter_horizontal(void * image_data, float alpha, float deltaZ, size_t first_row, size_t last_row)
         {
             size_t v{}, u{};
 
@@ -72,7 +88,7 @@ namespace librealsense
             auto image = reinterpret_cast<T*>(image_data);
             size_t cur_fill = 0;
 
-            for (v = 0; v < _height; v++)
+            for (v = first_row; v < last_row; v++)
             {
                 // left to right
                 T *im = image + v * _width;
@@ -151,7 +167,7 @@ namespace librealsense
         }
 
         template <typename T>
-        void recursive_filter_vertical(void * image_data, float alpha, float deltaZ)
+        void recursive_filter_vertical(void * image_data, float alpha, float deltaZ, size_t first_column, size_t last_column)
         {
             size_t v{}, u{};
 
@@ -170,12 +186,13 @@ namespace librealsense
 
             // top to bottom
 
-            T *im = image;
+            T *im = nullptr;
             T im0{};
             T imw{};
             for (v = 1; v < _height; v++)
             {
-                for (u = 0; u < _width; u++)
+                im = image + (v - 1) * _width + first_column;
+                for (u = first_column; u < last_column; u++)
                 {
                     im0 = im[0];
                     imw = im[_width];
@@ -194,10 +211,10 @@ namespace librealsense
             }
 
             // bottom to top
-            im = image + (_height - 2) * _width;
-            for (v = 1; v < _height; v++, im -= (_width * 2))
+            for (v = 1; v < _height; v++)
             {
-                for (u = 0; u < _width; u++)
+                im = image + (_height - 1 - v) * _width + first_column;
+                for (u = first_column; u < last_column; u++)
                 {
                     im0 = im[0];
                     imw = im[_width];
@@ -217,7 +234,7 @@ namespace librealsense
         }
 
         template<typename T>
-        inline void intertial_holes_fill(T* image_data)
+        inline void intertial_holes_fill(T* image_data, size_t first_row, size_t last_row)
         {
             std::function<bool(T*)> fp_oper = [](T* ptr) { return !*((int *)ptr); };
             std::function<bool(T*)> uint_oper = [](T* ptr) { return !(*ptr); };
@@ -225,8 +242,8 @@ namespace librealsense
 
             size_t cur_fill = 0;
 
-            T* p = image_data;
-            for (int j = 0; j < _height; ++j)
+            T* p = image_data + first_row * _width;
+            for (size_t j = first_row; j < last_row; ++j)
             {
                 ++p;
                 cur_fill = 0;
@@ -280,6 +297,8 @@ namespace librealsense
         float                   _stereo_baseline_mm;
         uint8_t                 _holes_filling_mode;
         uint8_t                 _holes_filling_radius;
+        uint8_t                 _processing_threads;
+        worker_pool             _workers;
     };
     MAP_EXTENSION(RS2_EXTENSION_SPATIAL_FILTER, librealsense::spatial_filter);
 }
@@ -0,0 +1,100 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2019 Intel Corporation. All Rights Reserved.
+
+#include "proc/sse/align-avx.h"
+
+#if defined(__SSSE3__) && defined(RS2_USE_AVX2)
+#include <immintrin.h>
+
+namespace librealsense
+{
+    namespace
+    {
+        struct projection
+        {
+            __m256 r[9], t[3], c[5];
+            __m256 two_c2, two_c3, fx, fy, ppx, ppy;
+            bool distort;
+        };
+
+        // Deprojection, transformation and projection of rsutil.h, operation by operation
+        inline void map_corner(const projection& p, __m256 depth, __m256 ray_x, __m256 ray_y, int2* out)
+        {
+            auto x = _mm256_mul_ps(depth, ray_x);
+            auto y = _mm256_mul_ps(depth, ray_y);
+
+            auto ox = _mm256_add_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(p.r[0], x), _mm256_mul_ps(p.r[3], y)), _mm256_mul_ps(p.r[6], depth)), p.t[0]);
+            auto oy = _mm256_add_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(p.r[1], x), _mm256_mul_ps(p.r[4], y)), _mm256_mul_ps(p.r[7], depth)), p.t[1]);
+            auto oz = _mm256_add_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(p.r[2], x), _mm256_mul_ps(p.r[5], y)), _mm256_mul_ps(p.r[8], depth)), p.t[2]);
+
+            x = _mm256_div_ps(ox, oz);
+            y = _mm256_div_ps(oy, oz);
+
+            if (p.distort)
+            {
+                auto one = _mm256_set1_ps(1);
+                auto two = _mm256_set1_ps(2);
+                auto r2 = _mm256_add_ps(_mm256_mul_ps(x, x), _mm256_mul_ps(y, y));
+                auto f = _mm256_add_ps(_mm256_add_ps(_mm256_add_ps(one, _mm256_mul_ps(p.c[0], r2)), _mm256_mul_ps(_mm256_mul_ps(p.c[1], r2), r2)),
+                    _mm256_mul_ps(_mm256_mul_ps(_mm256_mul_ps(p.c[4], r2), r2), r2));
+
+                auto x_f = _mm256_mul_ps(x, f);
+                auto y_f = _mm256_mul_ps(y, f);
+
+                x = _mm256_add_ps(_mm256_add_ps(x_f, _mm256_mul_ps(_mm256_mul_ps(p.two_c2, x_f), y_f)),
+                    _mm256_mul_ps(p.c[3], _mm256_add_ps(r2, _mm256_mul_ps(_mm256_mul_ps(two, x_f), x_f))));
+                y = _mm256_add_ps(_mm256_add_ps(y_f, _mm256_mul_ps(_mm256_mul_ps(p.two_c3, x_f), y_f)),
+                    _mm256_mul_ps(p.c[2], _mm256_add_ps(r2, _mm256_mul_ps(_mm256_mul_ps(two, y_f), y_f))));
+            }
+
+            // Rounded as static_cast<int>(pixel + 0.5f), truncating toward zero
+            auto half = _mm256_set1_ps(0.5f);
+            auto px = _mm256_cvttps_epi32(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(x, p.fx), p.ppx), half));
+            auto py = _mm256_cvttps_epi32(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(y, p.fy), p.ppy), half));
+
+            auto lo = _mm256_unpacklo_epi32(px, py);     // x0 y0 x1 y1 x4 y4 x5 y5
+            auto hi = _mm256_unpackhi_epi32(px, py);     // x2 y2 x3 y3 x6 y6 x7 y7
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(out), _mm256_permute2x128_si256(lo, hi, 0x20));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + 4), _mm256_permute2x128_si256(lo, hi, 0x31));
+        }
+    }
+
+    size_t map_depth_pixels_avx(const uint16_t* depth, float depth_scale,
+        const float* top_left_x, const float* top_left_y, const float* bottom_right_x, const float* bottom_right_y,
+        const rs2_extrinsics& depth_to_other, const rs2_intrinsics& other_intrin,
+        int2* top_left, int2* bottom_right, size_t count)
+    {
+        // The distortion models that need transcendental functions are left to the scalar code
+        if (other_intrin.model == RS2_DISTORTION_FTHETA || other_intrin.model == RS2_DISTORTION_KANNALA_BRANDT4)
+            return 0;
+
+        projection p;
+        for (int i = 0; i < 9; ++i)
+            p.r[i] = _mm256_set1_ps(depth_to_other.rotation[i]);
+        for (int i = 0; i < 3; ++i)
+            p.t[i] = _mm256_set1_ps(depth_to_other.translation[i]);
+        for (int i = 0; i < 5; ++i)
+            p.c[i] = _mm256_set1_ps(other_intrin.coeffs[i]);
+        p.two_c2 = _mm256_set1_ps(2 * other_intrin.coeffs[2]);
+        p.two_c3 = _mm256_set1_ps(2 * other_intrin.coeffs[3]);
+        p.fx = _mm256_set1_ps(other_intrin.fx);
+        p.fy = _mm256_set1_ps(other_intrin.fy);
+        p.ppx = _mm256_set1_ps(other_intrin.ppx);
+        p.ppy = _mm256_set1_ps(other_intrin.ppy);
+        p.distort = other_intrin.model == RS2_DISTORTION_MODIFIED_BROWN_CONRADY ||
+                    other_intrin.model == RS2_DISTORTION_INVERSE_BROWN_CONRADY;
+
+        auto scale = _mm256_set1_ps(depth_scale);
+        size_t n = count / 8 * 8;
+        for (size_t i = 0; i < n; i += 8)
+        {
+            auto d = _mm256_cvtepu16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(depth + i)));
+            auto z = _mm256_mul_ps(scale, _mm256_cvtepi32_ps(d));
+
+            map_corner(p, z, _mm256_loadu_ps(top_left_x + i), _mm256_loadu_ps(top_left_y + i), top_left + i);
+            map_corner(p, z, _mm256_loadu_ps(bottom_right_x + i), _mm256_loadu_ps(bottom_right_y + i), bottom_right + i);
+        }
+        return n;
+    }
+}
+#endif
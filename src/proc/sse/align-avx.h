@@ -0,0 +1,18 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2019 Intel Corporation. All Rights Reserved.
+
+#pragma once
+#include "types.h"
+
+namespace librealsense
+{
+    // Runtime-dispatched kernel, only to be called once has_avx2() confirmed CPU support.
+    // Maps depth pixels onto the other image as map_depth_pixel does, from the rays of their corners at unit depth.
+    // Handles the leading pixels that fill whole registers and returns how many, the caller completes the rest
+#if defined(__SSSE3__) && defined(RS2_USE_AVX2)
+    size_t map_depth_pixels_avx(const uint16_t* depth, float depth_scale,
+        const float* top_left_x, const float* top_left_y, const float* bottom_right_x, const float* bottom_right_y,
+        const rs2_extrinsics& depth_to_other, const rs2_intrinsics& other_intrin,
+        int2* top_left, int2* bottom_right, size_t count);
+#endif
+}
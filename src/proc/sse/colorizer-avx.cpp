@@ -0,0 +1,36 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2019 Intel Corporation. All Rights Reserved.
+
+#include "proc/sse/colorizer-avx.h"
+
+#if defined(__SSSE3__) && defined(RS2_USE_AVX2)
+#include <immintrin.h>
+
+namespace librealsense
+{
+    size_t colorize_lut_avx(const uint16_t* depth, const uint32_t* lut, uint8_t* rgb, size_t count)
+    {
+        // Moves the RGB bytes of the four entries of each lane to its 12 lowest bytes
+        const auto pack = _mm256_setr_epi8(0, 1, 2, 4, 5, 6, 8, 9, 10, 12, 13, 14, -1, -1, -1, -1,
+                                           0, 1, 2, 4, 5, 6, 8, 9, 10, 12, 13, 14, -1, -1, -1, -1);
+        auto table = reinterpret_cast<const int*>(lut);
+
+        size_t i = 0;
+        for (; i + 16 <= count; i += 16)
+        {
+            auto d = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(depth + i));
+            auto lo = _mm256_shuffle_epi8(_mm256_i32gather_epi32(table, _mm256_cvtepu16_epi32(_mm256_castsi256_si128(d)), 4), pack);
+            auto hi = _mm256_shuffle_epi8(_mm256_i32gather_epi32(table, _mm256_cvtepu16_epi32(_mm256_extracti128_si256(d, 1)), 4), pack);
+
+            // Four groups of 12 bytes make the 48 bytes of the 16 pixels
+            auto a = _mm256_castsi256_si128(lo), b = _mm256_extracti128_si256(lo, 1);
+            auto c = _mm256_castsi256_si128(hi), e = _mm256_extracti128_si256(hi, 1);
+            auto out = reinterpret_cast<__m128i*>(rgb + i * 3);
+            _mm_storeu_si128(out, _mm_or_si128(a, _mm_slli_si128(b, 12)));
+            _mm_storeu_si128(out + 1, _mm_or_si128(_mm_srli_si128(b, 4), _mm_slli_si128(c, 8)));
+            _mm_storeu_si128(out + 2, _mm_or_si128(_mm_srli_si128(c, 8), _mm_slli_si128(e, 4)));
+        }
+        return i;
+    }
+}
+#endif
@@ -0,0 +1,15 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2019 Intel Corporation. All Rights Reserved.
+
+#pragma once
+#include "types.h"
+
+namespace librealsense
+{
+    // Runtime-dispatched kernel, only to be called once has_avx2() confirmed CPU support.
+    // Writes the RGB colors the lookup table holds for the depth pixels, packed as RGBX, gathering 8 entries per instruction.
+    // Handles the leading pixels that fill whole registers and returns how many, the caller completes the rest
+#if defined(__SSSE3__) && defined(RS2_USE_AVX2)
+    size_t colorize_lut_avx(const uint16_t* depth, const uint32_t* lut, uint8_t* rgb, size_t count);
+#endif
+}
@@ -0,0 +1,116 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2019 Intel Corporation. All Rights Reserved.
+
+#include "proc/sse/pointcloud-avx.h"
+
+#if defined(__SSSE3__) && defined(RS2_USE_AVX2)
+#include <immintrin.h>
+
+namespace librealsense
+{
+    size_t deproject_depth_avx(float* points, const uint16_t* depth, const float* ray_x, const float* ray_y,
+        float depth_scale, size_t count)
+    {
+        auto scale = _mm256_set1_ps(depth_scale);
+        size_t n = count / 8 * 8;
+
+        for (size_t i = 0; i < n; i += 8)
+        {
+            auto d = _mm256_cvtepu16_epi32(_mm_loadu_si128((const __m128i*)(depth + i)));
+            auto z = _mm256_mul_ps(_mm256_cvtepi32_ps(d), scale);
+            auto x = _mm256_mul_ps(z, _mm256_loadu_ps(ray_x + i));
+            auto y = _mm256_mul_ps(z, _mm256_loadu_ps(ray_y + i));
+
+            // Interleave within each 128-bit lane, as the SSE kernel does: points 0-3 in the low lanes, 4-7 in the high ones
+            auto x_y = _mm256_shuffle_ps(x, y, _MM_SHUFFLE(2, 0, 2, 0));
+            auto z_x = _mm256_shuffle_ps(z, x, _MM_SHUFFLE(3, 1, 2, 0));
+            auto y_z = _mm256_shuffle_ps(y, z, _MM_SHUFFLE(3, 1, 3, 1));
+
+            auto xyz1 = _mm256_shuffle_ps(x_y, z_x, _MM_SHUFFLE(2, 0, 2, 0));
+            auto xyz2 = _mm256_shuffle_ps(y_z, x_y, _MM_SHUFFLE(3, 1, 2, 0));
+            auto xyz3 = _mm256_shuffle_ps(z_x, y_z, _MM_SHUFFLE(3, 1, 3, 1));
+
+            _mm256_storeu_ps(points + i * 3, _mm256_permute2f128_ps(xyz1, xyz2, 0x20));
+            _mm256_storeu_ps(points + i * 3 + 8, _mm256_permute2f128_ps(xyz3, xyz1, 0x30));
+            _mm256_storeu_ps(points + i * 3 + 16, _mm256_permute2f128_ps(xyz2, xyz3, 0x31));
+        }
+        return n;
+    }
+
+    size_t texture_map_avx(float2* tex, float2* pixels, const float3* points, const float* ray_x, const float* ray_y,
+        const float* ray_z, const rs2_intrinsics& other_intrinsics, const rs2_extrinsics& extr, size_t count)
+    {
+        const __m256i z_index = _mm256_setr_epi32(2, 5, 8, 11, 14, 17, 20, 23);
+
+        auto t0 = _mm256_set1_ps(extr.translation[0]);
+        auto t1 = _mm256_set1_ps(extr.translation[1]);
+        auto t2 = _mm256_set1_ps(extr.translation[2]);
+        auto c0 = _mm256_set1_ps(other_intrinsics.coeffs[0]);
+        auto c1 = _mm256_set1_ps(other_intrinsics.coeffs[1]);
+        auto c2 = _mm256_set1_ps(other_intrinsics.coeffs[2]);
+        auto c3 = _mm256_set1_ps(other_intrinsics.coeffs[3]);
+        auto c4 = _mm256_set1_ps(other_intrinsics.coeffs[4]);
+        auto two_c2 = _mm256_set1_ps(2 * other_intrinsics.coeffs[2]);
+        auto two_c3 = _mm256_set1_ps(2 * other_intrinsics.coeffs[3]);
+        auto fx = _mm256_set1_ps(other_intrinsics.fx);
+        auto fy = _mm256_set1_ps(other_intrinsics.fy);
+        auto ppx = _mm256_set1_ps(other_intrinsics.ppx);
+        auto ppy = _mm256_set1_ps(other_intrinsics.ppy);
+        auto w = _mm256_set1_ps(float(other_intrinsics.width));
+        auto h = _mm256_set1_ps(float(other_intrinsics.height));
+        auto distort = other_intrinsics.model == RS2_DISTORTION_MODIFIED_BROWN_CONRADY ||
+                       other_intrinsics.model == RS2_DISTORTION_INVERSE_BROWN_CONRADY;
+        auto zero = _mm256_setzero_ps();
+        auto one = _mm256_set1_ps(1);
+        auto two = _mm256_set1_ps(2);
+
+        size_t n = count / 8 * 8;
+        for (size_t i = 0; i < n; i += 8)
+        {
+            auto z = _mm256_i32gather_ps(reinterpret_cast<const float*>(points + i), z_index, 4);
+
+            // Transform to the other stream with the rotated rays
+            auto x = _mm256_add_ps(_mm256_mul_ps(z, _mm256_loadu_ps(ray_x + i)), t0);
+            auto y = _mm256_add_ps(_mm256_mul_ps(z, _mm256_loadu_ps(ray_y + i)), t1);
+            auto pz = _mm256_add_ps(_mm256_mul_ps(z, _mm256_loadu_ps(ray_z + i)), t2);
+
+            x = _mm256_div_ps(x, pz);
+            y = _mm256_div_ps(y, pz);
+
+            if (distort)
+            {
+                auto r2 = _mm256_add_ps(_mm256_mul_ps(x, x), _mm256_mul_ps(y, y));
+                auto f = _mm256_add_ps(_mm256_add_ps(_mm256_add_ps(one, _mm256_mul_ps(c0, r2)), _mm256_mul_ps(_mm256_mul_ps(c1, r2), r2)),
+                    _mm256_mul_ps(_mm256_mul_ps(_mm256_mul_ps(c4, r2), r2), r2));
+
+                auto x_f = _mm256_mul_ps(x, f);
+                auto y_f = _mm256_mul_ps(y, f);
+
+                x = _mm256_add_ps(_mm256_add_ps(x_f, _mm256_mul_ps(_mm256_mul_ps(two_c2, x_f), y_f)),
+                    _mm256_mul_ps(c3, _mm256_add_ps(r2, _mm256_mul_ps(_mm256_mul_ps(two, x_f), x_f))));
+                y = _mm256_add_ps(_mm256_add_ps(y_f, _mm256_mul_ps(_mm256_mul_ps(two_c3, x_f), y_f)),
+                    _mm256_mul_ps(c2, _mm256_add_ps(r2, _mm256_mul_ps(_mm256_mul_ps(two, y_f), y_f))));
+            }
+
+            // Pixels without depth map to (0, 0)
+            auto valid = _mm256_cmp_ps(z, zero, _CMP_NEQ_UQ);
+            x = _mm256_and_ps(_mm256_add_ps(_mm256_mul_ps(x, fx), ppx), valid);
+            y = _mm256_and_ps(_mm256_add_ps(_mm256_mul_ps(y, fy), ppy), valid);
+
+            auto lo = _mm256_unpacklo_ps(x, y);     // x0 y0 x1 y1 x4 y4 x5 y5
+            auto hi = _mm256_unpackhi_ps(x, y);     // x2 y2 x3 y3 x6 y6 x7 y7
+            _mm256_storeu_ps(reinterpret_cast<float*>(pixels + i), _mm256_permute2f128_ps(lo, hi, 0x20));
+            _mm256_storeu_ps(reinterpret_cast<float*>(pixels + i + 4), _mm256_permute2f128_ps(lo, hi, 0x31));
+
+            x = _mm256_div_ps(x, w);
+            y = _mm256_div_ps(y, h);
+
+            lo = _mm256_unpacklo_ps(x, y);
+            hi = _mm256_unpackhi_ps(x, y);
+            _mm256_storeu_ps(reinterpret_cast<float*>(tex + i), _mm256_permute2f128_ps(lo, hi, 0x20));
+            _mm256_storeu_ps(reinterpret_cast<float*>(tex + i + 4), _mm256_permute2f128_ps(lo, hi, 0x31));
+        }
+        return n;
+    }
+}
+#endif
@@ -0,0 +1,17 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2019 Intel Corporation. All Rights Reserved.
+
+#pragma once
+#include "types.h"
+
+namespace librealsense
+{
+    // Runtime-dispatched kernels, only to be called once has_avx2() confirmed CPU support.
+    // Each one handles the leading pixels that fill whole registers and returns how many, the caller completes the rest
+#if defined(__SSSE3__) && defined(RS2_USE_AVX2)
+    size_t deproject_depth_avx(float* points, const uint16_t* depth, const float* ray_x, const float* ray_y,
+        float depth_scale, size_t count);
+    size_t texture_map_avx(float2* tex, float2* pixels, const float3* points, const float* ray_x, const float* ray_y,
+        const float* ray_z, const rs2_intrinsics& other_intrinsics, const rs2_extrinsics& extr, size_t count);
+#endif
+}
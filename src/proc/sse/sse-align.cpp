@@ -3,6 +3,7 @@
 #ifdef __SSSE3__
 
 #include "sse-align.h"
+#include "align-avx.h"
 #include <tmmintrin.h> // For SSE3 intrinsic used in unpack_yuy2_sse
 #include "../include/librealsense2/hpp/rs_sensor.hpp"
 #include "../include/librealsense2/hpp/rs_processing.hpp"
@@ -12,6 +13,8 @@
 #include "proc/synthetic-stream.h"
 #include "environment.h"
 #include "stream.h"
+#include "option.h"
+#include "cpu-features.h"
 
 using namespace librealsense;
 
@@ -447,4 +450,202 @@ void align_sse::align_other_to_z(rs2::video_frame& aligned, const rs2::video_fra
 
     _stream_transform->align_other_to_depth(z_pixels, other_pixels, aligned_data, other.get_bytes_per_pixel(), other_intrin, z_to_other);
 }
+
+#ifdef RS2_USE_AVX2
+const uint8_t align_threads_min = 1;
+const uint8_t align_threads_max = 16;
+const uint8_t align_threads_step = 1;
+const uint8_t align_threads_default = 1;
+
+align_avx::align_avx(rs2_stream to_stream)
+    : align(to_stream, "Align (AVX2)"),
+    _processing_threads(align_threads_default),
+    _workers(align_threads_default)
+{
+    auto processing_threads = std::make_shared<ptr_option<uint8_t>>(
+        align_threads_min,
+        align_threads_max,
+        align_threads_step,
+        align_threads_default,
+        &_processing_threads, "Number of threads sharing the alignment of a frame");
+    register_option(RS2_OPTION_PROCESSING_THREADS, processing_threads);
+}
+
+void align_avx::map_depth_pixels(const uint16_t* z_pixels, float z_scale, const rs2_intrinsics& z_intrin,
+    const rs2_extrinsics& z_to_other, const rs2_intrinsics& other_intrin)
+{
+    if (!_pre_compute_intrinsics || !(*_pre_compute_intrinsics == z_intrin))
+    {
+        auto size = z_intrin.width * z_intrin.height;
+        _pre_compute_map_x_top_left.resize(size);
+        _pre_compute_map_y_top_left.resize(size);
+        _pre_compute_map_x_bottom_right.resize(size);
+        _pre_compute_map_y_bottom_right.resize(size);
+        for (int y = 0; y < z_intrin.height; ++y)
+        {
+            for (int x = 0; x < z_intrin.width; ++x)
+            {
+                // Deprojection is linear in the depth, so a ray scaled by the depth is the deprojected point
+                float top_left[] = { x - 0.5f, y - 0.5f }, bottom_right[] = { x + 0.5f, y + 0.5f }, ray[3];
+                rs2_deproject_pixel_to_point(ray, &z_intrin, top_left, 1.f);
+                _pre_compute_map_x_top_left[y * z_intrin.width + x] = ray[0];
+                _pre_compute_map_y_top_left[y * z_intrin.width + x] = ray[1];
+                rs2_deproject_pixel_to_point(ray, &z_intrin, bottom_right, 1.f);
+                _pre_compute_map_x_bottom_right[y * z_intrin.width + x] = ray[0];
+                _pre_compute_map_y_bottom_right[y * z_intrin.width + x] = ray[1];
+            }
+        }
+        _pixel_top_left_int.resize(size);
+        _pixel_bottom_right_int.resize(size);
+        _row_span.resize(z_intrin.height);
+        _pre_compute_intrinsics = z_intrin;
+    }
+
+    size_t width = z_intrin.width;
+    _workers.resize(_processing_threads);
+    _workers.run(z_intrin.height, [&](size_t begin, size_t end)
+    {
+        for (auto y = begin; y < end; ++y)
+        {
+            auto row = y * width;
+            auto top_left = _pixel_top_left_int.data() + row;
+            auto bottom_right = _pixel_bottom_right_int.data() + row;
+
+            size_t x = 0;
+            if (get_simd_level() == simd_level::avx2)
+                x = map_depth_pixels_avx(z_pixels + row, z_scale,
+                    _pre_compute_map_x_top_left.data() + row, _pre_compute_map_y_top_left.data() + row,
+                    _pre_compute_map_x_bottom_right.data() + row, _pre_compute_map_y_bottom_right.data() + row,
+                    z_to_other, other_intrin, top_left, bottom_right, width);
+            for (; x < width; ++x)
+            {
+                if (float depth = z_scale * z_pixels[row + x])
+                    map_depth_pixel(z_intrin, z_to_other, other_intrin, int(x), int(y), depth, top_left[x], bottom_right[x]);
+            }
+
+            // Skip the same depth pixels as the scalar align does
+            int2 span = { other_intrin.height, -1 };
+            for (x = 0; x < width; ++x)
+            {
+                auto& tl = top_left[x];
+                auto& br = bottom_right[x];
+                if (!(z_scale * z_pixels[row + x]) || tl.x < 0 || tl.y < 0 || br.x >= other_intrin.width || br.y >= other_intrin.height ||
+                    tl.x > br.x || tl.y > br.y)
+                {
+                    tl = { 0, 0 };
+                    br = { -1, -1 };
+                    continue;
+                }
+                span.x = std::min(span.x, tl.y);
+                span.y = std::max(span.y, br.y);
+            }
+            _row_span[y] = span;
+        }
+    });
+}
+
+void align_avx::align_z_to_other(rs2::video_frame& aligned, const rs2::video_frame& depth, const rs2::video_stream_profile& other_profile, float z_scale)
+{
+    byte* aligned_data = reinterpret_cast<byte*>(const_cast<void*>(aligned.get_data()));
+    auto aligned_profile = aligned.get_profile().as<rs2::video_stream_profile>();
+    memset(aligned_data, 0, aligned_profile.height() * aligned_profile.width() * aligned.get_bytes_per_pixel());
+
+    auto depth_profile = depth.get_profile().as<rs2::video_stream_profile>();
+
+    auto z_intrin = depth_profile.get_intrinsics();
+    auto other_intrin = other_profile.get_intrinsics();
+    auto z_to_other = depth_profile.get_extrinsics_to(other_profile);
+
+    auto z_pixels = reinterpret_cast<const uint16_t*>(depth.get_data());
+    auto out_z = reinterpret_cast<uint16_t*>(aligned_data);
+
+    map_depth_pixels(z_pixels, z_scale, z_intrin, z_to_other, other_intrin);
+
+    // Each thread owns a band of rows of the aligned image and keeps the nearest depth that falls there.
+    // A minimum does not depend on the order of the writes, so the result is that of a serial pass
+    _workers.run(other_intrin.height, [&](size_t begin, size_t end)
+    {
+        int first = int(begin), last = int(end) - 1;
+        for (int y = 0; y < z_intrin.height; ++y)
+        {
+            if (_row_span[y].y < first || _row_span[y].x > last)
+                continue;
+
+            for (int x = 0; x < z_intrin.width; ++x)
+            {
+                auto depth_pixel_index = y * z_intrin.width + x;
+                auto& tl = _pixel_top_left_int[depth_pixel_index];
+                auto& br = _pixel_bottom_right_int[depth_pixel_index];
+                auto z = z_pixels[depth_pixel_index];
+                for (int other_y = std::max(tl.y, first); other_y <= std::min(br.y, last); ++other_y)
+                {
+                    for (int other_x = tl.x; other_x <= br.x; ++other_x)
+                    {
+                        auto& out = out_z[other_y * other_intrin.width + other_x];
+                        out = out ? std::min(out, z) : z;
+                    }
+                }
+            }
+        }
+    });
+}
+
+template<int N>
+void align_avx::move_other_to_depth(const byte* source, byte* dest, const rs2_intrinsics& z_intrin, const rs2_intrinsics& other_intrin)
+{
+    auto in_other = reinterpret_cast<const bytes<N>*>(source);
+    auto out_other = reinterpret_cast<bytes<N>*>(dest);
+
+    // The scalar align transfers every pixel of the rectangle in turn, the bottom-right one is the last written
+    _workers.run(z_intrin.height, [&](size_t begin, size_t end)
+    {
+        for (auto i = begin * z_intrin.width; i < end * z_intrin.width; ++i)
+        {
+            auto& br = _pixel_bottom_right_int[i];
+            if (br.x >= 0)
+                out_other[i] = in_other[br.y * other_intrin.width + br.x];
+        }
+    });
+}
+
+void align_avx::align_other_to_z(rs2::video_frame& aligned, const rs2::video_frame& depth, const rs2::video_frame& other, float z_scale)
+{
+    byte* aligned_data = reinterpret_cast<byte*>(const_cast<void*>(aligned.get_data()));
+    auto aligned_profile = aligned.get_profile().as<rs2::video_stream_profile>();
+    memset(aligned_data, 0, aligned_profile.height() * aligned_profile.width() * aligned.get_bytes_per_pixel());
+
+    auto depth_profile = depth.get_profile().as<rs2::video_stream_profile>();
+    auto other_profile = other.get_profile().as<rs2::video_stream_profile>();
+
+    auto z_intrin = depth_profile.get_intrinsics();
+    auto other_intrin = other_profile.get_intrinsics();
+    auto z_to_other = depth_profile.get_extrinsics_to(other_profile);
+
+    auto z_pixels = reinterpret_cast<const uint16_t*>(depth.get_data());
+    auto other_pixels = reinterpret_cast<const byte*>(other.get_data());
+
+    map_depth_pixels(z_pixels, z_scale, z_intrin, z_to_other, other_intrin);
+
+    switch (other_profile.format())
+    {
+    case RS2_FORMAT_Y8:
+        move_other_to_depth<1>(other_pixels, aligned_data, z_intrin, other_intrin);
+        break;
+    case RS2_FORMAT_Y16:
+    case RS2_FORMAT_Z16:
+        move_other_to_depth<2>(other_pixels, aligned_data, z_intrin, other_intrin);
+        break;
+    case RS2_FORMAT_RGB8:
+    case RS2_FORMAT_BGR8:
+        move_other_to_depth<3>(other_pixels, aligned_data, z_intrin, other_intrin);
+        break;
+    case RS2_FORMAT_RGBA8:
+    case RS2_FORMAT_BGRA8:
+        move_other_to_depth<4>(other_pixels, aligned_data, z_intrin, other_intrin);
+        break;
+    default:
+        assert(false); // As in the scalar align, formats with shared chroma samples are not aligned
+    }
+}
+#endif
 #endif
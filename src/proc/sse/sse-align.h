@@ -4,6 +4,7 @@
 #ifdef __SSSE3__
 
 #include "proc/align.h"
+#include "concurrency.h"
 
 namespace librealsense
 {
@@ -85,5 +86,43 @@ namespace librealsense
     private:
         std::shared_ptr<image_transform> _stream_transform;
     };
+
+#ifdef RS2_USE_AVX2
+    // Produces exactly the output of the scalar align. The corners of the depth pixels are mapped with AVX2,
+    // depth rows are split across a worker pool, and the aligned depth image is written in bands of rows,
+    // one thread per band keeping the nearest depth of every pixel, so collisions resolve as in a serial pass
+    class align_avx : public align
+    {
+    public:
+        align_avx(rs2_stream to_stream);
+
+    protected:
+        void align_z_to_other(rs2::video_frame& aligned, const rs2::video_frame& depth, const rs2::video_stream_profile& other_profile, float z_scale) override;
+
+        void align_other_to_z(rs2::video_frame& aligned, const rs2::video_frame& depth, const rs2::video_frame& other, float z_scale) override;
+
+    private:
+        // Fills the rectangle of other image pixels covered by each depth pixel, an empty one when nothing is transferred
+        void map_depth_pixels(const uint16_t* z_pixels, float z_scale, const rs2_intrinsics& z_intrin,
+            const rs2_extrinsics& z_to_other, const rs2_intrinsics& other_intrin);
+
+        template<int N>
+        void move_other_to_depth(const byte* source, byte* dest, const rs2_intrinsics& z_intrin, const rs2_intrinsics& other_intrin);
+
+        // Corner rays of the depth pixels at unit depth
+        std::vector<float> _pre_compute_map_x_top_left;
+        std::vector<float> _pre_compute_map_y_top_left;
+        std::vector<float> _pre_compute_map_x_bottom_right;
+        std::vector<float> _pre_compute_map_y_bottom_right;
+        optional_value<rs2_intrinsics> _pre_compute_intrinsics;
+
+        std::vector<int2> _pixel_top_left_int;
+        std::vector<int2> _pixel_bottom_right_int;
+        std::vector<int2> _row_span;    // First and last row of the other image covered by each depth row
+
+        uint8_t _processing_threads;
+        worker_pool _workers;
+    };
+#endif
 }
 #endif // __SSSE3__
@@ -8,9 +8,11 @@
 #include "environment.h"
 #include "proc/occlusion-filter.h"
 #include "proc/sse/sse-pointcloud.h"
+#include "proc/sse/pointcloud-avx.h"
 #include "option.h"
 #include "environment.h"
 #include "context.h"
+#include "cpu-features.h"
 
 #include <iostream>
 
@@ -24,52 +26,16 @@ namespace librealsense
 {
     pointcloud_sse::pointcloud_sse() : pointcloud("Pointcloud (SSE3)") {}
 
-    void pointcloud_sse::preprocess()
-    {
-        _pre_compute_map_x.resize(_depth_intrinsics->width*_depth_intrinsics->height);
-        _pre_compute_map_y.resize(_depth_intrinsics->width*_depth_intrinsics->height);
-
-        for (int h = 0; h < _depth_intrinsics->height; ++h)
-        {
-            for (int w = 0; w < _depth_intrinsics->width; ++w)
-            {
-                const float pixel[] = { (float)w, (float)h };
-
-                float x = (pixel[0] - _depth_intrinsics->ppx) / _depth_intrinsics->fx;
-                float y = (pixel[1] - _depth_intrinsics->ppy) / _depth_intrinsics->fy;
-
-
-                if (_depth_intrinsics->model == RS2_DISTORTION_INVERSE_BROWN_CONRADY)
-                {
-                    float r2 = x * x + y * y;
-                    float f = 1 + _depth_intrinsics->coeffs[0] * r2 + _depth_intrinsics->coeffs[1] * r2*r2 + _depth_intrinsics->coeffs[4] * r2*r2*r2;
-                    float ux = x * f + 2 * _depth_intrinsics->coeffs[2] * x*y + _depth_intrinsics->coeffs[3] * (r2 + 2 * x*x);
-                    float uy = y * f + 2 * _depth_intrinsics->coeffs[3] * x*y + _depth_intrinsics->coeffs[2] * (r2 + 2 * y*y);
-                    x = ux;
-                    y = uy;
-                }
-
-                _pre_compute_map_x[h*_depth_intrinsics->width + w] = x;
-                _pre_compute_map_y[h*_depth_intrinsics->width + w] = y;
-            }
-        }
-    }
-
-    const float3* pointcloud_sse::depth_to_points(rs2::points output,
-            const rs2_intrinsics &depth_intrinsics, 
-            const rs2::depth_frame& depth_frame,
-            float depth_scale)
+    size_t pointcloud_sse::deproject_kernel(float* points, const uint16_t* depth, const float* ray_x, const float* ray_y,
+        float depth_scale, size_t count) const
     {
+#if defined(__SSSE3__) && defined(RS2_USE_AVX2)
+        if (get_simd_level() == simd_level::avx2)
+            return deproject_depth_avx(points, depth, ray_x, ray_y, depth_scale, count);
+#endif
 #ifdef __SSSE3__
-
-        auto depth_image = (const uint16_t*)depth_frame.get_data();
-
-        float* pre_compute_x = _pre_compute_map_x.data();
-        float* pre_compute_y = _pre_compute_map_y.data();
-
-        uint32_t size = depth_intrinsics.height * depth_intrinsics.width;
-
-        auto point = (float*)output.get_vertices();
+        if (get_simd_level() < simd_level::ssse3)
+            return 0;
 
         //mask for shuffle
         const __m128i mask0 = _mm_set_epi8((char)0xff, (char)0xff, (char)7, (char)6, (char)0xff, (char)0xff, (char)5, (char)4,
@@ -78,19 +44,18 @@ namespace librealsense
             (char)0xff, (char)0xff, (char)11, (char)10, (char)0xff, (char)0xff, (char)9, (char)8);
 
         auto scale = _mm_set_ps1(depth_scale);
+        auto point = points;
+        size_t n = count / 8 * 8;
 
-        auto mapx = pre_compute_x;
-        auto mapy = pre_compute_y;
-
-        for (unsigned int i = 0; i < size; i += 8)
+        for (size_t i = 0; i < n; i += 8)
         {
-            auto x0 = _mm_load_ps(mapx + i);
-            auto x1 = _mm_load_ps(mapx + i + 4);
+            auto x0 = _mm_loadu_ps(ray_x + i);
+            auto x1 = _mm_loadu_ps(ray_x + i + 4);
 
-            auto y0 = _mm_load_ps(mapy + i);
-            auto y1 = _mm_load_ps(mapy + i + 4);
+            auto y0 = _mm_loadu_ps(ray_y + i);
+            auto y1 = _mm_loadu_ps(ray_y + i + 4);
 
-            __m128i d = _mm_load_si128((__m128i const*)(depth_image + i));        //d7 d7 d6 d6 d5 d5 d4 d4 d3 d3 d2 d2 d1 d1 d0 d0
+            __m128i d = _mm_loadu_si128((__m128i const*)(depth + i));        //d7 d7 d6 d6 d5 d5 d4 d4 d3 d3 d2 d2 d1 d1 d0 d0
 
                                                                             //split the depth pixel to 2 registers of 4 floats each
             __m128i d0 = _mm_shuffle_epi8(d, mask0);        // 00 00 d3 d3 00 00 d2 d2 00 00 d1 d1 00 00 d0 d0
@@ -125,43 +90,44 @@ namespace librealsense
             auto xyz12 = _mm_shuffle_ps(y_z1, x_y1, _MM_SHUFFLE(3, 1, 2, 0));
             auto xyz13 = _mm_shuffle_ps(z_x1, y_z1, _MM_SHUFFLE(3, 1, 3, 1));
 
-
             //store 8 points of x y z
-            _mm_stream_ps(&point[0], xyz01);
-            _mm_stream_ps(&point[4], xyz02);
-            _mm_stream_ps(&point[8], xyz03);
-            _mm_stream_ps(&point[12], xyz11);
-            _mm_stream_ps(&point[16], xyz12);
-            _mm_stream_ps(&point[20], xyz13);
+            _mm_storeu_ps(&point[0], xyz01);
+            _mm_storeu_ps(&point[4], xyz02);
+            _mm_storeu_ps(&point[8], xyz03);
+            _mm_storeu_ps(&point[12], xyz11);
+            _mm_storeu_ps(&point[16], xyz12);
+            _mm_storeu_ps(&point[20], xyz13);
             point += 24;
         }
+        return n;
+#else
+        return 0;
 #endif
-        return (float3*)output.get_vertices();
     }
 
-    void pointcloud_sse::get_texture_map(rs2::points output,
-        const float3* points,
-        const unsigned int width,
-        const unsigned int height,
-        const rs2_intrinsics &other_intrinsics,
-        const rs2_extrinsics& extr,
-        float2* pixels_ptr)
+    size_t pointcloud_sse::texture_map_kernel(float2* tex, float2* pixels, const float3* points, const float* ray_x, const float* ray_y,
+        const float* ray_z, const rs2_intrinsics& other_intrinsics, const rs2_extrinsics& extr, size_t count) const
     {
-        auto tex_ptr = (float2*)output.get_texture_coordinates();
-
+        // The kernels follow rs2_project_point_to_pixel operation by operation, the distortion models
+        // that need transcendental functions are left to it
+        if (other_intrinsics.model == RS2_DISTORTION_FTHETA || other_intrinsics.model == RS2_DISTORTION_KANNALA_BRANDT4)
+            return 0;
+
+#if defined(__SSSE3__) && defined(RS2_USE_AVX2)
+        if (get_simd_level() == simd_level::avx2)
+            return texture_map_avx(tex, pixels, points, ray_x, ray_y, ray_z, other_intrinsics, extr, count);
+#endif
 #ifdef __SSSE3__
+        if (get_simd_level() < simd_level::ssse3)
+            return 0;
+
         auto point = reinterpret_cast<const float*>(points);
-        auto res = reinterpret_cast<float*>(tex_ptr);
-        auto res1 = reinterpret_cast<float*>(pixels_ptr);
+        auto res = reinterpret_cast<float*>(tex);
+        auto res1 = reinterpret_cast<float*>(pixels);
 
-        __m128 r[9];
         __m128 t[3];
         __m128 c[5];
 
-        for (int i = 0; i < 9; ++i)
-        {
-            r[i] = _mm_set_ps1(extr.rotation[i]);
-        }
         for (int i = 0; i < 3; ++i)
         {
             t[i] = _mm_set_ps1(extr.translation[i]);
@@ -170,96 +136,76 @@ namespace librealsense
         {
             c[i] = _mm_set_ps1(other_intrinsics.coeffs[i]);
         }
+        auto two_c2 = _mm_set_ps1(2 * other_intrinsics.coeffs[2]);
+        auto two_c3 = _mm_set_ps1(2 * other_intrinsics.coeffs[3]);
 
         auto fx = _mm_set_ps1(other_intrinsics.fx);
         auto fy = _mm_set_ps1(other_intrinsics.fy);
         auto ppx = _mm_set_ps1(other_intrinsics.ppx);
         auto ppy = _mm_set_ps1(other_intrinsics.ppy);
-        auto w = _mm_set_ps1(other_intrinsics.width);
-        auto h = _mm_set_ps1(other_intrinsics.height);
-        auto mask_inv_brown_conrady = _mm_set_ps1(RS2_DISTORTION_INVERSE_BROWN_CONRADY);
+        auto w = _mm_set_ps1(float(other_intrinsics.width));
+        auto h = _mm_set_ps1(float(other_intrinsics.height));
+        auto distort = other_intrinsics.model == RS2_DISTORTION_MODIFIED_BROWN_CONRADY ||
+                       other_intrinsics.model == RS2_DISTORTION_INVERSE_BROWN_CONRADY;
         auto zero = _mm_set_ps1(0);
         auto one = _mm_set_ps1(1);
         auto two = _mm_set_ps1(2);
 
-        for (auto i = 0UL; i < height*width * 3; i += 12)
+        size_t n = count / 4 * 4;
+        for (size_t i = 0; i < n; i += 4)
         {
             //load 4 points (x,y,z)
-            auto xyz1 = _mm_load_ps(point + i);
-            auto xyz2 = _mm_load_ps(point + i + 4);
-            auto xyz3 = _mm_load_ps(point + i + 8);
+            auto xyz1 = _mm_loadu_ps(point + i * 3);
+            auto xyz2 = _mm_loadu_ps(point + i * 3 + 4);
+            auto xyz3 = _mm_loadu_ps(point + i * 3 + 8);
 
-
-            //gather x,y,z
+            //gather z
             auto yz = _mm_shuffle_ps(xyz1, xyz2, _MM_SHUFFLE(1, 0, 2, 1));
-            auto xy = _mm_shuffle_ps(xyz2, xyz3, _MM_SHUFFLE(2, 1, 3, 2));
-
-            auto x = _mm_shuffle_ps(xyz1, xy, _MM_SHUFFLE(2, 0, 3, 0));
-            auto y = _mm_shuffle_ps(yz, xy, _MM_SHUFFLE(3, 1, 2, 0));
             auto z = _mm_shuffle_ps(yz, xyz3, _MM_SHUFFLE(3, 0, 3, 1));
 
-            auto p_x = _mm_add_ps(_mm_mul_ps(r[0], x), _mm_add_ps(_mm_mul_ps(r[3], y), _mm_add_ps(_mm_mul_ps(r[6], z), t[0])));
-            auto p_y = _mm_add_ps(_mm_mul_ps(r[1], x), _mm_add_ps(_mm_mul_ps(r[4], y), _mm_add_ps(_mm_mul_ps(r[7], z), t[1])));
-            auto p_z = _mm_add_ps(_mm_mul_ps(r[2], x), _mm_add_ps(_mm_mul_ps(r[5], y), _mm_add_ps(_mm_mul_ps(r[8], z), t[2])));
+            //transform to the other stream with the rotated rays
+            auto p_x = _mm_add_ps(_mm_mul_ps(z, _mm_loadu_ps(ray_x + i)), t[0]);
+            auto p_y = _mm_add_ps(_mm_mul_ps(z, _mm_loadu_ps(ray_y + i)), t[1]);
+            auto p_z = _mm_add_ps(_mm_mul_ps(z, _mm_loadu_ps(ray_z + i)), t[2]);
 
             p_x = _mm_div_ps(p_x, p_z);
             p_y = _mm_div_ps(p_y, p_z);
 
-            // if(model == RS2_DISTORTION_MODIFIED_BROWN_CONRADY)
-            auto dist = _mm_set_ps1(other_intrinsics.model);
-
-            auto r2 = _mm_add_ps(_mm_mul_ps(p_x, p_x), _mm_mul_ps(p_y, p_y));
-            auto r3 = _mm_add_ps(_mm_mul_ps(c[1], _mm_mul_ps(r2, r2)), _mm_mul_ps(c[4], _mm_mul_ps(r2, _mm_mul_ps(r2, r2))));
-            auto f = _mm_add_ps(one, _mm_add_ps(_mm_mul_ps(c[0], r2), r3));
-
-            auto x_f = _mm_mul_ps(p_x, f);
-            auto y_f = _mm_mul_ps(p_y, f);
-
-            auto r4 = _mm_mul_ps(c[3], _mm_add_ps(r2, _mm_mul_ps(two, _mm_mul_ps(x_f, x_f))));
-            auto d_x = _mm_add_ps(x_f, _mm_add_ps(_mm_mul_ps(two, _mm_mul_ps(c[2], _mm_mul_ps(x_f, y_f))), r4));
-
-            auto r5 = _mm_mul_ps(c[2], _mm_add_ps(r2, _mm_mul_ps(two, _mm_mul_ps(y_f, y_f))));
-            auto d_y = _mm_add_ps(y_f, _mm_add_ps(_mm_mul_ps(two, _mm_mul_ps(c[3], _mm_mul_ps(x_f, y_f))), r4));
-
-            auto cmp = _mm_cmpeq_ps(mask_inv_brown_conrady, dist);
+            if (distort)
+            {
+                auto r2 = _mm_add_ps(_mm_mul_ps(p_x, p_x), _mm_mul_ps(p_y, p_y));
+                auto f = _mm_add_ps(_mm_add_ps(_mm_add_ps(one, _mm_mul_ps(c[0], r2)), _mm_mul_ps(_mm_mul_ps(c[1], r2), r2)),
+                    _mm_mul_ps(_mm_mul_ps(_mm_mul_ps(c[4], r2), r2), r2));
 
-            p_x = _mm_or_ps(_mm_and_ps(cmp, d_x), _mm_andnot_ps(cmp, p_x));
-            p_y = _mm_or_ps(_mm_and_ps(cmp, d_y), _mm_andnot_ps(cmp, p_y));
+                auto x_f = _mm_mul_ps(p_x, f);
+                auto y_f = _mm_mul_ps(p_y, f);
 
-            //TODO: add handle to RS2_DISTORTION_FTHETA
+                p_x = _mm_add_ps(_mm_add_ps(x_f, _mm_mul_ps(_mm_mul_ps(two_c2, x_f), y_f)),
+                    _mm_mul_ps(c[3], _mm_add_ps(r2, _mm_mul_ps(_mm_mul_ps(two, x_f), x_f))));
+                p_y = _mm_add_ps(_mm_add_ps(y_f, _mm_mul_ps(_mm_mul_ps(two_c3, x_f), y_f)),
+                    _mm_mul_ps(c[2], _mm_add_ps(r2, _mm_mul_ps(_mm_mul_ps(two, y_f), y_f))));
+            }
 
             //zero the x and y if z is zero
-            cmp = _mm_cmpneq_ps(z, zero);
+            auto cmp = _mm_cmpneq_ps(z, zero);
             p_x = _mm_and_ps(_mm_add_ps(_mm_mul_ps(p_x, fx), ppx), cmp);
             p_y = _mm_and_ps(_mm_add_ps(_mm_mul_ps(p_y, fy), ppy), cmp);
 
-            //scattering of the x y before normalize and store in pixels_ptr
-            auto xx_yy01 = _mm_shuffle_ps(p_x, p_y, _MM_SHUFFLE(2, 0, 2, 0));
-            auto xx_yy23 = _mm_shuffle_ps(p_x, p_y, _MM_SHUFFLE(3, 1, 3, 1));
-
-            auto xyxy1 = _mm_shuffle_ps(xx_yy01, xx_yy23, _MM_SHUFFLE(2, 0, 2, 0));
-            auto xyxy2 = _mm_shuffle_ps(xx_yy01, xx_yy23, _MM_SHUFFLE(3, 1, 3, 1));
-
-            _mm_stream_ps(res1, xyxy1);
-            _mm_stream_ps(res1 + 4, xyxy2);
-            res1 += 8;
+            //scattering of the x y before normalize and store in pixels
+            _mm_storeu_ps(res1 + i * 2, _mm_unpacklo_ps(p_x, p_y));
+            _mm_storeu_ps(res1 + i * 2 + 4, _mm_unpackhi_ps(p_x, p_y));
 
             //normalize x and y
             p_x = _mm_div_ps(p_x, w);
             p_y = _mm_div_ps(p_y, h);
 
-            //scattering of the x y after normalize and store in tex_ptr
-            xx_yy01 = _mm_shuffle_ps(p_x, p_y, _MM_SHUFFLE(2, 0, 2, 0));
-            xx_yy23 = _mm_shuffle_ps(p_x, p_y, _MM_SHUFFLE(3, 1, 3, 1));
-
-            xyxy1 = _mm_shuffle_ps(xx_yy01, xx_yy23, _MM_SHUFFLE(2, 0, 2, 0));
-            xyxy2 = _mm_shuffle_ps(xx_yy01, xx_yy23, _MM_SHUFFLE(3, 1, 3, 1));
-
-            _mm_stream_ps(res, xyxy1);
-            _mm_stream_ps(res + 4, xyxy2);
-            res += 8;
+            //scattering of the x y after normalize and store in tex
+            _mm_storeu_ps(res + i * 2, _mm_unpacklo_ps(p_x, p_y));
+            _mm_storeu_ps(res + i * 2 + 4, _mm_unpackhi_ps(p_x, p_y));
         }
+        return n;
+#else
+        return 0;
 #endif
-
     }
 }
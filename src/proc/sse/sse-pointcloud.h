@@ -6,29 +6,15 @@
 
 namespace librealsense
 {
+    // Runs the pointcloud kernels with SSSE3, or AVX2 when the CPU supports it (see get_simd_level)
     class pointcloud_sse : public pointcloud
     {
     public:
         pointcloud_sse();
     private:
-        void preprocess() override;
-        const float3 * depth_to_points(
-            rs2::points output,
-            const rs2_intrinsics &depth_intrinsics, 
-            const rs2::depth_frame& depth_frame, 
-            float depth_scale) override;
-        void get_texture_map(
-            rs2::points output,
-            const float3* points,
-            const unsigned int width,
-            const unsigned int height,
-            const rs2_intrinsics &other_intrinsics,
-            const rs2_extrinsics& extr,
-            float2* pixels_ptr) override;
-
-        std::vector<float> _pre_compute_map_x;
-        std::vector<float> _pre_compute_map_y;
-
-        void pre_compute_x_y_map();
+        size_t deproject_kernel(float* points, const uint16_t* depth, const float* ray_x, const float* ray_y,
+            float depth_scale, size_t count) const override;
+        size_t texture_map_kernel(float2* tex, float2* pixels, const float3* points, const float* ray_x, const float* ray_y,
+            const float* ray_z, const rs2_intrinsics& other_intrinsics, const rs2_extrinsics& extr, size_t count) const override;
     };
 }
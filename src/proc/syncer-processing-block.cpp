@@ -6,10 +6,23 @@
 #include "sync.h"
 #include "proc/synthetic-stream.h"
 #include "proc/syncer-processing-block.h"
+#include "option.h"
 
 
 namespace librealsense
 {
+    // Largest timestamp difference of matched frames, 0 derives it from the frame rates
+    const float sync_tolerance_min = 0.f;
+    const float sync_tolerance_max = 1000.f;
+    const float sync_tolerance_step = 0.1f;
+    const float sync_tolerance_default = 0.f;
+
+    // Timestamp milliseconds a frameset waits for missing streams
+    const float sync_max_latency_min = 0.f;
+    const float sync_max_latency_max = 10000.f;
+    const float sync_max_latency_step = 1.f;
+    const float sync_max_latency_default = 100.f;
+
     syncer_process_unit::syncer_process_unit()
         : processing_block("syncer"), _matcher((new timestamp_composite_matcher({})))
     {
@@ -45,4 +58,68 @@ namespace librealsense
         set_processing_callback(std::shared_ptr<rs2_frame_processor_callback>(
             new internal_frame_processor_callback<decltype(f)>(f)));
     }
+
+    const sync_telemetry& syncer_process_unit::get_telemetry() const
+    {
+        return _matcher->get_telemetry();
+    }
+
+    multi_device_syncer_process_unit::multi_device_syncer_process_unit()
+        : processing_block("multi-device syncer"), _matcher(new global_time_matcher()),
+        _tolerance(sync_tolerance_default), _max_latency(sync_max_latency_default), _drop_incomplete(0)
+    {
+        auto tolerance = std::make_shared<ptr_option<float>>(
+            sync_tolerance_min,
+            sync_tolerance_max,
+            sync_tolerance_step,
+            sync_tolerance_default,
+            &_tolerance, "Largest difference in milliseconds between the timestamps of matched frames, 0 for half the shortest frame interval");
+        register_option(RS2_OPTION_SYNC_TOLERANCE, tolerance);
+
+        auto max_latency = std::make_shared<ptr_option<float>>(
+            sync_max_latency_min,
+            sync_max_latency_max,
+            sync_max_latency_step,
+            sync_max_latency_default,
+            &_max_latency, "Milliseconds of timestamps a frameset waits for missing streams");
+        register_option(RS2_OPTION_SYNC_MAX_LATENCY, max_latency);
+
+        auto drop_incomplete = std::make_shared<ptr_option<uint8_t>>(0, 1, 1, 0,
+            &_drop_incomplete, "Release framesets missing some of their streams");
+        drop_incomplete->set_description(0, "Pass on");
+        drop_incomplete->set_description(1, "Release");
+        register_option(RS2_OPTION_SYNC_DROP_INCOMPLETE, drop_incomplete);
+
+        _matcher->set_callback([](frame_holder f, syncronization_environment env)
+        {
+            env.matches.enqueue(std::move(f));
+        });
+
+        auto f = [&](frame_holder frame, synthetic_source_interface* source)
+        {
+            single_consumer_frame_queue<frame_holder> matches;
+
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                _matcher->set_config({ _tolerance, _max_latency, _drop_incomplete != 0 });
+                _matcher->dispatch(std::move(frame), { source, matches });
+            }
+
+            frame_holder f;
+            while (matches.try_dequeue(&f))
+                get_source().frame_ready(std::move(f));
+        };
+        set_processing_callback(std::shared_ptr<rs2_frame_processor_callback>(
+            new internal_frame_processor_callback<decltype(f)>(f)));
+    }
+
+    multi_device_syncer_process_unit::~multi_device_syncer_process_unit()
+    {
+        _matcher.reset();
+    }
+
+    const sync_telemetry& multi_device_syncer_process_unit::get_telemetry() const
+    {
+        return _matcher->get_telemetry();
+    }
 }
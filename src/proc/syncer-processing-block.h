@@ -14,6 +14,8 @@ namespace librealsense
 {
     class processing_block;
     class timestamp_composite_matcher;
+    class global_time_matcher;
+    class sync_telemetry;
     class syncer_process_unit : public processing_block
     {
     public:
@@ -23,7 +25,24 @@ namespace librealsense
         {
             _matcher.reset();
         }
+
+        const sync_telemetry& get_telemetry() const;
     private:
         std::unique_ptr<timestamp_composite_matcher> _matcher;
     };
+
+    // Syncs the frames of several devices by their global time timestamps, see global_time_matcher
+    class multi_device_syncer_process_unit : public processing_block
+    {
+    public:
+        multi_device_syncer_process_unit();
+        ~multi_device_syncer_process_unit();
+
+        const sync_telemetry& get_telemetry() const;
+    private:
+        std::unique_ptr<global_time_matcher> _matcher;
+        float _tolerance;
+        float _max_latency;
+        uint8_t _drop_incomplete;
+    };
 }
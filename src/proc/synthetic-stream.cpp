@@ -5,6 +5,8 @@
 #include "proc/synthetic-stream.h"
 #include "option.h"
 
+#include <algorithm>
+
 namespace librealsense
 {
     void processing_block::set_processing_callback(frame_processor_callback_ptr callback)
@@ -18,15 +20,123 @@ namespace librealsense
         _source.set_callback(callback);
     }
 
+    // Workers shared by the processing blocks of every camera.
+    // Intentionally never destroyed, as joining threads while the library is being unloaded is not safe on every platform
+    static task_executor& processing_executor()
+    {
+        static auto executor = new task_executor(std::max(2u, std::thread::hardware_concurrency()));
+        return *executor;
+    }
+
     processing_block::processing_block(const char* name) :
-        _source_wrapper(_source)
+        _source_wrapper(_source),
+        _queue_size_option(0),
+        _drop_policy_option(drop_oldest),
+        _queue_size(0),
+        _drop_policy(drop_oldest),
+        _scheduled(false)
     {
         register_option(RS2_OPTION_FRAMES_QUEUE_SIZE, _source.get_published_size_option());
         register_info(RS2_CAMERA_INFO_NAME, name);
         _source.init(std::shared_ptr<metadata_parser_map>());
+
+        auto queue_size = std::make_shared<ptr_option<uint8_t>>(0, 32, 1, 0, &_queue_size_option,
+            "Number of frames that may wait to be processed on the shared worker threads, 0 processes frames on the invoking thread");
+        queue_size->on_set([this](float val)
+        {
+            // Invokers blocked on a full queue re-evaluate it
+            std::lock_guard<std::mutex> lock(_queue_mutex);
+            _queue_size = static_cast<uint8_t>(val);
+            _queue_cv.notify_all();
+        });
+        register_option(RS2_OPTION_PROCESSING_QUEUE_SIZE, queue_size);
+
+        auto drop_policy = std::make_shared<ptr_option<uint8_t>>(drop_oldest, drop_policy_count - 1, 1, drop_oldest, &_drop_policy_option,
+            "What happens to a frame invoked while the processing queue is full");
+        drop_policy->on_set([this](float val)
+        {
+            std::lock_guard<std::mutex> lock(_queue_mutex);
+            _drop_policy = static_cast<uint8_t>(val);
+        });
+        drop_policy->set_description(drop_oldest, "Drop the oldest queued frame");
+        drop_policy->set_description(drop_newest, "Drop the new frame");
+        drop_policy->set_description(block_invoker, "Block the invoking thread");
+        register_option(RS2_OPTION_PROCESSING_DROP_POLICY, drop_policy);
     }
 
     void processing_block::invoke(frame_holder f)
+    {
+        frame_holder dropped;   // released once the queue is unlocked
+        {
+            std::unique_lock<std::mutex> lock(_queue_mutex);
+
+            // Once frames are queued, later ones wait behind them even if the queue was disabled meanwhile
+            if (_queue_size || _scheduled)
+            {
+                // Queued frames keep the block alive, one that is not owned by a shared_ptr is always processed in place
+                std::shared_ptr<processing_block> self;
+                try
+                {
+                    self = shared_from_this();
+                }
+                catch (const std::bad_weak_ptr&) {}
+
+                if (self)
+                {
+                    auto& executor = processing_executor();
+                    if (_queue_size && _queue.size() >= _queue_size)
+                    {
+                        // The shared workers never wait for each other: a block fed from another block's worker
+                        // queues the frame beyond the limit, rather than risk all the workers waiting on one another
+                        if (_drop_policy == block_invoker)
+                        {
+                            if (!executor.is_executor_thread())
+                                _queue_cv.wait(lock, [&]() { return !_queue_size || _queue.size() < _queue_size; });
+                        }
+                        else if (_drop_policy == drop_newest)
+                            return;
+                        else
+                        {
+                            dropped = std::move(_queue.front());
+                            _queue.pop_front();
+                        }
+                    }
+
+                    _queue.push_back(std::move(f));
+                    if (!_scheduled)
+                    {
+                        _scheduled = true;
+                        executor.submit([this, self]() { process_queued(self); });
+                    }
+                    return;
+                }
+            }
+        }
+
+        run_callback(std::move(f));
+    }
+
+    void processing_block::process_queued(std::shared_ptr<processing_block> self)
+    {
+        // One frame per task, so that blocks sharing the workers take turns
+        frame_holder f;
+        {
+            std::lock_guard<std::mutex> lock(_queue_mutex);
+            f = std::move(_queue.front());
+            _queue.pop_front();
+            _queue_cv.notify_all();
+        }
+
+        run_callback(std::move(f));
+
+        std::lock_guard<std::mutex> lock(_queue_mutex);
+        if (_queue.empty())
+            _scheduled = false;
+        else
+            processing_executor().submit([this, self]() { process_queued(self); });
+    }
+
+    void processing_block::run_callback(frame_holder f)
     {
         auto callback = _source.begin_callback();
         try
@@ -391,7 +501,9 @@ namespace librealsense
                 res->set_blocking(true);
         }
 
+        // Pooled buffers are not zeroed, while slots of unused embedded frames must read as null
         auto frames = cf->get_frames();
+        std::fill(frames, frames + req_size, nullptr);
         for (auto&& f : holders)
             copy_frames(std::move(f), frames);
         frames -= req_size;
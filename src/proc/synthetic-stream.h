@@ -9,6 +9,8 @@
 #include "../include/librealsense2/hpp/rs_frame.hpp"
 #include "../include/librealsense2/hpp/rs_processing.hpp"
 
+#include <deque>
+
 namespace librealsense
 {
     class synthetic_source : public synthetic_source_interface
@@ -41,7 +43,21 @@ namespace librealsense
         std::shared_ptr<rs2_source> _c_wrapper;
     };
 
-    class LRS_EXTENSION_API processing_block : public processing_block_interface, public options_container, public info_container
+    enum processing_drop_policy : uint8_t
+    {
+        drop_oldest,
+        drop_newest,
+        block_invoker,
+        drop_policy_count
+    };
+
+    // Frames are processed synchronously on the invoking thread by default.
+    // With RS2_OPTION_PROCESSING_QUEUE_SIZE set, invoke() queues the frame instead and returns, and the library's shared
+    // worker threads process it. Frames of a block are processed one at a time and in the order they were invoked,
+    // so its output keeps the order of every stream, while different blocks run concurrently.
+    // The block is kept alive until its queued frames are processed, it is therefore expected to be owned by a shared_ptr
+    class LRS_EXTENSION_API processing_block : public processing_block_interface, public options_container, public info_container,
+                                               public std::enable_shared_from_this<processing_block>
     {
     public:
         processing_block(const char* name);
@@ -57,6 +73,19 @@ namespace librealsense
         std::mutex _mutex;
         frame_processor_callback_ptr _callback;
         synthetic_source _source_wrapper;
+
+    private:
+        void run_callback(frame_holder frame);
+        void process_queued(std::shared_ptr<processing_block> self);
+
+        uint8_t _queue_size_option;     // Written by the options, invoke() reads the copies taken under _queue_mutex
+        uint8_t _drop_policy_option;
+        uint8_t _queue_size;
+        uint8_t _drop_policy;
+        std::mutex _queue_mutex;
+        std::condition_variable _queue_cv;
+        std::deque<frame_holder> _queue;
+        bool _scheduled;            // A task of this block is pending on the shared workers
     };
 
     class LRS_EXTENSION_API generic_processing_block : public processing_block
@@ -9,6 +9,11 @@
 #include "context.h"
 #include "proc/synthetic-stream.h"
 #include "proc/temporal-filter.h"
+#include "cpu-features.h"
+
+#ifdef __SSSE3__
+#include <tmmintrin.h> // For SSSE3 intrinsics
+#endif
 
 namespace librealsense
 {
@@ -32,6 +37,12 @@ namespace librealsense
     const uint8_t temp_delta_default = 20;
     const uint8_t temp_delta_step = 1;
 
+    // Worker threads sharing each frame, a single thread keeps the filter on the calling thread
+    const uint8_t temp_threads_min = 1;
+    const uint8_t temp_threads_max = 16;
+    const uint8_t temp_threads_step = 1;
+    const uint8_t temp_threads_default = 1;
+
     temporal_filter::temporal_filter() :
         depth_processing_block("Temporal Filter"),
         _persistence_param(persistence_default),
@@ -40,7 +51,9 @@ namespace librealsense
         _delta_param(temp_delta_default),
         _width(0), _height(0), _stride(0), _bpp(0),
         _extension_type(RS2_EXTENSION_DEPTH_FRAME),
-        _current_frm_size_pixels(0)
+        _current_frm_size_pixels(0),
+        _processing_threads(temp_threads_default),
+        _workers(temp_threads_default)
     {
         _stream_filter.stream = RS2_STREAM_DEPTH;
         _stream_filter.format = RS2_FORMAT_Z16;
@@ -103,6 +116,14 @@ namespace librealsense
         register_option(RS2_OPTION_FILTER_SMOOTH_ALPHA, temporal_filter_alpha);
         register_option(RS2_OPTION_FILTER_SMOOTH_DELTA, temporal_filter_delta);
 
+        auto processing_threads = std::make_shared<ptr_option<uint8_t>>(
+            temp_threads_min,
+            temp_threads_max,
+            temp_threads_step,
+            temp_threads_default,
+            &_processing_threads, "Number of threads sharing the filtering of a frame");
+        register_option(RS2_OPTION_PROCESSING_THREADS, processing_threads);
+
         on_set_persistence_control(_persistence_param);
         on_set_delta(_delta_param);
         on_set_alpha(_alpha_param);
@@ -113,13 +134,21 @@ namespace librealsense
         update_configuration(f);
         auto tgt = prepare_target_frame(f, source);
 
+        filter_in_place(const_cast<void*>(tgt.get_data()));
+
+        return tgt;
+    }
+
+    void temporal_filter::filter_in_place(void* frame_data)
+    {
+        // The pool is only resized here, between frames, since the option may be set from any thread
+        _workers.resize(_processing_threads);
+
         // Temporal filter execution
         if (_extension_type == RS2_EXTENSION_DISPARITY_FRAME)
-            temp_jw_smooth<float>(const_cast<void*>(tgt.get_data()), _last_frame.data(), _history.data());
+            temp_jw_smooth<float>(frame_data, _last_frame.data(), _history.data());
         else
-            temp_jw_smooth<uint16_t>(const_cast<void*>(tgt.get_data()), _last_frame.data(), _history.data());
-
-        return tgt;
+            temp_jw_smooth<uint16_t>(frame_data, _last_frame.data(), _history.data());
     }
 
 
@@ -159,21 +188,25 @@ namespace librealsense
             _target_stream_profile = _source_stream_profile.clone(RS2_STREAM_DEPTH, 0, _source_stream_profile.format());
 
             //TODO - reject any frame other than depth/disparity
-            _extension_type = f.is<rs2::disparity_frame>() ? RS2_EXTENSION_DISPARITY_FRAME : RS2_EXTENSION_DEPTH_FRAME;
-            _bpp = (_extension_type == RS2_EXTENSION_DISPARITY_FRAME) ? sizeof(float) : sizeof(uint16_t);
             auto vp = _target_stream_profile.as<rs2::video_stream_profile>();
-            _width = vp.width();
-            _height = vp.height();
-            _stride = _width*_bpp;
-            _current_frm_size_pixels = _width * _height;
+            configure(vp.width(), vp.height(), f.is<rs2::disparity_frame>() ? RS2_EXTENSION_DISPARITY_FRAME : RS2_EXTENSION_DEPTH_FRAME);
+        }
+    }
 
-            _last_frame.clear();
-            _last_frame.resize(_current_frm_size_pixels*_bpp);
+    void temporal_filter::configure(size_t width, size_t height, rs2_extension type)
+    {
+        _extension_type = type;
+        _bpp = (_extension_type == RS2_EXTENSION_DISPARITY_FRAME) ? sizeof(float) : sizeof(uint16_t);
+        _width = width;
+        _height = height;
+        _stride = _width*_bpp;
+        _current_frm_size_pixels = _width * _height;
 
-            _history.clear();
-            _history.resize(_current_frm_size_pixels*_bpp);
+        _last_frame.clear();
+        _last_frame.resize(_current_frm_size_pixels*_bpp);
 
-        }
+        _history.clear();
+        _history.resize(_current_frm_size_pixels);
     }
 
     rs2::frame temporal_filter::prepare_target_frame(const rs2::frame& f, const rs2::frame_source& source)
@@ -271,4 +304,190 @@ namespace librealsense
         // Store results
         _persistence_map = credible_threshold;
     }
+
+#ifdef __SSSE3__
+    namespace
+    {
+        // Per-byte lookup of the packed credibility bits of each history value
+        inline __m128i credible_history(__m128i hist, __m128i credible_lo, __m128i credible_hi)
+        {
+            const __m128i bits = _mm_setr_epi8(1, 2, 4, 8, 16, 32, 64, -128, 1, 2, 4, 8, 16, 32, 64, -128);
+            auto index = _mm_and_si128(_mm_srli_epi16(hist, 3), _mm_set1_epi8(0x1f));
+            auto upper = _mm_cmpeq_epi8(_mm_and_si128(index, _mm_set1_epi8(0x10)), _mm_set1_epi8(0x10));
+            auto packed = _mm_or_si128(_mm_andnot_si128(upper, _mm_shuffle_epi8(credible_lo, index)),
+                                       _mm_and_si128(upper, _mm_shuffle_epi8(credible_hi, index)));
+            auto bit = _mm_shuffle_epi8(bits, _mm_and_si128(hist, _mm_set1_epi8(7)));
+            return _mm_xor_si128(_mm_cmpeq_epi8(_mm_and_si128(packed, bit), _mm_setzero_si128()), _mm_set1_epi8(-1));
+        }
+
+        inline __m128i blend(__m128i mask, __m128i a, __m128i b)
+        {
+            return _mm_or_si128(_mm_and_si128(mask, a), _mm_andnot_si128(mask, b));
+        }
+
+        // Byte masks of the 16 pixels: new value valid, last value valid, both valid and close enough to smooth
+        struct pixel_masks
+        {
+            __m128i valid, prev_valid, agree;
+        };
+
+        inline __m128i next_history(__m128i hist, const pixel_masks& m, __m128i mask)
+        {
+            auto reset = _mm_andnot_si128(m.agree, m.valid);
+            return _mm_or_si128(_mm_or_si128(_mm_and_si128(m.agree, _mm_or_si128(hist, mask)), _mm_and_si128(reset, mask)),
+                                _mm_andnot_si128(m.valid, _mm_andnot_si128(mask, hist)));
+        }
+
+        struct z16_lanes
+        {
+            __m128i cur[2], prev[2], result[2];
+            __m128i agree[2], valid[2], prev_valid[2];
+
+            z16_lanes(const uint16_t* frame, const uint16_t* last_frame, __m128i delta, __m128 alpha, __m128 one_minus_alpha)
+            {
+                const auto zero = _mm_setzero_si128();
+                const auto ones = _mm_set1_epi8(-1);
+                const auto bias = _mm_set1_epi32(0x8000);
+                for (int j = 0; j < 2; j++)
+                {
+                    cur[j] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(frame + j * 8));
+                    prev[j] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(last_frame + j * 8));
+                    valid[j] = _mm_xor_si128(_mm_cmpeq_epi16(cur[j], zero), ones);
+                    prev_valid[j] = _mm_xor_si128(_mm_cmpeq_epi16(prev[j], zero), ones);
+                    auto diff = _mm_or_si128(_mm_subs_epu16(cur[j], prev[j]), _mm_subs_epu16(prev[j], cur[j]));
+                    auto small = _mm_xor_si128(_mm_cmpeq_epi16(_mm_subs_epu16(delta, diff), zero), ones);
+                    agree[j] = _mm_and_si128(_mm_and_si128(valid[j], prev_valid[j]), small);
+
+                    // Same operations and truncation as the scalar code: alpha * cur + (1 - alpha) * prev
+                    __m128i filtered[2];
+                    for (int k = 0; k < 2; k++)
+                    {
+                        auto c = _mm_cvtepi32_ps(k ? _mm_unpackhi_epi16(cur[j], zero) : _mm_unpacklo_epi16(cur[j], zero));
+                        auto p = _mm_cvtepi32_ps(k ? _mm_unpackhi_epi16(prev[j], zero) : _mm_unpacklo_epi16(prev[j], zero));
+                        auto f = _mm_add_ps(_mm_mul_ps(alpha, c), _mm_mul_ps(one_minus_alpha, p));
+                        filtered[k] = _mm_sub_epi32(_mm_cvttps_epi32(f), bias);
+                    }
+                    // No unsigned saturating pack before SSE4.1, hence the bias
+                    result[j] = _mm_xor_si128(_mm_packs_epi32(filtered[0], filtered[1]), _mm_set1_epi16(-0x8000));
+                }
+            }
+
+            pixel_masks masks() const
+            {
+                return{ _mm_packs_epi16(valid[0], valid[1]), _mm_packs_epi16(prev_valid[0], prev_valid[1]),
+                        _mm_packs_epi16(agree[0], agree[1]) };
+            }
+
+            void store(uint16_t* frame, uint16_t* last_frame, __m128i fill) const
+            {
+                for (int j = 0; j < 2; j++)
+                {
+                    auto fill16 = j ? _mm_unpackhi_epi8(fill, fill) : _mm_unpacklo_epi8(fill, fill);
+                    auto out = blend(agree[j], result[j], blend(fill16, prev[j], cur[j]));
+                    auto last = blend(agree[j], result[j], blend(valid[j], cur[j], prev[j]));
+                    _mm_storeu_si128(reinterpret_cast<__m128i*>(frame + j * 8), out);
+                    _mm_storeu_si128(reinterpret_cast<__m128i*>(last_frame + j * 8), last);
+                }
+            }
+        };
+
+        struct disparity_lanes
+        {
+            __m128 cur[4], prev[4], result[4];
+            __m128 agree[4], valid[4], prev_valid[4];
+
+            disparity_lanes(const float* frame, const float* last_frame, __m128 delta, __m128 alpha, __m128 one_minus_alpha)
+            {
+                const auto zero = _mm_setzero_ps();
+                const auto abs_mask = _mm_castsi128_ps(_mm_set1_epi32(0x7fffffff));
+                for (int j = 0; j < 4; j++)
+                {
+                    cur[j] = _mm_loadu_ps(frame + j * 4);
+                    prev[j] = _mm_loadu_ps(last_frame + j * 4);
+                    // Not-equal is also true for NaN, matching the implicit conversion to bool
+                    valid[j] = _mm_cmpneq_ps(cur[j], zero);
+                    prev_valid[j] = _mm_cmpneq_ps(prev[j], zero);
+                    auto diff = _mm_and_ps(_mm_sub_ps(cur[j], prev[j]), abs_mask);
+                    agree[j] = _mm_and_ps(_mm_and_ps(valid[j], prev_valid[j]), _mm_cmplt_ps(diff, delta));
+                    result[j] = _mm_add_ps(_mm_mul_ps(alpha, cur[j]), _mm_mul_ps(one_minus_alpha, prev[j]));
+                }
+            }
+
+            static __m128i pack(const __m128* m)
+            {
+                auto lo = _mm_packs_epi32(_mm_castps_si128(m[0]), _mm_castps_si128(m[1]));
+                auto hi = _mm_packs_epi32(_mm_castps_si128(m[2]), _mm_castps_si128(m[3]));
+                return _mm_packs_epi16(lo, hi);
+            }
+
+            pixel_masks masks() const
+            {
+                return{ pack(valid), pack(prev_valid), pack(agree) };
+            }
+
+            void store(float* frame, float* last_frame, __m128i fill) const
+            {
+                __m128i fill16[2] = { _mm_unpacklo_epi8(fill, fill), _mm_unpackhi_epi8(fill, fill) };
+                for (int j = 0; j < 4; j++)
+                {
+                    auto half = fill16[j / 2];
+                    auto fill32 = _mm_castsi128_ps((j % 2) ? _mm_unpackhi_epi16(half, half) : _mm_unpacklo_epi16(half, half));
+                    auto out = _mm_or_ps(_mm_and_ps(agree[j], result[j]),
+                        _mm_andnot_ps(agree[j], _mm_or_ps(_mm_and_ps(fill32, prev[j]), _mm_andnot_ps(fill32, cur[j]))));
+                    auto last = _mm_or_ps(_mm_and_ps(agree[j], result[j]),
+                        _mm_andnot_ps(agree[j], _mm_or_ps(_mm_and_ps(valid[j], cur[j]), _mm_andnot_ps(valid[j], prev[j]))));
+                    _mm_storeu_ps(frame + j * 4, out);
+                    _mm_storeu_ps(last_frame + j * 4, last);
+                }
+            }
+        };
+
+        template<class Lanes, class T, class Delta>
+        size_t smooth_sse(T* frame, T* last_frame, uint8_t* history, size_t begin, size_t end,
+            unsigned char mask, const uint8_t* credible, Delta delta, float alpha, float one_minus_alpha)
+        {
+            const auto credible_lo = _mm_loadu_si128(reinterpret_cast<const __m128i*>(credible));
+            const auto credible_hi = _mm_loadu_si128(reinterpret_cast<const __m128i*>(credible + 16));
+            const auto phase = _mm_set1_epi8(static_cast<char>(mask));
+            const auto alpha_v = _mm_set1_ps(alpha);
+            const auto one_minus_alpha_v = _mm_set1_ps(one_minus_alpha);
+
+            auto i = begin;
+            for (; i + 16 <= end; i += 16)
+            {
+                Lanes lanes(frame + i, last_frame + i, delta, alpha_v, one_minus_alpha_v);
+                auto hist = _mm_loadu_si128(reinterpret_cast<const __m128i*>(history + i));
+                auto m = lanes.masks();
+
+                // Holes are filled from the last frame when it was valid and the history is credible
+                auto fill = _mm_andnot_si128(m.valid, _mm_and_si128(m.prev_valid, credible_history(hist, credible_lo, credible_hi)));
+                lanes.store(frame + i, last_frame + i, fill);
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(history + i), next_history(hist, m, phase));
+            }
+            return i;
+        }
+    }
+#endif
+
+    size_t temporal_filter::temp_jw_smooth_simd(uint16_t* frame, uint16_t* last_frame, uint8_t* history,
+        size_t begin, size_t end, unsigned char mask, const uint8_t* credible) const
+    {
+#ifdef __SSSE3__
+        if (get_simd_level() >= simd_level::ssse3)
+            return smooth_sse<z16_lanes>(frame, last_frame, history, begin, end, mask, credible,
+                _mm_set1_epi16(static_cast<uint16_t>(_delta_param)), _alpha_param, _one_minus_alpha);
+#endif
+        return begin;
+    }
+
+    size_t temporal_filter::temp_jw_smooth_simd(float* frame, float* last_frame, uint8_t* history,
+        size_t begin, size_t end, unsigned char mask, const uint8_t* credible) const
+    {
+#ifdef __SSSE3__
+        if (get_simd_level() >= simd_level::ssse3)
+            return smooth_sse<disparity_lanes>(frame, last_frame, history, begin, end, mask, credible,
+                _mm_set1_ps(static_cast<float>(_delta_param)), _alpha_param, _one_minus_alpha);
+#endif
+        return begin;
+    }
 }
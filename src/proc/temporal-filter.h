@@ -3,6 +3,7 @@
 
 #pragma once
 #include "types.h"
+#include "concurrency.h"
 
 namespace librealsense
 {
@@ -14,7 +15,13 @@ namespace librealsense
         temporal_filter();
 
     protected:
+        friend class depth_postprocess;
+
         void    update_configuration(const rs2::frame& f);
+
+        // Sets the layout of the frames to filter and resets the history, also used by the fused depth_postprocess block
+        void    configure(size_t width, size_t height, rs2_extension type);
+        void    filter_in_place(void* frame_data);
         rs2::frame process_frame(const rs2::frame_source& source, const rs2::frame& f) override;
 
         rs2::frame prepare_target_frame(const rs2::frame& f, const rs2::frame_source& source);
@@ -24,17 +31,35 @@ namespace librealsense
         {
             static_assert((std::is_arithmetic<T>::value), "temporal filter assumes numeric types");
 
-            const bool fp = (std::is_floating_point<T>::value);
-
-            T delta_z = static_cast<T>(_delta_param);
-
             auto frame          = reinterpret_cast<T*>(frame_data);
             auto _last_frame    = reinterpret_cast<T*>(_last_frame_data);
 
             unsigned char mask = 1 << _cur_frame_index;
 
+            // Whether each 8 bit history is credible in the current phase, packed one bit per history value
+            std::array<uint8_t, PRESISTENCY_LUT_SIZE / 8> credible{};
+            for (size_t hist = 0; hist < PRESISTENCY_LUT_SIZE; hist++)
+                if (_persistence_map[hist] & mask)
+                    credible[hist >> 3] |= 1 << (hist & 7);
+
+            // Pixels are independent of each other, so the frame is split in fixed chunks across the workers
+            _workers.run(_current_frm_size_pixels, [&](size_t begin, size_t end)
+            {
+                auto first = temp_jw_smooth_simd(frame, _last_frame, history, begin, end, mask, credible.data());
+                temp_jw_smooth_range(frame, _last_frame, history, first, end, mask);
+            });
+
+            _cur_frame_index = (_cur_frame_index + 1) % 8;  // at end of cycle
+        }
+
+        // Reference implementation, also handles the pixels left over by the vectorized code
+        template<typename T>
+        void temp_jw_smooth_range(T* frame, T* _last_frame, uint8_t *history, size_t begin, size_t end, unsigned char mask) const
+        {
+            T delta_z = static_cast<T>(_delta_param);
+
             // pass one -- go through image and update all
-            for (size_t i = 0; i < _current_frm_size_pixels; i++)
+            for (size_t i = begin; i < end; i++)
             {
                 T cur_val = frame[i];
                 T prev_val = _last_frame[i];
@@ -79,10 +104,15 @@ namespace librealsense
                     history[i] &= ~mask;
                 }
             }
-
-            _cur_frame_index = (_cur_frame_index + 1) % 8;  // at end of cycle
         }
 
+        // Vectorized equivalent of temp_jw_smooth_range, 16 pixels per step, unless the SIMD level of the
+        // library (get_simd_level) is set to scalar. Returns the first pixel it did not process
+        size_t temp_jw_smooth_simd(uint16_t* frame, uint16_t* last_frame, uint8_t* history,
+            size_t begin, size_t end, unsigned char mask, const uint8_t* credible) const;
+        size_t temp_jw_smooth_simd(float* frame, float* last_frame, uint8_t* history,
+            size_t begin, size_t end, unsigned char mask, const uint8_t* credible) const;
+
     private:
         void on_set_persistence_control(uint8_t val);
         void on_set_alpha(float val);
@@ -101,10 +131,15 @@ namespace librealsense
         rs2::stream_profile     _source_stream_profile;
         rs2::stream_profile     _target_stream_profile;
         std::vector<uint8_t>    _last_frame;                // Hold the last frame received for the current profile
-        std::vector<uint8_t>    _history;                   // represents the history over the last 8 frames, 1 bit per frame
+        // History over the last 8 frames, 1 bit per frame, one byte per pixel. It is kept apart from _last_frame, so the
+        // SIMD kernels load the history of 16 pixels with one instruction. Packing it further into per-frame bit planes
+        // would need a bit transpose for every persistence lookup, so the byte per pixel layout is kept on purpose
+        std::vector<uint8_t>    _history;
         uint8_t                 _cur_frame_index;
         // encodes whether a particular 8 bit history is good enough for all 8 phases of storage
         std::array<uint8_t, PRESISTENCY_LUT_SIZE> _persistence_map;
+        uint8_t                 _processing_threads;
+        worker_pool             _workers;
     };
     MAP_EXTENSION(RS2_EXTENSION_TEMPORAL_FILTER, librealsense::temporal_filter);
 }
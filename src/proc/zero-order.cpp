@@ -4,8 +4,14 @@
 #include "zero-order.h"
 #include <iomanip>
 #include "l500/l500-depth.h"
+#include "cpu-features.h"
+#include "../include/librealsense2/rsutil.h"
 
-const double METER_TO_MM = 1000;
+#ifdef __SSSE3__
+#include <tmmintrin.h> // For SSSE3 intrinsics
+#endif
+
+const float METER_TO_MM = 1000;
 
 namespace librealsense
 {
@@ -22,26 +28,18 @@ namespace librealsense
         RS2_OPTION_FILTER_ZO_THRESHOLD_SCALE = static_cast<rs2_option>(RS2_OPTION_COUNT + 8) /**< threshold scale used by zero order filter */
     };
 
-    double get_pixel_rtd(const rs2::vertex& v, int baseline)
+    // Round trip distance in mm of a point at depth z mm, from the camera to the point and back to the receiver at the baseline.
+    // The ray of the pixel is taken at unit depth, so the distance to the point is z * |ray| and the squared distance
+    // to the receiver is that distance squared, less 2 * baseline * z * ray.x, plus the baseline squared
+    inline float get_pixel_rtd(float z, float ray_norm, float ray_x, float baseline)
     {
-        auto x = (double)v.x*METER_TO_MM;
-        auto y = (double)v.y*METER_TO_MM;
-        auto z = (double)v.z*METER_TO_MM;
-       
-        auto rtd = sqrt(x*x + y*y + z*z) + sqrt((x - baseline) *(x - baseline) + y*y + z*z);
-        return v.z ? rtd : 0;
+        auto distance = z * ray_norm;
+        auto to_receiver = distance * distance - 2 * baseline * z * ray_x + baseline * baseline;
+        return z ? distance + std::sqrt(std::max(to_receiver, 0.f)) : 0;
     }
 
-    void z2rtd(const rs2::vertex* vertices, double* rtd, const rs2_intrinsics& intrinsics, int baseline)
-    {
-        for (auto i = 0;i < intrinsics.height*intrinsics.width; i++)
-        {
-            rtd[i] = get_pixel_rtd(vertices[i], baseline);           
-        }
-    }
-    
-    template<typename T>
-    std::vector <T> get_zo_point_values(const T* frame_data_in, const rs2_intrinsics& intrinsics, int zo_point_x, int zo_point_y, int patch_r)
+    template<typename T, typename F>
+    std::vector <T> get_zo_point_values(F value_at, const rs2_intrinsics& intrinsics, int zo_point_x, int zo_point_y, int patch_r)
     {
         std::vector<T> values;
         values.reserve((patch_r + 2) *(patch_r + 2));
@@ -50,7 +48,7 @@ namespace librealsense
         {
             for (auto j = (zo_point_x - 1 - patch_r); j <= (zo_point_x + patch_r) && i < intrinsics.width; j++)
             {
-                values.push_back(frame_data_in[i*intrinsics.width + j]);
+                values.push_back(value_at(i*intrinsics.width + j));
             }
         }
 
@@ -72,7 +70,9 @@ namespace librealsense
         return 0;
     }
 
-    bool try_get_zo_rtd_ir_point_values(const double* rtd, const uint16_t* depth_data_in, const uint8_t* ir_data, 
+    // The round trip distances are only computed over the patch around the zero order point
+    template<typename F>
+    bool try_get_zo_rtd_ir_point_values(F rtd_at, const uint16_t* depth_data_in, const uint8_t* ir_data,
         const rs2_intrinsics& intrinsics, const zero_order_options& options, int zo_point_x, int zo_point_y,
         double *rtd_zo_value, uint8_t* ir_zo_data)
     {
@@ -80,9 +80,9 @@ namespace librealsense
             zo_point_y - options.patch_size < 0 || zo_point_y + options.patch_size >= intrinsics.height)
             return false;
 
-        auto values_rtd = get_zo_point_values(rtd, intrinsics, zo_point_x, zo_point_y, options.patch_size);
-        auto values_ir = get_zo_point_values(ir_data, intrinsics, zo_point_x, zo_point_y, options.patch_size);
-        auto values_z = get_zo_point_values(depth_data_in, intrinsics, zo_point_x, zo_point_y, options.patch_size);
+        auto values_rtd = get_zo_point_values<double>(rtd_at, intrinsics, zo_point_x, zo_point_y, options.patch_size);
+        auto values_ir = get_zo_point_values<uint8_t>([&](int i) { return ir_data[i]; }, intrinsics, zo_point_x, zo_point_y, options.patch_size);
+        auto values_z = get_zo_point_values<uint16_t>([&](int i) { return depth_data_in[i]; }, intrinsics, zo_point_x, zo_point_y, options.patch_size);
 
         for (auto i = 0; i < values_rtd.size(); i++)
         {
@@ -112,10 +112,49 @@ namespace librealsense
         return true;
     }
 
-    template<class T>
-    void detect_zero_order(const double * rtd, const uint16_t* depth_data_in, const uint8_t* ir_data, T zero_pixel,
-       const rs2_intrinsics& intrinsics, const zero_order_options& options,
-       float zo_value, uint8_t iro_value)
+#ifdef __SSSE3__
+    // Classifies 8 pixels per step with the same float operations as get_pixel_rtd, returns how many pixels were handled
+    size_t detect_zero_order_sse(const zero_order_detection& d, size_t count)
+    {
+        const auto zero = _mm_setzero_si128();
+        const auto units = _mm_set1_ps(d.depth_units_mm);
+        const auto two_baseline = _mm_set1_ps(2 * d.baseline);
+        const auto baseline_squared = _mm_set1_ps(d.baseline * d.baseline);
+        const auto low = _mm_set1_ps(d.rtd_low), high = _mm_set1_ps(d.rtd_high);
+        const auto ir_limit = _mm_set1_epi16(static_cast<short>(d.ir_limit));
+
+        auto in_range = [&](__m128i depth, size_t index)
+        {
+            auto z = _mm_mul_ps(_mm_cvtepi32_ps(depth), units);
+            auto distance = _mm_mul_ps(z, _mm_loadu_ps(d.ray_norm + index));
+            auto to_receiver = _mm_add_ps(_mm_sub_ps(_mm_mul_ps(distance, distance),
+                _mm_mul_ps(_mm_mul_ps(two_baseline, z), _mm_loadu_ps(d.ray_x + index))), baseline_squared);
+            auto rtd = _mm_add_ps(distance, _mm_sqrt_ps(_mm_max_ps(to_receiver, _mm_setzero_ps())));
+            return _mm_castps_si128(_mm_and_ps(_mm_cmpgt_ps(rtd, low), _mm_cmplt_ps(rtd, high)));
+        };
+
+        size_t i = 0;
+        for (; i + 8 <= count; i += 8)
+        {
+            auto depth = _mm_loadu_si128(reinterpret_cast<const __m128i*>(d.depth_in + i));
+            auto ir = _mm_unpacklo_epi8(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(d.ir + i)), zero);
+
+            auto rtd_in_range = _mm_packs_epi32(in_range(_mm_unpacklo_epi16(depth, zero), i), in_range(_mm_unpackhi_epi16(depth, zero), i + 4));
+            auto candidate = _mm_andnot_si128(_mm_cmpeq_epi16(depth, zero), _mm_cmplt_epi16(ir, ir_limit));
+            auto invalid = _mm_and_si128(rtd_in_range, candidate);
+
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(d.depth_out + i), _mm_andnot_si128(invalid, depth));
+            if (d.confidence_in)
+            {
+                auto confidence = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(d.confidence_in + i));
+                _mm_storel_epi64(reinterpret_cast<__m128i*>(d.confidence_out + i), _mm_andnot_si128(_mm_packs_epi16(invalid, invalid), confidence));
+            }
+        }
+        return i;
+    }
+#endif
+
+    void detect_zero_order(zero_order_detection& d, size_t count, const zero_order_options& options, float zo_value, uint8_t iro_value)
     {
         const int ir_dynamic_range = 256;
 
@@ -123,34 +162,47 @@ namespace librealsense
 
         auto res = (1 + r);
         auto i_threshold_relative = (double)options.ir_threshold / res;
-        for (auto i = 0; i < intrinsics.height*intrinsics.width; i++)
+
+        // An integer IR value is below the relative threshold exactly when it is below the smallest integer not below it
+        d.ir_limit = 0;
+        while (d.ir_limit < ir_dynamic_range && d.ir_limit < i_threshold_relative)
+            d.ir_limit++;
+        d.rtd_low = zo_value - options.rtd_low_threshold;
+        d.rtd_high = zo_value + options.rtd_high_threshold;
+
+        size_t i = 0;
+#ifdef __SSSE3__
+        if (get_simd_level() >= simd_level::ssse3)
+            i = detect_zero_order_sse(d, count);
+#endif
+        for (; i < count; i++)
         {
-            auto rtd_val = rtd[i];
-            auto ir_val = ir_data[i];
+            auto rtd_val = get_pixel_rtd(d.depth_in[i] * d.depth_units_mm, d.ray_norm[i], d.ray_x[i], d.baseline);
 
-            auto zero = (depth_data_in[i] > 0) && (ir_val < i_threshold_relative) &&
-                (rtd_val > (zo_value - options.rtd_low_threshold)) && (rtd_val < (zo_value + options.rtd_high_threshold));
+            auto zero = (d.depth_in[i] > 0) && (d.ir[i] < d.ir_limit) &&
+                (rtd_val > d.rtd_low) && (rtd_val < d.rtd_high);
 
-            zero_pixel(i, zero);
+            d.depth_out[i] = zero ? 0 : d.depth_in[i];
+            if (d.confidence_in)
+                d.confidence_out[i] = zero ? 0 : d.confidence_in[i];
         }
     }
 
-    template<class T>
-    bool zero_order_invalidation(const uint16_t * depth_data_in, const uint8_t * ir_data, T zero_pixel,
-        const rs2::vertex* vertices,
-        rs2_intrinsics intrinsics,
+    bool zero_order_invalidation(zero_order_detection& d, const rs2_intrinsics& intrinsics,
         const zero_order_options& options, int zo_point_x, int zo_point_y)
     {
-        std::vector<double> rtd(intrinsics.height*intrinsics.width);
-        z2rtd(vertices, rtd.data(), intrinsics, options.baseline);
         double rtd_zo_value;
         uint8_t ir_zo_value;
 
-        if (try_get_zo_rtd_ir_point_values(rtd.data(), depth_data_in, ir_data, intrinsics, 
-            options,zo_point_x, zo_point_y, &rtd_zo_value, &ir_zo_value))
+        auto rtd_at = [&](int i)
         {
-            detect_zero_order(rtd.data(), depth_data_in, ir_data, zero_pixel, intrinsics,
-                options, rtd_zo_value, ir_zo_value);
+            return get_pixel_rtd(d.depth_in[i] * d.depth_units_mm, d.ray_norm[i], d.ray_x[i], d.baseline);
+        };
+
+        if (try_get_zo_rtd_ir_point_values(rtd_at, d.depth_in, d.ir, intrinsics,
+            options, zo_point_x, zo_point_y, &rtd_zo_value, &ir_zo_value))
+        {
+            detect_zero_order(d, intrinsics.width * intrinsics.height, options, rtd_zo_value, ir_zo_value);
             return true;
         }
         return false;
@@ -357,6 +409,28 @@ namespace librealsense
         return { intrinsics.zo.x, intrinsics.zo.y };
     }
 
+    void zero_order::update_rays(const rs2_intrinsics& intrinsics)
+    {
+        if (_rays_intrinsics && *_rays_intrinsics == intrinsics)
+            return;
+
+        _ray_norm.resize(intrinsics.width * intrinsics.height);
+        _ray_x.resize(intrinsics.width * intrinsics.height);
+        for (int y = 0; y < intrinsics.height; ++y)
+        {
+            for (int x = 0; x < intrinsics.width; ++x)
+            {
+                const float pixel[] = { (float)x, (float)y };
+                float ray[3];
+                rs2_deproject_pixel_to_point(ray, &intrinsics, pixel, 1.f);
+
+                _ray_norm[y * intrinsics.width + x] = std::sqrt(ray[0] * ray[0] + ray[1] * ray[1] + ray[2] * ray[2]);
+                _ray_x[y * intrinsics.width + x] = ray[0];
+            }
+        }
+        _rays_intrinsics = intrinsics;
+    }
+
     rs2::frame zero_order::process_frame(const rs2::frame_source& source, const rs2::frame& f)
     {
         std::vector<rs2::frame> result;
@@ -379,14 +453,14 @@ namespace librealsense
             _source_profile_depth = data.get_depth_frame().get_profile();
             _target_profile_depth = _source_profile_depth.clone(_source_profile_depth.stream_type(), _source_profile_depth.stream_index(), _source_profile_depth.format());
 
+            auto sensor = ((frame_interface*)data.get_depth_frame().get())->get_sensor();
+            _depth_units = sensor->get_option(RS2_OPTION_DEPTH_UNITS).query();
         }
 
         auto depth_frame = data.get_depth_frame();
         auto ir_frame = data.get_infrared_frame();
         auto confidence_frame = data.first_or_default(RS2_STREAM_CONFIDENCE);
 
-        auto points = _pc.calculate(depth_frame);
-
         auto depth_out = source.allocate_video_frame(_target_profile_depth, depth_frame, 0, 0, 0, 0, RS2_EXTENSION_DEPTH_FRAME);
 
         rs2::frame confidence_out;
@@ -401,31 +475,26 @@ namespace librealsense
             confidence_out = source.allocate_video_frame(_source_profile_confidence, confidence_frame, 0, 0, 0, 0, RS2_EXTENSION_VIDEO_FRAME);
         }
         auto depth_intrinsics = depth_frame.get_profile().as<rs2::video_stream_profile>().get_intrinsics();
+        update_rays(depth_intrinsics);
 
-        auto depth_output = (uint16_t*)depth_out.get_data();
-        uint8_t* confidence_output;
-
+        zero_order_detection detection = {};
+        detection.depth_in = (const uint16_t*)depth_frame.get_data();
+        detection.ir = (const uint8_t*)ir_frame.get_data();
+        detection.depth_out = (uint16_t*)depth_out.get_data();
         if (confidence_frame)
         {
-            confidence_output = (uint8_t*)confidence_out.get_data();
+            detection.confidence_in = (const uint8_t*)confidence_frame.get_data();
+            detection.confidence_out = (uint8_t*)confidence_out.get_data();
         }
+        detection.ray_norm = _ray_norm.data();
+        detection.ray_x = _ray_x.data();
+        detection.depth_units_mm = _depth_units * METER_TO_MM;
+        // The baseline is taken in whole mm, as when the distances were computed from the vertices of a pointcloud
+        detection.baseline = static_cast<float>(static_cast<int>(_options.baseline));
 
         auto zo = get_zo_point(f);
 
-        if (zero_order_invalidation((const uint16_t*)depth_frame.get_data(),
-            (const uint8_t*)ir_frame.get_data(),
-            [&](int index, bool zero) 
-        {
-            depth_output[index] = zero ? 0 : ((uint16_t*)depth_frame.get_data())[index];
-
-            if (confidence_frame)
-            {
-                confidence_output[index] = zero ? 0 : ((uint8_t*)confidence_frame.get_data())[index];
-            }
-        },
-            points.get_vertices(),
-            depth_intrinsics,
-            _options, zo.first, zo.second))
+        if (zero_order_invalidation(detection, depth_intrinsics, _options, zo.first, zo.second))
         {
             result.push_back(depth_out);
             result.push_back(ir_frame);
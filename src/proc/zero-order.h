@@ -45,6 +45,27 @@ namespace librealsense
         int                     threshold_scale;
     };
 
+    // Inputs of the per-pixel classification, which invalidates the valid depth pixels of dim IR
+    // whose round trip distance is within the thresholds around the one of the zero order point
+    struct zero_order_detection
+    {
+        const uint16_t* depth_in;
+        const uint8_t* ir;
+        const uint8_t* confidence_in;
+        uint16_t* depth_out;
+        uint8_t* confidence_out;
+        const float* ray_norm;
+        const float* ray_x;
+        float depth_units_mm;
+        float baseline;
+        float rtd_low, rtd_high;
+        int ir_limit;           // IR values below it are under the relative IR threshold
+    };
+
+    // Classifies count pixels around the round trip distance and IR of the zero order point, with SSSE3
+    // unless the SIMD level of the library (get_simd_level) is set to scalar. Sets the thresholds of d
+    void detect_zero_order(zero_order_detection& d, size_t count, const zero_order_options& options, float zo_value, uint8_t iro_value);
+
     class zero_order : public generic_processing_block
     {
     public:
@@ -60,6 +81,7 @@ namespace librealsense
         ivcam2::intrinsic_params try_read_intrinsics(const rs2::frame& frame);
 
         std::pair<int, int> get_zo_point(const rs2::frame& frame);
+        void update_rays(const rs2_intrinsics& intrinsics);
 
         rs2::stream_profile     _source_profile_depth;
         rs2::stream_profile     _target_profile_depth;
@@ -67,7 +89,12 @@ namespace librealsense
         rs2::stream_profile     _source_profile_confidence;
         rs2::stream_profile     _target_profile_confidence;
 
-        rs2::pointcloud         _pc;
+        // Norm and x component of the ray of each depth pixel at unit depth, from which the round trip
+        // distances are computed without deprojecting the whole frame
+        std::vector<float>      _ray_norm;
+        std::vector<float>      _ray_x;
+        optional_value<rs2_intrinsics> _rays_intrinsics;
+        float                   _depth_units = 0.f;
 
         bool                    _first_frame;
 
@@ -30,6 +30,7 @@
 #include "proc/hole-filling-filter.h"
 #include "proc/yuy2rgb.h"
 #include "proc/rates-printer.h"
+#include "proc/depth-postprocess.h"
 #include "media/playback/playback_device.h"
 #include "stream.h"
 #include "../include/librealsense2/h/rs_types.h"
@@ -100,8 +101,8 @@ struct rs2_pipeline_profile
 
 struct rs2_frame_queue
 {
-    explicit rs2_frame_queue(int cap)
-        : queue(cap)
+    explicit rs2_frame_queue(int cap, bool lock_free = false)
+        : queue(cap, lock_free)
     {
     }
 
@@ -667,6 +668,37 @@ void rs2_set_notifications_callback_cpp(const rs2_sensor* sensor, rs2_notificati
 }
 HANDLE_EXCEPTIONS_AND_RETURN(, sensor, callback)
 
+void rs2_set_frame_allocator(const rs2_sensor* sensor, rs2_frame_alloc_callback_ptr alloc_cb, rs2_frame_free_callback_ptr free_cb, void* user, rs2_error** error) BEGIN_API_CALL
+{
+    VALIDATE_NOT_NULL(sensor);
+    auto sb = dynamic_cast<librealsense::sensor_base*>(sensor->sensor);
+    if (!sb)
+        throw librealsense::not_implemented_exception("Custom frame allocators are not supported by this sensor");
+
+    if (!alloc_cb)
+    {
+        sb->set_frame_allocator(nullptr);
+        return;
+    }
+    VALIDATE_NOT_NULL(free_cb);
+    librealsense::frame_allocator_ptr allocator(
+        new librealsense::frame_allocator(alloc_cb, free_cb, user), [](rs2_frame_allocator* p) { p->release(); });
+    sb->set_frame_allocator(allocator);
+}
+HANDLE_EXCEPTIONS_AND_RETURN(, sensor, alloc_cb, free_cb, user)
+
+void rs2_set_frame_allocator_cpp(const rs2_sensor* sensor, rs2_frame_allocator* allocator, rs2_error** error) BEGIN_API_CALL
+{
+    VALIDATE_NOT_NULL(sensor);
+    VALIDATE_NOT_NULL(allocator);
+    librealsense::frame_allocator_ptr ptr(allocator, [](rs2_frame_allocator* p) { p->release(); });
+    auto sb = dynamic_cast<librealsense::sensor_base*>(sensor->sensor);
+    if (!sb)
+        throw librealsense::not_implemented_exception("Custom frame allocators are not supported by this sensor");
+    sb->set_frame_allocator(ptr);
+}
+HANDLE_EXCEPTIONS_AND_RETURN(, sensor, allocator)
+
 void rs2_set_devices_changed_callback_cpp(rs2_context* context, rs2_devices_changed_callback* callback, rs2_error** error) BEGIN_API_CALL
 {
     VALIDATE_NOT_NULL(context);
@@ -698,6 +730,15 @@ rs2_metadata_type rs2_get_frame_metadata(const rs2_frame* frame, rs2_frame_metad
 }
 HANDLE_EXCEPTIONS_AND_RETURN(0, frame, frame_metadata)
 
+unsigned long long rs2_get_frame_metadata_all(const rs2_frame* frame, rs2_metadata_type* values, int count, rs2_error** error) BEGIN_API_CALL
+{
+    VALIDATE_NOT_NULL(frame);
+    VALIDATE_NOT_NULL(values);
+    VALIDATE_RANGE(count, 0, std::numeric_limits<int>::max());
+    return ((frame_interface*)frame)->get_frame_metadata_all(values, count);
+}
+HANDLE_EXCEPTIONS_AND_RETURN(0, frame, values, count)
+
 const char* rs2_get_notification_description(rs2_notification* notification, rs2_error** error) BEGIN_API_CALL
 {
     VALIDATE_NOT_NULL(notification);
@@ -880,6 +921,13 @@ rs2_frame_queue* rs2_create_frame_queue(int capacity, rs2_error** error) BEGIN_A
 }
 HANDLE_EXCEPTIONS_AND_RETURN(nullptr, capacity)
 
+rs2_frame_queue* rs2_create_frame_queue_ex(int capacity, int lock_free, rs2_error** error) BEGIN_API_CALL
+{
+    VALIDATE_RANGE(capacity, 1, int(lock_free_single_consumer_queue<librealsense::frame_holder>::max_capacity));
+    return new rs2_frame_queue(capacity, lock_free != 0);
+}
+HANDLE_EXCEPTIONS_AND_RETURN(nullptr, capacity, lock_free)
+
 void rs2_delete_frame_queue(rs2_frame_queue* queue) BEGIN_API_CALL
 {
     VALIDATE_NOT_NULL(queue);
@@ -1077,6 +1125,7 @@ const char* rs2_sr300_visual_preset_to_string(rs2_sr300_visual_preset preset)
 const char* rs2_log_severity_to_string(rs2_log_severity severity)                         { return librealsense::get_string(severity);     }
 const char* rs2_exception_type_to_string(rs2_exception_type type)                         { return librealsense::get_string(type);         }
 const char* rs2_playback_status_to_string(rs2_playback_status status)                     { return librealsense::get_string(status);       }
+const char* rs2_recorder_overflow_policy_to_string(rs2_recorder_overflow_policy policy)    { return librealsense::get_string(policy);       }
 const char* rs2_extension_type_to_string(rs2_extension type)                              { return librealsense::get_string(type);         }
 const char* rs2_frame_metadata_to_string(rs2_frame_metadata_value metadata)               { return librealsense::get_string(metadata);     }
 const char* rs2_extension_to_string(rs2_extension type)                                   { return rs2_extension_type_to_string(type);     }
@@ -1178,6 +1227,7 @@ int rs2_is_processing_block_extendable_to(const rs2_processing_block* f, rs2_ext
     case RS2_EXTENSION_TEMPORAL_FILTER: return VALIDATE_INTERFACE_NO_THROW((processing_block_interface*)(f->block.get()), librealsense::temporal_filter) != nullptr;
     case RS2_EXTENSION_HOLE_FILLING_FILTER: return VALIDATE_INTERFACE_NO_THROW((processing_block_interface*)(f->block.get()), librealsense::hole_filling_filter) != nullptr;
     case RS2_EXTENSION_ZERO_ORDER_FILTER: return VALIDATE_INTERFACE_NO_THROW((processing_block_interface*)(f->block.get()), librealsense::zero_order) != nullptr;
+    case RS2_EXTENSION_DEPTH_POSTPROCESS_FILTER: return VALIDATE_INTERFACE_NO_THROW((processing_block_interface*)(f->block.get()), librealsense::depth_postprocess) != nullptr;
   
     default:
         return false;
@@ -1270,6 +1320,27 @@ unsigned long long int rs2_playback_get_position(const rs2_device* device, rs2_e
 }
 HANDLE_EXCEPTIONS_AND_RETURN(0, device)
 
+unsigned long long int rs2_playback_get_frames_count(const rs2_device* device, const rs2_stream_profile* profile, rs2_error** error) BEGIN_API_CALL
+{
+    VALIDATE_NOT_NULL(device);
+    VALIDATE_NOT_NULL(profile);
+    auto playback = VALIDATE_INTERFACE(device->device, librealsense::playback_device);
+    return playback->get_frames_count(*profile->profile);
+}
+HANDLE_EXCEPTIONS_AND_RETURN(0, device, profile)
+
+rs2_frame* rs2_playback_get_frame(const rs2_device* device, const rs2_stream_profile* profile, unsigned long long int index, rs2_error** error) BEGIN_API_CALL
+{
+    VALIDATE_NOT_NULL(device);
+    VALIDATE_NOT_NULL(profile);
+    auto playback = VALIDATE_INTERFACE(device->device, librealsense::playback_device);
+    auto f = playback->get_frame(*profile->profile, index);
+    auto frame = f.frame;
+    f.frame = nullptr;
+    return (rs2_frame*)(frame);
+}
+HANDLE_EXCEPTIONS_AND_RETURN(nullptr, device, profile, index)
+
 void rs2_playback_device_resume(const rs2_device* device, rs2_error** error) BEGIN_API_CALL
 {
     VALIDATE_NOT_NULL(device);
@@ -1294,6 +1365,14 @@ void rs2_playback_device_set_real_time(const rs2_device* device, int real_time,
 }
 HANDLE_EXCEPTIONS_AND_RETURN(, device)
 
+void rs2_playback_device_set_read_ahead(const rs2_device* device, unsigned int threads, unsigned long long max_bytes, rs2_error** error) BEGIN_API_CALL
+{
+    VALIDATE_NOT_NULL(device);
+    auto playback = VALIDATE_INTERFACE(device->device, librealsense::playback_device);
+    playback->set_read_ahead(threads, max_bytes);
+}
+HANDLE_EXCEPTIONS_AND_RETURN(, device, threads, max_bytes)
+
 int rs2_playback_device_is_real_time(const rs2_device* device, rs2_error** error) BEGIN_API_CALL
 {
     VALIDATE_NOT_NULL(device);
@@ -1352,13 +1431,27 @@ rs2_device* rs2_create_record_device_ex(const rs2_device* device, const char* fi
     VALIDATE_NOT_NULL(device);
     VALIDATE_NOT_NULL(file);
 
+    auto config = record_device::default_config(compression_enabled != 0);
+    return rs2_create_record_device_with_config(device, file, &config, error);
+}
+HANDLE_EXCEPTIONS_AND_RETURN(nullptr, device, file)
+
+rs2_device* rs2_create_record_device_with_config(const rs2_device* device, const char* file, const rs2_recorder_config* config, rs2_error** error) BEGIN_API_CALL
+{
+    VALIDATE_NOT_NULL(device);
+    VALIDATE_NOT_NULL(file);
+    VALIDATE_NOT_NULL(config);
+    VALIDATE_ENUM(config->overflow_policy);
+    VALIDATE_RANGE(config->compression_level, 0, 9);
+    VALIDATE_RANGE(config->compression_threads, 0, 64);
+
     return new rs2_device({
         device->ctx,
         device->info,
-        std::make_shared<record_device>(device->device, std::make_shared<ros_writer>(file, compression_enabled))
+        std::make_shared<record_device>(device->device, std::make_shared<ros_writer>(file, *config), *config)
         });
 }
-HANDLE_EXCEPTIONS_AND_RETURN(nullptr, device, file)
+HANDLE_EXCEPTIONS_AND_RETURN(nullptr, device, file, config)
 
 void rs2_record_device_pause(const rs2_device* device, rs2_error** error) BEGIN_API_CALL
 {
@@ -1384,6 +1477,15 @@ const char* rs2_record_device_filename(const rs2_device* device, rs2_error** err
 }
 HANDLE_EXCEPTIONS_AND_RETURN(nullptr, device)
 
+void rs2_record_device_get_statistics(const rs2_device* device, rs2_recorder_statistics* stats, rs2_error** error) BEGIN_API_CALL
+{
+    VALIDATE_NOT_NULL(device);
+    VALIDATE_NOT_NULL(stats);
+    auto record_device = VALIDATE_INTERFACE(device->device, librealsense::record_device);
+    record_device->get_statistics(*stats);
+}
+HANDLE_EXCEPTIONS_AND_RETURN(, device, stats)
+
 
 rs2_frame* rs2_allocate_synthetic_video_frame(rs2_source* source, const rs2_stream_profile* new_stream, rs2_frame* original,
     int new_bpp, int new_width, int new_height, int new_stride, rs2_extension frame_type, rs2_error** error) BEGIN_API_CALL
@@ -1737,6 +1839,14 @@ rs2_processing_block* rs2_create_sync_processing_block(rs2_error** error) BEGIN_
 }
 NOARGS_HANDLE_EXCEPTIONS_AND_RETURN(nullptr)
 
+rs2_processing_block* rs2_create_multi_device_sync_processing_block(rs2_error** error) BEGIN_API_CALL
+{
+    auto block = std::make_shared<librealsense::multi_device_syncer_process_unit>();
+
+    return new rs2_processing_block{ block };
+}
+NOARGS_HANDLE_EXCEPTIONS_AND_RETURN(nullptr)
+
 void rs2_start_processing(rs2_processing_block* block, rs2_frame_callback* on_frame, rs2_error** error) BEGIN_API_CALL
 {
     VALIDATE_NOT_NULL(block);
@@ -1957,6 +2067,33 @@ rs2_processing_block* rs2_create_zero_order_invalidation_block(rs2_error** error
 }
 NOARGS_HANDLE_EXCEPTIONS_AND_RETURN(nullptr)
 
+// Stages of the depth post-processing block are optional, but a given one has to be of the expected kind
+template<class T>
+static std::shared_ptr<T> get_postprocess_stage(rs2_processing_block* block, const char* stage)
+{
+    if (!block)
+        return nullptr;
+
+    auto filter = std::dynamic_pointer_cast<T>(block->block);
+    if (!filter)
+        throw librealsense::invalid_value_exception(librealsense::to_string() << "The " << stage << " stage is not a " << stage << " filter block");
+    return filter;
+}
+
+rs2_processing_block* rs2_create_depth_postprocess_block(rs2_processing_block* decimation, rs2_processing_block* spatial,
+    rs2_processing_block* temporal, rs2_processing_block* hole_filling, int use_disparity, rs2_error** error) BEGIN_API_CALL
+{
+    auto block = std::make_shared<librealsense::depth_postprocess>(
+        get_postprocess_stage<librealsense::decimation_filter>(decimation, "decimation"),
+        get_postprocess_stage<librealsense::spatial_filter>(spatial, "spatial"),
+        get_postprocess_stage<librealsense::temporal_filter>(temporal, "temporal"),
+        get_postprocess_stage<librealsense::hole_filling_filter>(hole_filling, "hole filling"),
+        use_disparity != 0);
+
+    return new rs2_processing_block{ block };
+}
+HANDLE_EXCEPTIONS_AND_RETURN(nullptr, decimation, spatial, temporal, hole_filling, use_disparity)
+
 float rs2_get_depth_scale(rs2_sensor* sensor, rs2_error** error) BEGIN_API_CALL
 {
     VALIDATE_NOT_NULL(sensor);
@@ -2125,6 +2262,23 @@ void rs2_software_sensor_update_read_only_option(rs2_sensor* sensor, rs2_option
 }
 HANDLE_EXCEPTIONS_AND_RETURN(, sensor, option, val)
 
+void rs2_get_frame_pool_statistics(const rs2_sensor* sensor, rs2_frame_pool_statistics* stats, rs2_error** error) BEGIN_API_CALL
+{
+    VALIDATE_NOT_NULL(sensor);
+    VALIDATE_NOT_NULL(stats);
+    auto sb = dynamic_cast<librealsense::sensor_base*>(sensor->sensor);
+    if (!sb)
+        throw librealsense::not_implemented_exception("Frame pool statistics are not available for this sensor");
+
+    auto res = sb->get_frame_pool_statistics();
+    stats->hits = res.hits;
+    stats->misses = res.misses;
+    stats->expired = res.expired;
+    stats->pooled_buffers = res.pooled_buffers;
+    stats->pooled_bytes = res.pooled_bytes;
+}
+HANDLE_EXCEPTIONS_AND_RETURN(, sensor, stats)
+
 void rs2_log(rs2_log_severity severity, const char * message, rs2_error ** error) BEGIN_API_CALL
 {
     VALIDATE_ENUM(severity);
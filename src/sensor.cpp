@@ -34,6 +34,7 @@ namespace librealsense
           })
     {
         register_option(RS2_OPTION_FRAMES_QUEUE_SIZE, _source.get_published_size_option());
+        register_option(RS2_OPTION_FRAME_POOL_RETENTION, _source.get_pool_retention_option());
 
         register_metadata(RS2_FRAME_METADATA_TIME_OF_ARRIVAL, std::make_shared<librealsense::md_time_of_arrival_parser>());
 
@@ -437,14 +438,17 @@ namespace librealsense
 
         std::vector<platform::stream_profile> commited;
 
+        // Formats that are plain copies of the payload are published without copying when the backend keeps its buffers alive for the frame
+        auto zero_copy = _device->supports_zero_copy();
         for (auto&& mode : mapping)
         {
             try
             {
                 unsigned long long last_frame_number = 0;
                 rs2_time_t last_timestamp = 0;
+                auto requires_processing = mode.requires_processing() && !(zero_copy && is_zero_copy_capable(*mode.unpacker));
                 _device->probe_and_commit(mode.profile,
-                [this, mode, timestamp_reader, requests, last_frame_number, last_timestamp](platform::stream_profile p, platform::frame_object f, std::function<void()> continuation) mutable
+                [this, mode, timestamp_reader, requests, last_frame_number, last_timestamp, requires_processing](platform::stream_profile p, platform::frame_object f, std::function<void()> continuation) mutable
                 {
                     auto system_time = environment::get_instance().get_time_service()->get_time();
                     if (!this->is_streaming())
@@ -456,7 +460,8 @@ namespace librealsense
                         return;
                     }
 
-                    frame_continuation release_and_enqueue(continuation, f.pixels);
+                    frame_continuation release_and_enqueue(continuation, f.pixels, requires_processing ? 0 :
+                        get_image_size(mode.profile.width, mode.profile.height, mode.unpacker->outputs.front().format));
 
                     // Ignore any frames which appear corrupted or invalid
                     // Determine the timestamp for this frame
@@ -464,8 +469,6 @@ namespace librealsense
                     auto timestamp_domain = timestamp_reader->get_frame_timestamp_domain(mode, f);
                     auto frame_counter = timestamp_reader->get_frame_counter(mode, f);
 
-                    auto requires_processing = mode.requires_processing();
-
                     std::vector<byte *> dest;
                     std::vector<frame_holder> refs;
 
@@ -823,6 +826,7 @@ namespace librealsense
     stream_profiles hid_sensor::get_sensor_profiles(std::string sensor_name) const
     {
         stream_profiles profiles{};
+        stream_profiles batch_profiles{};
         for (auto& elem : _sensor_name_and_hid_profiles)
         {
             if (!elem.first.compare(sensor_name))
@@ -835,9 +839,22 @@ namespace librealsense
                 profile->set_format(p.format);
                 profile->set_framerate(p.fps);
                 profiles.push_back(profile);
+
+                // Each motion profile can also be streamed as batches of samples
+                if (p.format == RS2_FORMAT_MOTION_XYZ32F)
+                {
+                    auto batch_profile = std::make_shared<motion_stream_profile>(sp);
+                    batch_profile->set_stream_index(p.index);
+                    batch_profile->set_stream_type(p.stream);
+                    batch_profile->set_format(RS2_FORMAT_MOTION_XYZ32F_BATCH);
+                    batch_profile->set_framerate(p.fps);
+                    batch_profiles.push_back(batch_profile);
+                }
             }
         }
 
+        // The batched profiles follow all the regular ones, which keep their former order
+        profiles.insert(profiles.end(), batch_profiles.begin(), batch_profiles.end());
         return profiles;
     }
 
@@ -938,7 +955,7 @@ namespace librealsense
         unsigned long long last_frame_number = 0;
         rs2_time_t last_timestamp = 0;
         raise_on_before_streaming_changes(true); //Required to be just before actual start allow recording to work
-        _hid_device->start_capture([this,last_frame_number,last_timestamp](const platform::sensor_data& sensor_data) mutable
+        auto on_sample = [this,last_frame_number,last_timestamp](const platform::sensor_data& sensor_data) mutable
         {
             auto system_time = environment::get_instance().get_time_service()->get_time();
             auto timestamp_reader = _hid_iio_timestamp_reader.get();
@@ -1026,11 +1043,120 @@ namespace librealsense
             }
 
             _source.invoke_callback(std::move(frame));
+        };
+
+        // Batched streams are opt-in, so sensors that only stream one sample per frame keep the per-sample backend callback
+        auto batched = std::any_of(_configured_profiles.begin(), _configured_profiles.end(), [](const std::pair<const std::string, stream_profile>& p)
+        {
+            return p.second.format == RS2_FORMAT_MOTION_XYZ32F_BATCH;
         });
 
+        if (!batched)
+        {
+            _hid_device->start_capture(on_sample);
+        }
+        else
+        {
+            _hid_device->start_batch_capture([this, on_sample, last_frame_number, last_timestamp](const platform::sensor_data_batch& batch) mutable
+            {
+                auto it = _configured_profiles.find(batch.sensor.name);
+                if (it == _configured_profiles.end() || it->second.format != RS2_FORMAT_MOTION_XYZ32F_BATCH)
+                {
+                    for (size_t i = 0; i < batch.samples_count; i++)
+                        on_sample(platform::sensor_data{ batch.sensor, batch.samples[i] });
+                    return;
+                }
+                on_batch(batch, last_frame_number, last_timestamp);
+            });
+        }
+
         _is_streaming = true;
     }
 
+    // Packs all the samples of a batch into a single motion frame of rs2_motion_sample.
+    // The frame takes the timestamp, counter and metadata of its first sample
+    void hid_sensor::on_batch(const platform::sensor_data_batch& batch, unsigned long long& last_frame_number, rs2_time_t& last_timestamp)
+    {
+        auto system_time = environment::get_instance().get_time_service()->get_time();
+        auto timestamp_reader = _hid_iio_timestamp_reader.get();
+        auto&& sensor_name = batch.sensor.name;
+
+        if (!this->is_streaming())
+        {
+            LOG_INFO("HID Frame received when Streaming is not active,"
+                        << get_string(_configured_profiles[sensor_name].stream)
+                        << ",Arrived," << std::fixed << system_time);
+            return;
+        }
+
+        auto mode = _hid_mapping[sensor_name];
+        auto request = *(mode.original_requests.begin());
+        auto&& first = batch.samples[0];
+        mode.profile.width = (uint32_t)first.frame_size;
+        mode.profile.height = 1;
+
+        auto timestamp = timestamp_reader->get_frame_timestamp(mode, first);
+        auto frame_counter = timestamp_reader->get_frame_counter(mode, first);
+        auto ts_domain = timestamp_reader->get_frame_timestamp_domain(mode, first);
+
+        frame_additional_data additional_data(timestamp,
+            frame_counter,
+            system_time,
+            static_cast<uint8_t>(first.metadata_size),
+            (const uint8_t*)first.metadata,
+            first.backend_time,
+            last_timestamp,
+            last_frame_number,
+            false);
+
+        additional_data.timestamp_domain = ts_domain;
+        additional_data.backend_timestamp = first.backend_time;
+
+        auto frame = _source.alloc_frame(RS2_EXTENSION_MOTION_FRAME, batch.samples_count * sizeof(rs2_motion_sample), additional_data, true);
+        if (!frame)
+        {
+            LOG_INFO("Dropped frame. alloc_frame(...) returned nullptr");
+            return;
+        }
+        frame->set_stream(request);
+
+        last_frame_number = frame_counter;
+        last_timestamp = timestamp;
+
+        auto samples = reinterpret_cast<rs2_motion_sample*>(const_cast<byte*>(frame->get_frame_data()));
+        for (size_t i = 0; i < batch.samples_count; i++)
+        {
+            auto&& sample = batch.samples[i];
+            // The first sample was already given to the timestamp reader above. The following samples
+            // still advance its counter, so frame numbers keep counting samples as in the unbatched format
+            if (i)
+            {
+                samples[i].timestamp = timestamp_reader->get_frame_timestamp(mode, sample);
+                timestamp_reader->get_frame_counter(mode, sample);
+            }
+            else
+                samples[i].timestamp = timestamp;
+
+            std::vector<byte*> dest{ reinterpret_cast<byte*>(&samples[i].data) };
+            mode.unpacker->unpack(dest.data(), (const byte*)sample.pixels, mode.profile.width, mode.profile.height, (int)sample.frame_size);
+        }
+
+        LOG_DEBUG("FrameAccepted," << get_string(request->get_stream_type())
+                << ",Counter," << std::dec << frame_counter << ",Samples," << batch.samples_count
+                << ",BackEndTS," << std::fixed << first.backend_time
+                << ",SystemTime," << std::fixed << system_time
+                << ",TS," << std::fixed << timestamp << ",TS_Domain," << rs2_timestamp_domain_to_string(ts_domain));
+
+        if (_on_before_frame_callback)
+        {
+            auto callback = _source.begin_callback();
+            auto stream_type = frame->get_stream()->get_stream_type();
+            _on_before_frame_callback(stream_type, frame, std::move(callback));
+        }
+
+        _source.invoke_callback(std::move(frame));
+    }
+
     void hid_sensor::stop()
     {
         std::lock_guard<std::mutex> lock(_configure_lock);
@@ -80,6 +80,16 @@ namespace librealsense
         {
             return {};
         }
+
+        frame_pool_statistics get_frame_pool_statistics() const
+        {
+            return _source.get_frame_pool_statistics();
+        }
+
+        void set_frame_allocator(frame_allocator_ptr allocator)
+        {
+            _source.set_frame_allocator(allocator);
+        }
     protected:
         void raise_on_before_streaming_changes(bool streaming);
         void set_active_streams(const stream_profiles& requests);
@@ -191,6 +201,8 @@ namespace librealsense
         uint32_t stream_to_fourcc(rs2_stream stream) const;
 
         uint32_t fps_to_sampling_frequency(rs2_stream stream, uint32_t fps) const;
+
+        void on_batch(const platform::sensor_data_batch& batch, unsigned long long& last_frame_number, rs2_time_t& last_timestamp);
     };
 
     class uvc_sensor : public sensor_base
@@ -150,7 +150,7 @@ namespace librealsense
         {
             if (supports_option(RS2_OPTION_DEPTH_UNITS))
             {
-                *ptr = &(*_stereo_extension);
+                *ptr = static_cast<depth_sensor*>(&(*_stereo_extension));
                 return true;
             }
         }
@@ -159,7 +159,7 @@ namespace librealsense
             if (supports_option(RS2_OPTION_DEPTH_UNITS) && 
                 supports_option(RS2_OPTION_STEREO_BASELINE))
             {
-                *ptr = &(*_stereo_extension);
+                *ptr = static_cast<depth_stereo_sensor*>(&(*_stereo_extension));
                 return true;
             }
         }
@@ -260,9 +260,10 @@ namespace librealsense
         vid_frame->assign(vid_profile->get_width(), vid_profile->get_height(), software_frame.stride, software_frame.bpp * 8);
 
         frame->set_stream(std::dynamic_pointer_cast<stream_profile_interface>(software_frame.profile->profile->shared_from_this()));
+        // The wrapped pixels are the frame data, its size accounts for them
         frame->attach_continuation(frame_continuation{ [=]() {
             software_frame.deleter(software_frame.pixels);
-        }, software_frame.pixels });
+        }, software_frame.pixels, static_cast<size_t>(software_frame.stride) * vid_profile->get_height() });
 
         auto sd = dynamic_cast<software_device*>(_owner);
         sd->register_extrinsic(*vid_profile, _unique_id);
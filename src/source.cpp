@@ -36,14 +36,62 @@ namespace librealsense
         std::atomic<uint32_t>* _ptr;
     };
 
+    class frame_pool_retention : public option_base
+    {
+    public:
+        frame_pool_retention(std::atomic<uint32_t>* ptr, const option_range& opt_range)
+            : option_base(opt_range),
+              _ptr(ptr)
+        {}
+
+        void set(float value) override
+        {
+            if (!is_valid(value))
+                throw invalid_value_exception(to_string() << "set(frame_pool_retention) failed! Given value " << value << " is out of range.");
+
+            *_ptr = static_cast<uint32_t>(value);
+            _recording_function(*this);
+        }
+
+        float query() const override { return static_cast<float>(_ptr->load()); }
+
+        bool is_enabled() const override { return true; }
+
+        const char* get_description() const override
+        {
+            return "Time in milliseconds released frame buffers are kept for reuse. Zero disables buffer recycling";
+        }
+    private:
+        std::atomic<uint32_t>* _ptr;
+    };
+
     std::shared_ptr<option> frame_source::get_published_size_option()
     {
         return std::make_shared<frame_queue_size>(&_max_publish_list_size, option_range{ 0, 32, 1, 16 });
     }
 
+    std::shared_ptr<option> frame_source::get_pool_retention_option()
+    {
+        return std::make_shared<frame_pool_retention>(&_pool_retention_ms, option_range{ 0, 10000, 100, 1000 });
+    }
+
+    frame_pool_statistics frame_source::get_frame_pool_statistics() const
+    {
+        std::lock_guard<std::mutex> lock(_callback_mutex);
+
+        frame_pool_statistics stats;
+        for (auto&& kvp : _archive)
+        {
+            if (kvp.second)
+                stats += kvp.second->get_pool_statistics();
+        }
+        return stats;
+    }
+
     frame_source::frame_source(uint32_t max_publish_list_size)
             : _callback(nullptr, [](rs2_frame_callback*) {}),
               _max_publish_list_size(max_publish_list_size),
+              _pool_retention_ms(1000),
               _ts(environment::get_instance().get_time_service())
     {}
 
@@ -61,12 +109,24 @@ namespace librealsense
 
         for (auto type : supported)
         {
-            _archive[type] = make_archive(type, &_max_publish_list_size, _ts, metadata_parsers);
+            _archive[type] = make_archive(type, &_max_publish_list_size, &_pool_retention_ms, _ts, metadata_parsers);
+            _archive[type]->set_frame_allocator(_allocator);
         }
 
         _metadata_parsers = metadata_parsers;
     }
 
+    void frame_source::set_frame_allocator(frame_allocator_ptr allocator)
+    {
+        std::lock_guard<std::mutex> lock(_callback_mutex);
+        _allocator = allocator;
+        for (auto&& kvp : _archive)
+        {
+            if (kvp.second)
+                kvp.second->set_frame_allocator(allocator);
+        }
+    }
+
     callback_invocation_holder frame_source::begin_callback()
     {
         return _archive[RS2_EXTENSION_VIDEO_FRAME]->begin_callback();
@@ -25,6 +25,12 @@ namespace librealsense
         void reset();
 
         std::shared_ptr<option> get_published_size_option();
+        std::shared_ptr<option> get_pool_retention_option();
+
+        frame_pool_statistics get_frame_pool_statistics() const;
+
+        // Buffers of frames allocated from now on are provided by the given allocator, nullptr restores the default one
+        void set_frame_allocator(frame_allocator_ptr allocator);
 
         frame_interface* alloc_frame(rs2_extension type, size_t size, frame_additional_data additional_data, bool requires_memory) const;
 
@@ -44,7 +50,8 @@ namespace librealsense
         template<class T>
         void add_extension(rs2_extension ex)
         {
-            _archive[ex] = std::make_shared<frame_archive<T>>(&_max_publish_list_size, _ts, _metadata_parsers);
+            _archive[ex] = std::make_shared<frame_archive<T>>(&_max_publish_list_size, &_pool_retention_ms, _ts, _metadata_parsers);
+            _archive[ex]->set_frame_allocator(_allocator);
         }
 
         void set_max_publish_list_size(int qsize) {_max_publish_list_size = qsize; }
@@ -57,8 +64,10 @@ namespace librealsense
         std::map<rs2_extension, std::shared_ptr<archive_interface>> _archive;
 
         std::atomic<uint32_t> _max_publish_list_size;
+        std::atomic<uint32_t> _pool_retention_ms;
         frame_callback_ptr _callback;
         std::shared_ptr<platform::time_service> _ts;
         std::shared_ptr<metadata_parser_map> _metadata_parsers;
+        frame_allocator_ptr _allocator;
     };
 }
@@ -5,6 +5,10 @@
 #include "sync.h"
 #include "environment.h"
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
 namespace librealsense
 {
     const int MAX_GAP = 1000;
@@ -114,17 +118,81 @@ namespace librealsense
         return s.str();
     }
 
+    sync_ring::sync_ring(size_t capacity)
+        : _entries(std::max<size_t>(capacity, 1)), _head(0), _size(0)
+    {
+    }
+
+    bool sync_ring::push(entry&& e, bool grow)
+    {
+        auto dropped = false;
+        if (_size == _entries.size())
+        {
+            if (grow)
+            {
+                // Blocking frames are never dropped, and the single thread driving the matcher cannot wait for room
+                std::vector<entry> entries(_entries.size() * 2);
+                for (size_t i = 0; i < _size; i++)
+                    entries[i] = std::move(_entries[(_head + i) % _entries.size()]);
+                _entries = std::move(entries);
+                _head = 0;
+            }
+            else
+            {
+                pop();
+                dropped = true;
+            }
+        }
+        _entries[(_head + _size) % _entries.size()] = std::move(e);
+        _size++;
+        return dropped;
+    }
+
+    sync_ring::entry sync_ring::pop()
+    {
+        auto e = std::move(_entries[_head]);
+        _head = (_head + 1) % _entries.size();
+        _size--;
+        return e;
+    }
+
+    size_t sync_ring::clear()
+    {
+        auto dropped = _size;
+        while (_size)
+            pop();
+        return dropped;
+    }
+
+    sync_telemetry::sync_telemetry()
+        : _matches(0), _matched_frames(0)
+    {
+        for (auto&& drops : _drops)
+            drops = 0;
+    }
+
+    void sync_telemetry::record_match(std::chrono::microseconds latency, std::chrono::microseconds skew, size_t frames)
+    {
+        _latency.record(latency);
+        _skew.record(skew);
+        _matches.fetch_add(1, std::memory_order_relaxed);
+        _matched_frames.fetch_add(frames, std::memory_order_relaxed);
+    }
+
+    void sync_telemetry::record_drop(sync_drop_reason reason, size_t frames)
+    {
+        if (frames)
+            _drops[static_cast<size_t>(reason)].fetch_add(frames, std::memory_order_relaxed);
+    }
+
     composite_matcher::composite_matcher(std::vector<std::shared_ptr<matcher>> matchers, std::string name)
     {
         for (auto&& matcher : matchers)
         {
+            auto slot = add_slot(matcher);
             for (auto&& stream : matcher->get_streams())
             {
-                matcher->set_callback([&](frame_holder f, syncronization_environment env)
-                {
-                    sync(std::move(f), env);
-                });
-                _matchers[stream] = matcher;
+                _stream_slots.push_back({ stream, slot });
                 _streams_id.push_back(stream);
             }
             for (auto&& stream : matcher->get_streams_types())
@@ -136,6 +204,32 @@ namespace librealsense
         _name = create_composite_name(matchers, name);
     }
 
+    size_t composite_matcher::add_slot(std::shared_ptr<matcher> m)
+    {
+        m->set_callback([&](frame_holder f, syncronization_environment env)
+        {
+            sync(std::move(f), env);
+        });
+
+        stream_slot slot;
+        slot.child = m;
+        slot.tracked = false;
+        slot.next_expected = 0;
+        slot.has_next_expected_domain = false;
+        slot.next_expected_domain = RS2_TIMESTAMP_DOMAIN_COUNT;
+        slot.last_arrived = 0;
+        slot.fps = 0;
+        _slots.push_back(std::move(slot));
+        return _slots.size() - 1;
+    }
+
+    void composite_matcher::drop_frames(size_t slot, sync_drop_reason reason, bool untrack)
+    {
+        _telemetry.record_drop(reason, _slots[slot].frames.clear());
+        if (untrack)
+            _slots[slot].tracked = false;
+    }
+
     void composite_matcher::dispatch(frame_holder f, syncronization_environment env)
     {
         std::stringstream s;
@@ -143,25 +237,39 @@ namespace librealsense
         LOG_DEBUG(s.str());
 
         clean_inactive_streams(f);
-        auto matcher = find_matcher(f);
-        update_last_arrived(f, matcher.get());
-        matcher->dispatch(std::move(f), env);
+        auto slot = find_slot(f);
+        update_last_arrived(f, slot);
+        _slots[slot].child->dispatch(std::move(f), env);
+    }
+
+    std::shared_ptr<matcher> composite_matcher::find_matcher(const frame_holder& f)
+    {
+        return _slots[find_slot(f)].child;
     }
 
-    std::shared_ptr<matcher> composite_matcher::find_matcher(const frame_holder& frame)
+    size_t composite_matcher::find_slot(const frame_holder& frame)
     {
-        std::shared_ptr<matcher> matcher;
         auto stream_id = frame.frame->get_stream()->get_unique_id();
         auto stream_type = frame.frame->get_stream()->get_stream_type();
 
-        auto sensor = frame.frame->get_sensor().get(); //TODO: Potential deadlock if get_sensor() gets a hold of the last reference of that sensor
+        auto it = std::find_if(_stream_slots.begin(), _stream_slots.end(),
+            [stream_id](const std::pair<librealsense::stream_id, size_t>& s) { return s.first == stream_id; });
+        if (it != _stream_slots.end())
+        {
+            auto& slot = _slots[it->second];
+            if (!slot.child->get_active())
+            {
+                slot.child->set_active(true);
+                slot.tracked = true;
+            }
+            return it->second;
+        }
 
-        auto dev_exist = false;
+        auto sensor = frame.frame->get_sensor().get(); //TODO: Potential deadlock if get_sensor() gets a hold of the last reference of that sensor
 
+        const device_interface* dev = nullptr;
         if (sensor)
         {
-
-            const device_interface* dev = nullptr;
             try
             {
                 dev = sensor->get_device().shared_from_this().get();
@@ -170,101 +278,105 @@ namespace librealsense
             {
                 LOG_WARNING("Device destroyed");
             }
-            if (dev)
-            {
-                dev_exist = true;
-                matcher = _matchers[stream_id];
-                if (!matcher)
-                {
-                    matcher = dev->create_matcher(frame);
-
-
-                    matcher->set_callback([&](frame_holder f, syncronization_environment env)
-                    {
-                        sync(std::move(f), env);
-                    });
-
-                    for (auto stream : matcher->get_streams())
-                    {
-                        if (_matchers[stream])
-                        {
-                            _frames_queue.erase(_matchers[stream].get());
-                        }
-                        _matchers[stream] = matcher;
-                        _streams_id.push_back(stream);
+        }
 
-                    }
-                    for (auto stream : matcher->get_streams_types())
-                    {
-                        _streams_type.push_back(stream);
-                    }
+        if (dev)
+        {
+            auto matcher = dev->create_matcher(frame);
+            auto slot = add_slot(matcher);
 
-                    if (std::find(_streams_type.begin(), _streams_type.end(), stream_type) == _streams_type.end())
-                    {
-                        LOG_ERROR("Stream matcher not found! stream=" << rs2_stream_to_string(stream_type));
-                    }
+            for (auto stream : matcher->get_streams())
+            {
+                auto existing = std::find_if(_stream_slots.begin(), _stream_slots.end(),
+                    [stream](const std::pair<librealsense::stream_id, size_t>& s) { return s.first == stream; });
+                if (existing != _stream_slots.end())
+                {
+                    drop_frames(existing->second, sync_drop_reason::matcher_replaced, true);
+                    existing->second = slot;
                 }
-
-                else if(!matcher->get_active())
+                else
                 {
-
-                     matcher->set_active(true);
-                     _frames_queue[matcher.get()].start();
+                    _stream_slots.push_back({ stream, slot });
                 }
+                _streams_id.push_back(stream);
             }
-        }
-
-        if(!dev_exist)
-        {
-            matcher = _matchers[stream_id];
-            // We don't know what device this frame came from, so just store it under device NULL with ID matcher
-            if (!matcher)
+            for (auto stream : matcher->get_streams_types())
             {
-                if (_matchers[stream_id])
-                {
-                    _frames_queue.erase(_matchers[stream_id].get());
-                }
-                 _matchers[stream_id] = std::make_shared<identity_matcher>(stream_id, stream_type);
-                _streams_id.push_back(stream_id);
-                _streams_type.push_back(stream_type);
-                matcher = _matchers[stream_id];
+                _streams_type.push_back(stream);
+            }
 
-                matcher->set_callback([&](frame_holder f, syncronization_environment env)
-                {
-                    sync(std::move(f), env);
-                });
+            if (std::find(_streams_type.begin(), _streams_type.end(), stream_type) == _streams_type.end())
+            {
+                LOG_ERROR("Stream matcher not found! stream=" << rs2_stream_to_string(stream_type));
             }
+
+            // A device matcher that does not cover the stream of the frame still handles it
+            if (std::find(matcher->get_streams().begin(), matcher->get_streams().end(), stream_id) == matcher->get_streams().end())
+                _stream_slots.push_back({ stream_id, slot });
+            return slot;
         }
-        return matcher;
-    }
 
+        // We don't know what device this frame came from, so just store it under device NULL with ID matcher
+        auto slot = add_slot(std::make_shared<identity_matcher>(stream_id, stream_type));
+        _stream_slots.push_back({ stream_id, slot });
+        _streams_id.push_back(stream_id);
+        _streams_type.push_back(stream_type);
+        return slot;
+    }
 
-    std::string composite_matcher::frames_to_string(std::vector<librealsense::matcher*> matchers)
+    std::string composite_matcher::frames_to_string(const std::vector<size_t>& slots)
     {
         std::string str;
-        for (auto m : matchers)
+        for (auto slot : slots)
         {
-            frame_holder* f;
-            if(_frames_queue[m].peek(&f))
-                str += frame_to_string(*f);
+            if (!_slots[slot].frames.empty())
+                str += frame_to_string(_slots[slot].frames.front().frame);
         }
         return str;
     }
 
+    // Frames of different timestamp domains are only comparable by their time of arrival
+    std::pair<double, double> extract_values(sync_ring::entry& a, sync_ring::entry& b)
+    {
+        if (a.key.domain == b.key.domain)
+            return{ a.key.value, b.key.value };
+        else
+        {
+            return{ (double)a.frame->get_frame_metadata(RS2_FRAME_METADATA_TIME_OF_ARRIVAL),
+                    (double)b.frame->get_frame_metadata(RS2_FRAME_METADATA_TIME_OF_ARRIVAL) };
+        }
+    }
+
+    bool composite_matcher::are_equivalent(sync_ring::entry& a, sync_ring::entry& b) const
+    {
+        auto values = extract_values(a, b);
+        return std::abs(values.first - values.second) < std::max(a.key.tolerance, b.key.tolerance);
+    }
+
+    bool composite_matcher::is_smaller_than(sync_ring::entry& a, sync_ring::entry& b) const
+    {
+        auto values = extract_values(a, b);
+        return values.first < values.second;
+    }
+
     void composite_matcher::sync(frame_holder f, syncronization_environment env)
     {
         std::stringstream s;
         s <<"SYNC "<<_name<<"--> "<< frame_to_string(f)<<"\n";
         LOG_DEBUG(s.str());
 
-        update_next_expected(f);
-        auto matcher = find_matcher(f);
-        _frames_queue[matcher.get()].enqueue(std::move(f));
+        auto slot = find_slot(f);
+        update_next_expected(f, slot);
+
+        auto key = make_key(f);
+        auto blocking = f.is_blocking();
+        _slots[slot].tracked = true;
+        if (_slots[slot].frames.push({ std::move(f), key, std::chrono::steady_clock::now() }, blocking))
+            _telemetry.record_drop(sync_drop_reason::queue_overflow, 1);
 
-        std::vector<frame_holder*> frames_arrived;
-        std::vector<librealsense::matcher*> frames_arrived_matchers;
-        std::vector<librealsense::matcher*> synced_frames;
-        std::vector<librealsense::matcher*> missing_streams;
+        std::vector<size_t> frames_arrived;
+        std::vector<size_t> synced_frames;
+        std::vector<size_t> missing_streams;
 
         do
         {
@@ -273,45 +385,37 @@ namespace librealsense
 
             synced_frames.clear();
             missing_streams.clear();
-            frames_arrived_matchers.clear();
             frames_arrived.clear();
 
-
-            for (auto s = _frames_queue.begin(); s != _frames_queue.end(); s++)
+            for (size_t i = 0; i < _slots.size(); i++)
             {
-                frame_holder* f;
-                if (s->second.peek(&f))
-                {
-                    frames_arrived.push_back(f);
-                    frames_arrived_matchers.push_back(s->first);
-                }
+                if (!_slots[i].tracked)
+                    continue;
+                if (!_slots[i].frames.empty())
+                    frames_arrived.push_back(i);
                 else
-                {
-                    missing_streams.push_back(s->first);
-                }
+                    missing_streams.push_back(i);
             }
 
             if (frames_arrived.size() == 0)
                 break;
 
-            frame_holder* curr_sync;
-            if (frames_arrived.size() > 0)
-            {
-                curr_sync = frames_arrived[0];
-                synced_frames.push_back(frames_arrived_matchers[0]);
-            }
+            auto curr_sync = frames_arrived[0];
+            synced_frames.push_back(curr_sync);
 
-            for (auto i = 1; i < frames_arrived.size(); i++)
+            for (size_t i = 1; i < frames_arrived.size(); i++)
             {
-                if (are_equivalent(*curr_sync, *frames_arrived[i]))
+                auto& candidate = _slots[frames_arrived[i]].frames.front();
+                auto& current = _slots[curr_sync].frames.front();
+                if (are_equivalent(current, candidate))
                 {
-                    synced_frames.push_back(frames_arrived_matchers[i]);
+                    synced_frames.push_back(frames_arrived[i]);
                 }
-                else if (is_smaller_than(*frames_arrived[i], *curr_sync))
+                else if (is_smaller_than(candidate, current))
                 {
                     old_frames = true;
                     synced_frames.clear();
-                    synced_frames.push_back(frames_arrived_matchers[i]);
+                    synced_frames.push_back(frames_arrived[i]);
                     curr_sync = frames_arrived[i];
                 }
                 else
@@ -322,14 +426,15 @@ namespace librealsense
 
             if (!old_frames)
             {
+                auto& synced_key = _slots[synced_frames[0]].frames.front().key;
                 for (auto i : missing_streams)
                 {
-                    if (!skip_missing_stream(synced_frames, i))
+                    if (!skip_missing_stream(synced_key, i))
                     {
                         s <<  _name<<" "<<frames_to_string(synced_frames )<<" Wait for missing stream: ";
 
-                        for (auto&& stream : i->get_streams())
-                            s << stream<<" next expected "<<std::fixed<< _next_expected[i];
+                        for (auto&& stream : _slots[i].child->get_streams())
+                            s << stream<<" next expected "<<std::fixed<< _slots[i].next_expected;
                         synced_frames.clear();
                         LOG_DEBUG(s.str());
                         break;
@@ -338,8 +443,8 @@ namespace librealsense
                     {
                         std::stringstream s;
                         s << _name << " " << frames_to_string(synced_frames) << " Skipped missing stream: ";
-                        for (auto&& stream : i->get_streams())
-                            s << stream << " next expected " << std::fixed << _next_expected[i]<<" ";
+                        for (auto&& stream : _slots[i].child->get_streams())
+                            s << stream << " next expected " << std::fixed << _slots[i].next_expected<<" ";
                         LOG_DEBUG(s.str());
                     }
 
@@ -354,16 +459,20 @@ namespace librealsense
                 std::vector<frame_holder> match;
                 match.reserve(synced_frames.size());
 
+                auto oldest = std::chrono::steady_clock::time_point::max();
+                auto min_timestamp = std::numeric_limits<double>::max();
+                auto max_timestamp = std::numeric_limits<double>::lowest();
                 for (auto index : synced_frames)
                 {
-                    frame_holder frame;
-                    int timeout_ms = 5000;
-                    _frames_queue[index].dequeue(&frame, timeout_ms);
+                    auto entry = _slots[index].frames.pop();
                     if (old_frames)
                     {
-                        s  << "--> " << frame_to_string(frame) << "\n";
+                        s  << "--> " << frame_to_string(entry.frame) << "\n";
                     }
-                    match.push_back(std::move(frame));
+                    oldest = std::min(oldest, entry.queued);
+                    min_timestamp = std::min(min_timestamp, entry.key.timestamp);
+                    max_timestamp = std::max(max_timestamp, entry.key.timestamp);
+                    match.push_back(std::move(entry.frame));
                 }
 
                 if (old_frames)
@@ -376,15 +485,24 @@ namespace librealsense
                     return ((frame_interface*)f1)->get_stream()->get_unique_id() > ((frame_interface*)f2)->get_stream()->get_unique_id();
                 });
 
-
+                auto frames = match.size();
                 frame_holder composite = env.source->allocate_composite_frame(std::move(match));
                 if (composite.frame)
                 {
                     s <<"SYNCED "<<_name<<"--> "<< frame_to_string(composite)<<"\n";
 
+                    using namespace std::chrono;
+                    _telemetry.record_match(duration_cast<microseconds>(steady_clock::now() - oldest),
+                                            duration_cast<microseconds>(duration<double, std::milli>(max_timestamp - min_timestamp)),
+                                            frames);
+
                     auto cb = begin_callback();
                     _callback(std::move(composite), env);
                 }
+                else
+                {
+                    _telemetry.record_drop(sync_drop_reason::allocation_failed, frames);
+                }
             }
         } while (synced_frames.size() > 0);
     }
@@ -394,117 +512,81 @@ namespace librealsense
     {
     }
 
-    void frame_number_composite_matcher::update_last_arrived(frame_holder& f, matcher* m)
+    void frame_number_composite_matcher::update_last_arrived(frame_holder& f, size_t slot)
     {
-        _last_arrived[m] =f->get_frame_number();
+        _slots[slot].last_arrived = static_cast<double>(f->get_frame_number());
     }
 
-    bool frame_number_composite_matcher::are_equivalent(frame_holder& a, frame_holder& b)
-    {
-        return a->get_frame_number() == b->get_frame_number();
-    }
-    bool frame_number_composite_matcher::is_smaller_than(frame_holder & a, frame_holder & b)
+    sync_key frame_number_composite_matcher::make_key(const frame_holder& f)
     {
-        return a->get_frame_number() < b->get_frame_number();
+        // Frame numbers are integers, so only equal numbers are within the tolerance
+        return{ static_cast<double>(f.frame->get_frame_number()), f.frame->get_frame_timestamp(), 0.5,
+                RS2_TIMESTAMP_DOMAIN_COUNT, 0 };
     }
+
     void frame_number_composite_matcher::clean_inactive_streams(frame_holder& f)
     {
-        std::vector<stream_id> inactive_matchers;
-        for(auto m: _matchers)
+        for (size_t i = 0; i < _slots.size(); i++)
         {
-            if (_last_arrived[m.second.get()] && (fabs((long long)f->get_frame_number() - (long long)_last_arrived[m.second.get()])) > 5)
+            auto& slot = _slots[i];
+            if (slot.last_arrived && (fabs((long long)f->get_frame_number() - (long long)slot.last_arrived)) > 5)
             {
                 std::stringstream s;
                 s << "clean inactive stream in "<<_name;
-                for (auto stream : m.second->get_streams_types())
+                for (auto stream : slot.child->get_streams_types())
                 {
                     s << stream << " ";
                 }
                 LOG_DEBUG(s.str());
 
-                inactive_matchers.push_back(m.first);
-                m.second->set_active(false);
+                slot.child->set_active(false);
+                drop_frames(i, sync_drop_reason::inactive_stream, false);
             }
         }
-
-        for(auto id: inactive_matchers)
-        {
-            _frames_queue[_matchers[id].get()].clear();
-        }
     }
 
-    bool frame_number_composite_matcher::skip_missing_stream(std::vector<matcher*> synced, matcher* missing)
+    bool frame_number_composite_matcher::skip_missing_stream(const sync_key& synced, size_t missing)
     {
-        frame_holder* synced_frame;
-
-         if(!missing->get_active())
-             return true;
-
-        _frames_queue[synced[0]].peek(&synced_frame);
+        if (!_slots[missing].child->get_active())
+            return true;
 
-        auto next_expected = _next_expected[missing];
+        auto next_expected = _slots[missing].next_expected;
 
-        if((*synced_frame)->get_frame_number() - next_expected > 4 || (*synced_frame)->get_frame_number() < next_expected)
+        if (synced.value - next_expected > 4 || synced.value < next_expected)
         {
             return true;
         }
         return false;
     }
 
-    void frame_number_composite_matcher::update_next_expected(const frame_holder& f)
+    void frame_number_composite_matcher::update_next_expected(const frame_holder& f, size_t slot)
     {
-        auto matcher = find_matcher(f);
-        _next_expected[matcher.get()] = f.frame->get_frame_number()+1.;
-    }
-
-    std::pair<double, double> extract_timestamps(frame_holder & a, frame_holder & b)
-    {
-        if (a->get_frame_timestamp_domain() == b->get_frame_timestamp_domain())
-            return{ a->get_frame_timestamp(), b->get_frame_timestamp() };
-        else
-        {
-            return{ (double)a->get_frame_metadata(RS2_FRAME_METADATA_TIME_OF_ARRIVAL),
-                    (double)b->get_frame_metadata(RS2_FRAME_METADATA_TIME_OF_ARRIVAL) };
-        }
+        _slots[slot].next_expected = f.frame->get_frame_number()+1.;
     }
 
     timestamp_composite_matcher::timestamp_composite_matcher(std::vector<std::shared_ptr<matcher>> matchers)
         :composite_matcher(matchers, "TS: ")
     {
     }
-    bool timestamp_composite_matcher::are_equivalent(frame_holder & a, frame_holder & b)
-    {
-        auto a_fps = get_fps(a);
-        auto b_fps = get_fps(b);
-
-        auto min_fps = std::min(a_fps, b_fps);
-
-        auto ts = extract_timestamps(a, b);
-
-        return  are_equivalent(ts.first, ts.second, min_fps);
-    }
 
-    bool timestamp_composite_matcher::is_smaller_than(frame_holder & a, frame_holder & b)
+    sync_key timestamp_composite_matcher::make_key(const frame_holder& f)
     {
-        if (!a || !b)
-        {
-            return false;
-        }
-
-        auto ts = extract_timestamps(a, b);
-
-        return ts.first < ts.second;
+        // Matching frames are less than half the frame time of the slower stream apart
+        auto fps = get_fps(f);
+        auto gap = 1000.f / (float)fps;
+        auto timestamp = f.frame->get_frame_timestamp();
+        return{ timestamp, timestamp, (float)gap / (float)2, f.frame->get_frame_timestamp_domain(), fps };
     }
 
-    void timestamp_composite_matcher::update_last_arrived(frame_holder& f, matcher* m)
+    void timestamp_composite_matcher::update_last_arrived(frame_holder& f, size_t slot)
     {
         if(f->supports_frame_metadata(RS2_FRAME_METADATA_ACTUAL_FPS))
-            _fps[m] = (uint32_t)f->get_frame_metadata(RS2_FRAME_METADATA_ACTUAL_FPS);
+            _slots[slot].fps = (uint32_t)f->get_frame_metadata(RS2_FRAME_METADATA_ACTUAL_FPS);
 
         else
-            _fps[m] = f->get_stream()->get_framerate();
+            _slots[slot].fps = f->get_stream()->get_framerate();
 
-        _last_arrived[m] = environment::get_instance().get_time_service()->get_time();
+        _slots[slot].last_arrived = environment::get_instance().get_time_service()->get_time();
     }
 
     unsigned int timestamp_composite_matcher::get_fps(const frame_holder & f)
@@ -518,16 +600,15 @@ namespace librealsense
         return fps?fps:f.frame->get_stream()->get_framerate();
     }
 
-    void timestamp_composite_matcher::update_next_expected(const frame_holder & f)
+    void timestamp_composite_matcher::update_next_expected(const frame_holder & f, size_t slot)
     {
         auto fps = get_fps(f);
         auto gap = 1000.f / (float)fps;
 
-        auto matcher = find_matcher(f);
-
-        _next_expected[matcher.get()] = f.frame->get_frame_timestamp() + gap;
-        _next_expected_domain[matcher.get()] = f.frame->get_frame_timestamp_domain();
-        LOG_DEBUG(_name << frame_to_string(const_cast<frame_holder&>(f))<<"fps " <<fps<<" gap " <<gap<<" next_expected: "<< _next_expected[matcher.get()]);
+        _slots[slot].next_expected = f.frame->get_frame_timestamp() + gap;
+        _slots[slot].next_expected_domain = f.frame->get_frame_timestamp_domain();
+        _slots[slot].has_next_expected_domain = true;
+        LOG_DEBUG(_name << frame_to_string(const_cast<frame_holder&>(f))<<"fps " <<fps<<" gap " <<gap<<" next_expected: "<< _slots[slot].next_expected);
 
     }
 
@@ -535,62 +616,51 @@ namespace librealsense
     {
         if (f.is_blocking())
             return;
-        std::vector<stream_id> dead_matchers;
         auto now = environment::get_instance().get_time_service()->get_time();
-        for(auto m: _matchers)
+        for (size_t i = 0; i < _slots.size(); i++)
         {
-            auto threshold = _fps[m.second.get()] ? (1000 / _fps[m.second.get()]) * 5 : 500; //if frame of a specific stream didn't arrive for time equivalence to 5 frames duration
-                                                                                             //this stream will be marked as "not active" in order to not stack the other streams
-            if(_last_arrived[m.second.get()] && (now - _last_arrived[m.second.get()]) > threshold)
+            auto& slot = _slots[i];
+            auto threshold = slot.fps ? (1000 / slot.fps) * 5 : 500; //if frame of a specific stream didn't arrive for time equivalence to 5 frames duration
+                                                                     //this stream will be marked as "not active" in order to not stack the other streams
+            if(slot.last_arrived && (now - slot.last_arrived) > threshold)
             {
                 std::stringstream s;
                 s << "clean inactive stream in "<<_name;
-                for (auto stream : m.second->get_streams_types())
+                for (auto stream : slot.child->get_streams_types())
                 {
                     s << stream << " ";
                 }
                 LOG_DEBUG(s.str());
 
-                dead_matchers.push_back(m.first);
-                m.second->set_active(false);
+                slot.child->set_active(false);
+                drop_frames(i, sync_drop_reason::inactive_stream, true);
             }
         }
-
-        for(auto id: dead_matchers)
-        {
-            _frames_queue[_matchers[id].get()].clear();
-            _frames_queue.erase(_matchers[id].get());
-        }
     }
 
-    bool timestamp_composite_matcher::skip_missing_stream(std::vector<matcher*> synced, matcher* missing)
+    bool timestamp_composite_matcher::skip_missing_stream(const sync_key& synced, size_t missing)
     {
-        if(!missing->get_active())
+        if(!_slots[missing].child->get_active())
             return true;
 
-        frame_holder* synced_frame;
-
-        _frames_queue[synced[0]].peek(&synced_frame);
+        auto next_expected = _slots[missing].next_expected;
 
-        auto next_expected = _next_expected[missing];
-
-        auto it = _next_expected_domain.find(missing);
-        if (it != _next_expected_domain.end())
+        if (_slots[missing].has_next_expected_domain)
         {
-            if (it->second != (*synced_frame)->get_frame_timestamp_domain())
+            if (_slots[missing].next_expected_domain != synced.domain)
             {
                 return false;
             }
         }
-        auto gap = 1000.f/ (float)get_fps(*synced_frame);
+        auto gap = 1000.f/ (float)synced.fps;
         //next expected of the missing stream didn't updated yet
-        if((*synced_frame)->get_frame_timestamp() > next_expected && abs((*synced_frame)->get_frame_timestamp()- next_expected)<gap*10)
+        if(synced.timestamp > next_expected && abs(synced.timestamp- next_expected)<gap*10)
         {
             LOG_DEBUG("next expected of the missing stream didn't updated yet");
             return false;
         }
 
-        return !are_equivalent((*synced_frame)->get_frame_timestamp(), next_expected, get_fps(*synced_frame));
+        return !are_equivalent(synced.timestamp, next_expected, synced.fps);
     }
 
     bool timestamp_composite_matcher::are_equivalent(double a, double b, int fps)
@@ -598,4 +668,204 @@ namespace librealsense
         auto gap = 1000.f / (float)fps;
         return abs(a - b) < ((float)gap / (float)2) ;
     }
+
+    global_time_matcher::global_time_matcher()
+        : _config{ 0, 100, false },
+        _first_timestamp(std::numeric_limits<double>::lowest()),
+        _newest_timestamp(std::numeric_limits<double>::lowest())
+    {
+        _name = "GT: ";
+    }
+
+    void global_time_matcher::set_config(const global_time_sync_config& config)
+    {
+        _config = config;
+    }
+
+    size_t global_time_matcher::find_slot(const frame_holder& f)
+    {
+        auto stream = f.frame->get_stream();
+        auto id = stream->get_unique_id();
+        for (size_t i = 0; i < _slots.size(); i++)
+        {
+            if (_slots[i].stream == id)
+                return i;
+        }
+
+        stream_slot slot;
+        slot.stream = id;
+        slot.tracked = false;
+        auto fps = stream->get_framerate();
+        slot.frame_interval = fps ? 1000. / fps : 0.;
+        _slots.push_back(std::move(slot));
+        return _slots.size() - 1;
+    }
+
+    double global_time_matcher::get_tolerance() const
+    {
+        if (_config.tolerance > 0)
+            return _config.tolerance;
+
+        auto interval = std::numeric_limits<double>::max();
+        for (auto&& slot : _slots)
+        {
+            if (slot.tracked && slot.frame_interval > 0)
+                interval = std::min(interval, slot.frame_interval);
+        }
+        return interval == std::numeric_limits<double>::max() ? 0. : interval / 2;
+    }
+
+    void global_time_matcher::pass_alone(frame_holder f, syncronization_environment env)
+    {
+        std::vector<frame_holder> match;
+        match.push_back(std::move(f));
+        frame_holder composite = env.source->allocate_composite_frame(std::move(match));
+        if (composite.frame)
+        {
+            auto cb = begin_callback();
+            _callback(std::move(composite), env);
+        }
+        else
+        {
+            _telemetry.record_drop(sync_drop_reason::allocation_failed, 1);
+        }
+    }
+
+    void global_time_matcher::dispatch(frame_holder f, syncronization_environment env)
+    {
+        auto domain = f->get_frame_timestamp_domain();
+        if (domain != RS2_TIMESTAMP_DOMAIN_GLOBAL_TIME && domain != RS2_TIMESTAMP_DOMAIN_SYSTEM_TIME)
+        {
+            // Device clocks are not comparable across devices
+            auto id = f->get_stream()->get_unique_id();
+            if (std::find(_foreign_domain_streams.begin(), _foreign_domain_streams.end(), id) == _foreign_domain_streams.end())
+            {
+                _foreign_domain_streams.push_back(id);
+                LOG_WARNING(_name << "frames of stream " << id << " are in the " << domain
+                    << " timestamp domain and are passed on unmatched");
+            }
+            pass_alone(std::move(f), env);
+            return;
+        }
+
+        auto slot = find_slot(f);
+        auto timestamp = f->get_frame_timestamp();
+        if (_newest_timestamp - timestamp > _config.max_latency)
+        {
+            // The clock went back (looped playback, restarted device, clock step): the frames queued so far
+            // are not waited on further, and the streams are gathered again from this frame on
+            LOG_DEBUG(_name << "timestamps went back from " << std::fixed << _newest_timestamp << " to " << timestamp);
+            match(env, true);
+            _first_timestamp = _newest_timestamp = std::numeric_limits<double>::lowest();
+        }
+        if (_first_timestamp == std::numeric_limits<double>::lowest())
+            _first_timestamp = timestamp;
+        sync_key key{ timestamp, timestamp, 0, domain, 0 };
+        auto blocking = f.is_blocking();
+        _slots[slot].tracked = true;
+        if (_slots[slot].frames.push({ std::move(f), key, std::chrono::steady_clock::now() }, blocking))
+            _telemetry.record_drop(sync_drop_reason::queue_overflow, 1);
+        _newest_timestamp = std::max(_newest_timestamp, timestamp);
+
+        match(env);
+    }
+
+    void global_time_matcher::match(syncronization_environment env, bool flush)
+    {
+        // Streams are only known once they deliver a frame, no match is made before all had the time to
+        if (!flush && _newest_timestamp - _first_timestamp <= _config.max_latency)
+            return;
+
+        std::vector<size_t> synced;
+        std::vector<size_t> missing;
+        while (true)
+        {
+            // Matches are built around the oldest queued frame
+            auto oldest_timestamp = std::numeric_limits<double>::max();
+            for (auto&& slot : _slots)
+            {
+                if (!slot.frames.empty())
+                    oldest_timestamp = std::min(oldest_timestamp, slot.frames.front().key.timestamp);
+            }
+            if (oldest_timestamp == std::numeric_limits<double>::max())
+                return;
+
+            auto tolerance = get_tolerance();
+            synced.clear();
+            missing.clear();
+            auto complete = true;
+            for (size_t i = 0; i < _slots.size(); i++)
+            {
+                if (!_slots[i].tracked)
+                    continue;
+
+                if (_slots[i].frames.empty())
+                {
+                    missing.push_back(i);
+                    complete = false;
+                }
+                else if (_slots[i].frames.front().key.timestamp - oldest_timestamp <= tolerance)
+                {
+                    synced.push_back(i);
+                }
+                else
+                {
+                    // The stream is past the match, its frame for it was lost
+                    complete = false;
+                }
+            }
+
+            if (!missing.empty() && !flush)
+            {
+                if (_newest_timestamp - oldest_timestamp <= _config.max_latency)
+                    return;
+
+                for (auto i : missing)
+                {
+                    LOG_DEBUG(_name << "stream " << _slots[i].stream << " missed the latency bound at " << std::fixed << oldest_timestamp);
+                    _slots[i].tracked = false;
+                }
+            }
+
+            std::vector<frame_holder> match;
+            match.reserve(synced.size());
+            auto oldest = std::chrono::steady_clock::time_point::max();
+            auto max_timestamp = oldest_timestamp;
+            for (auto i : synced)
+            {
+                auto entry = _slots[i].frames.pop();
+                oldest = std::min(oldest, entry.queued);
+                max_timestamp = std::max(max_timestamp, entry.key.timestamp);
+                match.push_back(std::move(entry.frame));
+            }
+
+            auto frames = match.size();
+            if (!complete && _config.drop_incomplete)
+            {
+                _telemetry.record_drop(sync_drop_reason::incomplete_match, frames);
+                continue;
+            }
+
+            std::sort(match.begin(), match.end(), [](const frame_holder& f1, const frame_holder& f2)
+            {
+                return ((frame_interface*)f1)->get_stream()->get_unique_id() > ((frame_interface*)f2)->get_stream()->get_unique_id();
+            });
+
+            frame_holder composite = env.source->allocate_composite_frame(std::move(match));
+            if (composite.frame)
+            {
+                using namespace std::chrono;
+                _telemetry.record_match(duration_cast<microseconds>(steady_clock::now() - oldest),
+                                        duration_cast<microseconds>(duration<double, std::milli>(max_timestamp - oldest_timestamp)),
+                                        frames);
+
+                auto cb = begin_callback();
+                _callback(std::move(composite), env);
+            }
+            else
+            {
+                _telemetry.record_drop(sync_drop_reason::allocation_failed, frames);
+            }
+        }
+    }
 }
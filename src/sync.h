@@ -5,8 +5,12 @@
 
 #include "types.h"
 #include "archive.h"
+#include "latency-histogram.h"
 
 #include <stdint.h>
+#include <array>
+#include <atomic>
+#include <chrono>
 #include <vector>
 #include <mutex>
 #include <memory>
@@ -109,63 +113,193 @@ namespace librealsense
 
     };
 
+    // What a composite matcher compares frames by, extracted once when the frame is queued
+    struct sync_key
+    {
+        double value;                   // Frame number or timestamp
+        double timestamp;
+        double tolerance;               // Values closer than that are equivalent
+        rs2_timestamp_domain domain;    // Values of different domains are compared by time of arrival instead
+        unsigned int fps;
+    };
+
+    // Frames of one stream slot waiting for a match, oldest first.
+    // Composite matchers are only driven under their owner's lock, so the ring has no synchronization of its own
+    class sync_ring
+    {
+    public:
+        struct entry
+        {
+            frame_holder frame;
+            sync_key key;
+            std::chrono::steady_clock::time_point queued;
+        };
+
+        explicit sync_ring(size_t capacity = QUEUE_MAX_SIZE);
+
+        bool empty() const { return !_size; }
+        size_t size() const { return _size; }
+        entry& front() { return _entries[_head]; }
+
+        // A full ring drops its oldest frame, unless grow is set. Returns whether a frame was dropped
+        bool push(entry&& e, bool grow);
+        entry pop();
+        size_t clear();
+
+    private:
+        std::vector<entry> _entries;
+        size_t _head;
+        size_t _size;
+    };
+
+    enum class sync_drop_reason
+    {
+        queue_overflow,     // A stream queued more frames than its ring holds while waiting for others
+        inactive_stream,    // Queued frames of a stream declared inactive
+        matcher_replaced,   // Queued frames of a stream taken over by the matcher of its device
+        allocation_failed,  // Frames of a match whose composite frame could not be allocated
+        incomplete_match,   // Frames of a match missing some of its streams, released by the drop policy
+        count
+    };
+
+    // Quality of the matching, cumulative since the matcher was created. May be read while the matcher runs
+    class sync_telemetry
+    {
+    public:
+        sync_telemetry();
+
+        void record_match(std::chrono::microseconds latency, std::chrono::microseconds skew, size_t frames);
+        void record_drop(sync_drop_reason reason, size_t frames);
+
+        uint64_t get_matches() const { return _matches; }
+        uint64_t get_matched_frames() const { return _matched_frames; }
+        uint64_t get_drops(sync_drop_reason reason) const { return _drops[static_cast<size_t>(reason)]; }
+
+        // From the arrival of the oldest frame of a match to the match being dispatched
+        const latency_histogram& get_match_latency() const { return _latency; }
+        // Spread of the timestamps of the frames of each match
+        const latency_histogram& get_skew() const { return _skew; }
+
+    private:
+        latency_histogram _latency;
+        latency_histogram _skew;
+        std::atomic<uint64_t> _matches;
+        std::atomic<uint64_t> _matched_frames;
+        std::array<std::atomic<uint64_t>, static_cast<size_t>(sync_drop_reason::count)> _drops;
+    };
+
+    // Matches the frames of its child matchers. Every child owns a slot holding its queued frames and
+    // the state the policy of the derived class keeps about it; slots are only appended, so their index is stable
     class composite_matcher : public matcher
     {
     public:
         composite_matcher(std::vector<std::shared_ptr<matcher>> matchers, std::string name);
 
-
-        virtual bool are_equivalent(frame_holder& a, frame_holder& b) = 0;
-        virtual bool is_smaller_than(frame_holder& a, frame_holder& b) = 0;
-        virtual bool skip_missing_stream(std::vector<matcher*> synced, matcher* missing)  = 0;
+        virtual sync_key make_key(const frame_holder& f) = 0;
+        virtual bool skip_missing_stream(const sync_key& synced, size_t missing) = 0;
         virtual void clean_inactive_streams(frame_holder& f) = 0;
-        virtual void update_last_arrived(frame_holder& f, matcher* m) = 0;
+        virtual void update_last_arrived(frame_holder& f, size_t slot) = 0;
 
         void dispatch(frame_holder f, syncronization_environment env) override;
-        std::string frames_to_string(std::vector<librealsense::matcher*> matchers);
+        std::string frames_to_string(const std::vector<size_t>& slots);
         void sync(frame_holder f, syncronization_environment env) override;
         std::shared_ptr<matcher> find_matcher(const frame_holder& f);
 
-    protected:
-        virtual void update_next_expected(const frame_holder& f) = 0;
+        const sync_telemetry& get_telemetry() const { return _telemetry; }
 
-        std::map<matcher*, single_consumer_frame_queue<frame_holder>> _frames_queue;
-        std::map<stream_id, std::shared_ptr<matcher>> _matchers;
-        std::map<matcher*, double> _next_expected;
-        std::map<matcher*, rs2_timestamp_domain> _next_expected_domain;
+    protected:
+        struct stream_slot
+        {
+            std::shared_ptr<matcher> child;
+            sync_ring frames;
+            bool tracked;           // Takes part in the matching, missing when it has no frames queued
+            double next_expected;
+            bool has_next_expected_domain;
+            rs2_timestamp_domain next_expected_domain;
+            double last_arrived;
+            unsigned int fps;
+        };
+
+        virtual void update_next_expected(const frame_holder& f, size_t slot) = 0;
+
+        size_t find_slot(const frame_holder& f);
+        size_t add_slot(std::shared_ptr<matcher> m);
+        void drop_frames(size_t slot, sync_drop_reason reason, bool untrack);
+        bool are_equivalent(sync_ring::entry& a, sync_ring::entry& b) const;
+        bool is_smaller_than(sync_ring::entry& a, sync_ring::entry& b) const;
+
+        std::vector<stream_slot> _slots;
+        std::vector<std::pair<stream_id, size_t>> _stream_slots;
+        sync_telemetry _telemetry;
     };
 
     class frame_number_composite_matcher : public composite_matcher
     {
     public:
         frame_number_composite_matcher(std::vector<std::shared_ptr<matcher>> matchers);
-        virtual void update_last_arrived(frame_holder& f, matcher* m) override;
-        bool are_equivalent(frame_holder& a, frame_holder& b) override;
-        bool is_smaller_than(frame_holder& a, frame_holder& b) override;
-        bool skip_missing_stream(std::vector<matcher*> synced, matcher* missing) override;
+        virtual void update_last_arrived(frame_holder& f, size_t slot) override;
+        sync_key make_key(const frame_holder& f) override;
+        bool skip_missing_stream(const sync_key& synced, size_t missing) override;
         void clean_inactive_streams(frame_holder& f) override;
-        void update_next_expected(const frame_holder& f) override;
-
-    private:
-         std::map<matcher*,unsigned long long> _last_arrived;
+        void update_next_expected(const frame_holder& f, size_t slot) override;
     };
 
     class timestamp_composite_matcher : public composite_matcher
     {
     public:
         timestamp_composite_matcher(std::vector<std::shared_ptr<matcher>> matchers);
-        bool are_equivalent(frame_holder& a, frame_holder& b) override;
-        bool is_smaller_than(frame_holder& a, frame_holder& b) override;
-        virtual void update_last_arrived(frame_holder& f, matcher* m) override;
+        sync_key make_key(const frame_holder& f) override;
+        virtual void update_last_arrived(frame_holder& f, size_t slot) override;
         void clean_inactive_streams(frame_holder& f) override;
-        bool skip_missing_stream(std::vector<matcher*> synced, matcher* missing) override;
-        void update_next_expected(const frame_holder & f) override;
+        bool skip_missing_stream(const sync_key& synced, size_t missing) override;
+        void update_next_expected(const frame_holder & f, size_t slot) override;
 
     private:
         unsigned int get_fps(const frame_holder & f);
         bool are_equivalent(double a, double b, int fps);
-        std::map<matcher*, double> _last_arrived;
-        std::map<matcher*, unsigned int> _fps;
+    };
 
+    struct global_time_sync_config
+    {
+        double tolerance;       // Milliseconds, 0 uses half the shortest frame interval of the matched streams
+        double max_latency;     // Milliseconds of timestamps a match waits for its missing streams
+        bool drop_incomplete;   // Release matches missing some of their streams instead of passing them on
+    };
+
+    // Matches the frames of any number of streams and devices by their host clock timestamps, i.e. global time
+    // or system time; frames of other timestamp domains are passed on alone. Matching starts once the timestamps
+    // are max_latency past the first frame, so that every stream had the time to be seen, and starts over when
+    // they go back by more than that. A match waits for every stream seen until the newest timestamp is
+    // max_latency past it; streams missing from it are not waited for again until they deliver a frame
+    class global_time_matcher : public matcher
+    {
+    public:
+        global_time_matcher();
+
+        void set_config(const global_time_sync_config& config);
+        void dispatch(frame_holder f, syncronization_environment env) override;
+
+        const sync_telemetry& get_telemetry() const { return _telemetry; }
+
+    private:
+        struct stream_slot
+        {
+            int stream;             // Unique id of the stream profile
+            sync_ring frames;
+            bool tracked;           // Waited for by the matches
+            double frame_interval;  // Milliseconds, 0 when the stream has no frame rate
+        };
+
+        size_t find_slot(const frame_holder& f);
+        double get_tolerance() const;
+        void match(syncronization_environment env, bool flush = false);
+        void pass_alone(frame_holder f, syncronization_environment env);
+
+        std::vector<stream_slot> _slots;
+        std::vector<int> _foreign_domain_streams;   // Already warned about
+        global_time_sync_config _config;
+        double _first_timestamp;    // Since the matcher started or the timestamps went back
+        double _newest_timestamp;
+        sync_telemetry _telemetry;
     };
 }
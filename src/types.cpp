@@ -183,6 +183,7 @@ namespace librealsense
             CASE(UPDATABLE)
             CASE(UPDATE_DEVICE)
             CASE(GLOBAL_TIMER)
+            CASE(DEPTH_POSTPROCESS_FILTER)
         default: assert(!is_valid(value)); return UNKNOWN_VALUE;
         }
 #undef CASE
@@ -202,6 +203,18 @@ namespace librealsense
 #undef CASE
     }
 
+    const char* get_string(rs2_recorder_overflow_policy value)
+    {
+#define CASE(X) STRCASE(RECORDER_OVERFLOW_POLICY, X)
+        switch (value)
+        {
+            CASE(DROP_FRAMES)
+            CASE(BLOCK)
+        default: assert(!is_valid(value)); return UNKNOWN_VALUE;
+        }
+#undef CASE
+    }
+
     const char* get_string(rs2_log_severity value)
     {
 #define CASE(X) STRCASE(LOG_SEVERITY, X)
@@ -283,6 +296,13 @@ namespace librealsense
             CASE(ENABLE_POSE_JUMPING)
             CASE(ENABLE_DYNAMIC_CALIBRATION)
             CASE(DEPTH_OFFSET)
+            CASE(FRAME_POOL_RETENTION)
+            CASE(PROCESSING_THREADS)
+            CASE(PROCESSING_QUEUE_SIZE)
+            CASE(PROCESSING_DROP_POLICY)
+            CASE(SYNC_TOLERANCE)
+            CASE(SYNC_MAX_LATENCY)
+            CASE(SYNC_DROP_INCOMPLETE)
         default: assert(!is_valid(value)); return UNKNOWN_VALUE;
         }
 #undef CASE
@@ -316,6 +336,7 @@ namespace librealsense
             CASE(Y10BPACK)
             CASE(DISTANCE)
             CASE(MJPEG)
+            CASE(MOTION_XYZ32F_BATCH)
         default: assert(!is_valid(value)); return UNKNOWN_VALUE;
         }
 #undef CASE
@@ -504,6 +504,7 @@ namespace librealsense
     RS2_ENUM_HELPERS(rs2_log_severity, LOG_SEVERITY)
     RS2_ENUM_HELPERS(rs2_notification_category, NOTIFICATION_CATEGORY)
     RS2_ENUM_HELPERS(rs2_playback_status, PLAYBACK_STATUS)
+    RS2_ENUM_HELPERS(rs2_recorder_overflow_policy, RECORDER_OVERFLOW_POLICY)
     RS2_ENUM_HELPERS(rs2_matchers, MATCHER)
     ////////////////////////////////////////////
     // World's tiniest linear algebra library //
@@ -1016,7 +1017,26 @@ namespace librealsense
     };
 
     typedef std::unique_ptr<rs2_log_callback, void(*)(rs2_log_callback*)> log_callback_ptr;
+    typedef void*(*frame_alloc_function_ptr)(int size, void * user);
+    typedef void(*frame_free_function_ptr)(void * buffer, int size, void * user);
+
+    class frame_allocator : public rs2_frame_allocator
+    {
+        frame_alloc_function_ptr alloc_fptr;
+        frame_free_function_ptr free_fptr;
+        void * user;
+    public:
+        frame_allocator(frame_alloc_function_ptr alloc, frame_free_function_ptr free, void * user)
+            : alloc_fptr(alloc), free_fptr(free), user(user) {}
+
+        void* allocate(int size) override { return alloc_fptr(size, user); }
+        void deallocate(void* buffer, int size) override { free_fptr(buffer, size, user); }
+
+        void release() override { delete this; }
+    };
+
     typedef std::shared_ptr<rs2_frame_callback> frame_callback_ptr;
+    typedef std::shared_ptr<rs2_frame_allocator> frame_allocator_ptr;
     typedef std::shared_ptr<rs2_frame_processor_callback> frame_processor_callback_ptr;
     typedef std::shared_ptr<rs2_notifications_callback> notifications_callback_ptr;
     typedef std::shared_ptr<rs2_devices_changed_callback> devices_changed_callback_ptr;
@@ -1391,19 +1411,22 @@ namespace librealsense
     {
         std::function<void()> continuation;
         const void* protected_data = nullptr;
+        size_t protected_size = 0;
 
         frame_continuation(const frame_continuation &) = delete;
         frame_continuation & operator=(const frame_continuation &) = delete;
     public:
         frame_continuation() : continuation([]() {}) {}
 
-        explicit frame_continuation(std::function<void()> continuation, const void* protected_data) : continuation(continuation), protected_data(protected_data) {}
+        explicit frame_continuation(std::function<void()> continuation, const void* protected_data, size_t protected_size = 0)
+            : continuation(continuation), protected_data(protected_data), protected_size(protected_size) {}
 
 
-        frame_continuation(frame_continuation && other) : continuation(std::move(other.continuation)), protected_data(other.protected_data)
+        frame_continuation(frame_continuation && other) : continuation(std::move(other.continuation)), protected_data(other.protected_data), protected_size(other.protected_size)
         {
             other.continuation = []() {};
             other.protected_data = nullptr;
+            other.protected_size = 0;
         }
 
         void operator()()
@@ -1411,23 +1434,28 @@ namespace librealsense
             continuation();
             continuation = []() {};
             protected_data = nullptr;
+            protected_size = 0;
         }
 
         void reset()
         {
             protected_data = nullptr;
+            protected_size = 0;
             continuation = [](){};
         }
 
         const void* get_data() const { return protected_data; }
+        size_t get_size() const { return protected_size; }
 
         frame_continuation & operator=(frame_continuation && other)
         {
             continuation();
             protected_data = other.protected_data;
+            protected_size = other.protected_size;
             continuation = other.continuation;
             other.continuation = []() {};
             other.protected_data = nullptr;
+            other.protected_size = 0;
             return *this;
         }
 
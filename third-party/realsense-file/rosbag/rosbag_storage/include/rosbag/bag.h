@@ -52,11 +52,15 @@
 
 //#include "ros/subscription_callback_helper.h"
 
+#include <condition_variable>
+#include <deque>
 #include <ios>
 #include <map>
+#include <mutex>
 #include <queue>
 #include <set>
 #include <stdexcept>
+#include <thread>
 
 #include <boost/format.hpp>
 //#include <boost/iterator/iterator_facade.hpp>
@@ -87,6 +91,16 @@ class ROSBAG_DECL Bag
     friend class View;
 
 public:
+    //! Progress of the chunks handed to the compression threads
+    struct CompressionStatistics
+    {
+        uint32_t pending_chunks;     //!< chunks queued or being compressed, not yet written to the file
+        uint64_t pending_bytes;      //!< uncompressed size of the pending chunks
+        uint64_t written_chunks;     //!< chunks written to the file
+        uint64_t uncompressed_bytes; //!< uncompressed size of the written chunks
+        uint64_t compressed_bytes;   //!< size of the written chunks in the file
+    };
+
     Bag();
 
     //! Open a bag file
@@ -123,6 +137,19 @@ public:
     std::tuple<std::string, uint64_t, uint64_t> getCompressionInfo() const;
     void            setChunkThreshold(uint32_t chunk_threshold);  //!< Set the threshold for creating new chunks
     uint32_t        getChunkThreshold() const;                    //!< Get the threshold for creating new chunks
+    void            setCompressionLevel(int level);               //!< Set the LZ4 compression level, from 1 (fastest) to 9 (smallest, default)
+    int             getCompressionLevel() const;                  //!< Get the LZ4 compression level
+    void            setCompressionThreads(uint32_t threads);      //!< Compress LZ4 chunks on background threads, 0 compresses while writing (default)
+    uint32_t        getCompressionThreads() const;                //!< Get the number of compression threads
+    CompressionStatistics getCompressionStatistics() const;       //!< Get the progress of the written and pending chunks
+
+    //! Decompress the chunks following the one being read on background threads
+    /*!
+     * \param threads   Number of decompression threads, 0 decompresses each chunk when it is read (default)
+     * \param max_bytes Uncompressed size of the chunks kept ahead of the one being read
+     */
+    void            setReadAhead(uint32_t threads, uint64_t max_bytes);
+    uint32_t        getReadAheadThreads() const;                  //!< Get the number of decompression threads
 
     //! Write a message into the bag file
     /*!
@@ -208,6 +235,24 @@ private:
     void writeChunkHeader(CompressionType compression, uint32_t compressed_size, uint32_t uncompressed_size);
     void stopWritingChunk();
 
+    // Background compression
+
+    struct PendingChunk;
+    void queueChunk();
+    void compressChunks();
+    void writeCompressedChunks(size_t max_pending);
+    void writeIndexRecords(std::map<uint32_t, std::multiset<IndexEntry> > const& connection_indexes);
+    void stopCompressionThreads();
+
+    // Read-ahead
+
+    struct ReadAheadChunk;
+    bool takeReadAheadChunk(uint64_t chunk_pos) const;
+    void readAhead(uint64_t chunk_pos) const;
+    void decompressChunks() const;
+    static void decompressReadAheadChunk(ReadAheadChunk& chunk);
+    void stopReadAheadThreads() const;
+
     // Reading
 
     void readVersion();
@@ -310,6 +355,28 @@ private:
     mutable Buffer*  current_buffer_;
 
     mutable uint64_t decompressed_chunk_;      //!< position of decompressed chunk
+
+    int                                        compression_level_;
+    uint32_t                                   compression_threads_count_;
+    bool                                       chunk_deferred_;           //!< current chunk is only assembled in outgoing_chunk_buffer_
+    std::deque<std::shared_ptr<PendingChunk> > pending_chunks_;           //!< chunks waiting to be compressed and written, in file order
+    std::vector<std::thread>                   compression_threads_;
+    bool                                       stop_compression_;
+    CompressionStatistics                      compression_stats_;
+    mutable std::mutex                         compression_mutex_;        //!< guards pending_chunks_ and compression_stats_
+    std::condition_variable                    chunk_queued_cv_;
+    std::condition_variable                    chunk_compressed_cv_;
+
+    uint32_t                                               read_ahead_threads_count_;
+    uint64_t                                               read_ahead_max_bytes_;
+    mutable std::deque<std::shared_ptr<ReadAheadChunk> >   read_ahead_chunks_;     //!< chunks following the one being read, in file order
+    mutable std::vector<std::thread>                       read_ahead_threads_;
+    mutable bool                                           stop_read_ahead_;
+    mutable std::mutex                                     read_ahead_mutex_;      //!< guards read_ahead_chunks_
+    mutable std::condition_variable                        read_ahead_queued_cv_;
+    mutable std::condition_variable                        read_ahead_decompressed_cv_;
+    mutable Buffer                                         previous_buffer_;       //!< chunk read before the decompressed one, while reading ahead
+    mutable uint64_t                                       previous_chunk_;        //!< position of the chunk in previous_buffer_
 };
 
 } // namespace rosbag
@@ -543,7 +610,8 @@ void Bag::doWrite(std::string const& topic, rs2rosinternal::Time const& time, T
             }
             connections_[conn_id] = connection_info;
 
-            writeConnectionRecord(connection_info);
+            if (!chunk_deferred_)
+                writeConnectionRecord(connection_info);
             appendConnectionRecordToBuffer(outgoing_chunk_buffer_, connection_info);
         }
 
@@ -555,8 +623,11 @@ void Bag::doWrite(std::string const& topic, rs2rosinternal::Time const& time, T
 
         std::multiset<IndexEntry>& chunk_connection_index = curr_chunk_connection_indexes_[connection_info->id];
         chunk_connection_index.insert(chunk_connection_index.end(), index_entry);
-        std::multiset<IndexEntry>& connection_index = connection_indexes_[connection_info->id];
-        connection_index.insert(connection_index.end(), index_entry);
+        // Deferred chunks are indexed once they are written and their position is known
+        if (!chunk_deferred_) {
+            std::multiset<IndexEntry>& connection_index = connection_indexes_[connection_info->id];
+            connection_index.insert(connection_index.end(), index_entry);
+        }
 
         // Increment the connection count
         curr_chunk_info_.connection_counts[connection_info->id]++;
@@ -604,9 +675,11 @@ void Bag::writeMessageDataRecord(uint32_t conn_id, rs2rosinternal::Time const& t
     CONSOLE_BRIDGE_logDebug("Writing MSG_DATA [%llu:%d]: conn=%d sec=%d nsec=%d data_len=%d",
               (unsigned long long) file_.getOffset(), getChunkOffset(), conn_id, time.sec, time.nsec, msg_ser_len);
 
-    writeHeader(header);
-    writeDataLength(msg_ser_len);
-    write((char*) record_buffer_.getData(), msg_ser_len);
+    if (!chunk_deferred_) {
+        writeHeader(header);
+        writeDataLength(msg_ser_len);
+        write((char*) record_buffer_.getData(), msg_ser_len);
+    }
 
     // todo: use better abstraction than appendHeaderToBuffer
     appendHeaderToBuffer(outgoing_chunk_buffer_, header);
@@ -68,6 +68,7 @@ public:
 
     void        setReadMode(CompressionType type);
     void        setWriteMode(CompressionType type);
+    void        setLz4Acceleration(int acceleration);           //!< set the acceleration used by following LZ4 compressed writes
 
     // File I/O
     void        write(std::string const& s);
@@ -140,12 +140,15 @@ public:
 
     void decompress(uint8_t* dest, unsigned int dest_len, uint8_t* source, unsigned int source_len);
 
+    void setAcceleration(int acceleration);  //!< LZ4 acceleration of the next written stream, 1 compresses best
+
 private:
     void writeStream(int action);
 
     char *buff_;
     int buff_size_;
     int block_size_id_;
+    int acceleration_;
     roslz4_stream lz4s_;
 };
 
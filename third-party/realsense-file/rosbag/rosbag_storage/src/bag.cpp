@@ -37,6 +37,7 @@
 #endif
 #include <signal.h>
 #include <assert.h>
+#include <algorithm>
 #include <iomanip>
 #include <map>
 #include <tuple>
@@ -73,7 +74,16 @@ Bag::Bag() :
     chunk_open_(false),
     curr_chunk_data_pos_(0),
     current_buffer_(0),
-    decompressed_chunk_(0)
+    decompressed_chunk_(0),
+    compression_level_(9),
+    compression_threads_count_(0),
+    chunk_deferred_(false),
+    stop_compression_(false),
+    compression_stats_(),
+    read_ahead_threads_count_(0),
+    read_ahead_max_bytes_(0),
+    stop_read_ahead_(false),
+    previous_chunk_(0)
 {
 }
 
@@ -89,7 +99,16 @@ Bag::Bag(string const& filename, uint32_t mode) :
     chunk_open_(false),
     curr_chunk_data_pos_(0),
     current_buffer_(0),
-    decompressed_chunk_(0)
+    decompressed_chunk_(0),
+    compression_level_(9),
+    compression_threads_count_(0),
+    chunk_deferred_(false),
+    stop_compression_(false),
+    compression_stats_(),
+    read_ahead_threads_count_(0),
+    read_ahead_max_bytes_(0),
+    stop_read_ahead_(false),
+    previous_chunk_(0)
 {
     open(filename, mode);
 }
@@ -98,6 +117,31 @@ Bag::~Bag() {
     close();
 }
 
+//! A chunk handed to the compression threads
+struct Bag::PendingChunk
+{
+    ChunkInfo                                       info;
+    std::map<uint32_t, std::multiset<IndexEntry> > connection_indexes;
+    Buffer                                          uncompressed;
+    Buffer                                          compressed;
+    int                                             acceleration;
+    bool                                            started;
+    bool                                            done;
+    int                                             result;
+};
+
+//! A chunk read from the file ahead of its messages, decompressed by the read-ahead threads
+struct Bag::ReadAheadChunk
+{
+    uint64_t                                        pos;
+    size_t                                          index;        //!< position of the chunk in chunks_
+    Buffer                                          compressed;
+    Buffer                                          uncompressed;
+    bool                                            started;
+    bool                                            done;
+    int                                             result;
+};
+
 void Bag::open(string const& filename, uint32_t mode) {
     mode_ = (BagMode) mode;
 
@@ -165,6 +209,15 @@ void Bag::close() {
     if (mode_ & bagmode::Write || mode_ & bagmode::Append)
         closeWrite();
 
+    stopCompressionThreads();
+    pending_chunks_.clear();
+    chunk_deferred_ = false;
+
+    stopReadAheadThreads();
+    read_ahead_chunks_.clear();
+    decompressed_chunk_ = 0;
+    previous_chunk_     = 0;
+
     file_.close();
 
     topic_connection_ids_.clear();
@@ -196,6 +249,54 @@ void Bag::setChunkThreshold(uint32_t chunk_threshold) {
 
 CompressionType Bag::getCompression() const { return compression_; }
 
+int Bag::getCompressionLevel() const { return compression_level_; }
+
+void Bag::setCompressionLevel(int level) {
+    if (level < 1 || level > 9)
+        throw BagException((format("Unknown compression level: %i") % level).str());
+
+    if (file_.isOpen() && chunk_open_)
+        stopWritingChunk();
+
+    // Level 9 compresses as LZ4 does by default, lower levels trade size for speed
+    compression_level_ = level;
+    file_.setLz4Acceleration(10 - level);
+}
+
+uint32_t Bag::getCompressionThreads() const { return compression_threads_count_; }
+
+void Bag::setCompressionThreads(uint32_t threads) {
+    if (file_.isOpen() && chunk_open_)
+        stopWritingChunk();
+
+    writeCompressedChunks(0);
+    stopCompressionThreads();
+
+    compression_threads_count_ = threads;
+}
+
+uint32_t Bag::getReadAheadThreads() const { return read_ahead_threads_count_; }
+
+void Bag::setReadAhead(uint32_t threads, uint64_t max_bytes) {
+    stopReadAheadThreads();
+    read_ahead_chunks_.clear();
+    previous_chunk_ = 0;
+
+    read_ahead_threads_count_ = threads;
+    read_ahead_max_bytes_     = max_bytes;
+}
+
+Bag::CompressionStatistics Bag::getCompressionStatistics() const {
+    std::lock_guard<std::mutex> lock(compression_mutex_);
+
+    CompressionStatistics stats = compression_stats_;
+    stats.pending_chunks = static_cast<uint32_t>(pending_chunks_.size());
+    stats.pending_bytes  = 0;
+    for (auto&& chunk : pending_chunks_)
+        stats.pending_bytes += chunk->uncompressed.getSize();
+    return stats;
+}
+
 std::tuple<std::string, uint64_t, uint64_t> Bag::getCompressionInfo() const
 {
     std::map<std::string, uint64_t> compression_counts;
@@ -298,6 +399,9 @@ void Bag::stopWriting() {
     if (chunk_open_)
         stopWritingChunk();
 
+    writeCompressedChunks(0);
+    stopCompressionThreads();
+
     seek(0, std::ios::end);
 
     index_data_pos_ = file_.getOffset();
@@ -442,13 +546,31 @@ void Bag::readFileHeaderRecord() {
 }
 
 uint32_t Bag::getChunkOffset() const {
-    if (compression_ == compression::Uncompressed)
+    if (chunk_deferred_)
+        return outgoing_chunk_buffer_.getSize();
+    else if (compression_ == compression::Uncompressed)
         return static_cast<uint32_t>(file_.getOffset() - curr_chunk_data_pos_);
     else
         return file_.getCompressedBytesIn();
 }
 
 void Bag::startWritingChunk(Time time) {
+    outgoing_chunk_buffer_.setSize(0);
+
+    // LZ4 chunks are only assembled in outgoing_chunk_buffer_ when compression threads are used,
+    // they are written once compressed and their position is known
+    chunk_deferred_ = compression_ == compression::LZ4 && compression_threads_count_ > 0;
+    if (chunk_deferred_) {
+        curr_chunk_info_.pos        = 0;
+        curr_chunk_info_.start_time = time;
+        curr_chunk_info_.end_time   = time;
+        chunk_open_ = true;
+        return;
+    }
+
+    // Keep the chunks in order when switching from compression threads
+    writeCompressedChunks(0);
+
     // Initialize chunk info
     curr_chunk_info_.pos        = file_.getOffset();
     curr_chunk_info_.start_time = time;
@@ -467,6 +589,11 @@ void Bag::startWritingChunk(Time time) {
 }
 
 void Bag::stopWritingChunk() {
+    if (chunk_deferred_) {
+        queueChunk();
+        return;
+    }
+
     // Add this chunk to the index
     chunks_.push_back(curr_chunk_info_);
 
@@ -481,6 +608,13 @@ void Bag::stopWritingChunk() {
     seek(curr_chunk_info_.pos);
     writeChunkHeader(compression_, compressed_size, uncompressed_size);
 
+    {
+        std::lock_guard<std::mutex> lock(compression_mutex_);
+        compression_stats_.written_chunks++;
+        compression_stats_.uncompressed_bytes += uncompressed_size;
+        compression_stats_.compressed_bytes   += compressed_size;
+    }
+
     // Write out the indexes and clear them
     seek(end_of_chunk_pos);
     writeIndexRecords();
@@ -532,10 +666,140 @@ void Bag::readChunkHeader(ChunkHeader& chunk_header) const {
     CONSOLE_BRIDGE_logDebug("Read CHUNK: compression=%s size=%d uncompressed=%d (%f)", chunk_header.compression.c_str(), chunk_header.compressed_size, chunk_header.uncompressed_size, 100 * ((double) chunk_header.compressed_size) / chunk_header.uncompressed_size);
 }
 
+// Background compression
+
+void Bag::queueChunk() {
+    std::shared_ptr<PendingChunk> chunk = std::make_shared<PendingChunk>();
+    chunk->info = curr_chunk_info_;
+    chunk->connection_indexes.swap(curr_chunk_connection_indexes_);
+    chunk->uncompressed.swap(outgoing_chunk_buffer_);
+    chunk->acceleration = 10 - compression_level_;
+    chunk->started      = false;
+    chunk->done         = false;
+    chunk->result       = ROSLZ4_OK;
+
+    // Clear the connection counts
+    curr_chunk_info_.connection_counts.clear();
+
+    // Flag that we're starting a new chunk
+    chunk_open_     = false;
+    chunk_deferred_ = false;
+
+    {
+        std::lock_guard<std::mutex> lock(compression_mutex_);
+        while (compression_threads_.size() < compression_threads_count_)
+            compression_threads_.push_back(std::thread(&Bag::compressChunks, this));
+
+        pending_chunks_.push_back(chunk);
+    }
+    chunk_queued_cv_.notify_one();
+
+    // Write what is already compressed, and wait for the threads when they fall behind
+    writeCompressedChunks(2 * compression_threads_count_);
+}
+
+void Bag::compressChunks() {
+    std::unique_lock<std::mutex> lock(compression_mutex_);
+    while (true) {
+        std::shared_ptr<PendingChunk> chunk;
+        chunk_queued_cv_.wait(lock, [&] {
+            for (auto&& pending : pending_chunks_) {
+                if (!pending->started) {
+                    chunk = pending;
+                    return true;
+                }
+            }
+            return stop_compression_;
+        });
+        if (!chunk)
+            return;
+
+        chunk->started = true;
+        lock.unlock();
+
+        // Room for every block stored uncompressed, with its size prefix, and the frame header and footer
+        unsigned int uncompressed_size = chunk->uncompressed.getSize();
+        unsigned int block_size        = roslz4_blockSizeFromIndex(6);
+        unsigned int compressed_size   = uncompressed_size + (uncompressed_size / block_size + 1) * 4 + 64;
+        chunk->compressed.setSize(compressed_size);
+
+        // Same block size as LZ4Stream so the chunk matches one compressed while writing
+        int result = roslz4_buffToBuffCompressFast((char*) chunk->uncompressed.getData(), uncompressed_size,
+                                                   (char*) chunk->compressed.getData(), &compressed_size,
+                                                   6, chunk->acceleration);
+
+        lock.lock();
+        chunk->compressed.setSize(compressed_size);
+        chunk->result = result;
+        chunk->done   = true;
+        chunk_compressed_cv_.notify_all();
+    }
+}
+
+void Bag::writeCompressedChunks(size_t max_pending) {
+    std::unique_lock<std::mutex> lock(compression_mutex_);
+    while (!pending_chunks_.empty()) {
+        std::shared_ptr<PendingChunk> chunk = pending_chunks_.front();
+        if (!chunk->done) {
+            if (pending_chunks_.size() <= max_pending)
+                return;
+            chunk_compressed_cv_.wait(lock, [&] { return chunk->done; });
+        }
+        pending_chunks_.pop_front();
+        lock.unlock();
+
+        if (chunk->result != ROSLZ4_OK)
+            throw BagIOException((format("Error compressing chunk: %i") % chunk->result).str());
+
+        uint32_t uncompressed_size = chunk->uncompressed.getSize();
+        uint32_t compressed_size   = chunk->compressed.getSize();
+
+        seek(0, std::ios::end);
+        chunk->info.pos = file_.getOffset();
+        writeChunkHeader(compression::LZ4, compressed_size, uncompressed_size);
+        write((char*) chunk->compressed.getData(), compressed_size);
+
+        writeIndexRecords(chunk->connection_indexes);
+
+        // Now that the chunk position is known, add its messages to the connection indexes
+        for (auto&& i : chunk->connection_indexes) {
+            multiset<IndexEntry>& connection_index = connection_indexes_[i.first];
+            for (IndexEntry index_entry : i.second) {
+                index_entry.chunk_pos = chunk->info.pos;
+                connection_index.insert(connection_index.end(), index_entry);
+            }
+        }
+        chunks_.push_back(chunk->info);
+        file_size_ = file_.getOffset();
+
+        lock.lock();
+        compression_stats_.written_chunks++;
+        compression_stats_.uncompressed_bytes += uncompressed_size;
+        compression_stats_.compressed_bytes   += compressed_size;
+    }
+}
+
+void Bag::stopCompressionThreads() {
+    {
+        std::lock_guard<std::mutex> lock(compression_mutex_);
+        stop_compression_ = true;
+    }
+    chunk_queued_cv_.notify_all();
+
+    for (auto&& thread : compression_threads_)
+        thread.join();
+    compression_threads_.clear();
+    stop_compression_ = false;
+}
+
 // Index records
 
 void Bag::writeIndexRecords() {
-    for (map<uint32_t, multiset<IndexEntry> >::const_iterator i = curr_chunk_connection_indexes_.begin(); i != curr_chunk_connection_indexes_.end(); i++) {
+    writeIndexRecords(curr_chunk_connection_indexes_);
+}
+
+void Bag::writeIndexRecords(map<uint32_t, multiset<IndexEntry> > const& connection_indexes) {
+    for (map<uint32_t, multiset<IndexEntry> >::const_iterator i = connection_indexes.begin(); i != connection_indexes.end(); i++) {
         uint32_t                    connection_id = i->first;
         multiset<IndexEntry> const& index         = i->second;
 
@@ -796,6 +1060,24 @@ void Bag::decompressChunk(uint64_t chunk_pos) const {
     if (decompressed_chunk_ == chunk_pos)
         return;
 
+    if (read_ahead_threads_count_ > 0) {
+        // Messages at the edge of a chunk may be read between a few of the next chunk's
+        if (previous_chunk_ == chunk_pos) {
+            decompress_buffer_.swap(previous_buffer_);
+            std::swap(decompressed_chunk_, previous_chunk_);
+            return;
+        }
+        decompress_buffer_.swap(previous_buffer_);
+        previous_chunk_     = decompressed_chunk_;
+        decompressed_chunk_ = 0;
+
+        if (takeReadAheadChunk(chunk_pos)) {
+            decompressed_chunk_ = chunk_pos;
+            readAhead(chunk_pos);
+            return;
+        }
+    }
+
     // Seek to the start of the chunk
     seek(chunk_pos);
 
@@ -814,6 +1096,153 @@ void Bag::decompressChunk(uint64_t chunk_pos) const {
         throw BagFormatException("Unknown compression: " + chunk_header.compression);
 
     decompressed_chunk_ = chunk_pos;
+
+    if (read_ahead_threads_count_ > 0)
+        readAhead(chunk_pos);
+}
+
+// Read-ahead
+
+bool Bag::takeReadAheadChunk(uint64_t chunk_pos) const {
+    std::unique_lock<std::mutex> lock(read_ahead_mutex_);
+
+    auto it = std::find_if(read_ahead_chunks_.begin(), read_ahead_chunks_.end(),
+                           [&](std::shared_ptr<ReadAheadChunk> const& chunk) { return chunk->pos == chunk_pos; });
+    if (it == read_ahead_chunks_.end())
+        return false;
+
+    // Chunks before the one being read were skipped
+    std::shared_ptr<ReadAheadChunk> chunk = *it;
+    read_ahead_chunks_.erase(read_ahead_chunks_.begin(), it + 1);
+    if (chunk->started) {
+        read_ahead_decompressed_cv_.wait(lock, [&] { return chunk->done; });
+        lock.unlock();
+    }
+    else {
+        // No thread got to it yet, and none will now that it left the queue
+        chunk->started = true;
+        lock.unlock();
+        decompressReadAheadChunk(*chunk);
+    }
+
+    switch (chunk->result) {
+    case ROSLZ4_OK: break;
+    case ROSLZ4_ERROR: throw BagException("ROSLZ4_ERROR: decompression error"); break;
+    case ROSLZ4_MEMORY_ERROR: throw BagException("ROSLZ4_MEMORY_ERROR: insufficient memory available"); break;
+    case ROSLZ4_OUTPUT_SMALL: throw BagException("ROSLZ4_OUTPUT_SMALL: output buffer is too small"); break;
+    case ROSLZ4_DATA_ERROR: throw BagException("ROSLZ4_DATA_ERROR: malformed data to decompress"); break;
+    default: throw BagException("Unhandled return code");
+    }
+
+    decompress_buffer_.swap(chunk->uncompressed);
+    return true;
+}
+
+void Bag::readAhead(uint64_t chunk_pos) const {
+    auto it = std::lower_bound(chunks_.begin(), chunks_.end(), chunk_pos,
+                               [](ChunkInfo const& info, uint64_t pos) { return info.pos < pos; });
+    if (it == chunks_.end() || it->pos != chunk_pos)
+        return;
+    size_t chunk_index = it - chunks_.begin();
+
+    std::unique_lock<std::mutex> lock(read_ahead_mutex_);
+
+    while (!read_ahead_chunks_.empty() && read_ahead_chunks_.front()->index <= chunk_index)
+        read_ahead_chunks_.pop_front();
+
+    // A gap before the chunks read ahead means the view was moved
+    if (!read_ahead_chunks_.empty() && read_ahead_chunks_.front()->index > chunk_index + 1)
+        read_ahead_chunks_.clear();
+
+    size_t next_index = read_ahead_chunks_.empty() ? chunk_index + 1 : read_ahead_chunks_.back()->index + 1;
+    uint64_t queued_bytes = 0;
+    for (auto&& chunk : read_ahead_chunks_)
+        queued_bytes += chunk->uncompressed.getSize();
+    lock.unlock();
+
+    // The file is only read here, the threads just decompress what was read
+    std::vector<std::shared_ptr<ReadAheadChunk> > read_chunks;
+    for (; next_index < chunks_.size(); next_index++) {
+        seek(chunks_[next_index].pos);
+        ChunkHeader chunk_header;
+        readChunkHeader(chunk_header);
+
+        // Always keep one chunk ahead, even when it is larger than the budget
+        if (chunk_header.compression != COMPRESSION_LZ4 ||
+            (queued_bytes > 0 && queued_bytes + chunk_header.uncompressed_size > read_ahead_max_bytes_))
+            break;
+
+        std::shared_ptr<ReadAheadChunk> chunk = std::make_shared<ReadAheadChunk>();
+        chunk->pos     = chunks_[next_index].pos;
+        chunk->index   = next_index;
+        chunk->started = false;
+        chunk->done    = false;
+        chunk->result  = ROSLZ4_OK;
+        chunk->compressed.setSize(chunk_header.compressed_size);
+        file_.read((char*) chunk->compressed.getData(), chunk_header.compressed_size);
+        chunk->uncompressed.setSize(chunk_header.uncompressed_size);
+
+        queued_bytes += chunk_header.uncompressed_size;
+        read_chunks.push_back(chunk);
+    }
+    if (read_chunks.empty())
+        return;
+
+    lock.lock();
+    while (read_ahead_threads_.size() < read_ahead_threads_count_)
+        read_ahead_threads_.push_back(std::thread(&Bag::decompressChunks, this));
+
+    read_ahead_chunks_.insert(read_ahead_chunks_.end(), read_chunks.begin(), read_chunks.end());
+    lock.unlock();
+    read_ahead_queued_cv_.notify_all();
+}
+
+void Bag::decompressChunks() const {
+    std::unique_lock<std::mutex> lock(read_ahead_mutex_);
+    while (true) {
+        std::shared_ptr<ReadAheadChunk> chunk;
+        read_ahead_queued_cv_.wait(lock, [&] {
+            for (auto&& queued : read_ahead_chunks_) {
+                if (!queued->started) {
+                    chunk = queued;
+                    return true;
+                }
+            }
+            return stop_read_ahead_;
+        });
+        if (!chunk)
+            return;
+
+        chunk->started = true;
+        lock.unlock();
+
+        decompressReadAheadChunk(*chunk);
+
+        lock.lock();
+        chunk->done = true;
+        read_ahead_decompressed_cv_.notify_all();
+    }
+}
+
+void Bag::decompressReadAheadChunk(ReadAheadChunk& chunk) {
+    unsigned int uncompressed_size = chunk.uncompressed.getSize();
+    chunk.result = roslz4_buffToBuffDecompress((char*) chunk.compressed.getData(), chunk.compressed.getSize(),
+                                               (char*) chunk.uncompressed.getData(), &uncompressed_size);
+    if (chunk.result == ROSLZ4_OK && uncompressed_size != chunk.uncompressed.getSize())
+        chunk.result = ROSLZ4_DATA_ERROR;
+}
+
+void Bag::stopReadAheadThreads() const {
+    {
+        std::lock_guard<std::mutex> lock(read_ahead_mutex_);
+        stop_read_ahead_ = true;
+    }
+    read_ahead_queued_cv_.notify_all();
+
+    for (auto&& thread : read_ahead_threads_)
+        thread.join();
+    read_ahead_threads_.clear();
+    stop_read_ahead_ = false;
 }
 
 void Bag::readMessageDataRecord102(uint64_t offset, rs2rosinternal::Header& header) const {
@@ -56,6 +56,18 @@ void Buffer::setSize(uint32_t size) {
     ensureCapacity(size);
 }
 
+void Buffer::swap(Buffer& other) {
+    uint8_t* buffer   = buffer_;
+    uint32_t capacity = capacity_;
+    uint32_t size     = size_;
+    buffer_   = other.buffer_;
+    capacity_ = other.capacity_;
+    size_     = other.size_;
+    other.buffer_   = buffer;
+    other.capacity_ = capacity;
+    other.size_     = size;
+}
+
 void Buffer::ensureCapacity(uint32_t capacity) {
     if (capacity <= capacity_)
         return;
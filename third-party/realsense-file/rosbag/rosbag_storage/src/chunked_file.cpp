@@ -163,6 +163,11 @@ void ChunkedFile::setWriteMode(CompressionType type) {
     }
 }
 
+void ChunkedFile::setLz4Acceleration(int acceleration) {
+    auto lz4_stream = std::dynamic_pointer_cast<LZ4Stream>(stream_factory_->getStream(compression::LZ4));
+    lz4_stream->setAcceleration(acceleration);
+}
+
 void ChunkedFile::setReadMode(CompressionType type) {
     if (!file_)
         throw BagIOException("Can't set compression mode before opening a file");
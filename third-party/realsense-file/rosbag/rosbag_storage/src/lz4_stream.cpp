@@ -43,7 +43,7 @@ using std::string;
 namespace rosbag {
 
 LZ4Stream::LZ4Stream(ChunkedFile* file)
-    : Stream(file), block_size_id_(6) {
+    : Stream(file), block_size_id_(6), acceleration_(1) {
     buff_size_ = roslz4_blockSizeFromIndex(block_size_id_) + 64;
     buff_ = new char[buff_size_];
 }
@@ -56,10 +56,16 @@ CompressionType LZ4Stream::getCompressionType() const {
     return compression::LZ4;
 }
 
+void LZ4Stream::setAcceleration(int acceleration) {
+    if (acceleration < 1)
+        throw BagException("Invalid LZ4 acceleration: " + std::to_string(acceleration));
+    acceleration_ = acceleration;
+}
+
 void LZ4Stream::startWrite() {
     setCompressedIn(0);
 
-    int ret = roslz4_compressStart(&lz4s_, block_size_id_);
+    int ret = roslz4_compressStartFast(&lz4s_, block_size_id_, acceleration_);
     switch(ret) {
     case ROSLZ4_OK: break;
     case ROSLZ4_MEMORY_ERROR: throw BagIOException("ROSLZ4_MEMORY_ERROR: insufficient memory available"); break;
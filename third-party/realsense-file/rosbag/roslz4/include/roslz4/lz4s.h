@@ -74,6 +74,8 @@ typedef struct {
 int roslz4_blockSizeFromIndex(int block_id);
 
 int roslz4_compressStart(roslz4_stream *stream, int block_size_id);
+// Same as roslz4_compressStart, blocks are compressed with the given LZ4_compress_fast acceleration
+int roslz4_compressStartFast(roslz4_stream *stream, int block_size_id, int acceleration);
 int roslz4_compress(roslz4_stream *stream, int action);
 void roslz4_compressEnd(roslz4_stream *stream);
 
@@ -85,6 +87,9 @@ void roslz4_decompressEnd(roslz4_stream *str);
 int roslz4_buffToBuffCompress(char *input, unsigned int input_size,
                               char *output, unsigned int *output_size,
                               int block_size_id);
+int roslz4_buffToBuffCompressFast(char *input, unsigned int input_size,
+                                  char *output, unsigned int *output_size,
+                                  int block_size_id, int acceleration);
 int roslz4_buffToBuffDecompress(char *input, unsigned int input_size,
                                 char *output, unsigned int *output_size);
 
@@ -91,6 +91,7 @@ typedef struct {
 
   // Compression state
   int wrote_header;
+  int acceleration; // LZ4_compress_fast acceleration, 1 compresses best
 
   // Decompression state
   char header[10];
@@ -181,10 +182,11 @@ int bufferToOutput(roslz4_stream *str) {
         state->buffer_offset, str->output_left);
 
   // Shrink output by 1 to detect if data is not compressible
-  uint32_t comp_size = LZ4_compress_default(state->buffer,
-                                            str->output_next + 4,
-                                            state->buffer_offset,
-                                            uncomp_size - 1);
+  uint32_t comp_size = LZ4_compress_fast(state->buffer,
+                                         str->output_next + 4,
+                                         state->buffer_offset,
+                                         uncomp_size - 1,
+                                         state->acceleration);
   uint32_t wrote;
   if (comp_size > 0) {
     DEBUG("bufferToOutput() Compressed to %i bytes\n", comp_size);
@@ -251,6 +253,7 @@ int streamStateAlloc(roslz4_stream *str) {
   state->stream_checksum_read = 0;
 
   state->wrote_header = 0;
+  state->acceleration = 1;
 
   state->buffer_offset = 0;
   state->buffer_size = 0;
@@ -301,8 +304,16 @@ int roslz4_blockSizeFromIndex(int block_id) {
 }
 
 int roslz4_compressStart(roslz4_stream *str, int block_size_id) {
+  return roslz4_compressStartFast(str, block_size_id, 1);
+}
+
+int roslz4_compressStartFast(roslz4_stream *str, int block_size_id, int acceleration) {
+  if (acceleration < 1) {
+    return ROSLZ4_PARAM_ERROR;
+  }
   int ret = streamStateAlloc(str);
   if (ret < 0) { return ret; }
+  ((stream_state*) str->state)->acceleration = acceleration;
   return streamResizeBuffer(str, block_size_id);
 }
 
@@ -565,6 +576,13 @@ void roslz4_decompressEnd(roslz4_stream *str) {
 int roslz4_buffToBuffCompress(char *input, unsigned int input_size,
                               char *output, unsigned int *output_size,
                               int block_size_id) {
+  return roslz4_buffToBuffCompressFast(input, input_size, output, output_size,
+                                       block_size_id, 1);
+}
+
+int roslz4_buffToBuffCompressFast(char *input, unsigned int input_size,
+                                  char *output, unsigned int *output_size,
+                                  int block_size_id, int acceleration) {
   roslz4_stream stream;
   stream.input_next = input;
   stream.input_left = input_size;
@@ -572,7 +590,7 @@ int roslz4_buffToBuffCompress(char *input, unsigned int input_size,
   stream.output_left = *output_size;
 
   int ret;
-  ret = roslz4_compressStart(&stream, block_size_id);
+  ret = roslz4_compressStartFast(&stream, block_size_id, acceleration);
   if (ret != ROSLZ4_OK) { return ret; }
 
   while (stream.input_left > 0 && ret != ROSLZ4_STREAM_END) {
@@ -0,0 +1,380 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2019 Intel Corporation. All Rights Reserved.
+
+#include <librealsense2/rs.hpp>
+#include <librealsense2/hpp/rs_internal.hpp>
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <vector>
+#include <chrono>
+#include <functional>
+#include <algorithm>
+#include <numeric>
+
+#include "tclap/CmdLine.h"
+#include "synthetic-depth.h"
+
+using namespace std;
+using namespace chrono;
+using namespace TCLAP;
+using namespace rs2;
+
+// Distinct synthetic images per stream, cycled over the injected frames to keep the memory footprint low
+const int SYNTHETIC_IMAGES = 8;
+
+// Frames of every stream a block may take as input. Streams missing from a recording are left empty
+struct input_set
+{
+    string name;
+    vector<frame> depth, color, yuyv;
+    vector<frame> depth_color;   // Framesets
+};
+
+struct block_result
+{
+    string name, input, skipped;
+    int frames = 0;
+    double p50 = 0, p90 = 0, p99 = 0, max = 0, mean = 0, fps = 0;
+};
+
+struct benchmark_block
+{
+    string name;
+    function<const vector<frame>&(const input_set&)> select;
+    function<shared_ptr<filter>()> create;
+};
+
+// Moving gradients, channels bytes per pixel
+vector<vector<uint8_t>> generate_pattern(int width, int height, int channels)
+{
+    vector<vector<uint8_t>> images(SYNTHETIC_IMAGES, vector<uint8_t>(width * height * channels));
+    for (int i = 0; i < SYNTHETIC_IMAGES; i++)
+        for (int y = 0; y < height; y++)
+            for (int x = 0; x < width; x++)
+                for (int c = 0; c < channels; c++)
+                    images[i][(y * width + x) * channels + c] = uint8_t(x * (c + 1) + y + i * 16);
+    return images;
+}
+
+// Holds the software device alive as long as the frames it produced are in use
+struct synthetic_source
+{
+    software_device dev;
+    vector<vector<uint16_t>> depth;
+    vector<vector<uint8_t>> color, yuyv;
+};
+
+// Collects framesets combined out of frames of different sensors
+class frameset_builder
+{
+public:
+    frameset_builder()
+        : _block([this](frame f, const frame_source& src) {
+              vector<frame> frames{ f };
+              frames.insert(frames.end(), _others.begin(), _others.end());
+              src.frame_ready(src.allocate_composite_frame(frames));
+          })
+    {}
+
+    frame combine(frame f, vector<frame> others)
+    {
+        _others = others;
+        auto fs = _block.process(f);
+        fs.keep();
+        return fs;
+    }
+
+private:
+    vector<frame> _others;
+    filter _block;
+};
+
+input_set make_synthetic_input(synthetic_source& source, int width, int height, int frames)
+{
+    source.depth = generate_depth(width, height, SYNTHETIC_IMAGES);
+    source.color = generate_pattern(width, height, 3);
+    source.yuyv = generate_pattern(width, height, 2);
+
+    rs2_intrinsics intrinsics{ width, height, width / 2.f, height / 2.f, float(width), float(width), RS2_DISTORTION_BROWN_CONRADY, { 0,0,0,0,0 } };
+    auto depth_sensor = source.dev.add_sensor("Depth");
+    auto depth_profile = depth_sensor.add_video_stream({ RS2_STREAM_DEPTH, 0, 0, width, height, 30, 2, RS2_FORMAT_Z16, intrinsics });
+    depth_sensor.add_read_only_option(RS2_OPTION_DEPTH_UNITS, 0.001f);
+    depth_sensor.add_read_only_option(RS2_OPTION_STEREO_BASELINE, 50.f);
+
+    auto color_sensor = source.dev.add_sensor("Color");
+    auto color_profile = color_sensor.add_video_stream({ RS2_STREAM_COLOR, 0, 2, width, height, 30, 3, RS2_FORMAT_RGB8, intrinsics });
+    auto yuyv_profile = color_sensor.add_video_stream({ RS2_STREAM_COLOR, 1, 3, width, height, 30, 2, RS2_FORMAT_YUYV, intrinsics });
+    depth_profile.register_extrinsics_to(color_profile, { { 1,0,0, 0,1,0, 0,0,1 }, { 0.015f, 0, 0 } });
+
+    frame_queue q(4);
+    depth_sensor.open(depth_profile);
+    color_sensor.open({ color_profile, yuyv_profile });
+    depth_sensor.start(q);
+    color_sensor.start(q);
+
+    auto inject = [&](software_sensor& sensor, stream_profile profile, void* data, int bpp, int i) {
+        sensor.on_video_frame({ data, [](void*) {}, width * bpp, bpp, double(i), RS2_TIMESTAMP_DOMAIN_SYSTEM_TIME, i + 1, profile });
+        auto f = q.wait_for_frame();
+        f.keep();
+        return f;
+    };
+
+    input_set input;
+    input.name = to_string(width) + "x" + to_string(height);
+    frameset_builder builder;
+    for (int i = 0; i < frames; i++)
+    {
+        auto n = i % SYNTHETIC_IMAGES;
+        auto depth = inject(depth_sensor, depth_profile, source.depth[n].data(), 2, i);
+        auto color = inject(color_sensor, color_profile, source.color[n].data(), 3, i);
+        auto yuyv = inject(color_sensor, yuyv_profile, source.yuyv[n].data(), 2, i);
+
+        input.depth.push_back(depth);
+        input.color.push_back(color);
+        input.yuyv.push_back(yuyv);
+        input.depth_color.push_back(builder.combine(depth, { color }));
+    }
+
+    depth_sensor.stop();
+    color_sensor.stop();
+    depth_sensor.close();
+    color_sensor.close();
+    return input;
+}
+
+// Blocks query the sensor of a frame, so the playback device is kept as long as its frames are in use
+input_set make_recorded_input(const string& file, int frames, device& dev)
+{
+    config cfg;
+    cfg.enable_device_from_file(file, false);
+    pipeline pipe;
+    auto profile = pipe.start(cfg);
+    dev = profile.get_device();
+    dev.as<playback>().set_real_time(false);
+
+    input_set input;
+    input.name = file;
+    frameset_builder builder;
+    frameset fs;
+    while (int(input.depth.size()) < frames && pipe.try_wait_for_frames(&fs, 1000))
+    {
+        fs.keep();
+        auto depth = fs.get_depth_frame();
+        auto color = fs.get_color_frame();
+        if (!depth)
+            continue;
+
+        input.depth.push_back(depth);
+        if (color && color.get_profile().format() == RS2_FORMAT_YUYV)
+            input.yuyv.push_back(color);
+        else if (color)
+            input.color.push_back(color);
+        if (color)
+            input.depth_color.push_back(builder.combine(depth, { color }));
+    }
+    pipe.stop();
+
+    if (input.depth.empty())
+        throw runtime_error("No depth frames found in " + file);
+    return input;
+}
+
+// The zero order fix is left out: it reads its calibration from an L500 depth sensor,
+// which neither the synthetic software device nor a playback device provides
+vector<benchmark_block> make_blocks()
+{
+    auto depth = [](const input_set& in) -> const vector<frame>& { return in.depth; };
+    return {
+        { "decimation", depth, [] { return make_shared<decimation_filter>(); } },
+        { "spatial", depth, [] { return make_shared<spatial_filter>(); } },
+        { "temporal", depth, [] { return make_shared<temporal_filter>(); } },
+        { "hole_filling", depth, [] { return make_shared<hole_filling_filter>(); } },
+        { "disparity", depth, [] { return make_shared<disparity_transform>(true); } },
+        { "align", [](const input_set& in) -> const vector<frame>& { return in.depth_color; }, [] { return make_shared<rs2::align>(RS2_STREAM_COLOR); } },
+        { "pointcloud", depth, [] { return make_shared<pointcloud>(); } },
+        { "colorizer", depth, [] { return make_shared<colorizer>(); } },
+        { "yuy_decoder", [](const input_set& in) -> const vector<frame>& { return in.yuyv; }, [] { return make_shared<yuy_decoder>(); } },
+    };
+}
+
+block_result run_block(const benchmark_block& block, const input_set& input, int warmup)
+{
+    block_result result;
+    result.name = block.name;
+    result.input = input.name;
+
+    auto& frames = block.select(input);
+    if (frames.empty())
+    {
+        result.skipped = "the input has no suitable frames";
+        return result;
+    }
+
+    try
+    {
+        auto filter = block.create();
+        for (int i = 0; i < warmup; i++)
+            filter->process(frames[i % frames.size()]);
+
+        vector<double> times;
+        auto begin = high_resolution_clock::now();
+        for (auto&& f : frames)
+        {
+            auto start = high_resolution_clock::now();
+            auto out = filter->process(f);
+            times.push_back(duration<double, milli>(high_resolution_clock::now() - start).count());
+            // A block passing its input through did not process it
+            if (out.get() == f.get())
+            {
+                result.skipped = "the block passed the input through unprocessed";
+                return result;
+            }
+        }
+        auto total = duration<double>(high_resolution_clock::now() - begin).count();
+
+        sort(times.begin(), times.end());
+        auto percentile = [&](double p) { return times[min(times.size() - 1, size_t(p * times.size()))]; };
+        result.frames = int(times.size());
+        result.p50 = percentile(0.5);
+        result.p90 = percentile(0.9);
+        result.p99 = percentile(0.99);
+        result.max = times.back();
+        result.mean = accumulate(times.begin(), times.end(), 0.0) / times.size();
+        result.fps = total > 0 ? times.size() / total : 0;
+    }
+    catch (const exception& e)
+    {
+        result.skipped = e.what();
+    }
+    return result;
+}
+
+string escape(const string& str)
+{
+    stringstream ss;
+    for (auto c : str)
+    {
+        if (c == '"' || c == '\\') ss << '\\' << c;
+        else if (c == '\n') ss << "\\n";
+        else if (uint8_t(c) >= 0x20) ss << c;
+    }
+    return ss.str();
+}
+
+void write_json(ostream& out, const vector<block_result>& results, int frames, int warmup)
+{
+    out << fixed << setprecision(4);
+    out << "{" << endl;
+    out << "  \"version\": \"" << RS2_API_VERSION_STR << "\"," << endl;
+    out << "  \"frames\": " << frames << "," << endl;
+    out << "  \"warmup\": " << warmup << "," << endl;
+    out << "  \"results\": [" << endl;
+    for (size_t i = 0; i < results.size(); i++)
+    {
+        auto& r = results[i];
+        out << "    { \"block\": \"" << r.name << "\", \"input\": \"" << escape(r.input) << "\", ";
+        if (r.skipped.empty())
+            out << "\"frames\": " << r.frames << ", \"latency_ms\": { \"p50\": " << r.p50 << ", \"p90\": " << r.p90
+                << ", \"p99\": " << r.p99 << ", \"max\": " << r.max << ", \"mean\": " << r.mean << " }, \"fps\": " << r.fps << " }";
+        else
+            out << "\"skipped\": \"" << escape(r.skipped) << "\" }";
+        out << (i + 1 < results.size() ? "," : "") << endl;
+    }
+    out << "  ]" << endl;
+    out << "}" << endl;
+}
+
+int main(int argc, char** argv) try
+{
+    CmdLine cmd("librealsense rs-proc-bench tool", ' ', RS2_API_VERSION_STR);
+    ValueArg<int> frames_arg("f", "frames", "Number of timed frames per block and input", false, 100, "frames");
+    ValueArg<int> warmup_arg("w", "warmup", "Number of untimed frames processed before timing", false, 10, "frames");
+    ValueArg<string> resolutions_arg("r", "resolutions", "Comma separated resolutions of the synthetic input", false, "640x480,848x480,1280x720", "WxH,...");
+    ValueArg<string> blocks_arg("b", "blocks", "Comma separated blocks to time, all when empty", false, "", "names");
+    ValueArg<string> input_arg("i", "input", "Recorded bag file to use instead of synthetic frames", false, "", "path");
+    ValueArg<string> output_arg("o", "output", "File to write the JSON results to, standard output when empty", false, "", "path");
+    cmd.add(frames_arg);
+    cmd.add(warmup_arg);
+    cmd.add(resolutions_arg);
+    cmd.add(blocks_arg);
+    cmd.add(input_arg);
+    cmd.add(output_arg);
+    cmd.parse(argc, argv);
+
+    auto frames = max(1, frames_arg.getValue());
+    auto warmup = max(0, warmup_arg.getValue());
+
+    auto split = [](const string& str) {
+        vector<string> items;
+        stringstream ss(str);
+        string item;
+        while (getline(ss, item, ','))
+            if (!item.empty())
+                items.push_back(item);
+        return items;
+    };
+
+    auto blocks = make_blocks();
+    auto selected = split(blocks_arg.getValue());
+    for (auto&& name : selected)
+        if (none_of(blocks.begin(), blocks.end(), [&](const benchmark_block& b) { return b.name == name; }))
+            throw runtime_error("Unknown block " + name);
+
+    vector<block_result> results;
+    auto run_all = [&](const input_set& input) {
+        for (auto&& block : blocks)
+        {
+            if (!selected.empty() && find(selected.begin(), selected.end(), block.name) == selected.end())
+                continue;
+            cerr << "Timing " << block.name << " on " << input.name << endl;
+            results.push_back(run_block(block, input, warmup));
+        }
+    };
+
+    if (!input_arg.getValue().empty())
+    {
+        device dev;
+        run_all(make_recorded_input(input_arg.getValue(), frames, dev));
+    }
+    else
+    {
+        for (auto&& res : split(resolutions_arg.getValue()))
+        {
+            int width = 0, height = 0;
+            char x = 0;
+            stringstream ss(res);
+            if (!(ss >> width >> x >> height) || x != 'x' || width <= 0 || height <= 0)
+                throw runtime_error("Invalid resolution " + res);
+
+            synthetic_source source;
+            run_all(make_synthetic_input(source, width, height, frames));
+        }
+    }
+
+    if (output_arg.getValue().empty())
+    {
+        write_json(cout, results, frames, warmup);
+    }
+    else
+    {
+        ofstream out(output_arg.getValue());
+        if (!out)
+            throw runtime_error("Cannot open " + output_arg.getValue());
+        write_json(out, results, frames, warmup);
+    }
+
+    return EXIT_SUCCESS;
+}
+catch (const error & e)
+{
+    cerr << "RealSense error calling " << e.get_failed_function() << "(" << e.get_failed_args() << "):\n    " << e.what() << endl;
+    return EXIT_FAILURE;
+}
+catch (const exception & e)
+{
+    cerr << e.what() << endl;
+    return EXIT_FAILURE;
+}
@@ -0,0 +1,215 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2019 Intel Corporation. All Rights Reserved.
+
+#include <librealsense2/rs.hpp>
+#include <librealsense2/hpp/rs_internal.hpp>
+
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <array>
+#include <chrono>
+#include <cstring>
+#include <cmath>
+#include <algorithm>
+#include <numeric>
+#include <thread>
+
+#include "tclap/CmdLine.h"
+#include "synthetic-depth.h"
+
+using namespace std;
+using namespace chrono;
+using namespace TCLAP;
+using namespace rs2;
+
+// Straightforward per-pixel temporal filter, as implemented in librealsense before vectorization.
+// Serves both as the baseline for timing and as the reference the library output is compared against
+class reference_temporal_filter
+{
+public:
+    reference_temporal_filter(int persistence, float alpha, uint8_t delta)
+        : _alpha(alpha), _delta(delta), _phase(0)
+    {
+        // Credible history patterns: valid in at least <count> of the last <window> frames
+        const int window[] = { 0, 8, 3, 4, 8, 2, 5, 8, 8 };
+        const int count[] = { 9, 8, 2, 2, 2, 1, 1, 1, 0 };
+
+        array<uint8_t, 256> map{};
+        for (int i = 0; i < 256; i++)
+        {
+            int sum = 0;
+            for (int frame = 0; frame < window[persistence]; frame++)
+                sum += !!(i & (128 >> frame));
+            map[i] = sum >= count[persistence];
+        }
+
+        // Rotate to each of the 8 phases of storage
+        _persistence_map.fill(0);
+        for (int phase = 0; phase < 8; phase++)
+            for (int i = 0; i < 256; i++)
+                if (map[uint8_t((i << (8 - phase)) | (i >> phase))])
+                    _persistence_map[i] |= 1 << phase;
+    }
+
+    void process(uint16_t* frame, size_t pixels)
+    {
+        if (_last_frame.size() != pixels)
+        {
+            _last_frame.assign(pixels, 0);
+            _history.assign(pixels, 0);
+        }
+
+        uint8_t mask = 1 << _phase;
+        for (size_t i = 0; i < pixels; i++)
+        {
+            uint16_t cur_val = frame[i];
+            uint16_t prev_val = _last_frame[i];
+
+            if (cur_val)
+            {
+                if (prev_val && uint16_t(abs(cur_val - prev_val)) < _delta)
+                {
+                    _history[i] |= mask;
+                    uint16_t result = static_cast<uint16_t>(_alpha * cur_val + (1.f - _alpha) * prev_val);
+                    frame[i] = result;
+                    _last_frame[i] = result;
+                }
+                else
+                {
+                    _last_frame[i] = cur_val;
+                    _history[i] = mask;
+                }
+            }
+            else
+            {
+                if (prev_val && (_persistence_map[_history[i]] & mask))
+                    frame[i] = prev_val;
+                _history[i] &= ~mask;
+            }
+        }
+        _phase = (_phase + 1) % 8;
+    }
+
+private:
+    float _alpha;
+    uint8_t _delta;
+    int _phase;
+    array<uint8_t, 256> _persistence_map;
+    vector<uint16_t> _last_frame;
+    vector<uint8_t> _history;
+};
+
+struct timing
+{
+    double median, mean, max;
+};
+
+timing summarize(vector<double> samples)
+{
+    sort(samples.begin(), samples.end());
+    return{ samples[samples.size() / 2], accumulate(samples.begin(), samples.end(), 0.0) / samples.size(), samples.back() };
+}
+
+int main(int argc, char** argv) try
+{
+    CmdLine cmd("librealsense rs-temporal-benchmark tool", ' ', RS2_API_VERSION_STR);
+    ValueArg<int> frames_arg("f", "frames", "Number of frames per resolution", false, 100, "frames");
+    ValueArg<int> threads_arg("t", "threads", "Worker threads of the multithreaded run", false,
+        max(1, min(16, int(thread::hardware_concurrency()))), "threads");
+    ValueArg<int> persistence_arg("p", "persistence", "Temporal filter persistence mode", false, 3, "0-8");
+    cmd.add(frames_arg);
+    cmd.add(threads_arg);
+    cmd.add(persistence_arg);
+    cmd.parse(argc, argv);
+
+    auto frames = max(1, frames_arg.getValue());
+    auto threads = threads_arg.getValue();
+    auto persistence = persistence_arg.getValue();
+    if (persistence < 0 || persistence > 8)
+        throw runtime_error("Persistence mode must be between 0 and 8");
+    const float alpha = 0.4f;
+    const uint8_t delta = 20;
+
+    cout << endl;
+    cout << "|Resolution |Implementation |Median(m) |Mean(m) |Max(m) |Speedup |Bit-exact |" << endl;
+    cout << "|-----------|---------------|----------|--------|-------|--------|----------|" << endl;
+    cout << fixed << setprecision(3);
+
+    bool all_exact = true;
+    for (auto res : { make_pair(848, 480), make_pair(1280, 720), make_pair(1920, 1080) })
+    {
+        auto width = res.first, height = res.second;
+        auto sequence = generate_depth(width, height, frames);
+
+        // Reference output and timing
+        reference_temporal_filter reference(persistence, alpha, delta);
+        vector<vector<uint16_t>> expected = sequence;
+        vector<double> ref_times;
+        for (auto&& frame : expected)
+        {
+            auto start = high_resolution_clock::now();
+            reference.process(frame.data(), frame.size());
+            ref_times.push_back(duration<double, milli>(high_resolution_clock::now() - start).count());
+        }
+        auto ref = summarize(ref_times);
+        cout << "|" << width << "x" << height << " |Reference (scalar) |" << ref.median << " |" << ref.mean << " |" << ref.max << " |1.00x | |" << endl;
+
+        // The same sequence through the library block, injected via a software device
+        software_device dev;
+        auto sensor = dev.add_sensor("Depth");
+        rs2_intrinsics intrinsics{ width, height, width / 2.f, height / 2.f, float(width), float(width), RS2_DISTORTION_BROWN_CONRADY, { 0,0,0,0,0 } };
+        auto profile = sensor.add_video_stream({ RS2_STREAM_DEPTH, 0, 0, width, height, 30, 2, RS2_FORMAT_Z16, intrinsics });
+        sensor.add_read_only_option(RS2_OPTION_DEPTH_UNITS, 0.001f);
+        frame_queue q(frames);
+        sensor.open(profile);
+        sensor.start(q);
+
+        vector<frame> inputs;
+        for (int i = 0; i < frames; i++)
+        {
+            sensor.on_video_frame({ sequence[i].data(), [](void*) {}, width * 2, 2, double(i), RS2_TIMESTAMP_DOMAIN_SYSTEM_TIME, i + 1, profile });
+            auto f = q.wait_for_frame();
+            f.keep();
+            inputs.push_back(f);
+        }
+
+        for (auto run_threads : { 1, threads })
+        {
+            temporal_filter filter(alpha, delta, persistence);
+            filter.set_option(RS2_OPTION_PROCESSING_THREADS, float(run_threads));
+
+            vector<double> times;
+            bool exact = true;
+            for (int i = 0; i < frames; i++)
+            {
+                auto start = high_resolution_clock::now();
+                auto filtered = filter.process(inputs[i]);
+                times.push_back(duration<double, milli>(high_resolution_clock::now() - start).count());
+                exact = exact && !memcmp(filtered.get_data(), expected[i].data(), expected[i].size() * sizeof(uint16_t));
+            }
+            all_exact = all_exact && exact;
+
+            auto t = summarize(times);
+            cout << "|" << width << "x" << height << " |librealsense, " << run_threads << " thread" << (run_threads > 1 ? "s" : "")
+                 << " |" << t.median << " |" << t.mean << " |" << t.max << " |" << setprecision(2) << ref.median / t.median << "x"
+                 << setprecision(3) << " |" << (exact ? "yes" : "**NO**") << " |" << endl;
+        }
+
+        sensor.stop();
+        sensor.close();
+    }
+    cout << endl;
+
+    return all_exact ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+catch (const error & e)
+{
+    cerr << "RealSense error calling " << e.get_failed_function() << "(" << e.get_failed_args() << "):\n    " << e.what() << endl;
+    return EXIT_FAILURE;
+}
+catch (const exception & e)
+{
+    cerr << e.what() << endl;
+    return EXIT_FAILURE;
+}
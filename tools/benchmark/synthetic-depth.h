@@ -0,0 +1,27 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2019 Intel Corporation. All Rights Reserved.
+
+#pragma once
+
+#include <cstdint>
+#include <random>
+#include <vector>
+
+// Depth images with the usual artifacts: sensor noise, flickering invalid pixels and depth edges.
+// The benchmarks share it, so that they time the processing blocks on the same content
+inline std::vector<std::vector<uint16_t>> generate_depth(int width, int height, int count)
+{
+    std::mt19937 gen(width ^ height);
+    std::normal_distribution<float> noise(0.f, 4.f);
+    std::uniform_int_distribution<int> percent(0, 99);
+
+    std::vector<std::vector<uint16_t>> images(count, std::vector<uint16_t>(width * height));
+    for (auto&& image : images)
+        for (int y = 0; y < height; y++)
+            for (int x = 0; x < width; x++)
+            {
+                float depth = (x / (width / 8)) % 2 ? 1200.f : 2500.f + y;
+                image[y * width + x] = percent(gen) < 10 ? 0 : uint16_t(depth + noise(gen));
+            }
+    return images;
+}
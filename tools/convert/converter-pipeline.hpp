@@ -0,0 +1,157 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2019 Intel Corporation. All Rights Reserved.
+
+#ifndef __RS_CONVERTER_CONVERTER_PIPELINE_H
+#define __RS_CONVERTER_CONVERTER_PIPELINE_H
+
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <set>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "converter.hpp"
+
+
+namespace rs2 {
+    namespace tools {
+        namespace converter {
+
+            // Runs every converter on each frameset, converting up to maxInFlight framesets at once on a pool of threads.
+            // Framesets are retired in the order they were pushed, whatever order their conversion completes in,
+            // so the retired count never includes a frameset whose predecessors are still being converted
+            class converter_pipeline {
+                struct item {
+                    unsigned long long sequence;
+                    rs2::frameset frameset;
+                };
+
+                std::vector<std::shared_ptr<converter_base>> _converters;
+                size_t _maxInFlight;
+
+                std::mutex _mutex;
+                std::condition_variable _cv;
+                std::deque<item> _queue;
+                std::set<unsigned long long> _converted;   // Completed ahead of an earlier frameset
+                size_t _inFlight = 0;
+                unsigned long long _pushed = 0;
+                unsigned long long _retired = 0;
+                bool _stopping = false;
+                std::exception_ptr _error;
+
+                std::vector<std::thread> _workers;
+
+                void work()
+                {
+                    std::unique_lock<std::mutex> lock(_mutex);
+
+                    while (true) {
+                        _cv.wait(lock, [this] { return _stopping || !_queue.empty(); });
+                        if (_queue.empty()) {
+                            return;
+                        }
+
+                        auto current = std::move(_queue.front());
+                        _queue.pop_front();
+                        lock.unlock();
+
+                        try {
+                            for (auto& converter : _converters) {
+                                converter->convert(current.frameset);
+                            }
+                        }
+                        catch (...) {
+                            std::lock_guard<std::mutex> errorLock(_mutex);
+                            if (!_error) {
+                                _error = std::current_exception();
+                            }
+                        }
+
+                        // Frames are released before waking the producer, which may be waiting for frame resources
+                        auto sequence = current.sequence;
+                        current.frameset = rs2::frameset();
+
+                        lock.lock();
+                        _converted.insert(sequence);
+
+                        while (_converted.erase(_retired)) {
+                            _retired++;
+                            _inFlight--;
+                        }
+
+                        _cv.notify_all();
+                    }
+                }
+
+                void rethrow_error()
+                {
+                    if (_error) {
+                        auto error = _error;
+                        _error = nullptr;
+                        std::rethrow_exception(error);
+                    }
+                }
+
+            public:
+                converter_pipeline(const std::vector<std::shared_ptr<converter_base>>& converters
+                    , size_t threads
+                    , size_t maxInFlight)
+                    : _converters(converters)
+                    , _maxInFlight(std::max<size_t>(maxInFlight, 1))
+                {
+                    for (size_t i = 0; i < std::max<size_t>(threads, 1); i++) {
+                        _workers.emplace_back([this] { work(); });
+                    }
+                }
+
+                ~converter_pipeline()
+                {
+                    {
+                        std::lock_guard<std::mutex> lock(_mutex);
+                        _stopping = true;
+                    }
+
+                    _cv.notify_all();
+
+                    for (auto& worker : _workers) {
+                        worker.join();
+                    }
+                }
+
+                // Queues the frameset for conversion, blocking while maxInFlight framesets are not retired yet
+                void push(const rs2::frameset& frameset)
+                {
+                    std::unique_lock<std::mutex> lock(_mutex);
+                    _cv.wait(lock, [this] { return _inFlight < _maxInFlight || _error; });
+                    rethrow_error();
+
+                    _queue.push_back({ _pushed++, frameset });
+                    _inFlight++;
+                    _cv.notify_all();
+                }
+
+                // Waits for all the pushed framesets to be retired
+                void finish()
+                {
+                    std::unique_lock<std::mutex> lock(_mutex);
+                    _cv.wait(lock, [this] { return _inFlight == 0; });
+                    rethrow_error();
+                }
+
+                unsigned long long get_retired()
+                {
+                    std::lock_guard<std::mutex> lock(_mutex);
+                    return _retired;
+                }
+            };
+
+        }
+    }
+}
+
+
+#endif
@@ -6,7 +6,7 @@
 
 #include <unordered_map>
 #include <unordered_set>
-#include <thread>
+#include <mutex>
 #include <string>
 #include <sstream>
 
@@ -19,15 +19,18 @@ namespace rs2 {
 
             typedef unsigned long long frame_number_t;
 
+            // Converters are called for consecutive framesets from several threads at once,
+            // each call converting its frameset to completion before returning
             class converter_base {
             protected:
-                std::thread _worker;
-                std::vector<std::thread> _subWorkers;
+                std::mutex _framesMapMutex;
                 std::unordered_map<int, std::unordered_set<frame_number_t>> _framesMap;
 
             protected:
                 bool frames_map_get_and_set(rs2_stream streamType, frame_number_t frameNumber)
                 {
+                    std::lock_guard<std::mutex> lock(_framesMapMutex);
+
                     if (_framesMap.find(streamType) == _framesMap.end()) {
                         _framesMap.emplace(streamType, std::unordered_set<frame_number_t>());
                     }
@@ -42,32 +45,14 @@ namespace rs2 {
                     return result;
                 }
 
-                template <typename F> void start_worker(const F& f)
-                {
-                    _worker = std::thread(f);
-                }
-
-                template <typename F> void add_sub_worker(const F& f)
-                {
-                    _subWorkers.emplace_back(f);
-                }
-
-                void wait_sub_workers()
-                {
-                    for_each(_subWorkers.begin(), _subWorkers.end(),
-                        [] (std::thread& t) {
-                            t.join();
-                        });
-
-                    _subWorkers.clear();
-                }
-
             public:
                 virtual void convert(rs2::frameset& frameset) = 0;
                 virtual std::string name() const = 0;
 
                 virtual std::string get_statistics()
                 {
+                    std::lock_guard<std::mutex> lock(_framesMapMutex);
+
                     std::stringstream result;
                     result << name() << '\n';
 
@@ -81,11 +66,6 @@ namespace rs2 {
 
                     return (result.str());
                 }
-
-                void wait()
-                {
-                    _worker.join();
-                }
             };
 
         }
@@ -33,48 +33,38 @@ namespace rs2 {
 
                 void convert(rs2::frameset& frameset) override
                 {
-                    start_worker(
-                        [this, &frameset] {
-                            for (size_t i = 0; i < frameset.size(); i++) {
-                                auto frame = frameset[i].as<rs2::depth_frame>();
-
-                                if (frame && (_streamType == rs2_stream::RS2_STREAM_ANY || frame.get_profile().stream_type() == _streamType)) {
-                                    if (frames_map_get_and_set(frame.get_profile().stream_type(), frame.get_frame_number())) {
-                                        continue;
-                                    }
-
-                                    std::stringstream filename;
-                                    filename << _filePath
-                                        << "_" << frame.get_profile().stream_name()
-                                        << "_" << frame.get_frame_number()
-                                        << ".csv";
+                    for (size_t i = 0; i < frameset.size(); i++) {
+                        auto frame = frameset[i].as<rs2::depth_frame>();
 
-                                    std::string filenameS = filename.str();
+                        if (frame && (_streamType == rs2_stream::RS2_STREAM_ANY || frame.get_profile().stream_type() == _streamType)) {
+                            if (frames_map_get_and_set(frame.get_profile().stream_type(), frame.get_frame_number())) {
+                                continue;
+                            }
 
-                                    add_sub_worker(
-                                        [filenameS, frame] {
-                                            std::ofstream fs(filenameS, std::ios::trunc);
+                            std::stringstream filename;
+                            filename << _filePath
+                                << "_" << frame.get_profile().stream_name()
+                                << "_" << frame.get_frame_number()
+                                << ".csv";
 
-                                            if (fs) {
-                                                for (int y = 0; y < frame.get_height(); y++) {
-                                                    auto delim = "";
+                            std::ofstream fs(filename.str(), std::ios::trunc);
 
-                                                    for (int x = 0; x < frame.get_width(); x++) {
-                                                        fs << delim << frame.get_distance(x, y);
-                                                        delim = ",";
-                                                    }
+                            if (fs) {
+                                for (int y = 0; y < frame.get_height(); y++) {
+                                    auto delim = "";
 
-                                                    fs << '\n';
-                                                }
+                                    for (int x = 0; x < frame.get_width(); x++) {
+                                        fs << delim << frame.get_distance(x, y);
+                                        delim = ",";
+                                    }
 
-                                                fs.flush();
-                                            }
-                                        });
+                                    fs << '\n';
                                 }
-                            }
 
-                            wait_sub_workers();
-                        });
+                                fs.flush();
+                            }
+                        }
+                    }
                 }
             };
 
@@ -29,29 +29,26 @@ namespace rs2 {
 
                 void convert(rs2::frameset& frameset) override
                 {
-                    rs2::pointcloud pc;
-                    start_worker(
-                        [this, &frameset, pc]() mutable {
-                            auto frameDepth = frameset.get_depth_frame();
-                            auto frameColor = frameset.get_color_frame();
+                    auto frameDepth = frameset.get_depth_frame();
+                    auto frameColor = frameset.get_color_frame();
 
-                            if (frameDepth && frameColor) {
-                                if (frames_map_get_and_set(rs2_stream::RS2_STREAM_ANY, frameDepth.get_frame_number())) {
-                                    return;
-                                }
+                    if (frameDepth && frameColor) {
+                        if (frames_map_get_and_set(rs2_stream::RS2_STREAM_ANY, frameDepth.get_frame_number())) {
+                            return;
+                        }
 
-                                pc.map_to(frameColor);
+                        rs2::pointcloud pc;
+                        pc.map_to(frameColor);
 
-                                auto points = pc.calculate(frameDepth);
+                        auto points = pc.calculate(frameDepth);
 
-                                std::stringstream filename;
-                                filename << _filePath
-                                    << "_" << frameDepth.get_frame_number()
-                                    << ".ply";
+                        std::stringstream filename;
+                        filename << _filePath
+                            << "_" << frameDepth.get_frame_number()
+                            << ".ply";
 
-                                points.export_to_ply(filename.str(), frameColor);
-                            }
-                        });
+                        points.export_to_ply(filename.str(), frameColor);
+                    }
                 }
             };
 
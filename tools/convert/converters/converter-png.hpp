@@ -20,6 +20,7 @@ namespace rs2 {
                 rs2_stream _streamType;
                 std::string _filePath;
                 rs2::colorizer _colorizer;
+                std::mutex _colorizerMutex;
 
             public:
                 converter_png(const std::string& filePath, rs2_stream streamType = rs2_stream::RS2_STREAM_ANY)
@@ -35,44 +36,36 @@ namespace rs2 {
 
                 void convert(rs2::frameset& frameset) override
                 {
-                    start_worker(
-                        [this, &frameset] {
-                            for (size_t i = 0; i < frameset.size(); i++) {
-                                rs2::video_frame frame = frameset[i].as<rs2::video_frame>();
-
-                                if (frame && (_streamType == rs2_stream::RS2_STREAM_ANY || frame.get_profile().stream_type() == _streamType)) {
-                                    if (frames_map_get_and_set(frame.get_profile().stream_type(), frame.get_frame_number())) {
-                                        continue;
-                                    }
-
-                                    if (frame.get_profile().stream_type() == rs2_stream::RS2_STREAM_DEPTH) {
-                                        frame = _colorizer.process(frame);
-                                    }
-
-                                    std::stringstream filename;
-                                    filename << _filePath
-                                        << "_" << frame.get_profile().stream_name()
-                                        << "_" << frame.get_frame_number()
-                                        << ".png";
-
-                                    std::string filenameS = filename.str();
-
-                                    add_sub_worker(
-                                        [filenameS, frame] {
-                                            stbi_write_png(
-                                                filenameS.c_str()
-                                                , frame.get_width()
-                                                , frame.get_height()
-                                                , frame.get_bytes_per_pixel()
-                                                , frame.get_data()
-                                                , frame.get_stride_in_bytes()
-                                            );
-                                        });
-                                }
+                    for (size_t i = 0; i < frameset.size(); i++) {
+                        rs2::video_frame frame = frameset[i].as<rs2::video_frame>();
+
+                        if (frame && (_streamType == rs2_stream::RS2_STREAM_ANY || frame.get_profile().stream_type() == _streamType)) {
+                            if (frames_map_get_and_set(frame.get_profile().stream_type(), frame.get_frame_number())) {
+                                continue;
+                            }
+
+                            if (frame.get_profile().stream_type() == rs2_stream::RS2_STREAM_DEPTH) {
+                                // The colorizer hands its output through an internal queue, one frame at a time
+                                std::lock_guard<std::mutex> lock(_colorizerMutex);
+                                frame = _colorizer.process(frame);
                             }
 
-                            wait_sub_workers();
-                        });
+                            std::stringstream filename;
+                            filename << _filePath
+                                << "_" << frame.get_profile().stream_name()
+                                << "_" << frame.get_frame_number()
+                                << ".png";
+
+                            stbi_write_png(
+                                filename.str().c_str()
+                                , frame.get_width()
+                                , frame.get_height()
+                                , frame.get_bytes_per_pixel()
+                                , frame.get_data()
+                                , frame.get_stride_in_bytes()
+                            );
+                        }
+                    }
                 }
             };
 
@@ -2,6 +2,9 @@
 // Copyright(c) 2018 Intel Corporation. All Rights Reserved.
 
 #include <iostream>
+#include <chrono>
+#include <iomanip>
+#include <thread>
 
 #include "librealsense2/rs.hpp"
 
@@ -13,6 +16,8 @@
 #include "converters/converter-ply.hpp"
 #include "converters/converter-bin.hpp"
 
+#include "converter-pipeline.hpp"
+
 
 using namespace std;
 using namespace TCLAP;
@@ -32,6 +37,7 @@ int main(int argc, char** argv) try
     ValueArg<string> outputFilenameBin("b", "output-bin", "output BIN (depth matrix) file(s) path", false, "", "bin-path");
     SwitchArg switchDepth("d", "depth", "convert depth frames (default - all supported)", false);
     SwitchArg switchColor("c", "color", "convert color frames (default - all supported)", false);
+    ValueArg<unsigned int> threadsCount("t", "threads", "number of framesets converted in parallel (default - number of cores)", false, 0, "threads");
 
     cmd.add(inputFilename);
     cmd.add(outputFilenamePng);
@@ -41,6 +47,7 @@ int main(int argc, char** argv) try
     cmd.add(outputFilenameBin);
     cmd.add(switchDepth);
     cmd.add(switchColor);
+    cmd.add(threadsCount);
     cmd.parse(argc, argv);
 
     vector<shared_ptr<rs2::tools::converter::converter_base>> converters;
@@ -102,32 +109,32 @@ int main(int argc, char** argv) try
 
     auto duration = playback.get_duration();
     int progress = 0;
-    auto frameNumber = 0ULL;
-    
+
+    // Playback keeps decoding the next framesets while the previous ones are converted.
+    // Every frameset in flight holds on to its frames, so their count is kept within the streams frames queues
+    auto threads = threadsCount.getValue() ? threadsCount.getValue() : max(thread::hardware_concurrency(), 1u);
+    auto maxInFlight = min<size_t>(threads * 2, 8);
+    rs2::tools::converter::converter_pipeline pipeline(converters, threads, maxInFlight);
+
+    auto start = chrono::steady_clock::now();
+    auto frames_per_second = [&pipeline, &start] {
+        chrono::duration<double> elapsed = chrono::steady_clock::now() - start;
+        return elapsed.count() > 0 ? pipeline.get_retired() / elapsed.count() : 0.;
+    };
+
     rs2::frameset frameset;
     uint64_t posLast = playback.get_position();
-    while (pipe->try_wait_for_frames(&frameset, 1000)) 
+    while (pipe->try_wait_for_frames(&frameset, 1000))
     {
         int posP = static_cast<int>(posLast * 100. / duration.count());
 
         if (posP > progress) {
             progress = posP;
-            cout << posP << "%" << "\r" << flush;
+            cout << posP << "% (" << fixed << setprecision(1) << frames_per_second() << " frames/s)" << "\r" << flush;
         }
 
+        pipeline.push(frameset);
 
-
-        frameNumber = frameset[0].get_frame_number();
-
-        for_each(converters.begin(), converters.end(),
-            [&frameset] (shared_ptr<rs2::tools::converter::converter_base>& converter) {
-                converter->convert(frameset);
-            });
-
-        for_each(converters.begin(), converters.end(),
-            [] (shared_ptr<rs2::tools::converter::converter_base>& converter) {
-                converter->wait();
-            });
         const uint64_t posCurr = playback.get_position();
         if(static_cast<int64_t>(posCurr - posLast) < 0){
             break;
@@ -135,7 +142,10 @@ int main(int argc, char** argv) try
         posLast = posCurr;
     }
 
-    cout << endl;
+    pipeline.finish();
+
+    cout << endl << pipeline.get_retired() << " framesets converted on " << threads << " thread(s), "
+        << fixed << setprecision(1) << frames_per_second() << " frames/s" << endl;
 
     for_each(converters.begin(), converters.end(),
         [] (shared_ptr<rs2::tools::converter::converter_base>& converter) {
@@ -0,0 +1,233 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2019 Intel Corporation. All Rights Reserved.
+
+#include "catch/catch.hpp"
+#include <iostream>
+#include <chrono>
+#include <vector>
+#include <thread>
+#include <algorithm>
+#include "./../src/concurrency.h"
+
+template<class Q>
+void check_drop_oldest(Q& q)
+{
+    for (int i = 0; i < 10; i++)
+        q.enqueue(std::move(i));
+
+    REQUIRE(q.size() == 4);
+    int item = -1;
+    for (int i = 6; i < 10; i++)
+    {
+        REQUIRE(q.try_dequeue(&item));
+        REQUIRE(item == i);
+    }
+    REQUIRE_FALSE(q.try_dequeue(&item));
+}
+
+template<class Q>
+void check_flush(Q& q)
+{
+    int item = 1;
+    q.enqueue(std::move(item));
+    q.clear();
+    REQUIRE(q.size() == 0);
+
+    // Once flushed, dequeue returns immediately and new items are dropped until the consumer resumes
+    auto start = std::chrono::steady_clock::now();
+    REQUIRE_FALSE(q.dequeue(&item, 1000));
+    REQUIRE(std::chrono::steady_clock::now() - start < std::chrono::milliseconds(500));
+
+    q.start();
+    item = 2;
+    q.enqueue(std::move(item));
+    REQUIRE(q.dequeue(&item, 1000));
+    REQUIRE(item == 2);
+}
+
+TEST_CASE("single_consumer_queue semantics", "[concurrency]")
+{
+    single_consumer_queue<int> locking(4);
+    check_drop_oldest(locking);
+
+    lock_free_single_consumer_queue<int> lock_free(4);
+    check_drop_oldest(lock_free);
+
+    single_consumer_queue<int> locking_flush(4);
+    check_flush(locking_flush);
+
+    lock_free_single_consumer_queue<int> lock_free_flush(4);
+    check_flush(lock_free_flush);
+
+    REQUIRE_THROWS(lock_free_single_consumer_queue<int>(0));
+    REQUIRE_THROWS(selectable_single_consumer_queue<int>(4, true).peek(nullptr));
+}
+
+TEST_CASE("lock-free queue blocking enqueue delivers every item in order", "[concurrency]")
+{
+    const int producers = 4, items = 20000;
+    lock_free_single_consumer_queue<int> q(8);
+
+    std::vector<std::thread> threads;
+    for (int p = 0; p < producers; p++)
+    {
+        threads.emplace_back([&, p]()
+        {
+            for (int i = 0; i < items; i++)
+            {
+                int val = p * items + i;
+                q.blocking_enqueue(std::move(val));
+            }
+        });
+    }
+
+    std::vector<int> last(producers, -1);
+    int received = 0, item = 0;
+    while (received < producers * items)
+    {
+        REQUIRE(q.dequeue(&item, 5000));
+        auto p = item / items;
+        REQUIRE(item % items > last[p]);
+        last[p] = item % items;
+        received++;
+    }
+    for (auto&& t : threads) t.join();
+    REQUIRE(q.size() == 0);
+}
+
+TEST_CASE("worker_pool covers the range once, in fixed chunks", "[concurrency]")
+{
+    worker_pool pool;
+    for (auto threads : { 1u, 3u, 8u, 2u })
+    {
+        pool.resize(threads);
+        REQUIRE(pool.size() == threads);
+        for (size_t count : { 0, 1, 7, 1000 })
+        {
+            std::vector<int> hits(count, 0);
+            std::vector<std::pair<size_t, size_t>> chunks;
+            std::mutex m;
+            pool.run(count, [&](size_t begin, size_t end)
+            {
+                for (auto i = begin; i < end; i++) hits[i]++;
+                std::lock_guard<std::mutex> lock(m);
+                chunks.emplace_back(begin, end);
+            });
+            REQUIRE(std::count(hits.begin(), hits.end(), 1) == count);
+            REQUIRE(chunks.size() <= threads);
+        }
+    }
+
+    REQUIRE_THROWS(pool.run(100, [](size_t begin, size_t) { if (begin) throw std::runtime_error("worker failure"); }));
+    REQUIRE_THROWS(pool.resize(0));
+}
+
+TEST_CASE("task_executor runs every task on its own threads", "[concurrency]")
+{
+    const int tasks = 1000;
+    std::vector<int> hits(tasks, 0);
+    std::atomic<int> done(0);
+    std::atomic<int> outside(0);
+    {
+        task_executor executor(3);
+        REQUIRE(executor.size() == 3);
+        REQUIRE_FALSE(executor.is_executor_thread());
+
+        for (int i = 0; i < tasks; i++)
+        {
+            executor.submit([&, i]()
+            {
+                hits[i]++;
+                if (!executor.is_executor_thread()) outside++;
+                if (i % 100 == 0) throw std::runtime_error("task failure");
+                done++;
+            });
+        }
+
+        auto start = std::chrono::steady_clock::now();
+        while (done < tasks - tasks / 100 && std::chrono::steady_clock::now() - start < std::chrono::seconds(10))
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    // Failing tasks do not stop the workers
+    REQUIRE(done == tasks - tasks / 100);
+    REQUIRE(std::count(hits.begin(), hits.end(), 1) == tasks);
+    REQUIRE(outside == 0);
+    REQUIRE_THROWS(task_executor(0));
+}
+
+TEST_CASE("seqlock readers never observe a partial write", "[concurrency]")
+{
+    struct value { double a; uint64_t b; int c[5]; };
+    seqlock<value> published(value{ 0, 0, { 0, 0, 0, 0, 0 } });
+    std::atomic<bool> done(false);
+    std::atomic<int> torn(0);
+
+    std::vector<std::thread> readers;
+    for (int r = 0; r < 2; r++)
+    {
+        readers.emplace_back([&]()
+        {
+            while (!done)
+            {
+                auto v = published.load();
+                bool consistent = v.b == static_cast<uint64_t>(v.a) * 3;
+                for (auto c : v.c)
+                    consistent &= c == static_cast<int>(v.a);
+                if (!consistent) torn++;
+            }
+        });
+    }
+
+    for (int i = 1; i <= 200000; i++)
+        published.store(value{ double(i), uint64_t(i) * 3, { i, i, i, i, i } });
+    done = true;
+    for (auto&& t : readers) t.join();
+
+    REQUIRE(torn == 0);
+    REQUIRE(published.load().c[4] == 200000);
+}
+
+// Contention micro-benchmark: N producers push frame-sized handles through one consumer.
+// Hidden by default, run explicitly with "[benchmark]"
+double measure_queue_throughput(bool lock_free, int producers, int items_per_producer)
+{
+    selectable_single_consumer_queue<std::shared_ptr<int>> q(16, lock_free);
+    std::atomic<bool> done(false);
+    auto start = std::chrono::high_resolution_clock::now();
+
+    std::vector<std::thread> threads;
+    for (int p = 0; p < producers; p++)
+    {
+        threads.emplace_back([&]()
+        {
+            for (int i = 0; i < items_per_producer; i++)
+                q.enqueue(std::make_shared<int>(i));
+        });
+    }
+
+    std::thread consumer([&]()
+    {
+        std::shared_ptr<int> item;
+        while (!done || q.size())
+            q.dequeue(&item, 10);
+    });
+
+    for (auto&& t : threads) t.join();
+    done = true;
+    consumer.join();
+
+    auto sec = std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - start).count();
+    return producers * items_per_producer / sec;
+}
+
+TEST_CASE("Frame queue contention benchmark", "[concurrency][benchmark][!hide]")
+{
+    for (auto producers : { 1, 2, 6, 12 })
+    {
+        auto locking = measure_queue_throughput(false, producers, 200000);
+        auto lock_free = measure_queue_throughput(true, producers, 200000);
+        std::cout << producers << " producers: mutex queue " << int(locking) << " items/s, lock-free queue "
+                  << int(lock_free) << " items/s (x" << lock_free / locking << ")" << std::endl;
+    }
+}
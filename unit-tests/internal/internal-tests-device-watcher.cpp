@@ -0,0 +1,280 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2019 Intel Corporation. All Rights Reserved.
+
+#ifdef RS2_USE_V4L2_BACKEND
+
+#include "catch/catch.hpp"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <ftw.h>
+#include <stdlib.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "./../src/linux/netlink-device-watcher.h"
+
+using namespace librealsense::platform;
+
+// Minimal sysfs tree of a USB camera exposing video nodes and HID sensors through iio, rooted in a temporary directory
+class fake_sysfs
+{
+public:
+    fake_sysfs()
+    {
+        char root[] = "/tmp/rs-sysfs-XXXXXX";
+        REQUIRE(mkdtemp(root) != nullptr);
+        _root = root;
+
+        make_dirs(_root + "/bus/iio/devices");
+        make_dirs(_root + "/class/video4linux");
+        write(_usb_device + "/busnum", "1");
+        write(_usb_device + "/devnum", "5");
+        write(_usb_device + "/devpath", "2");
+        write(_usb_device + "/idVendor", "8086");
+        write(_usb_device + "/idProduct", "0b3a");
+        write(_usb_device + "/dev", "189:4");
+    }
+
+    ~fake_sysfs()
+    {
+        nftw(_root.c_str(), [](const char* path, const struct stat*, int, FTW*) { return ::remove(path); },
+             16, FTW_DEPTH | FTW_PHYS);
+    }
+
+    // Creates iio:deviceN with the given sensor name, returns its devpath
+    std::string add_iio_device(int index, const std::string& name)
+    {
+        auto node = "iio:device" + std::to_string(index);
+        auto devpath = _usb_device + "/1-2:1.5/0003:8086:0B3A.0001/HID-SENSOR-20007" + std::to_string(index) + ".3.auto/" + node;
+        write(devpath + "/name", name);
+        REQUIRE(symlink((_root + devpath).c_str(), (_root + "/bus/iio/devices/" + node).c_str()) == 0);
+        return devpath;
+    }
+
+    void remove_iio_device(int index)
+    {
+        ::unlink((_root + "/bus/iio/devices/iio:device" + std::to_string(index)).c_str());
+    }
+
+    // Creates videoN under the first interface of the camera, returns its devpath
+    std::string add_video_node(int index)
+    {
+        auto devpath = _usb_device + "/1-2:1.0/video4linux/video" + std::to_string(index);
+        write(devpath + "/dev", "81:" + std::to_string(index));
+        return devpath;
+    }
+
+    void remove_video_node(int index)
+    {
+        auto path = _root + _usb_device + "/1-2:1.0/video4linux/video" + std::to_string(index);
+        ::remove((path + "/dev").c_str());
+        ::remove(path.c_str());
+    }
+
+    const std::string& root() const { return _root; }
+
+private:
+    void make_dirs(const std::string& path)
+    {
+        for (auto pos = path.find('/', 1); ; pos = path.find('/', pos + 1))
+        {
+            mkdir(path.substr(0, pos).c_str(), 0755);
+            if (pos == std::string::npos)
+                break;
+        }
+    }
+
+    void write(const std::string& devpath, const std::string& value)
+    {
+        auto path = _root + devpath;
+        make_dirs(path.substr(0, path.rfind('/')));
+        std::ofstream(path) << value << std::endl;
+    }
+
+    std::string _root;
+    const std::string _usb_device = "/devices/pci0000:00/0000:00:14.0/usb1/1-2";
+};
+
+// Kernel uevent wire format: "action@devpath\0KEY=VALUE\0..."
+static std::string make_uevent(const std::string& action, const std::string& devpath, const std::string& subsystem)
+{
+    std::string msg = action + "@" + devpath;
+    msg.push_back('\0');
+    for (auto&& entry : { "ACTION=" + action, "DEVPATH=" + devpath, "SUBSYSTEM=" + subsystem, std::string("SEQNUM=1") })
+    {
+        msg += entry;
+        msg.push_back('\0');
+    }
+    return msg;
+}
+
+struct callback_recorder
+{
+    std::mutex mutex;
+    std::condition_variable cv;
+    std::vector<backend_device_group> changes;
+
+    device_changed_callback callback()
+    {
+        return [this](backend_device_group, backend_device_group curr)
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            changes.push_back(curr);
+            cv.notify_all();
+        };
+    }
+
+    bool wait_for(size_t count, std::chrono::milliseconds timeout = std::chrono::milliseconds(2000))
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        return cv.wait_for(lock, timeout, [&]() { return changes.size() >= count; });
+    }
+};
+
+TEST_CASE("Device watcher reports injected uevents", "[device-watcher]")
+{
+    fake_sysfs sysfs;
+    callback_recorder recorder;
+    netlink_device_watcher watcher(sysfs.root(), std::chrono::milliseconds(50));
+    watcher.start(recorder.callback());
+
+    auto devpath = sysfs.add_iio_device(0, "accel_3d");
+    auto add = make_uevent("add", devpath, "iio");
+    REQUIRE(watcher.handle_uevent(add.data(), add.size()));
+    REQUIRE(recorder.wait_for(1));
+    {
+        std::lock_guard<std::mutex> lock(recorder.mutex);
+        auto& hid_devices = recorder.changes.back().hid_devices;
+        REQUIRE(hid_devices.size() == 1);
+        REQUIRE(hid_devices[0].id == "accel_3d");
+        REQUIRE(hid_devices[0].vid == "8086");
+        REQUIRE(hid_devices[0].unique_id == "1-2-5");
+    }
+
+    // Repeated or unrelated events leave the list untouched
+    REQUIRE_FALSE(watcher.handle_uevent(add.data(), add.size()));
+    auto net = make_uevent("add", "/devices/virtual/net/lo", "net");
+    REQUIRE_FALSE(watcher.handle_uevent(net.data(), net.size()));
+    auto change = make_uevent("change", devpath, "iio");
+    REQUIRE_FALSE(watcher.handle_uevent(change.data(), change.size()));
+
+    sysfs.remove_iio_device(0);
+    auto remove = make_uevent("remove", devpath, "iio");
+    REQUIRE(watcher.handle_uevent(remove.data(), remove.size()));
+    REQUIRE(recorder.wait_for(2));
+    {
+        std::lock_guard<std::mutex> lock(recorder.mutex);
+        REQUIRE(recorder.changes.back().hid_devices.empty());
+    }
+
+    watcher.stop();
+    std::lock_guard<std::mutex> lock(recorder.mutex);
+    REQUIRE(recorder.changes.size() == 2);
+}
+
+// Video nodes cannot be opened until udev applied their permissions, which the first queries miss
+class late_permissions_watcher : public netlink_device_watcher
+{
+public:
+    late_permissions_watcher(const std::string& sysfs_root, int denied_queries)
+        : netlink_device_watcher(sysfs_root, std::chrono::milliseconds(50)), queries(0), _denied_queries(denied_queries) {}
+    ~late_permissions_watcher() { stop(); }
+
+    mutable std::atomic<int> queries;
+
+protected:
+    std::vector<uvc_device_info> query_uvc_interface(const std::string& interface_path) const override
+    {
+        auto node = interface_path + "/video4linux/video0";
+        if (queries++ < _denied_queries || access(node.c_str(), F_OK) != 0)
+            return {};
+
+        uvc_device_info info{};
+        info.vid = 0x8086;
+        info.pid = 0x0b3a;
+        info.id = "/dev/video0";
+        info.device_path = node;
+        info.unique_id = "1-2-5";
+        return { info };
+    }
+
+private:
+    int _denied_queries;
+};
+
+TEST_CASE("Device watcher queries video nodes once udev is done with them", "[device-watcher]")
+{
+    fake_sysfs sysfs;
+    callback_recorder recorder;
+
+    SECTION("Nodes are queried again until they can be opened")
+    {
+        late_permissions_watcher watcher(sysfs.root(), 2);
+        watcher.start(recorder.callback());
+
+        auto devpath = sysfs.add_video_node(0);
+        auto add = make_uevent("add", devpath, "video4linux");
+        REQUIRE(watcher.handle_uevent(add.data(), add.size()));
+        REQUIRE(recorder.wait_for(1));
+        REQUIRE(watcher.queries == 3);
+        {
+            std::lock_guard<std::mutex> lock(recorder.mutex);
+            auto& uvc_devices = recorder.changes.back().uvc_devices;
+            REQUIRE(uvc_devices.size() == 1);
+            REQUIRE(uvc_devices[0].id == "/dev/video0");
+            REQUIRE(uvc_devices[0].device_path == sysfs.root() + devpath);
+        }
+
+        sysfs.remove_video_node(0);
+        auto remove = make_uevent("remove", devpath, "video4linux");
+        REQUIRE(watcher.handle_uevent(remove.data(), remove.size()));
+        REQUIRE(recorder.wait_for(2));
+        std::lock_guard<std::mutex> lock(recorder.mutex);
+        REQUIRE(recorder.changes.back().uvc_devices.empty());
+    }
+
+    SECTION("Nodes that never become accessible are given up on")
+    {
+        late_permissions_watcher watcher(sysfs.root(), 100);
+        watcher.start(recorder.callback());
+
+        auto add = make_uevent("add", sysfs.add_video_node(0), "video4linux");
+        REQUIRE(watcher.handle_uevent(add.data(), add.size()));
+        REQUIRE_FALSE(recorder.wait_for(1, std::chrono::milliseconds(800)));
+        REQUIRE(watcher.queries == 5);
+    }
+}
+
+TEST_CASE("Device watcher coalesces a burst of uevents", "[device-watcher]")
+{
+    fake_sysfs sysfs;
+    auto accel = sysfs.add_iio_device(0, "accel_3d");
+
+    callback_recorder recorder;
+    netlink_device_watcher watcher(sysfs.root(), std::chrono::milliseconds(300));
+    watcher.start(recorder.callback());
+
+    // The initial enumeration already holds the existing sensor
+    auto add_accel = make_uevent("add", accel, "iio");
+    REQUIRE_FALSE(watcher.handle_uevent(add_accel.data(), add_accel.size()));
+
+    auto gyro = sysfs.add_iio_device(1, "gyro_3d");
+    auto add_gyro = make_uevent("add", gyro, "iio");
+    REQUIRE(watcher.handle_uevent(add_gyro.data(), add_gyro.size()));
+    sysfs.remove_iio_device(0);
+    auto remove_accel = make_uevent("remove", accel, "iio");
+    REQUIRE(watcher.handle_uevent(remove_accel.data(), remove_accel.size()));
+
+    REQUIRE(recorder.wait_for(1));
+    REQUIRE_FALSE(recorder.wait_for(2, std::chrono::milliseconds(600)));
+    std::lock_guard<std::mutex> lock(recorder.mutex);
+    auto& hid_devices = recorder.changes.back().hid_devices;
+    REQUIRE(hid_devices.size() == 1);
+    REQUIRE(hid_devices[0].id == "gyro_3d");
+}
+
+#endif
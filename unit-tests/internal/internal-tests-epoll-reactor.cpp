@@ -0,0 +1,134 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2019 Intel Corporation. All Rights Reserved.
+
+#ifdef RS2_USE_V4L2_BACKEND
+
+#include "catch/catch.hpp"
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+#include <unistd.h>
+#include "./../src/linux/epoll-reactor.h"
+
+using namespace librealsense::platform;
+
+TEST_CASE("Latency histogram buckets", "[epoll-reactor]")
+{
+    latency_histogram histogram;
+    REQUIRE(histogram.get_count() == 0);
+    REQUIRE(histogram.get_percentile(0.5).count() == 0);
+
+    histogram.record(std::chrono::microseconds(0));
+    histogram.record(std::chrono::microseconds(1));
+    histogram.record(std::chrono::microseconds(3));
+    histogram.record(std::chrono::microseconds(1000));
+    histogram.record(std::chrono::hours(1));
+
+    auto counts = histogram.get_counts();
+    REQUIRE(counts[0] == 1);
+    REQUIRE(counts[1] == 1);
+    REQUIRE(counts[2] == 1);
+    REQUIRE(counts[10] == 1);   // [512, 1024)
+    REQUIRE(counts[latency_histogram::buckets - 1] == 1);
+    REQUIRE(histogram.get_count() == 5);
+    REQUIRE(histogram.get_percentile(0.6).count() == 4);
+    REQUIRE(histogram.get_percentile(0.8).count() == 1024);
+
+    histogram.reset();
+    REQUIRE(histogram.get_count() == 0);
+}
+
+struct pipe_source
+{
+    int fds[2];
+    std::atomic<int> handled;
+    std::atomic<int> running;
+    std::atomic<bool> overlapped;
+
+    pipe_source() : handled(0), running(0), overlapped(false) { REQUIRE(pipe(fds) == 0); }
+    ~pipe_source() { close(fds[0]); close(fds[1]); }
+
+    bool on_ready()
+    {
+        if (running.fetch_add(1) > 0)
+            overlapped = true;
+        char buff[64];
+        auto size = read(fds[0], buff, sizeof(buff));
+        if (size > 0)
+            handled += static_cast<int>(size);
+        std::this_thread::sleep_for(std::chrono::microseconds(100));
+        running--;
+        return true;
+    }
+};
+
+TEST_CASE("Epoll reactor multiplexes many sources over few threads", "[epoll-reactor]")
+{
+    epoll_reactor reactor(2);
+    REQUIRE(reactor.get_threads_count() == 2);
+
+    const int sources_count = 8, writes = 50;
+    std::vector<std::unique_ptr<pipe_source>> sources;
+    std::vector<int> ids;
+    for (int i = 0; i < sources_count; i++)
+    {
+        sources.emplace_back(new pipe_source());
+        auto src = sources.back().get();
+        ids.push_back(reactor.add({ src->fds[0] }, [src]() { return src->on_ready(); }));
+    }
+
+    for (int n = 0; n < writes; n++)
+        for (auto&& src : sources)
+            REQUIRE(write(src->fds[1], "x", 1) == 1);
+
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    auto all_handled = [&]() {
+        for (auto&& src : sources)
+            if (src->handled < writes) return false;
+        return true;
+    };
+    while (!all_handled() && std::chrono::steady_clock::now() < deadline)
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+
+    REQUIRE(all_handled());
+    for (auto&& src : sources)
+        REQUIRE_FALSE(src->overlapped);
+
+    // Once removed, a source is no longer serviced
+    reactor.remove(ids[0]);
+    REQUIRE(write(sources[0]->fds[1], "x", 1) == 1);
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    REQUIRE(sources[0]->handled == writes);
+
+    for (size_t i = 1; i < ids.size(); i++)
+        reactor.remove(ids[i]);
+}
+
+TEST_CASE("Epoll reactor reports idle sources and failed handlers", "[epoll-reactor]")
+{
+    epoll_reactor reactor(1);
+    pipe_source idle, failing;
+
+    std::atomic<int> timeouts(0);
+    auto idle_id = reactor.add({ idle.fds[0] }, [&]() { return idle.on_ready(); },
+                               std::chrono::milliseconds(200), [&]() { timeouts++; });
+
+    std::atomic<int> failures(0);
+    auto failing_id = reactor.add({ failing.fds[0] }, [&]() { failing.on_ready(); failures++; return false; });
+
+    REQUIRE(write(failing.fds[1], "x", 1) == 1);
+    std::this_thread::sleep_for(std::chrono::milliseconds(700));
+    REQUIRE(write(failing.fds[1], "x", 1) == 1);
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+    // Notified about once per timeout while no input arrives, the failed source is not watched anymore
+    REQUIRE(timeouts >= 2);
+    REQUIRE(timeouts <= 4);
+    REQUIRE(failures == 1);
+
+    reactor.remove(idle_id);
+    reactor.remove(failing_id);
+}
+
+#endif
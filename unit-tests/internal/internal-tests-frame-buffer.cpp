@@ -0,0 +1,315 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2019 Intel Corporation. All Rights Reserved.
+
+#include "catch/catch.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <vector>
+#include <librealsense2/rs.hpp>
+#include <librealsense2/hpp/rs_internal.hpp>
+#include "./../src/api.h"
+#include "./../src/frame-buffer.h"
+#include "./../src/source.h"
+#include "./../src/option.h"
+#include "./../src/software-device.h"
+
+using namespace librealsense;
+
+TEST_CASE("Frame buffer pool reuses the last released buffer of the same size", "[frame-buffer]")
+{
+    std::atomic<uint32_t> retention(1000);
+    frame_buffer_pool pool(&retention);
+
+    auto a = pool.acquire(100, 0);
+    auto b = pool.acquire(100, 0);
+    REQUIRE(a.size() == 100);
+    auto a_data = a.data();
+    auto b_data = b.data();
+    REQUIRE(pool.get_statistics().misses == 2);
+
+    pool.release(std::move(a), 1);
+    pool.release(std::move(b), 2);
+    auto stats = pool.get_statistics();
+    REQUIRE(stats.pooled_buffers == 2);
+    REQUIRE(stats.pooled_bytes == 200);
+
+    // Another size is not served from the bucket
+    auto other = pool.acquire(50, 3);
+    REQUIRE(pool.get_statistics().misses == 3);
+    REQUIRE(pool.get_statistics().pooled_buffers == 2);
+
+    // The most recently released buffer comes first
+    auto c = pool.acquire(100, 4);
+    auto d = pool.acquire(100, 4);
+    REQUIRE(c.data() == b_data);
+    REQUIRE(d.data() == a_data);
+
+    stats = pool.get_statistics();
+    REQUIRE(stats.hits == 2);
+    REQUIRE(stats.misses == 3);
+    REQUIRE(stats.expired == 0);
+    REQUIRE(stats.pooled_buffers == 0);
+    REQUIRE(stats.pooled_bytes == 0);
+}
+
+TEST_CASE("Frame buffer pool expires buffers idle past the retention period", "[frame-buffer]")
+{
+    std::atomic<uint32_t> retention(100);
+    frame_buffer_pool pool(&retention);
+
+    pool.release(pool.acquire(100, 0), 0);
+    pool.release(pool.acquire(200, 0), 50);
+    REQUIRE(pool.get_statistics().pooled_buffers == 2);
+
+    // Only the buffer released at 0 is older than the retention period at 120
+    auto a = pool.acquire(300, 120);
+    auto stats = pool.get_statistics();
+    REQUIRE(stats.expired == 1);
+    REQUIRE(stats.pooled_buffers == 1);
+    REQUIRE(stats.pooled_bytes == 200);
+
+    auto b = pool.acquire(100, 130);
+    auto c = pool.acquire(200, 130);
+    stats = pool.get_statistics();
+    REQUIRE(stats.hits == 1);
+    REQUIRE(stats.misses == 4);
+    REQUIRE(stats.pooled_buffers == 0);
+
+    // Zero retention disables recycling
+    retention = 0;
+    pool.release(std::move(b), 140);
+    REQUIRE(pool.get_statistics().pooled_buffers == 0);
+}
+
+TEST_CASE("Frame source pool follows the retention option", "[frame-buffer]")
+{
+    frame_source source;
+    source.init(std::make_shared<metadata_parser_map>());
+    auto retention = source.get_pool_retention_option();
+    REQUIRE(retention->query() == 1000);
+
+    frame_additional_data data;
+    auto release_frame = [&](double timestamp)
+    {
+        data.timestamp = timestamp;
+        auto f = source.alloc_frame(RS2_EXTENSION_VIDEO_FRAME, 64, data, true);
+        REQUIRE(f);
+        f->release();
+    };
+
+    release_frame(0);
+    auto stats = source.get_frame_pool_statistics();
+    REQUIRE(stats.misses == 1);
+    REQUIRE(stats.pooled_buffers == 1);
+    REQUIRE(stats.pooled_bytes == 64);
+
+    release_frame(10);
+    stats = source.get_frame_pool_statistics();
+    REQUIRE(stats.hits == 1);
+    REQUIRE(stats.pooled_buffers == 1);
+
+    // A shorter retention expires the pooled buffer on the next allocation
+    retention->set(100);
+    release_frame(200);
+    stats = source.get_frame_pool_statistics();
+    REQUIRE(stats.expired == 1);
+    REQUIRE(stats.misses == 2);
+    REQUIRE(stats.pooled_buffers == 1);
+
+    // Zero retention expires the pool and does not take the released buffer back
+    retention->set(0);
+    release_frame(210);
+    stats = source.get_frame_pool_statistics();
+    REQUIRE(stats.expired == 2);
+    REQUIRE(stats.misses == 3);
+    REQUIRE(stats.pooled_buffers == 0);
+    REQUIRE(stats.pooled_bytes == 0);
+
+    source.reset();
+}
+
+struct counting_allocator
+{
+    int allocs = 0;
+    int frees = 0;
+    bool fail = false;
+    std::vector<void*> live;
+
+    static void* allocate(int size, void* user)
+    {
+        auto a = static_cast<counting_allocator*>(user);
+        a->allocs++;
+        if (a->fail)
+            return nullptr;
+        auto buffer = malloc(size);
+        a->live.push_back(buffer);
+        return buffer;
+    }
+
+    static void deallocate(void* buffer, int size, void* user)
+    {
+        auto a = static_cast<counting_allocator*>(user);
+        a->frees++;
+        a->live.erase(std::find(a->live.begin(), a->live.end(), buffer));
+        free(buffer);
+    }
+};
+
+// Copies the given pixels into frames of its frame source, as the UVC and HID sensors do with the kernel buffers
+class allocating_sensor : public software_sensor
+{
+public:
+    explicit allocating_sensor(software_device* owner) : software_sensor("Allocating", owner) {}
+
+    void publish(const std::vector<uint16_t>& pixels, int width, int height)
+    {
+        auto size = pixels.size() * sizeof(uint16_t);
+        frame_holder f = _source.alloc_frame(RS2_EXTENSION_VIDEO_FRAME, size, frame_additional_data(), true);
+        REQUIRE(f);
+        auto video = static_cast<video_frame*>(f.frame);
+        video->assign(width, height, width * sizeof(uint16_t), 16);
+        std::memcpy(video->data.data(), pixels.data(), size);
+        f->set_stream(get_active_streams().front());
+        _source.invoke_callback(std::move(f));
+    }
+};
+
+class allocating_device : public software_device
+{
+public:
+    allocating_sensor& add_allocating_sensor()
+    {
+        auto sensor = std::make_shared<allocating_sensor>(this);
+        add_sensor(sensor);
+        return *sensor;
+    }
+};
+
+TEST_CASE("Frame allocator provides the buffers of the frames a sensor allocates", "[frame-buffer]")
+{
+    const int width = 16, height = 8;
+
+    auto dev = std::make_shared<allocating_device>();
+    auto& source = dev->add_allocating_sensor();
+    rs2_intrinsics intrinsics{ width, height, 0, 0, 0, 0, RS2_DISTORTION_NONE, { 0,0,0,0,0 } };
+    source.add_video_stream({ RS2_STREAM_DEPTH, 0, 0, width, height, 30, 2, RS2_FORMAT_Z16, intrinsics });
+
+    // The allocators are set through the public API, on the sensors of the device
+    rs2_device device{ dev->get_context(), dev->get_info(), dev };
+    rs2_error* e = nullptr;
+    std::shared_ptr<rs2_sensor_list> list(rs2_query_sensors(&device, &e), rs2_delete_sensor_list);
+    REQUIRE(e == nullptr);
+    rs2::sensor sensor(std::shared_ptr<rs2_sensor>(rs2_create_sensor(list.get(), 0, &e), rs2_delete_sensor));
+    REQUIRE(e == nullptr);
+
+    // Without recycling, every frame takes a buffer of its own
+    sensor.set_option(RS2_OPTION_FRAME_POOL_RETENTION, 0);
+
+    std::vector<rs2::frame> held;
+    sensor.open(sensor.get_stream_profiles().front());
+    sensor.start([&](rs2::frame f) { held.push_back(f); });
+
+    std::vector<uint16_t> pixels(width * height);
+    auto publish = [&](int number)
+    {
+        std::fill(pixels.begin(), pixels.end(), uint16_t(number));
+        source.publish(pixels, width, height);
+        REQUIRE(held.size() > 0);
+        auto data = static_cast<const uint16_t*>(held.back().get_data());
+        REQUIRE(std::equal(pixels.begin(), pixels.end(), data));
+        return held.back().get_data();
+    };
+
+    SECTION("Each frame is allocated and freed once")
+    {
+        counting_allocator allocator;
+        rs2_set_frame_allocator(sensor.get().get(), counting_allocator::allocate, counting_allocator::deallocate, &allocator, &e);
+        REQUIRE(e == nullptr);
+
+        const int frames = 5;
+        for (auto i = 0; i < frames; i++)
+        {
+            auto data = publish(i);
+            REQUIRE(allocator.allocs == i + 1);
+            REQUIRE(allocator.live.back() == data);
+        }
+        REQUIRE(allocator.frees == 0);
+
+        held.clear();
+        REQUIRE(allocator.allocs == frames);
+        REQUIRE(allocator.frees == frames);
+        REQUIRE(allocator.live.empty());
+    }
+
+    SECTION("A failing allocator falls back to the pool")
+    {
+        sensor.set_option(RS2_OPTION_FRAME_POOL_RETENTION, 1000);
+        counting_allocator allocator;
+        allocator.fail = true;
+        rs2_set_frame_allocator(sensor.get().get(), counting_allocator::allocate, counting_allocator::deallocate, &allocator, &e);
+        REQUIRE(e == nullptr);
+
+        publish(0);
+        held.clear();
+        publish(1);
+        held.clear();
+        REQUIRE(allocator.allocs == 1);
+        REQUIRE(allocator.frees == 0);
+
+        rs2_frame_pool_statistics stats;
+        rs2_get_frame_pool_statistics(sensor.get().get(), &stats, &e);
+        REQUIRE(e == nullptr);
+        REQUIRE(stats.misses == 1);
+        REQUIRE(stats.hits == 1);
+        REQUIRE(stats.pooled_buffers == 1);
+    }
+
+    SECTION("Frames in flight return to the allocator they came from")
+    {
+        counting_allocator first, second;
+        sensor.set_frame_allocator([&](int size) { return counting_allocator::allocate(size, &first); },
+                                   [&](void* buffer, int size) { counting_allocator::deallocate(buffer, size, &first); });
+        auto first_data = publish(0);
+
+        sensor.set_frame_allocator([&](int size) { return counting_allocator::allocate(size, &second); },
+                                   [&](void* buffer, int size) { counting_allocator::deallocate(buffer, size, &second); });
+        auto second_data = publish(1);
+        REQUIRE(first.live == std::vector<void*>{ const_cast<void*>(first_data) });
+        REQUIRE(second.live == std::vector<void*>{ const_cast<void*>(second_data) });
+
+        held.clear();
+        REQUIRE(first.frees == 1);
+        REQUIRE(second.frees == 1);
+
+        // Restoring the default allocator
+        rs2_set_frame_allocator(sensor.get().get(), nullptr, nullptr, nullptr, &e);
+        REQUIRE(e == nullptr);
+        publish(2);
+        held.clear();
+        REQUIRE(first.allocs == 1);
+        REQUIRE(second.allocs == 1);
+    }
+
+    SECTION("Software sensors keep publishing the given pixels")
+    {
+        rs2::software_device software_dev;
+        auto software = software_dev.add_sensor("Depth");
+        auto profile = software.add_video_stream({ RS2_STREAM_DEPTH, 0, 0, width, height, 30, 2, RS2_FORMAT_Z16, intrinsics });
+        counting_allocator allocator;
+        rs2_set_frame_allocator(software.get().get(), counting_allocator::allocate, counting_allocator::deallocate, &allocator, &e);
+        REQUIRE(e == nullptr);
+
+        software.open(profile);
+        software.start([&](rs2::frame f) { held.push_back(f); });
+        software.on_video_frame({ pixels.data(), [](void*) {}, width * 2, 2, 0., RS2_TIMESTAMP_DOMAIN_HARDWARE_CLOCK, 1, profile });
+        REQUIRE(held.back().get_data() == pixels.data());
+        held.clear();
+        REQUIRE(allocator.allocs == 0);
+        software.stop();
+        software.close();
+    }
+
+    sensor.stop();
+    sensor.close();
+}
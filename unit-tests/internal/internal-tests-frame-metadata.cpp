@@ -0,0 +1,122 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2019 Intel Corporation. All Rights Reserved.
+
+#include "catch/catch.hpp"
+#include <vector>
+#include "./../src/archive.h"
+#include "./../src/metadata-parser.h"
+
+using namespace librealsense;
+
+class counting_parser : public md_attribute_parser_base
+{
+public:
+    explicit counting_parser(rs2_metadata_type value, bool supported = true)
+        : _value(value), _supported(supported) {}
+
+    rs2_metadata_type get(const frame&) const override { gets++; return _value; }
+    bool supports(const frame&) const override { supports_calls++; return _supported; }
+
+    mutable int gets = 0;
+    mutable int supports_calls = 0;
+
+private:
+    rs2_metadata_type _value;
+    bool _supported;
+};
+
+// Derived from another attribute of the same frame, like the actual fps is from the exposure
+class derived_parser : public md_attribute_parser_base
+{
+public:
+    rs2_metadata_type get(const frame& frm) const override
+    {
+        gets++;
+        return 1000000 / frm.get_frame_metadata(RS2_FRAME_METADATA_ACTUAL_EXPOSURE);
+    }
+    bool supports(const frame& frm) const override { return frm.supports_frame_metadata(RS2_FRAME_METADATA_ACTUAL_EXPOSURE); }
+
+    mutable int gets = 0;
+};
+
+TEST_CASE("Frame metadata is decoded per attribute on first access", "[frame-metadata]")
+{
+    auto counter = std::make_shared<counting_parser>(5);
+    auto exposure = std::make_shared<counting_parser>(100);
+    auto gain = std::make_shared<counting_parser>(16, false);
+    auto fps = std::make_shared<derived_parser>();
+
+    frame f;
+    f.metadata_parsers = std::make_shared<metadata_parser_map>();
+    (*f.metadata_parsers)[RS2_FRAME_METADATA_FRAME_COUNTER] = counter;
+    (*f.metadata_parsers)[RS2_FRAME_METADATA_ACTUAL_EXPOSURE] = exposure;
+    (*f.metadata_parsers)[RS2_FRAME_METADATA_GAIN_LEVEL] = gain;
+    (*f.metadata_parsers)[RS2_FRAME_METADATA_ACTUAL_FPS] = fps;
+
+    // Only the parser of the queried attribute runs, once
+    REQUIRE(f.get_frame_metadata(RS2_FRAME_METADATA_FRAME_COUNTER) == 5);
+    REQUIRE(f.get_frame_metadata(RS2_FRAME_METADATA_FRAME_COUNTER) == 5);
+    REQUIRE(f.supports_frame_metadata(RS2_FRAME_METADATA_FRAME_COUNTER));
+    REQUIRE(counter->gets == 1);
+    REQUIRE(counter->supports_calls == 1);
+    REQUIRE(exposure->supports_calls == 0);
+    REQUIRE(gain->supports_calls == 0);
+    REQUIRE(fps->gets == 0);
+
+    REQUIRE_FALSE(f.supports_frame_metadata(RS2_FRAME_METADATA_GAIN_LEVEL));
+    REQUIRE_FALSE(f.supports_frame_metadata(RS2_FRAME_METADATA_GAIN_LEVEL));
+    REQUIRE(gain->supports_calls == 1);
+    REQUIRE(gain->gets == 0);
+    REQUIRE_FALSE(f.supports_frame_metadata(RS2_FRAME_METADATA_SENSOR_TIMESTAMP));
+
+    // A derived attribute decodes the attributes it depends on
+    REQUIRE(f.get_frame_metadata(RS2_FRAME_METADATA_ACTUAL_FPS) == 10000);
+    REQUIRE(f.get_frame_metadata(RS2_FRAME_METADATA_ACTUAL_FPS) == 10000);
+    REQUIRE(f.get_frame_metadata(RS2_FRAME_METADATA_ACTUAL_EXPOSURE) == 100);
+    REQUIRE(fps->gets == 1);
+    REQUIRE(exposure->gets == 1);
+
+    // A new timestamp invalidates the decoded attributes
+    f.set_timestamp(1);
+    REQUIRE(f.get_frame_metadata(RS2_FRAME_METADATA_FRAME_COUNTER) == 5);
+    REQUIRE(counter->gets == 2);
+    REQUIRE(exposure->gets == 1);
+}
+
+TEST_CASE("Frame metadata bulk query stops at the public attributes", "[frame-metadata]")
+{
+    auto counter = std::make_shared<counting_parser>(5);
+    auto hw_type = std::make_shared<counting_parser>(7);
+    auto height = std::make_shared<counting_parser>(480);
+
+    frame f;
+    f.metadata_parsers = std::make_shared<metadata_parser_map>();
+    (*f.metadata_parsers)[RS2_FRAME_METADATA_FRAME_COUNTER] = counter;
+    (*f.metadata_parsers)[rs2_frame_metadata_value(RS2_FRAME_METADATA_HW_TYPE)] = hw_type;
+    (*f.metadata_parsers)[rs2_frame_metadata_value(RS2_FRAME_METADATA_HEIGHT)] = height;
+
+    // Sized for the internal attributes too, which are not part of the public enumeration
+    const int count = librealsense::RS2_FRAME_METADATA_COUNT;
+    REQUIRE(count > ::RS2_FRAME_METADATA_COUNT);
+    std::vector<rs2_metadata_type> values(count, -1);
+
+    rs2_error* e = nullptr;
+    auto frame_ref = reinterpret_cast<const rs2_frame*>(static_cast<frame_interface*>(&f));
+    auto supported = rs2_get_frame_metadata_all(frame_ref, values.data(), count, &e);
+    REQUIRE(e == nullptr);
+    REQUIRE(supported == 1ULL << RS2_FRAME_METADATA_FRAME_COUNTER);
+    REQUIRE(values[RS2_FRAME_METADATA_FRAME_COUNTER] == 5);
+    for (int i = ::RS2_FRAME_METADATA_COUNT; i < count; i++)
+    {
+        CAPTURE(i);
+        REQUIRE(values[i] == -1);
+    }
+    REQUIRE(hw_type->supports_calls == 0);
+    REQUIRE(height->supports_calls == 0);
+
+    // The internal attributes keep going through their parsers
+    REQUIRE(f.get_frame_metadata(rs2_frame_metadata_value(RS2_FRAME_METADATA_HW_TYPE)) == 7);
+    REQUIRE(f.get_frame_metadata(rs2_frame_metadata_value(RS2_FRAME_METADATA_HEIGHT)) == 480);
+    REQUIRE(f.get_frame_metadata(rs2_frame_metadata_value(RS2_FRAME_METADATA_HEIGHT)) == 480);
+    REQUIRE(height->gets == 2);
+}
@@ -0,0 +1,71 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2019 Intel Corporation. All Rights Reserved.
+
+#include "catch/catch.hpp"
+#include <cmath>
+#include <deque>
+#include <random>
+#include "./../src/global_timestamp_reader.h"
+
+using namespace librealsense;
+
+// Least squares fit of the whole window, evaluated at x
+double fit_window(const std::deque<CSample>& window, double x)
+{
+    double n = double(window.size()), sx = 0, sy = 0, sxy = 0, sx2 = 0;
+    for (auto&& s : window)
+    {
+        sx += s._x - window.back()._x;
+        sy += s._y - window.back()._y;
+        sxy += (s._x - window.back()._x) * (s._y - window.back()._y);
+        sx2 += (s._x - window.back()._x) * (s._x - window.back()._x);
+    }
+    double a = (n * sxy - sx * sy) / (n * sx2 - sx * sx);
+    double b = (sy * sx2 - sx * sxy) / (n * sx2 - sx * sx);
+    return a * (x - window.back()._x) + b + window.back()._y;
+}
+
+TEST_CASE("Incremental clock regression matches a full fit of the window", "[global-timestamp]")
+{
+    const unsigned int buffer_size = 15;
+    const double drift = 50e-6, noise = 0.05;
+    CLinearCoefficients coefs(buffer_size);
+    std::deque<CSample> window;
+    std::mt19937 gen(7);
+    std::uniform_real_distribution<double> jitter(-noise, noise);
+
+    REQUIRE(coefs.get_stats(0).samples == 0);
+
+    // Hardware milliseconds against host epoch milliseconds, over hours of samples
+    for (int i = 0; i < 20000; i++)
+    {
+        double hw = 1000. * i + 123.4;
+        CSample sample(hw, 1.5e12 + hw * (1 + drift) + jitter(gen));
+        while (window.size() > buffer_size)
+            window.pop_back();
+        window.push_front(sample);
+        coefs.add_value(sample);
+
+        REQUIRE(coefs.is_full() == (window.size() >= buffer_size));
+        if (window.size() > 1)
+            REQUIRE(std::abs(coefs.calc_value(hw + 500) - fit_window(window, hw + 500)) < 1e-3);
+    }
+
+    auto stats = coefs.get_stats(window.front()._y + 20);
+    REQUIRE(stats.samples == buffer_size + 1);
+    REQUIRE(std::abs(stats.drift_ppm - drift * 1e6) < 5);
+    REQUIRE(stats.residual > 0);
+    REQUIRE(stats.residual < noise);
+    REQUIRE(std::abs(stats.sample_age - 20) < 1e-3);
+
+    // After a reset the last model still converts timestamps until new samples arrive
+    auto before = coefs.calc_value(1e7);
+    coefs.reset();
+    REQUIRE_FALSE(coefs.is_full());
+    REQUIRE(coefs.get_stats(0).samples == 0);
+    REQUIRE(coefs.calc_value(1e7) == before);
+
+    coefs.add_value(CSample(10, 1000));
+    REQUIRE(coefs.calc_value(15) == 1005);
+    REQUIRE(coefs.get_stats(1000).residual == 0);
+}
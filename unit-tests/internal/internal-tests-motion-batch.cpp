@@ -0,0 +1,147 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2019 Intel Corporation. All Rights Reserved.
+
+#include "catch/catch.hpp"
+#include <cstdio>
+#include <cstring>
+#include <vector>
+#include "./../src/software-device.h"
+#include "./../src/media/ros/ros_writer.h"
+#include "rosbag/view.h"
+
+using namespace librealsense;
+
+static const std::vector<rs2_motion_sample> samples = {
+    { { 1.f, 2.f, 3.f }, 10. },
+    { { 4.f, 5.f, 6.f }, 12.5 },
+    { { 7.f, 8.f, 9.f }, 15. },
+};
+
+static std::shared_ptr<motion_stream_profile> motion_profile(rs2_format format)
+{
+    auto profile = std::make_shared<motion_stream_profile>(platform::stream_profile{ 1, 1, 400, 0 });
+    profile->set_stream_type(RS2_STREAM_GYRO);
+    profile->set_format(format);
+    profile->set_framerate(400);
+    return profile;
+}
+
+TEST_CASE("Motion frames visit every sample of a batch", "[motion-batch]")
+{
+    auto bytes = reinterpret_cast<const byte*>(samples.data());
+
+    motion_frame batch;
+    batch.data = std::vector<byte>(bytes, bytes + samples.size() * sizeof(rs2_motion_sample));
+    batch.set_stream(motion_profile(RS2_FORMAT_MOTION_XYZ32F_BATCH));
+
+    // The samples are modified in place, as the motion correction does, and keep their timestamps
+    std::vector<float> visited;
+    batch.foreach_sample([&](float3& xyz)
+    {
+        visited.push_back(xyz.x);
+        xyz.y = -xyz.y;
+    });
+    REQUIRE(visited == std::vector<float>({ 1.f, 4.f, 7.f }));
+    auto corrected = reinterpret_cast<const rs2_motion_sample*>(batch.get_frame_data());
+    for (size_t i = 0; i < samples.size(); i++)
+    {
+        CAPTURE(i);
+        REQUIRE(corrected[i].data.x == samples[i].data.x);
+        REQUIRE(corrected[i].data.y == -samples[i].data.y);
+        REQUIRE(corrected[i].timestamp == samples[i].timestamp);
+    }
+
+    // A regular motion frame holds a single sample
+    motion_frame single;
+    single.data = std::vector<byte>(bytes, bytes + sizeof(float3));
+    single.set_stream(motion_profile(RS2_FORMAT_MOTION_XYZ32F));
+    visited.clear();
+    single.foreach_sample([&](float3& xyz) { visited.push_back(xyz.z); });
+    REQUIRE(visited == std::vector<float>({ 3.f }));
+}
+
+class batch_sensor : public software_sensor
+{
+public:
+    explicit batch_sensor(software_device* owner) : software_sensor("Motion Module", owner) {}
+
+    frame_holder make_batch(const std::vector<rs2_motion_sample>& batch, unsigned long long frame_number)
+    {
+        frame_additional_data data;
+        data.timestamp = batch.front().timestamp;
+        data.timestamp_domain = RS2_TIMESTAMP_DOMAIN_HARDWARE_CLOCK;
+        data.frame_number = frame_number;
+
+        auto size = batch.size() * sizeof(rs2_motion_sample);
+        frame_holder f = _source.alloc_frame(RS2_EXTENSION_MOTION_FRAME, size, data, true);
+        REQUIRE(f);
+        std::memcpy(static_cast<motion_frame*>(f.frame)->data.data(), batch.data(), size);
+        f->set_stream(get_stream_profiles().front());
+        return f;
+    }
+};
+
+class batch_device : public software_device
+{
+public:
+    batch_sensor& add_batch_sensor()
+    {
+        auto sensor = std::make_shared<batch_sensor>(this);
+        add_sensor(sensor);
+        return *sensor;
+    }
+};
+
+TEST_CASE("Recorder writes batched motion samples one by one", "[motion-batch][record]")
+{
+    const std::string file = "motion_batch.bag";
+    const unsigned long long frame_number = 40;
+
+    auto dev = std::make_shared<batch_device>();
+    auto& sensor = dev->add_batch_sensor();
+    sensor.add_motion_stream({ RS2_STREAM_GYRO, 0, 0, 400, RS2_FORMAT_MOTION_XYZ32F_BATCH, {} });
+
+    // The frames are allocated by the sensor once it streams, and handed to the writer directly
+    sensor.open(sensor.get_stream_profiles());
+    sensor.start(frame_callback_ptr(new internal_frame_callback<void(*)(frame_interface*)>([](frame_interface*) {}),
+        [](rs2_frame_callback* p) { p->release(); }));
+
+    device_serializer::stream_identifier stream_id{ 0, 0, RS2_STREAM_GYRO, 0 };
+    const device_serializer::nanoseconds timestamp(1000000000);
+    {
+        ros_writer writer(file, rs2_recorder_config{});
+        writer.write_frame(stream_id, timestamp, sensor.make_batch(samples, frame_number));
+    }
+    sensor.stop();
+    sensor.close();
+
+    rosbag::Bag bag;
+    bag.open(file, rosbag::BagMode::Read);
+    rosbag::View view(bag, rosbag::TopicQuery(ros_topic::frame_data_topic(stream_id)));
+    std::vector<sensor_msgs::Imu> messages;
+    std::vector<device_serializer::nanoseconds> times;
+    for (auto&& m : view)
+    {
+        auto imu = m.instantiate<sensor_msgs::Imu>();
+        REQUIRE(imu);
+        messages.push_back(*imu);
+        times.push_back(device_serializer::nanoseconds(m.getTime().toNSec()));
+    }
+    bag.close();
+    std::remove(file.c_str());
+
+    // Each sample keeps its values and timestamp, the file times are offset by the sample timestamps
+    REQUIRE(messages.size() == samples.size());
+    for (size_t i = 0; i < samples.size(); i++)
+    {
+        CAPTURE(i);
+        REQUIRE(messages[i].header.seq == frame_number + i);
+        REQUIRE(messages[i].header.stamp.toSec() * 1000 == Approx(samples[i].timestamp));
+        REQUIRE(messages[i].angular_velocity.x == samples[i].data.x);
+        REQUIRE(messages[i].angular_velocity.y == samples[i].data.y);
+        REQUIRE(messages[i].angular_velocity.z == samples[i].data.z);
+        auto offset = std::chrono::duration_cast<device_serializer::nanoseconds>(
+            std::chrono::duration<double, std::milli>(samples[i].timestamp - samples[0].timestamp));
+        REQUIRE(times[i] == timestamp + offset);
+    }
+}
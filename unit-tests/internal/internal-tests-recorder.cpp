@@ -0,0 +1,143 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2019 Intel Corporation. All Rights Reserved.
+
+#include "catch/catch.hpp"
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <librealsense2/rs.hpp>
+#include <librealsense2/hpp/rs_internal.hpp>
+#include "./../src/api.h"
+#include "./../src/media/record/record_device.h"
+
+using namespace librealsense;
+
+// Holds the frames on the writing thread until opened, like a slow disk would
+class gated_writer : public device_serializer::writer
+{
+public:
+    void write_device_description(const device_serializer::device_snapshot&) override {}
+    void write_frame(const device_serializer::stream_identifier&, const device_serializer::nanoseconds&, frame_holder&& frame) override
+    {
+        std::unique_lock<std::mutex> lock(_mutex);
+        _opened.wait(lock, [&]() { return _open; });
+        _frames.push_back(frame.frame->get_frame_number());
+    }
+    void write_snapshot(uint32_t, const device_serializer::nanoseconds&, rs2_extension, const std::shared_ptr<extension_snapshot>&) override {}
+    void write_snapshot(const device_serializer::sensor_identifier&, const device_serializer::nanoseconds&, rs2_extension, const std::shared_ptr<extension_snapshot>&) override {}
+    void write_notification(const device_serializer::sensor_identifier&, const device_serializer::nanoseconds&, const notification&) override {}
+    const std::string& get_file_name() const override { return _file_name; }
+    void get_statistics(rs2_recorder_statistics&) const override {}
+
+    void open()
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _open = true;
+        _opened.notify_all();
+    }
+
+    std::vector<unsigned long long> get_frames() const
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _frames;
+    }
+
+private:
+    mutable std::mutex _mutex;
+    std::condition_variable _opened;
+    bool _open = false;
+    std::vector<unsigned long long> _frames;
+    std::string _file_name = "gated";
+};
+
+TEST_CASE("Recorder overflow policies", "[record]")
+{
+    const int W = 64;
+    const int H = 48;
+    const int BPP = 2;
+    const int frames_count = 5;
+
+    rs2_intrinsics intrinsics{ W, H, 0, 0, 0, 0, RS2_DISTORTION_NONE ,{ 0,0,0,0,0 } };
+    rs2::software_device dev;
+    auto sensor = dev.add_sensor("depth");
+    auto depth = sensor.add_video_stream({ RS2_STREAM_DEPTH, 0, 0, W, H, 30, BPP, RS2_FORMAT_Z16, intrinsics });
+
+    std::vector<uint8_t> pixels(W * H * BPP, 0);
+    auto inject = [&](int i)
+    {
+        sensor.on_video_frame({ pixels.data(), [](void*) {}, W * BPP, BPP, i * 10., RS2_TIMESTAMP_DOMAIN_HARDWARE_CLOCK, i, depth });
+    };
+
+    // The cap fits a single frame: while the writer is held, the frames after the first overflow
+    auto writer = std::make_shared<gated_writer>();
+    rs2_recorder_config config = { 0, 0, static_cast<unsigned long long>(pixels.size()), RS2_RECORDER_OVERFLOW_POLICY_DROP_FRAMES };
+
+    SECTION("Dropping policy records what fits and counts the rest")
+    {
+        auto recorder = std::make_shared<record_device>(dev.get()->device, writer, config);
+        sensor.open(depth);
+        sensor.start([](rs2::frame) {});
+        for (auto i = 0; i < frames_count; i++)
+            inject(i);
+
+        rs2_recorder_statistics stats;
+        recorder->get_statistics(stats);
+        REQUIRE(stats.pending_frames == 1);
+        REQUIRE(stats.pending_bytes == pixels.size());
+        REQUIRE(stats.dropped_frames == frames_count - 1);
+
+        writer->open();
+        recorder->pause_recording();
+        recorder->get_statistics(stats);
+        REQUIRE(stats.pending_frames == 0);
+        REQUIRE(stats.pending_bytes == 0);
+        REQUIRE(stats.dropped_frames == frames_count - 1);
+        REQUIRE(writer->get_frames() == std::vector<unsigned long long>({ 0 }));
+    }
+
+    SECTION("Blocking policy holds the producer until the frames are written")
+    {
+        config.overflow_policy = RS2_RECORDER_OVERFLOW_POLICY_BLOCK;
+        auto recorder = std::make_shared<record_device>(dev.get()->device, writer, config);
+        sensor.open(depth);
+        sensor.start([](rs2::frame) {});
+
+        std::mutex mutex;
+        std::condition_variable cv;
+        bool injected = false;
+        std::thread producer([&]()
+        {
+            for (auto i = 0; i < frames_count; i++)
+                inject(i);
+            std::lock_guard<std::mutex> lock(mutex);
+            injected = true;
+            cv.notify_all();
+        });
+
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            REQUIRE_FALSE(cv.wait_for(lock, std::chrono::milliseconds(200), [&]() { return injected; }));
+        }
+        rs2_recorder_statistics stats;
+        recorder->get_statistics(stats);
+        REQUIRE(stats.pending_frames == 1);
+        REQUIRE(stats.dropped_frames == 0);
+
+        writer->open();
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            REQUIRE(cv.wait_for(lock, std::chrono::seconds(5), [&]() { return injected; }));
+        }
+        producer.join();
+
+        recorder->pause_recording();
+        recorder->get_statistics(stats);
+        REQUIRE(stats.pending_frames == 0);
+        REQUIRE(stats.dropped_frames == 0);
+        REQUIRE(writer->get_frames() == std::vector<unsigned long long>({ 0, 1, 2, 3, 4 }));
+    }
+
+    sensor.stop();
+    sensor.close();
+}
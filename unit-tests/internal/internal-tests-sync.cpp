@@ -0,0 +1,134 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2019 Intel Corporation. All Rights Reserved.
+
+#include "catch/catch.hpp"
+#include <vector>
+#include <librealsense2/rs.hpp>
+#include <librealsense2/hpp/rs_internal.hpp>
+#include "./../src/proc/synthetic-stream.h"
+#include "./../src/proc/syncer-processing-block.h"
+#include "./../src/sync.h"
+
+using namespace librealsense;
+
+static sync_ring::entry make_entry(double value)
+{
+    sync_ring::entry e;
+    e.key.value = value;
+    return e;
+}
+
+static std::vector<double> drain(sync_ring& ring)
+{
+    std::vector<double> values;
+    while (!ring.empty())
+        values.push_back(ring.pop().key.value);
+    return values;
+}
+
+TEST_CASE("Sync ring drops its oldest frame when full", "[sync]")
+{
+    sync_ring ring(3);
+    for (auto i = 0; i < 3; i++)
+        REQUIRE_FALSE(ring.push(make_entry(i), false));
+
+    REQUIRE(ring.push(make_entry(3), false));
+    REQUIRE(ring.size() == 3);
+    REQUIRE(ring.front().key.value == 1);
+    REQUIRE(drain(ring) == std::vector<double>({ 1, 2, 3 }));
+    REQUIRE(ring.clear() == 0);
+}
+
+TEST_CASE("Sync ring grows for blocking frames", "[sync]")
+{
+    sync_ring ring(3);
+    REQUIRE_FALSE(ring.push(make_entry(0), false));
+    REQUIRE_FALSE(ring.push(make_entry(1), false));
+    REQUIRE(ring.pop().key.value == 0);
+
+    // Wrap around before filling up, growing must keep the queued frames in order
+    for (auto i = 2; i <= 3; i++)
+        REQUIRE_FALSE(ring.push(make_entry(i), false));
+    for (auto i = 4; i <= 9; i++)
+        REQUIRE_FALSE(ring.push(make_entry(i), true));
+    REQUIRE(ring.size() == 9);
+    REQUIRE(ring.front().key.value == 1);
+
+    // The grown ring drops again once full, unless asked to grow
+    for (auto i = 10; i <= 12; i++)
+        REQUIRE_FALSE(ring.push(make_entry(i), false));
+    REQUIRE(ring.push(make_entry(13), false));
+    REQUIRE(ring.size() == 12);
+
+    REQUIRE(drain(ring) == std::vector<double>({ 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13 }));
+}
+
+TEST_CASE("Syncer telemetry with software-device devices", "[sync][software-device]")
+{
+    const int W = 640;
+    const int H = 480;
+    const int BPP = 2;
+    const int frames = 20;
+    const double frame_time = 1000. / 30;
+    const double skew = 5;
+
+    rs2_intrinsics intrinsics{ W, H, 0, 0, 0, 0, RS2_DISTORTION_NONE ,{ 0,0,0,0,0 } };
+    rs2::software_device depth_dev, ir_dev;
+    auto depth_sensor = depth_dev.add_sensor("depth");
+    auto ir_sensor = ir_dev.add_sensor("ir");
+    auto depth = depth_sensor.add_video_stream({ RS2_STREAM_DEPTH, 0, 0, W, H, 30, BPP, RS2_FORMAT_Z16, intrinsics });
+    auto ir = ir_sensor.add_video_stream({ RS2_STREAM_INFRARED, 1, 1, W, H, 30, BPP, RS2_FORMAT_Y8, intrinsics });
+
+    // The syncer block is used directly to read the telemetry of its matcher
+    auto unit = std::make_shared<syncer_process_unit>();
+    rs2::processing_block sync(std::shared_ptr<rs2_processing_block>(new rs2_processing_block{ unit },
+        [](rs2_processing_block* block) { delete block; }));
+    rs2::frame_queue q(10);
+    sync.start(q);
+
+    depth_sensor.open(depth);
+    ir_sensor.open(ir);
+    depth_sensor.start([&](rs2::frame f) { sync.invoke(f); });
+    ir_sensor.start([&](rs2::frame f) { sync.invoke(f); });
+
+    std::vector<uint8_t> pixels(W * H * BPP, 0);
+    auto inject = [&](int i)
+    {
+        depth_sensor.on_video_frame({ pixels.data(), [](void*) {}, W * BPP, BPP, i * frame_time, RS2_TIMESTAMP_DOMAIN_HARDWARE_CLOCK, i, depth });
+        ir_sensor.on_video_frame({ pixels.data(), [](void*) {}, W * BPP, BPP, i * frame_time + skew, RS2_TIMESTAMP_DOMAIN_HARDWARE_CLOCK, i, ir });
+    };
+
+    // The first frame of each device is passed alone, the other device was not seen yet
+    inject(0);
+    for (auto i = 0; i < 2; i++)
+    {
+        rs2::frameset fs;
+        REQUIRE_NOTHROW(fs = q.wait_for_frame(5000));
+        REQUIRE(fs.size() == 1);
+    }
+
+    for (auto i = 1; i <= frames; i++)
+    {
+        inject(i);
+        rs2::frameset fs;
+        REQUIRE_NOTHROW(fs = q.wait_for_frame(5000));
+        CAPTURE(i);
+        REQUIRE(fs.size() == 2);
+        REQUIRE(fs.get_depth_frame().get_frame_number() == i);
+    }
+
+    auto& telemetry = unit->get_telemetry();
+    REQUIRE(telemetry.get_matches() == frames + 2);
+    REQUIRE(telemetry.get_matched_frames() == 2 * frames + 2);
+    REQUIRE(telemetry.get_match_latency().get_count() == frames + 2);
+    for (auto reason = 0; reason < static_cast<int>(sync_drop_reason::count); reason++)
+        REQUIRE(telemetry.get_drops(static_cast<sync_drop_reason>(reason)) == 0);
+
+    // 5ms of skew fall in the [4096, 8192) microseconds bucket
+    auto skew_counts = telemetry.get_skew().get_counts();
+    REQUIRE(skew_counts[0] == 2);
+    REQUIRE(skew_counts[13] == frames);
+
+    depth_sensor.stop();
+    ir_sensor.stop();
+}
@@ -0,0 +1,93 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2019 Intel Corporation. All Rights Reserved.
+
+#include "catch/catch.hpp"
+#include <cstring>
+#include <vector>
+#include <librealsense2/rs.hpp>
+#include <librealsense2/hpp/rs_internal.hpp>
+#include "./../src/cpu-features.h"
+
+using namespace librealsense;
+
+TEST_CASE("Temporal filter SIMD kernels match the scalar reference", "[temporal-filter]")
+{
+    // Odd width leaves a scalar tail after the vectorized pixels of every row chunk
+    const int width = 333, height = 40, depth_bpp = 2, frames = 12;
+
+    rs2::software_device dev;
+    auto depth_sensor = dev.add_sensor("Depth");
+    rs2_intrinsics depth_intrinsics = { width, height, width / 2.f, height / 2.f, 420.f, 420.f, RS2_DISTORTION_BROWN_CONRADY, { 0,0,0,0,0 } };
+    auto depth_stream_profile = depth_sensor.add_video_stream({ RS2_STREAM_DEPTH, 0, 0, width, height, 30, depth_bpp, RS2_FORMAT_Z16, depth_intrinsics });
+    depth_sensor.add_read_only_option(RS2_OPTION_DEPTH_UNITS, 0.001f);
+    depth_sensor.add_read_only_option(RS2_OPTION_STEREO_BASELINE, 50.f);
+
+    rs2::frame_queue q(frames);
+    depth_sensor.open(depth_stream_profile);
+    depth_sensor.start(q);
+
+    // Noisy depth with flickering holes, so that smoothing, edge preservation and persistence all take part
+    std::vector<std::vector<uint16_t>> sequence(frames, std::vector<uint16_t>(width * height));
+    std::vector<rs2::frame> inputs;
+    for (int i = 0; i < frames; i++)
+    {
+        for (int p = 0; p < width * height; p++)
+            sequence[i][p] = ((p * 31 + i * 17) % 11 == 0) ? 0 : uint16_t(1500 + (p % width) / 10 * 40 + (p * 7 + i * 13) % 29);
+        depth_sensor.on_video_frame({ sequence[i].data(), [](void*) {}, width * depth_bpp, depth_bpp, double(i), RS2_TIMESTAMP_DOMAIN_SYSTEM_TIME, i + 1, depth_stream_profile });
+        auto f = q.wait_for_frame();
+        REQUIRE(f);
+        f.keep();
+        inputs.push_back(f);
+    }
+
+    rs2::disparity_transform to_disparity(true);
+    std::vector<rs2::frame> disparity_inputs;
+    for (auto&& input : inputs)
+    {
+        auto f = to_disparity.process(input);
+        f.keep();
+        disparity_inputs.push_back(f);
+    }
+
+    // Filters the whole sequence with a fresh filter, so that every ISA starts from the same history
+    auto filter_sequence = [&](simd_level isa, float persistence, const std::vector<rs2::frame>& sequence_inputs)
+    {
+        set_simd_level(isa);
+        rs2::temporal_filter temporal;
+        temporal.set_option(RS2_OPTION_HOLES_FILL, persistence);
+        std::vector<std::vector<uint8_t>> outputs;
+        for (auto&& input : sequence_inputs)
+        {
+            auto filtered = temporal.process(input).as<rs2::video_frame>();
+            auto data = static_cast<const uint8_t*>(filtered.get_data());
+            outputs.emplace_back(data, data + filtered.get_stride_in_bytes() * filtered.get_height());
+        }
+        return outputs;
+    };
+
+    auto max_isa = get_max_simd_level();
+    for (auto disparity : { false, true })
+    {
+        for (auto persistence : { 0.f, 3.f, 8.f })
+        {
+            CAPTURE(disparity);
+            CAPTURE(persistence);
+            auto& sequence_inputs = disparity ? disparity_inputs : inputs;
+            auto reference = filter_sequence(simd_level::scalar, persistence, sequence_inputs);
+            for (auto isa = int(simd_level::ssse3); isa <= int(max_isa); isa++)
+            {
+                CAPTURE(isa);
+                auto outputs = filter_sequence(simd_level(isa), persistence, sequence_inputs);
+                for (int i = 0; i < frames; i++)
+                {
+                    CAPTURE(i);
+                    REQUIRE(outputs[i] == reference[i]);
+                }
+            }
+        }
+    }
+    set_simd_level(max_isa);
+
+    depth_sensor.stop();
+    depth_sensor.close();
+}
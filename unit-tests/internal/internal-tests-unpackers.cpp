@@ -0,0 +1,120 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2019 Intel Corporation. All Rights Reserved.
+
+#include "catch/catch.hpp"
+#include <iostream>
+#include <chrono>
+#include <random>
+#include <algorithm>
+#include "image.h"
+#include "cpu-features.h"
+
+using namespace librealsense;
+
+struct unpacker_case
+{
+    const char* name;
+    const native_pixel_format& pf;
+    size_t index;       // which of the format's unpackers
+    bool scalar_ref;    // false for the YUV conversions, whose SIMD arithmetic differs from the generic code
+};
+
+static const std::vector<unpacker_case>& unpacker_cases()
+{
+    static const std::vector<unpacker_case> cases = {
+        { "Y8I -> Y8 + Y8",          pf_y8i,         0, true },
+        { "Y12I -> Y16 + Y16",       pf_y12i,        0, true },
+        { "SR300 INZI -> Z16 + Y8",  pf_sr300_inzi,  0, true },
+        { "BGR -> RGB8",             pf_rgb888,      0, true },
+        { "Y16 (10 bit) -> Y16",     pf_y16,         0, true },
+        { "L500 Z16 rotation",       pf_z16_l500,    0, true },
+        { "L500 Y8 rotation",        pf_y8_l500,     0, true },
+        { "UYVY -> RGB8",            pf_uyvyc,       0, false },
+        { "UYVY -> BGRA8",           pf_uyvyc,       3, false },
+    };
+    return cases;
+}
+
+static std::vector<std::vector<byte>> run_unpacker(const unpacker_case& c, simd_level isa, int width, int height, const std::vector<byte>& input)
+{
+    auto&& unpacker = c.pf.unpackers[c.index];
+    std::vector<std::vector<byte>> outputs;
+    std::vector<byte*> dest;
+    for (auto&& output : unpacker.outputs)
+    {
+        auto res = output.stream_resolution({ uint32_t(width), uint32_t(height) });
+        outputs.emplace_back(get_image_size(res.width, res.height, output.format), 0);
+    }
+    for (auto&& output : outputs)
+        dest.push_back(output.data());
+
+    set_simd_level(isa);
+    unpacker.unpack(dest.data(), input.data(), width, height, int(input.size()));
+    return outputs;
+}
+
+static std::vector<byte> random_frame(const native_pixel_format& pf, int width, int height)
+{
+    std::mt19937 gen(width * 7919 + height);
+    std::uniform_int_distribution<int> dist(0, 255);
+    // Sized generously, since RGB2 declares 2 bytes per pixel for its 3 byte pixels
+    std::vector<byte> input(std::max(pf.get_image_size(width, height), size_t(width * height * 4)));
+    for (auto&& b : input) b = byte(dist(gen));
+    return input;
+}
+
+TEST_CASE("Vectorized unpackers match their reference", "[unpackers]")
+{
+    auto max_isa = get_max_simd_level();
+
+    // Odd sizes leave tails that do not fill a register, the multiple-of-16 ones are the only valid UYVY and L500 frames
+    std::vector<std::pair<int, int>> sizes = { { 64, 48 }, { 40, 6 }, { 1280, 720 }, { 101, 7 } };
+    for (auto&& c : unpacker_cases())
+    {
+        for (auto&& size : sizes)
+        {
+            auto width = size.first, height = size.second;
+            if (!c.scalar_ref && (width * height) % 16) continue;
+
+            CAPTURE(c.name);
+            CAPTURE(width);
+            CAPTURE(height);
+            auto input = random_frame(c.pf, width, height);
+            auto reference_isa = c.scalar_ref ? simd_level::scalar : simd_level::ssse3;
+            if (reference_isa > max_isa) continue;
+
+            auto reference = run_unpacker(c, reference_isa, width, height, input);
+            for (auto isa = int(reference_isa) + 1; isa <= int(max_isa); isa++)
+                REQUIRE(run_unpacker(c, simd_level(isa), width, height, input) == reference);
+        }
+    }
+    set_simd_level(max_isa);
+
+    REQUIRE_THROWS(set_simd_level(simd_level(int(max_isa) + 1)));
+}
+
+// Per-kernel throughput at every supported instruction set.
+// Hidden by default, run explicitly with "[benchmark]"
+TEST_CASE("Unpackers throughput benchmark", "[unpackers][benchmark][!hide]")
+{
+    const int width = 1280, height = 720, iterations = 200;
+    const char* isa_names[] = { "scalar", "ssse3", "avx2" };
+    auto max_isa = get_max_simd_level();
+
+    for (auto&& c : unpacker_cases())
+    {
+        auto input = random_frame(c.pf, width, height);
+        std::cout << c.name << ":";
+        for (auto isa = 0; isa <= int(max_isa); isa++)
+        {
+            run_unpacker(c, simd_level(isa), width, height, input); // warm-up
+            auto start = std::chrono::high_resolution_clock::now();
+            for (int i = 0; i < iterations; i++)
+                run_unpacker(c, simd_level(isa), width, height, input);
+            auto sec = std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - start).count();
+            std::cout << " " << isa_names[isa] << " " << int(input.size() * iterations / sec / 1e6) << " MB/s";
+        }
+        std::cout << std::endl;
+    }
+    set_simd_level(max_isa);
+}
@@ -0,0 +1,100 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2019 Intel Corporation. All Rights Reserved.
+
+#ifdef RS2_USE_V4L2_BACKEND
+
+#include "catch/catch.hpp"
+#include <cstdlib>
+#include <functional>
+#include <memory>
+#include <vector>
+#include "./../src/linux/backend-v4l2.h"
+
+using namespace librealsense::platform;
+
+struct published_frame
+{
+    const void* pixels;
+    std::vector<uint8_t> content;
+    std::function<void()> continuation;
+};
+
+TEST_CASE("V4L2 buffers are held by their frames until the pool runs dry", "[v4l2-buffers]")
+{
+    const uint32_t length = 64;
+    std::vector<std::shared_ptr<buffer>> pool;
+    for (uint32_t i = 0; i < 3; i++)
+        pool.push_back(std::make_shared<buffer>(V4L2_BUF_TYPE_VIDEO_CAPTURE, length, i));
+
+    std::vector<published_frame> frames;
+    frame_callback callback = [&](stream_profile, frame_object fo, std::function<void()> continuation)
+    {
+        auto pixels = static_cast<const uint8_t*>(fo.pixels);
+        frames.push_back({ fo.pixels, std::vector<uint8_t>(pixels, pixels + fo.frame_size), continuation });
+    };
+
+    std::vector<int> requeued(pool.size(), 0);
+    auto publish = [&](uint32_t index)
+    {
+        auto& buf = *pool[index];
+        std::fill(buf.get_frame_start(), buf.get_frame_start() + length, static_cast<uint8_t>(index + 1));
+
+        v4l2_buffer v4l_buf = {};
+        v4l_buf.index = index;
+        frame_object fo{ length, 0, buf.get_frame_start(), nullptr, 0 };
+        publish_buffer(pool, buf, v4l_buf, stream_profile{}, fo, callback, [&, index]()
+        {
+            requeued[index]++;
+            // Not a video node: the QBUF fails, the buffer is released all the same
+            pool[index]->request_next_frame(-1);
+        });
+    };
+
+    // While other buffers remain queued to the driver, frames reference the kernel buffers
+    publish(0);
+    publish(1);
+    REQUIRE(frames.size() == 2);
+    REQUIRE(frames[0].pixels == pool[0]->get_frame_start());
+    REQUIRE(frames[1].pixels == pool[1]->get_frame_start());
+    REQUIRE(pool[0]->is_held());
+    REQUIRE(pool[1]->is_held());
+    REQUIRE(requeued == std::vector<int>({ 0, 0, 0 }));
+
+    // Handing out the last buffer would starve the driver: the payload is copied and the buffer queued back at once
+    publish(2);
+    REQUIRE(frames.size() == 3);
+    REQUIRE(frames[2].pixels != pool[2]->get_frame_start());
+    REQUIRE(frames[2].content == std::vector<uint8_t>(length, 3));
+    REQUIRE_FALSE(pool[2]->is_held());
+    REQUIRE(requeued == std::vector<int>({ 0, 0, 1 }));
+
+    // Releasing the held frames queues their buffers back
+    frames[0].continuation();
+    REQUIRE_FALSE(pool[0]->is_held());
+    REQUIRE(requeued == std::vector<int>({ 1, 0, 1 }));
+
+    frames[1].continuation();
+    REQUIRE_FALSE(pool[1]->is_held());
+    REQUIRE(requeued == std::vector<int>({ 1, 1, 1 }));
+
+    // With the pool replenished, frames reference the kernel buffers again
+    publish(0);
+    REQUIRE(frames.back().pixels == pool[0]->get_frame_start());
+    REQUIRE(pool[0]->is_held());
+}
+
+TEST_CASE("V4L2 zero-copy capture is opted in through the environment", "[v4l2-buffers]")
+{
+    unsetenv("LRS_V4L_ZERO_COPY");
+    REQUIRE_FALSE(zero_copy_requested());
+
+    setenv("LRS_V4L_ZERO_COPY", "0", 1);
+    REQUIRE_FALSE(zero_copy_requested());
+
+    setenv("LRS_V4L_ZERO_COPY", "1", 1);
+    REQUIRE(zero_copy_requested());
+
+    unsetenv("LRS_V4L_ZERO_COPY");
+}
+
+#endif
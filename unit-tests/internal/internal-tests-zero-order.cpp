@@ -0,0 +1,121 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2019 Intel Corporation. All Rights Reserved.
+
+#include "catch/catch.hpp"
+#include <cmath>
+#include <vector>
+#include <librealsense2/rsutil.h>
+#include "./../src/cpu-features.h"
+#include "./../src/proc/zero-order.h"
+
+using namespace librealsense;
+
+TEST_CASE("Zero order detection matches the double precision reference around the thresholds", "[zero-order]")
+{
+    // The pixel count is not a multiple of the 8 pixels of a vector step, the last ones go through the scalar tail
+    const int width = 333, height = 41;
+    const size_t count = width * height;
+    const rs2_intrinsics intrinsics = { width, height, width / 2.f, height / 2.f, 420.f, 420.f, RS2_DISTORTION_NONE, { 0,0,0,0,0 } };
+
+    std::vector<float> ray_norm(count), ray_x(count);
+    for (int y = 0; y < height; ++y)
+    {
+        for (int x = 0; x < width; ++x)
+        {
+            const float pixel[] = { (float)x, (float)y };
+            float ray[3];
+            rs2_deproject_pixel_to_point(ray, &intrinsics, pixel, 1.f);
+            ray_norm[y * width + x] = std::sqrt(ray[0] * ray[0] + ray[1] * ray[1] + ray[2] * ray[2]);
+            ray_x[y * width + x] = ray[0];
+        }
+    }
+
+    // Depth steps of 50um sweep the round trip distances across both thresholds in steps of about 0.1mm
+    std::vector<uint16_t> depth(count);
+    std::vector<uint8_t> ir(count), confidence(count);
+    for (size_t i = 0; i < count; i++)
+    {
+        depth[i] = (i % 17 == 0) ? 0 : uint16_t(19000 + (i * 7) % 2000);
+        ir[i] = uint8_t((i * 13) % 256);
+        confidence[i] = uint8_t(1 + i % 255);
+    }
+
+    zero_order_options options;
+    const float zo_value = 2000.37f;
+    const uint8_t iro_value = 100;
+    const float depth_units_mm = 0.05f;
+    const float baseline = -10.f;
+
+    auto detect = [&](simd_level isa, std::vector<uint16_t>& depth_out, std::vector<uint8_t>& confidence_out)
+    {
+        depth_out.assign(count, 0xffff);
+        confidence_out.assign(count, 0xff);
+
+        zero_order_detection d = {};
+        d.depth_in = depth.data();
+        d.ir = ir.data();
+        d.confidence_in = confidence.data();
+        d.depth_out = depth_out.data();
+        d.confidence_out = confidence_out.data();
+        d.ray_norm = ray_norm.data();
+        d.ray_x = ray_x.data();
+        d.depth_units_mm = depth_units_mm;
+        d.baseline = baseline;
+
+        set_simd_level(isa);
+        detect_zero_order(d, count, options, zo_value, iro_value);
+    };
+
+    std::vector<uint16_t> scalar_depth;
+    std::vector<uint8_t> scalar_confidence;
+    auto max_isa = get_max_simd_level();
+    detect(simd_level::scalar, scalar_depth, scalar_confidence);
+    for (auto isa = int(simd_level::ssse3); isa <= int(max_isa); isa++)
+    {
+        CAPTURE(isa);
+        std::vector<uint16_t> simd_depth;
+        std::vector<uint8_t> simd_confidence;
+        detect(simd_level(isa), simd_depth, simd_confidence);
+        REQUIRE(simd_depth == scalar_depth);
+        REQUIRE(simd_confidence == scalar_confidence);
+    }
+    set_simd_level(max_isa);
+
+    // The classification computed in double precision, with the thresholds of the former implementation
+    const int ir_dynamic_range = 256;
+    auto r = std::exp((ir_dynamic_range / 2.0 + options.threshold_offset - iro_value) / (double)options.threshold_scale);
+    auto ir_threshold = (double)options.ir_threshold / (1 + r);
+    double rtd_low = zo_value - options.rtd_low_threshold;
+    double rtd_high = zo_value + options.rtd_high_threshold;
+
+    // Float rounding of the distances stays far below this margin, pixels closer to a threshold may go either way
+    const double margin = 1e-3;
+    int near_low = 0, near_high = 0, ambiguous = 0, invalidated = 0;
+    for (size_t i = 0; i < count; i++)
+    {
+        double z = depth[i] * (double)depth_units_mm;
+        double distance = z * ray_norm[i];
+        double to_receiver = distance * distance - 2 * (double)baseline * z * ray_x[i] + (double)baseline * baseline;
+        double rtd = z ? distance + std::sqrt(std::max(to_receiver, 0.)) : 0;
+
+        if (std::abs(rtd - rtd_low) < 0.5) near_low++;
+        if (std::abs(rtd - rtd_high) < 0.5) near_high++;
+        if (std::abs(rtd - rtd_low) < margin || std::abs(rtd - rtd_high) < margin)
+        {
+            ambiguous++;
+            continue;
+        }
+
+        auto zero = depth[i] > 0 && ir[i] < ir_threshold && rtd > rtd_low && rtd < rtd_high;
+        if (zero) invalidated++;
+        CAPTURE(i);
+        REQUIRE(scalar_depth[i] == (zero ? 0 : depth[i]));
+        REQUIRE(scalar_confidence[i] == (zero ? 0 : confidence[i]));
+    }
+
+    // The sweep does cross the thresholds, and the invalidation takes place
+    REQUIRE(near_low > 0);
+    REQUIRE(near_high > 0);
+    REQUIRE(invalidated > 0);
+    REQUIRE(ambiguous < 10);
+}
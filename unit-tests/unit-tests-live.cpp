@@ -1261,6 +1261,58 @@ TEST_CASE("Motion profiles sanity", "[live]")
     }
 }
 
+TEST_CASE("Motion batch streaming", "[live]")
+{
+    rs2::context ctx;
+    if (make_context(SECTION_FROM_TEST_NAME, &ctx))
+    {
+        std::vector<sensor> list;
+        REQUIRE_NOTHROW(list = ctx.query_all_sensors());
+        REQUIRE(list.size() > 0);
+
+        for (auto&& s : list)
+        {
+            std::vector<rs2::stream_profile> batch_profiles;
+            for (auto&& profile : s.get_stream_profiles())
+                if (profile.format() == RS2_FORMAT_MOTION_XYZ32F_BATCH)
+                    batch_profiles.push_back(profile);
+
+            if (batch_profiles.empty())
+                continue;
+
+            auto profile = batch_profiles.front();
+            CAPTURE(profile.stream_type());
+
+            std::mutex m;
+            size_t frames = 0, samples = 0;
+            bool ordered = true;
+            REQUIRE_NOTHROW(s.open(profile));
+            REQUIRE_NOTHROW(s.start([&](rs2::frame f)
+            {
+                auto motion = f.as<rs2::motion_frame>();
+                std::lock_guard<std::mutex> lock(m);
+                ++frames;
+                samples += motion.get_samples_count();
+                // The frame takes the timestamp of its first sample, the following samples never go back in time
+                ordered &= motion.get_sample(0).timestamp == motion.get_timestamp();
+                for (size_t i = 1; i < motion.get_samples_count(); i++)
+                    ordered &= motion.get_sample(i).timestamp >= motion.get_sample(i - 1).timestamp;
+            }));
+
+            std::this_thread::sleep_for(std::chrono::seconds(1));
+            REQUIRE_NOTHROW(s.stop());
+            REQUIRE_NOTHROW(s.close());
+
+            std::lock_guard<std::mutex> lock(m);
+            CAPTURE(frames);
+            CAPTURE(samples);
+            REQUIRE(frames > 0);
+            REQUIRE(samples >= frames);
+            REQUIRE(ordered);
+        }
+    }
+}
+
 TEST_CASE("Check width and height of stream intrinsics", "[live][AdvMd]")
 {
     rs2::context ctx;
@@ -4984,6 +5036,110 @@ TEST_CASE("Syncer try wait for frames", "[live][software-device]") {
     }
 }
 
+TEST_CASE("Multi-device syncer matches software-device devices by global time", "[software-device]")
+{
+    const int W = 16, H = 8, BPP = 2;
+    const int devices = 3;
+    const int frames = 20;
+    const double frame_time = 1000. / 30;
+    const double jitter[devices] = { 0, 3, -2 };
+
+    // Returns the frame numbers of the framesets, given which frames each device delivers
+    // and the number of frames after which their timestamps start over
+    auto run = [&](bool drop_incomplete, std::function<bool(int, int)> delivers, int period)
+    {
+        rs2_intrinsics intrinsics{ W, H, 0, 0, 0, 0, RS2_DISTORTION_NONE ,{ 0,0,0,0,0 } };
+        std::vector<software_device> devs(devices);
+        std::vector<software_sensor> sensors;
+        std::vector<stream_profile> profiles;
+        for (auto d = 0; d < devices; d++)
+        {
+            sensors.push_back(devs[d].add_sensor("depth"));
+            profiles.push_back(sensors.back().add_video_stream({ RS2_STREAM_DEPTH, 0, d, W, H, 30, BPP, RS2_FORMAT_Z16, intrinsics }));
+        }
+
+        multi_device_syncer sync(0.f, 100.f, drop_incomplete);
+        frame_queue q(frames * devices);
+        sync.start(q);
+        for (auto d = 0; d < devices; d++)
+        {
+            sensors[d].open(profiles[d]);
+            sensors[d].start([&](frame f) { sync.invoke(f); });
+        }
+
+        // The framesets are read as they come, a software sensor holds a limited number of frames in flight
+        std::vector<std::vector<unsigned long long>> results;
+        std::vector<uint8_t> pixels(W * H * BPP, 0);
+        for (auto i = 0; i < frames; i++)
+        {
+            for (auto d = 0; d < devices; d++)
+            {
+                if (delivers(d, i))
+                    sensors[d].on_video_frame({ pixels.data(), [](void*) {}, W * BPP, BPP, (i % period) * frame_time + jitter[d],
+                                                RS2_TIMESTAMP_DOMAIN_GLOBAL_TIME, i, profiles[d] });
+            }
+
+            frame f;
+            while (q.poll_for_frame(&f))
+            {
+                std::vector<unsigned long long> numbers;
+                for (auto&& m : frameset(f))
+                    numbers.push_back(m.get_frame_number());
+                results.push_back(numbers);
+            }
+        }
+
+        for (auto&& s : sensors)
+            s.stop();
+        return results;
+    };
+
+    SECTION("A lost frame makes a partial frameset")
+    {
+        auto results = run(false, [](int d, int i) { return d != 2 || i != 5; }, frames);
+
+        REQUIRE(results.size() == frames);
+        for (auto i = 0; i < frames; i++)
+        {
+            CAPTURE(i);
+            REQUIRE(results[i] == std::vector<unsigned long long>(i == 5 ? 2 : devices, i));
+        }
+    }
+
+    SECTION("A stopped device is waited for up to the latency bound")
+    {
+        const int last = 10;
+        auto results = run(true, [&](int d, int i) { return d != 2 || i <= last; }, frames);
+
+        // The first frameset waits for all the devices to start. Only the frameset that waited for
+        // the stopped device is incomplete and released, the later ones are complete without it
+        REQUIRE(results.size() == frames - 1);
+        for (auto i = 0; i <= last; i++)
+        {
+            CAPTURE(i);
+            REQUIRE(results[i] == std::vector<unsigned long long>(devices, i));
+        }
+        for (auto i = last + 2; i < frames; i++)
+        {
+            CAPTURE(i);
+            REQUIRE(results[i - 1] == std::vector<unsigned long long>(devices - 1, i));
+        }
+    }
+
+    SECTION("Timestamps going back restart the matching")
+    {
+        // Like a looped recording
+        auto results = run(true, [](int, int) { return true; }, frames / 2);
+
+        REQUIRE(results.size() == frames);
+        for (auto i = 0; i < frames; i++)
+        {
+            CAPTURE(i);
+            REQUIRE(results[i] == std::vector<unsigned long long>(devices, i));
+        }
+    }
+}
+
 // Marked as MayFail due to DSO-11753. TODO -revisit once resolved
 TEST_CASE("Projection from recording", "[software-device][using_pipeline][projection][!mayfail]") {
     rs2::context ctx;
@@ -5137,6 +5293,63 @@ TEST_CASE("software-device motion stream", "[software-device]")
 
 }
 
+TEST_CASE("software-device frame metadata in bulk", "[software-device]")
+{
+    const int width = 16, height = 8, bpp = 2;
+    std::map<rs2_frame_metadata_value, rs2_metadata_type> metadata = {
+        { RS2_FRAME_METADATA_FRAME_COUNTER, 42 },
+        { RS2_FRAME_METADATA_ACTUAL_EXPOSURE, 33000 },
+        { RS2_FRAME_METADATA_GAIN_LEVEL, 16 },
+        { RS2_FRAME_METADATA_LOW_LIGHT_COMPENSATION, -1 } };
+
+    rs2::software_device dev;
+
+    auto sensor = dev.add_sensor("Depth"); // Define single sensor
+    rs2_intrinsics intrinsics{ width, height, 0, 0, 0, 0, RS2_DISTORTION_NONE, { 0,0,0,0,0 } };
+    auto stream_profile = sensor.add_video_stream({ RS2_STREAM_DEPTH, 0, 0, width, height, 30, bpp, RS2_FORMAT_Z16, intrinsics });
+    for (auto&& md : metadata)
+        sensor.set_metadata(md.first, md.second);
+
+    rs2::frame_queue q;
+
+    sensor.open(stream_profile);
+    sensor.start(q);
+
+    std::vector<uint8_t> pixels(width * height * bpp, 0);
+    sensor.on_video_frame({ pixels.data(), [](void*) {}, width * bpp, bpp, 0, RS2_TIMESTAMP_DOMAIN_HARDWARE_CLOCK, 1, stream_profile });
+    rs2::frame f = q.wait_for_frame();
+
+    std::vector<rs2_metadata_type> values(RS2_FRAME_METADATA_COUNT, -7);
+    auto supported = f.get_frame_metadata_all(values.data());
+    for (int i = 0; i < RS2_FRAME_METADATA_COUNT; i++)
+    {
+        auto md = static_cast<rs2_frame_metadata_value>(i);
+        CAPTURE(md);
+        auto expected = metadata.find(md);
+        bool expected_supported = expected != metadata.end();
+        REQUIRE(f.supports_frame_metadata(md) == expected_supported);
+        REQUIRE(((supported >> i) & 1) == (expected_supported ? 1 : 0));
+        if (expected_supported)
+        {
+            REQUIRE(values[i] == expected->second);
+            REQUIRE(f.get_frame_metadata(md) == expected->second);
+        }
+        else
+        {
+            REQUIRE(values[i] == 0);
+            REQUIRE_THROWS(f.get_frame_metadata(md));
+        }
+    }
+
+    // A shorter array receives the leading attributes only
+    std::vector<rs2_metadata_type> first(2, -7);
+    REQUIRE(f.get_frame_metadata_all(first.data(), 2) == (supported & 3));
+    REQUIRE(first[0] == 42);
+
+    sensor.stop();
+    sensor.close();
+}
+
 TEST_CASE("Record software-device", "[software-device][record][!mayfail]")
 {
     const int W = 640;
@@ -5229,6 +5442,256 @@ TEST_CASE("Record software-device", "[software-device][record][!mayfail]")
         pose_frame.timestamp == recorded_pose.get_timestamp()));
 }
 
+TEST_CASE("Record software-device with compression threads", "[software-device][record]")
+{
+    const int W = 640;
+    const int H = 480;
+    const int BPP = 2;
+    const int frames_count = 20;
+
+    std::string folder_name = get_folder_path(special_folder::temp_folder);
+
+    std::vector<std::vector<uint8_t>> pixels(frames_count);
+    for (int i = 0; i < frames_count; i++)
+    {
+        pixels[i].resize(W * H * BPP);
+        for (size_t j = 0; j < pixels[i].size(); j++)
+            pixels[i][j] = static_cast<uint8_t>((j / W + i) * (j % 13));
+    }
+
+    auto record = [&](const std::string& filename, const rs2_recorder_config& config)
+    {
+        rs2::software_device dev;
+        auto sensor = dev.add_sensor("Synthetic");
+        rs2_intrinsics depth_intrinsics = { W, H, (float)W / 2, H / 2, (float)W, (float)H,
+            RS2_DISTORTION_BROWN_CONRADY ,{ 0,0,0,0,0 } };
+        rs2_video_stream video_stream = { RS2_STREAM_DEPTH, 0, 0, W, H, 60, BPP, RS2_FORMAT_Z16, depth_intrinsics };
+        auto depth_stream_profile = sensor.add_video_stream(video_stream);
+
+        recorder recorder(filename, dev, config);
+        sensor.open(depth_stream_profile);
+        sensor.start([](rs2::frame) {});
+        for (int i = 0; i < frames_count; i++)
+        {
+            rs2_software_video_frame video_frame = { pixels[i].data(), [](void*) {}, W*BPP, BPP, 10000.0 + i * 10, RS2_TIMESTAMP_DOMAIN_HARDWARE_CLOCK, i, depth_stream_profile };
+            sensor.on_video_frame(video_frame);
+        }
+        sensor.stop();
+        sensor.close();
+        // Pausing waits for the frames already handed to the recorder
+        recorder.pause();
+        return recorder.get_statistics();
+    };
+
+    struct recorded_frame
+    {
+        unsigned long long number;
+        double timestamp;
+        std::vector<uint8_t> data;
+    };
+    auto play = [&](const std::string& filename)
+    {
+        rs2::context ctx;
+        auto player_dev = ctx.load_device(filename);
+        player_dev.set_real_time(false);
+        auto s = player_dev.query_sensors()[0];
+
+        std::mutex mutex;
+        std::condition_variable cv;
+        std::vector<recorded_frame> frames;
+        bool playback_stopped = false;
+        player_dev.set_status_changed_callback([&](rs2_playback_status status)
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (status == RS2_PLAYBACK_STATUS_STOPPED)
+                playback_stopped = true;
+            cv.notify_all();
+        });
+        REQUIRE_NOTHROW(s.open(s.get_stream_profiles()));
+        REQUIRE_NOTHROW(s.start([&](rs2::frame depth)
+        {
+            // Copy while the frame is delivered, holding the frames would exhaust the playback frame pool
+            auto data = static_cast<const uint8_t*>(depth.get_data());
+            std::lock_guard<std::mutex> lock(mutex);
+            frames.push_back({ depth.get_frame_number(), depth.get_timestamp(), std::vector<uint8_t>(data, data + depth.get_data_size()) });
+        }));
+
+        // Playback stops the sensor by itself at the end of the file
+        std::unique_lock<std::mutex> lock(mutex);
+        REQUIRE(cv.wait_for(lock, std::chrono::seconds(10), [&]() { return playback_stopped; }));
+        lock.unlock();
+        s.close();
+        return frames;
+    };
+
+    // The same recording, with the chunks compressed on the writing thread and on two compression threads
+    auto inline_stats = record(folder_name + "recording_compression_inline.bag", { 5, 0, 0, RS2_RECORDER_OVERFLOW_POLICY_BLOCK });
+    auto threaded_stats = record(folder_name + "recording_compression_threads.bag", { 5, 2, 0, RS2_RECORDER_OVERFLOW_POLICY_BLOCK });
+    for (auto&& stats : { inline_stats, threaded_stats })
+    {
+        REQUIRE(stats.pending_frames == 0);
+        REQUIRE(stats.pending_bytes == 0);
+        REQUIRE(stats.dropped_frames == 0);
+    }
+
+    auto inline_frames = play(folder_name + "recording_compression_inline.bag");
+    auto threaded_frames = play(folder_name + "recording_compression_threads.bag");
+    REQUIRE(inline_frames.size() == frames_count);
+    REQUIRE(threaded_frames.size() == frames_count);
+    for (int i = 0; i < frames_count; i++)
+    {
+        CAPTURE(i);
+        REQUIRE(inline_frames[i].number == i);
+        REQUIRE(inline_frames[i].data == pixels[i]);
+        REQUIRE(threaded_frames[i].number == inline_frames[i].number);
+        REQUIRE(threaded_frames[i].timestamp == inline_frames[i].timestamp);
+        REQUIRE(threaded_frames[i].data == inline_frames[i].data);
+    }
+}
+
+TEST_CASE("Playback software-device random access", "[software-device][record]")
+{
+    const int W = 320;
+    const int H = 240;
+    const int BPP = 2;
+    const int frames_count = 30;
+
+    std::string folder_name = get_folder_path(special_folder::temp_folder);
+    const std::string filename = folder_name + "recording_random_access.bag";
+
+    rs2::software_device dev;
+
+    auto sensor = dev.add_sensor("Synthetic");
+    rs2_intrinsics depth_intrinsics = { W, H, (float)W / 2, H / 2, (float)W, (float)H,
+        RS2_DISTORTION_BROWN_CONRADY ,{ 0,0,0,0,0 } };
+    rs2_video_stream video_stream = { RS2_STREAM_DEPTH, 0, 0, W, H, 60, BPP, RS2_FORMAT_Z16, depth_intrinsics };
+    auto depth_stream_profile = sensor.add_video_stream(video_stream);
+
+    std::vector<std::vector<uint8_t>> pixels(frames_count);
+    for (int i = 0; i < frames_count; i++)
+        pixels[i].assign(W * H * BPP, static_cast<uint8_t>(i * 7));
+
+    {
+        recorder recorder(filename, dev);
+        sensor.open(depth_stream_profile);
+        sensor.start([](rs2::frame) {});
+        for (int i = 0; i < frames_count; i++)
+        {
+            rs2_software_video_frame video_frame = { pixels[i].data(), [](void*) {}, W*BPP, BPP, 10000.0 + i * 10, RS2_TIMESTAMP_DOMAIN_HARDWARE_CLOCK, i, depth_stream_profile };
+            sensor.on_video_frame(video_frame);
+        }
+        sensor.stop();
+        sensor.close();
+    }
+
+    rs2::context ctx;
+    if (!make_context(SECTION_FROM_TEST_NAME, &ctx))
+        return;
+    auto player_dev = ctx.load_device(filename);
+    auto profile = player_dev.query_sensors()[0].get_stream_profiles()[0];
+
+    REQUIRE(player_dev.get_frames_count(profile) == frames_count);
+
+    // Read out of order, frames are addressed by their position in the stream
+    for (int i : { 17, 0, frames_count - 1, 5, 5, 24 })
+    {
+        CAPTURE(i);
+        auto f = player_dev.get_frame(profile, i);
+        REQUIRE(f);
+        REQUIRE(f.get_frame_number() == static_cast<unsigned long long>(i));
+        REQUIRE(f.get_timestamp() == Approx(10000.0 + i * 10));
+        REQUIRE(f.get_profile().stream_type() == RS2_STREAM_DEPTH);
+        REQUIRE(memcmp(pixels[i].data(), f.get_data(), W * H * BPP) == 0);
+    }
+    REQUIRE_THROWS(player_dev.get_frame(profile, frames_count));
+
+    // Random access does not move the playback position
+    REQUIRE(player_dev.get_position() == 0);
+}
+
+TEST_CASE("Playback software-device with read ahead", "[software-device][record]")
+{
+    const int W = 640;
+    const int H = 480;
+    const int BPP = 2;
+    const int frames_count = 60;
+
+    std::string folder_name = get_folder_path(special_folder::temp_folder);
+    const std::string filename = folder_name + "recording_read_ahead.bag";
+
+    rs2::software_device dev;
+
+    auto sensor = dev.add_sensor("Synthetic");
+    rs2_intrinsics depth_intrinsics = { W, H, (float)W / 2, H / 2, (float)W, (float)H,
+        RS2_DISTORTION_BROWN_CONRADY ,{ 0,0,0,0,0 } };
+    rs2_video_stream video_stream = { RS2_STREAM_DEPTH, 0, 0, W, H, 60, BPP, RS2_FORMAT_Z16, depth_intrinsics };
+    auto depth_stream_profile = sensor.add_video_stream(video_stream);
+
+    std::vector<std::vector<uint8_t>> pixels(frames_count);
+    for (int i = 0; i < frames_count; i++)
+    {
+        pixels[i].resize(W * H * BPP);
+        for (size_t j = 0; j < pixels[i].size(); j++)
+            pixels[i][j] = static_cast<uint8_t>((j / W + i) * (j % 13));
+    }
+
+    {
+        recorder recorder(filename, dev);
+        sensor.open(depth_stream_profile);
+        sensor.start([](rs2::frame) {});
+        for (int i = 0; i < frames_count; i++)
+        {
+            rs2_software_video_frame video_frame = { pixels[i].data(), [](void*) {}, W*BPP, BPP, 10000.0 + i * 10, RS2_TIMESTAMP_DOMAIN_HARDWARE_CLOCK, i, depth_stream_profile };
+            sensor.on_video_frame(video_frame);
+        }
+        sensor.stop();
+        sensor.close();
+    }
+
+    rs2::context ctx;
+    if (!make_context(SECTION_FROM_TEST_NAME, &ctx))
+        return;
+
+    // Each of the chunks is about 768KB, a small budget keeps only a few of them ahead
+    for (auto max_bytes : { 0ULL, 2000000ULL, 64000000ULL })
+    {
+        CAPTURE(max_bytes);
+        auto player_dev = ctx.load_device(filename);
+        player_dev.set_real_time(false);
+        player_dev.set_read_ahead(2, max_bytes);
+        auto s = player_dev.query_sensors()[0];
+        std::atomic<int> recorded_frames(0), matching_frames(0), ordered_frames(0);
+        std::atomic<long long> last_frame_number(-1);
+        std::atomic<bool> playback_stopped(false);
+        player_dev.set_status_changed_callback([&](rs2_playback_status status)
+        {
+            if (status == RS2_PLAYBACK_STATUS_STOPPED)
+                playback_stopped = true;
+        });
+        REQUIRE_NOTHROW(s.open(s.get_stream_profiles()));
+        REQUIRE_NOTHROW(s.start([&](rs2::frame depth)
+        {
+            auto i = depth.get_frame_number();
+            if (i < frames_count && memcmp(pixels[i].data(), depth.get_data(), W * H * BPP) == 0)
+                matching_frames++;
+            if (static_cast<long long>(i) > last_frame_number)
+                ordered_frames++;
+            last_frame_number = i;
+            recorded_frames++;
+        }));
+
+        // Playback stops the sensor by itself at the end of the file
+        for (int i = 0; i < 100 && !playback_stopped; i++)
+            std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+        REQUIRE(playback_stopped);
+        REQUIRE(recorded_frames == frames_count);
+        REQUIRE(matching_frames == frames_count);
+        REQUIRE(ordered_frames == frames_count);
+        s.close();
+    }
+}
+
 void compare(filter first, filter second)
 {
     CAPTURE(first.get_info(RS2_CAMERA_INFO_NAME));
@@ -39,7 +39,8 @@ public enum Extension {
     WHEEL_ODOMETER(35),
     GLOBAL_TIMER(36),
     UPDATABLE(37),
-    UPDATE_DEVICE(38);
+    UPDATE_DEVICE(38),
+    DEPTH_POSTPROCESS_FILTER(39);
 
     private final int mValue;
 
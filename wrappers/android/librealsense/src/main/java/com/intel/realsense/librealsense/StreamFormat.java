@@ -23,7 +23,8 @@ public enum StreamFormat {
     DISPARITY32(19),
     Y10BPACK(20),
     DISTANCE(21),
-    MJPEG(22);
+    MJPEG(22),
+    MOTION_XYZ32F_BATCH(23);
     private final int mValue;
 
     private StreamFormat(int value) { mValue = value; }
@@ -47,5 +47,6 @@ namespace Intel.RealSense
         GlobalTimer = 36,
         Updatable = 37,
         UpdateDevice = 38,
+        DepthPostprocessFilter = 39,
     }
 }
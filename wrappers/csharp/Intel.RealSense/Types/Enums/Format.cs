@@ -77,5 +77,8 @@ namespace Intel.RealSense
         /// <summary>Bitstream encoding for video in which an image of each frame is encoded as JPEG-DIB.</summary>
         Mjpeg = 22,
 
+        /// <summary>Motion data of several consecutive samples, packed as an array of rs2_motion_sample</summary>
+        MotionXyz32fBatch = 23,
+
     }
 }